@@ -0,0 +1,902 @@
+/*
+    bench_chips.c
+
+    ROM-free micro-benchmarks for the chip emulators, using the measuring
+    and reporting code in util/bench.h.
+
+    Build and run from the repository root:
+
+        cc -O2 -I. bench/bench_chips.c -o bench_chips -lm
+        ./bench_chips [-csv] [-seconds N] [-tag TAG]
+
+    Each benchmark runs a small loop program, or a fixed chip setup with
+    minimal pin glue, for N emulated seconds (default: 10) and writes one
+    result per line as JSON (or CSV with -csv). Chips are ticked at the
+    clock frequency of a typical host system. The uPD765 has no tick
+    function, its benchmark runs the CPU side of an endless READ DATA
+    command loop at one register access per tick.
+*/
+#define CHIPS_IMPL
+#define CHIPS_UTIL_IMPL
+#include "chips/chips_common.h"
+#include "chips/chips_audio.h"
+#include "chips/clk.h"
+#include "chips/z80.h"
+#include "chips/m6502.h"
+#include "chips/m6502x.h"
+#include "chips/ay38910.h"
+#include "chips/m6581.h"
+#include "chips/m6526.h"
+#include "chips/m6569.h"
+#include "chips/m6522.h"
+#include "chips/m6561.h"
+#include "chips/mc6845.h"
+#include "chips/mc6847.h"
+#include "chips/am40010.h"
+#include "chips/i8255.h"
+#include "chips/z80ctc.h"
+#include "chips/z80pio.h"
+#include "chips/beeper.h"
+#include "chips/upd765.h"
+#include "util/bench.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define Z80_FREQ (4000000)
+#define M6502_FREQ (1000000)
+#define AY_FREQ (1773400)
+#define C64_FREQ (985248)
+#define SID_FREQ (C64_FREQ)
+#define VIC20_FREQ (1108404)
+#define CPC_FREQ (4000000)
+#define CCLK_FREQ (1000000)
+#define ATOM_FREQ (1000000)
+#define KC85_FREQ (1750000)
+#define ZX_FREQ (3500000)
+#define FDC_FREQ (1000000)
+#define SOUND_HZ (44100)
+
+typedef struct {
+    z80_t cpu;
+    uint64_t pins;
+    uint8_t mem[1<<16];
+} z80_bench_t;
+
+typedef struct {
+    m6502_t cpu;
+    uint64_t pins;
+    uint8_t mem[1<<16];
+} m6502_bench_t;
+
+typedef struct {
+    m6502x_t cpu;
+    uint64_t pins[M6502X_LANES];
+    uint8_t mem[M6502X_LANES][1<<16];
+} m6502x_bench_t;
+
+typedef struct {
+    ay38910_t ay;
+    int64_t sum;
+} ay38910_bench_t;
+
+typedef struct {
+    m6581_t sid;
+    int64_t sum;
+} m6581_bench_t;
+
+typedef struct {
+    m6526_t cia;
+    uint64_t pins;
+} m6526_bench_t;
+
+typedef struct {
+    m6569_t vic;
+    uint8_t mem[1<<14];
+    uint8_t color_ram[1<<10];
+    uint8_t fb[M6569_FRAMEBUFFER_SIZE_BYTES];
+} m6569_bench_t;
+
+typedef struct {
+    m6522_t via;
+    uint64_t pins;
+} m6522_bench_t;
+
+typedef struct {
+    m6561_t vic;
+    uint8_t mem[1<<14];
+    uint8_t color_ram[1<<10];
+    uint8_t fb[M6561_FRAMEBUFFER_SIZE_BYTES];
+    int64_t sum;
+} m6561_bench_t;
+
+typedef struct {
+    mc6845_t crtc;
+    uint32_t num_de;
+} mc6845_bench_t;
+
+typedef struct {
+    mc6847_t vdg;
+    uint8_t mem[1<<13];
+    uint8_t fb[MC6847_FRAMEBUFFER_SIZE_BYTES];
+} mc6847_bench_t;
+
+typedef struct {
+    am40010_t ga;
+    mc6845_t crtc;
+    uint8_t ram[1<<16];
+    uint8_t fb[AM40010_FRAMEBUFFER_SIZE_BYTES];
+} am40010_bench_t;
+
+typedef struct {
+    i8255_t ppi;
+    uint32_t sum;
+} i8255_bench_t;
+
+typedef struct {
+    z80ctc_t ctc;
+    uint64_t pins;
+} z80ctc_bench_t;
+
+typedef struct {
+    z80pio_t pio;
+    uint32_t sum;
+} z80pio_bench_t;
+
+typedef struct {
+    beeper_t beeper;
+    uint32_t count;
+    int64_t sum;
+} beeper_bench_t;
+
+typedef struct {
+    upd765_t fdc;
+    bool status_read;   // true if the next access reads the data register
+    uint8_t status;
+    int cmd_pos;
+    int sector_pos;
+    uint32_t sum;
+} upd765_bench_t;
+
+static z80_bench_t z80_bench;
+static m6502_bench_t m6502_bench;
+static m6502x_bench_t m6502x_bench;
+static ay38910_bench_t ay38910_bench;
+static m6581_bench_t m6581_bench;
+static m6526_bench_t m6526_bench;
+static m6569_bench_t m6569_bench;
+static m6522_bench_t m6522_bench;
+static m6561_bench_t m6561_bench;
+static mc6845_bench_t mc6845_bench;
+static mc6847_bench_t mc6847_bench;
+static am40010_bench_t am40010_bench;
+static i8255_bench_t i8255_bench;
+static z80ctc_bench_t z80ctc_bench;
+static z80pio_bench_t z80pio_bench;
+static beeper_bench_t beeper_bench;
+static upd765_bench_t upd765_bench;
+
+// a loop which reads, modifies and writes 256 bytes of memory
+static const uint8_t z80_prog[] = {
+    0x21, 0x00, 0x80,   // LD HL,0x8000
+    0x7E,               // loop: LD A,(HL)
+    0x85,               // ADD A,L
+    0x77,               // LD (HL),A
+    0x2C,               // INC L
+    0x10, 0xFA,         // DJNZ loop
+    0xC3, 0x03, 0x00,   // JP loop
+};
+
+static const uint8_t m6502_prog[] = {
+    0xA2, 0x00,         // LDX #0
+    0xBD, 0x00, 0x02,   // loop: LDA $0200,X
+    0x69, 0x01,         // ADC #1
+    0x9D, 0x00, 0x02,   // STA $0200,X
+    0xE8,               // INX
+    0xD0, 0xF5,         // BNE loop
+    0x4C, 0x00, 0x10,   // JMP $1000
+};
+
+static uint32_t exec_z80(void* user_data, uint32_t micro_seconds) {
+    z80_bench_t* b = (z80_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(Z80_FREQ, micro_seconds);
+    uint64_t pins = b->pins;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        pins = z80_tick(&b->cpu, pins);
+        if (pins & Z80_MREQ) {
+            const uint16_t addr = Z80_GET_ADDR(pins);
+            if (pins & Z80_RD) {
+                Z80_SET_DATA(pins, b->mem[addr]);
+            }
+            else if (pins & Z80_WR) {
+                b->mem[addr] = Z80_GET_DATA(pins);
+            }
+        }
+    }
+    b->pins = pins;
+    return num_ticks;
+}
+
+static uint32_t exec_m6502(void* user_data, uint32_t micro_seconds) {
+    m6502_bench_t* b = (m6502_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(M6502_FREQ, micro_seconds);
+    uint64_t pins = b->pins;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        pins = m6502_tick(&b->cpu, pins);
+        const uint16_t addr = M6502_GET_ADDR(pins);
+        if (pins & M6502_RW) {
+            M6502_SET_DATA(pins, b->mem[addr]);
+        }
+        else {
+            b->mem[addr] = M6502_GET_DATA(pins);
+        }
+    }
+    b->pins = pins;
+    return num_ticks;
+}
+
+// returns the number of ticks summed over all lanes
+static uint32_t exec_m6502x(void* user_data, uint32_t micro_seconds) {
+    m6502x_bench_t* b = (m6502x_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(M6502_FREQ, micro_seconds);
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        m6502x_tick(&b->cpu, b->pins);
+        for (int l = 0; l < M6502X_LANES; l++) {
+            const uint16_t addr = M6502_GET_ADDR(b->pins[l]);
+            if (b->pins[l] & M6502_RW) {
+                M6502_SET_DATA(b->pins[l], b->mem[l][addr]);
+            }
+            else {
+                b->mem[l][addr] = M6502_GET_DATA(b->pins[l]);
+            }
+        }
+    }
+    return num_ticks * M6502X_LANES;
+}
+
+static uint32_t exec_ay38910(void* user_data, uint32_t micro_seconds) {
+    ay38910_bench_t* b = (ay38910_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(AY_FREQ, micro_seconds);
+    uint32_t ticks = num_ticks;
+    while (ticks > 0) {
+        if (ay38910_advance(&b->ay, &ticks)) {
+            b->sum += b->ay.sample;
+        }
+    }
+    return num_ticks;
+}
+
+static uint32_t exec_m6581(void* user_data, uint32_t micro_seconds) {
+    m6581_bench_t* b = (m6581_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(SID_FREQ, micro_seconds);
+    uint32_t ticks = num_ticks;
+    while (ticks > 0) {
+        if (m6581_advance(&b->sid, &ticks)) {
+            b->sum += b->sid.sample;
+        }
+    }
+    return num_ticks;
+}
+
+static uint32_t exec_m6526(void* user_data, uint32_t micro_seconds) {
+    m6526_bench_t* b = (m6526_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(C64_FREQ, micro_seconds);
+    uint64_t pins = b->pins;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        // acknowledge the timer interrupt by reading the ICR
+        pins = (pins & M6526_IRQ) ? (M6526_CS|M6526_RW|M6526_REG_ICR) : 0;
+        pins = m6526_tick(&b->cia, pins);
+    }
+    b->pins = pins;
+    return num_ticks;
+}
+
+static uint32_t exec_m6569(void* user_data, uint32_t micro_seconds) {
+    m6569_bench_t* b = (m6569_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(C64_FREQ, micro_seconds);
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        m6569_tick(&b->vic, 0);
+    }
+    return num_ticks;
+}
+
+static uint32_t exec_m6522(void* user_data, uint32_t micro_seconds) {
+    m6522_bench_t* b = (m6522_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(VIC20_FREQ, micro_seconds);
+    uint64_t pins = b->pins;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        // acknowledge the timer 1 interrupt by reading T1CL
+        pins = (pins & M6522_IRQ) ? (M6522_CS1|M6522_RW|M6522_REG_T1CL) : 0;
+        pins = m6522_tick(&b->via, pins);
+    }
+    b->pins = pins;
+    return num_ticks;
+}
+
+static uint32_t exec_m6561(void* user_data, uint32_t micro_seconds) {
+    m6561_bench_t* b = (m6561_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(VIC20_FREQ, micro_seconds);
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        if (m6561_tick(&b->vic, 0) & M6561_SAMPLE) {
+            b->sum += b->vic.sound.sample;
+        }
+    }
+    return num_ticks;
+}
+
+static uint32_t exec_mc6845(void* user_data, uint32_t micro_seconds) {
+    mc6845_bench_t* b = (mc6845_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(CCLK_FREQ, micro_seconds);
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        if (mc6845_tick(&b->crtc) & MC6845_DE) {
+            b->num_de++;
+        }
+    }
+    return num_ticks;
+}
+
+static uint32_t exec_mc6847(void* user_data, uint32_t micro_seconds) {
+    mc6847_bench_t* b = (mc6847_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(ATOM_FREQ, micro_seconds);
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        mc6847_tick(&b->vdg, 0);
+    }
+    return num_ticks;
+}
+
+// the gate array ticks the CRTC through the CCLK callback
+static uint32_t exec_am40010(void* user_data, uint32_t micro_seconds) {
+    am40010_bench_t* b = (am40010_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(CPC_FREQ, micro_seconds);
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        am40010_tick(&b->ga, 0);
+    }
+    return num_ticks;
+}
+
+// alternately writes port A and reads port B
+static uint32_t exec_i8255(void* user_data, uint32_t micro_seconds) {
+    i8255_bench_t* b = (i8255_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(CPC_FREQ, micro_seconds);
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        uint64_t pins;
+        if (i & 1) {
+            pins = I8255_CS|I8255_RD|I8255_A0;
+            I8255_SET_PB(pins, i);
+        }
+        else {
+            pins = I8255_CS|I8255_WR;
+            I8255_SET_DATA(pins, i);
+        }
+        pins = i8255_tick(&b->ppi, pins);
+        b->sum += I8255_GET_DATA(pins) + I8255_GET_PA(pins);
+    }
+    return num_ticks;
+}
+
+// channel 3 counts the zero-count pulses of channel 0
+static uint32_t exec_z80ctc(void* user_data, uint32_t micro_seconds) {
+    z80ctc_bench_t* b = (z80ctc_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(KC85_FREQ, micro_seconds);
+    uint64_t pins = b->pins;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        pins = (pins & Z80CTC_ZCTO0) ? Z80CTC_CLKTRG3 : 0;
+        pins = z80ctc_tick(&b->ctc, pins);
+    }
+    b->pins = pins;
+    return num_ticks;
+}
+
+// alternately writes port A and reads port B
+static uint32_t exec_z80pio(void* user_data, uint32_t micro_seconds) {
+    z80pio_bench_t* b = (z80pio_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(KC85_FREQ, micro_seconds);
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        uint64_t pins;
+        if (i & 1) {
+            pins = Z80PIO_CE|Z80PIO_IORQ|Z80PIO_RD|Z80PIO_BASEL;
+            Z80PIO_SET_PB(pins, i);
+        }
+        else {
+            pins = Z80PIO_CE|Z80PIO_IORQ;
+            Z80PIO_SET_DATA(pins, i);
+        }
+        pins = z80pio_tick(&b->pio, pins);
+        b->sum += Z80PIO_GET_DATA(pins) + Z80PIO_GET_PA(pins);
+    }
+    return num_ticks;
+}
+
+// a 1750 Hz square wave
+static uint32_t exec_beeper(void* user_data, uint32_t micro_seconds) {
+    beeper_bench_t* b = (beeper_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(ZX_FREQ, micro_seconds);
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        if (++b->count == 1000) {
+            b->count = 0;
+            beeper_toggle(&b->beeper);
+        }
+        if (beeper_tick(&b->beeper)) {
+            b->sum += b->beeper.sample;
+        }
+    }
+    return num_ticks;
+}
+
+/*  alternately polls the main status register and transfers a data byte
+    when the FDC is ready, the transferred bytes are the command bytes
+    of a READ DATA command, the sector data and the result bytes
+*/
+static const uint8_t upd765_cmd[9] = { 0x46, 0x00, 0x00, 0x00, 0xC1, 0x02, 0xC1, 0x2A, 0xFF };
+
+static uint32_t exec_upd765(void* user_data, uint32_t micro_seconds) {
+    upd765_bench_t* b = (upd765_bench_t*) user_data;
+    const uint32_t num_ticks = clk_us_to_ticks(FDC_FREQ, micro_seconds);
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        uint64_t pins;
+        if (!b->status_read) {
+            pins = upd765_iorq(&b->fdc, UPD765_CS|UPD765_RD);
+            b->status = UPD765_GET_DATA(pins);
+            b->status_read = 0 != (b->status & UPD765_STATUS_RQM);
+        }
+        else {
+            if (b->status & UPD765_STATUS_DIO) {
+                pins = upd765_iorq(&b->fdc, UPD765_CS|UPD765_RD|UPD765_A0);
+                b->sum += UPD765_GET_DATA(pins);
+            }
+            else {
+                pins = UPD765_CS|UPD765_WR|UPD765_A0;
+                UPD765_SET_DATA(pins, upd765_cmd[b->cmd_pos]);
+                upd765_iorq(&b->fdc, pins);
+                b->cmd_pos = (b->cmd_pos + 1) % (int)sizeof(upd765_cmd);
+            }
+            b->status_read = false;
+        }
+    }
+    return num_ticks;
+}
+
+static void init_z80(z80_bench_t* b) {
+    memset(b, 0, sizeof(z80_bench_t));
+    memcpy(b->mem, z80_prog, sizeof(z80_prog));
+    b->pins = z80_init(&b->cpu);
+}
+
+static void init_m6502(m6502_bench_t* b) {
+    memset(b, 0, sizeof(m6502_bench_t));
+    memcpy(&b->mem[0x1000], m6502_prog, sizeof(m6502_prog));
+    b->mem[0xFFFD] = 0x10;
+    b->pins = m6502_init(&b->cpu, &(m6502_desc_t){0});
+}
+
+static void init_m6502x(m6502x_bench_t* b) {
+    memset(b, 0, sizeof(m6502x_bench_t));
+    for (int l = 0; l < M6502X_LANES; l++) {
+        memcpy(&b->mem[l][0x1000], m6502_prog, sizeof(m6502_prog));
+        b->mem[l][0xFFFD] = 0x10;
+        // different data in each lane
+        for (int i = 0; i < 256; i++) {
+            b->mem[l][0x0200 + i] = (uint8_t)(i * (l + 1));
+        }
+    }
+    m6502x_init(&b->cpu, &(m6502_desc_t){0}, b->pins);
+}
+
+static void ay38910_write(ay38910_t* ay, uint8_t reg, uint8_t val) {
+    uint64_t pins = AY38910_BDIR|AY38910_BC1;
+    AY38910_SET_DATA(pins, reg);
+    ay38910_iorq(ay, pins);
+    pins = AY38910_BDIR;
+    AY38910_SET_DATA(pins, val);
+    ay38910_iorq(ay, pins);
+}
+
+static void init_ay38910(ay38910_bench_t* b) {
+    memset(b, 0, sizeof(ay38910_bench_t));
+    ay38910_init(&b->ay, &(ay38910_desc_t){
+        .type = AY38910_TYPE_8912,
+        .tick_hz = AY_FREQ,
+        .sound_hz = SOUND_HZ,
+        .magnitude = 1.0f,
+    });
+    // three tones, noise on channel C, envelope on channel A
+    const uint8_t regs[14] = { 0x1C, 0x01, 0xFD, 0x00, 0x7E, 0x00, 0x0F, 0x18, 0x10, 0x0C, 0x0A, 0x00, 0x10, 0x0E };
+    for (uint8_t i = 0; i < 14; i++) {
+        ay38910_write(&b->ay, i, regs[i]);
+    }
+}
+
+static void m6581_write(m6581_t* sid, uint8_t reg, uint8_t val) {
+    uint64_t pins = M6581_CS | reg;
+    M6581_SET_DATA(pins, val);
+    m6581_iorq(sid, pins);
+}
+
+static void init_m6581(m6581_bench_t* b) {
+    memset(b, 0, sizeof(m6581_bench_t));
+    m6581_init(&b->sid, &(m6581_desc_t){
+        .tick_hz = SID_FREQ,
+        .sound_hz = SOUND_HZ,
+        .magnitude = 1.0f,
+    });
+    // three voices (pulse, sawtooth, noise), low-pass filter on voice 1
+    const uint8_t regs[25] = {
+        0x00, 0x1C, 0x00, 0x08, 0x41, 0x09, 0xF0,
+        0x00, 0x25, 0x00, 0x00, 0x21, 0x00, 0xF0,
+        0x00, 0x08, 0x00, 0x00, 0x81, 0x22, 0xA0,
+        0x00, 0x40, 0xF1, 0x1F,
+    };
+    for (uint8_t i = 0; i < 25; i++) {
+        m6581_write(&b->sid, i, regs[i]);
+    }
+}
+
+static void m6526_write(m6526_t* cia, uint8_t reg, uint8_t val) {
+    uint64_t pins = M6526_CS | reg;
+    M6526_SET_DATA(pins, val);
+    m6526_tick(cia, pins);
+}
+
+static void init_m6526(m6526_bench_t* b) {
+    memset(b, 0, sizeof(m6526_bench_t));
+    m6526_init(&b->cia);
+    // timer A continuous with interrupt, timer B counts timer A underflows
+    const uint8_t regs[][2] = {
+        { M6526_REG_TALO, 0x00 }, { M6526_REG_TAHI, 0x01 },
+        { M6526_REG_TBLO, 0x10 }, { M6526_REG_TBHI, 0x00 },
+        { M6526_REG_ICR, 0x81 },
+        { M6526_REG_CRA, 0x11 }, { M6526_REG_CRB, 0x51 },
+    };
+    for (size_t i = 0; i < (sizeof(regs) / sizeof(regs[0])); i++) {
+        m6526_write(&b->cia, regs[i][0], regs[i][1]);
+    }
+}
+
+static uint16_t m6569_fetch(uint16_t addr, void* user_data) {
+    m6569_bench_t* b = (m6569_bench_t*) user_data;
+    return (uint16_t)((b->color_ram[addr & 0x03FF]<<8) | b->mem[addr & 0x3FFF]);
+}
+
+static void m6569_write(m6569_t* vic, uint8_t reg, uint8_t val) {
+    uint64_t pins = M6569_CS | reg;
+    M6569_SET_DATA(pins, val);
+    m6569_tick(vic, pins);
+}
+
+static void init_m6569(m6569_bench_t* b) {
+    memset(b, 0, sizeof(m6569_bench_t));
+    for (size_t i = 0; i < sizeof(b->mem); i++) {
+        b->mem[i] = (uint8_t)(i * 7);
+    }
+    for (size_t i = 0; i < sizeof(b->color_ram); i++) {
+        b->color_ram[i] = (uint8_t)(i & 15);
+    }
+    m6569_init(&b->vic, &(m6569_desc_t){
+        .framebuffer = { .ptr = b->fb, .size = sizeof(b->fb) },
+        .screen = { .x = 64, .y = 24, .width = 392, .height = 272 },
+        .fetch_cb = m6569_fetch,
+        .user_data = b,
+    });
+    // text mode with badlines, and all 8 sprites visible
+    for (uint8_t i = 0; i < 8; i++) {
+        m6569_write(&b->vic, 2*i, (uint8_t)(40 + i*32));
+        m6569_write(&b->vic, 2*i + 1, 100);
+    }
+    m6569_write(&b->vic, 0x11, 0x1B);
+    m6569_write(&b->vic, 0x15, 0xFF);
+    m6569_write(&b->vic, 0x16, 0xC8);
+    m6569_write(&b->vic, 0x18, 0x14);
+    m6569_write(&b->vic, 0x1C, 0xF0);
+}
+
+static void m6522_write(m6522_t* via, uint8_t reg, uint8_t val) {
+    uint64_t pins = M6522_CS1 | reg;
+    M6522_SET_DATA(pins, val);
+    m6522_tick(via, pins);
+}
+
+static void init_m6522(m6522_bench_t* b) {
+    memset(b, 0, sizeof(m6522_bench_t));
+    m6522_init(&b->via);
+    // timer 1 continuous with interrupt, timer 2 one-shot
+    const uint8_t regs[][2] = {
+        { M6522_REG_ACR, 0x40 },
+        { M6522_REG_T1CL, 0x00 }, { M6522_REG_T1CH, 0x01 },
+        { M6522_REG_T2CL, 0x80 }, { M6522_REG_T2CH, 0x00 },
+        { M6522_REG_IER, 0xC0 },
+    };
+    for (size_t i = 0; i < (sizeof(regs) / sizeof(regs[0])); i++) {
+        m6522_write(&b->via, regs[i][0], regs[i][1]);
+    }
+}
+
+static uint16_t m6561_fetch(uint16_t addr, void* user_data) {
+    m6561_bench_t* b = (m6561_bench_t*) user_data;
+    return (uint16_t)((b->color_ram[addr & 0x03FF]<<8) | b->mem[addr & 0x3FFF]);
+}
+
+static void init_m6561(m6561_bench_t* b) {
+    memset(b, 0, sizeof(m6561_bench_t));
+    for (size_t i = 0; i < sizeof(b->mem); i++) {
+        b->mem[i] = (uint8_t)(i * 7);
+    }
+    for (size_t i = 0; i < sizeof(b->color_ram); i++) {
+        b->color_ram[i] = (uint8_t)(i & 15);
+    }
+    m6561_init(&b->vic, &(m6561_desc_t){
+        .framebuffer = { .ptr = b->fb, .size = sizeof(b->fb) },
+        .screen = { .x = 32, .y = 8, .width = 232, .height = 272 },
+        .fetch_cb = m6561_fetch,
+        .user_data = b,
+        .tick_hz = VIC20_FREQ,
+        .sound_hz = SOUND_HZ,
+        .sound_magnitude = 1.0f,
+    });
+    // the VIC-20 KERNAL video setup, two tone voices and noise
+    const uint8_t regs[16] = {
+        0x0C, 0x26, 0x16, 0x2E, 0x00, 0xC0, 0x00, 0x00,
+        0x00, 0x00, 0xC0, 0xD8, 0x00, 0xF0, 0x0B, 0x1B,
+    };
+    for (uint8_t i = 0; i < 16; i++) {
+        uint64_t pins = M6561_CS | i;
+        M6561_SET_DATA(pins, regs[i]);
+        m6561_tick(&b->vic, pins);
+    }
+}
+
+static void mc6845_write(mc6845_t* crtc, uint8_t reg, uint8_t val) {
+    uint64_t pins = MC6845_CS;
+    MC6845_SET_DATA(pins, reg);
+    mc6845_iorq(crtc, pins);
+    pins = MC6845_CS|MC6845_RS;
+    MC6845_SET_DATA(pins, val);
+    mc6845_iorq(crtc, pins);
+}
+
+// the CRTC setup of the Amstrad CPC firmware
+static void mc6845_init_cpc(mc6845_t* crtc) {
+    mc6845_init(crtc, MC6845_TYPE_UM6845R);
+    const uint8_t regs[14] = { 63, 40, 46, 0x8E, 38, 0, 25, 30, 0, 7, 0, 0, 0x30, 0x00 };
+    for (uint8_t i = 0; i < 14; i++) {
+        mc6845_write(crtc, i, regs[i]);
+    }
+}
+
+static void init_mc6845(mc6845_bench_t* b) {
+    memset(b, 0, sizeof(mc6845_bench_t));
+    mc6845_init_cpc(&b->crtc);
+}
+
+// same as the Acorn Atom: bit 6 selects semigraphics, bit 7 inverts
+static uint64_t mc6847_fetch(uint64_t pins, void* user_data) {
+    mc6847_bench_t* b = (mc6847_bench_t*) user_data;
+    const uint8_t data = b->mem[MC6847_GET_ADDR(pins) & 0x1FFF];
+    MC6847_SET_DATA(pins, data);
+    if (data & (1<<7)) { pins |= MC6847_INV; }
+    else               { pins &= ~MC6847_INV; }
+    if (data & (1<<6)) { pins |= (MC6847_AS|MC6847_INTEXT); }
+    else               { pins &= ~(MC6847_AS|MC6847_INTEXT); }
+    return pins;
+}
+
+static void init_mc6847(mc6847_bench_t* b) {
+    memset(b, 0, sizeof(mc6847_bench_t));
+    for (size_t i = 0; i < sizeof(b->mem); i++) {
+        b->mem[i] = (uint8_t)(i * 7);
+    }
+    mc6847_init(&b->vdg, &(mc6847_desc_t){
+        .tick_hz = ATOM_FREQ,
+        .framebuffer = { .ptr = b->fb, .size = sizeof(b->fb) },
+        .fetch_cb = mc6847_fetch,
+        .user_data = b,
+    });
+}
+
+static uint64_t am40010_cclk(void* user_data) {
+    am40010_bench_t* b = (am40010_bench_t*) user_data;
+    return mc6845_tick(&b->crtc);
+}
+
+static void am40010_bankswitch(uint8_t ram_config, uint8_t rom_enable, uint8_t rom_select, void* user_data) {
+    (void)ram_config; (void)rom_enable; (void)rom_select; (void)user_data;
+}
+
+static void am40010_write(am40010_t* ga, uint8_t val) {
+    uint64_t pins = AM40010_IORQ|AM40010_WR|AM40010_A14;
+    pins |= (uint64_t)val << AM40010_PIN_D0;
+    am40010_iorq(ga, pins);
+}
+
+static void init_am40010(am40010_bench_t* b) {
+    memset(b, 0, sizeof(am40010_bench_t));
+    for (size_t i = 0; i < sizeof(b->ram); i++) {
+        b->ram[i] = (uint8_t)(i * 7);
+    }
+    mc6845_init_cpc(&b->crtc);
+    am40010_init(&b->ga, &(am40010_desc_t){
+        .cpc_type = AM40010_CPC_TYPE_6128,
+        .bankswitch_cb = am40010_bankswitch,
+        .cclk_cb = am40010_cclk,
+        .ram = { .ptr = b->ram, .size = sizeof(b->ram) },
+        .framebuffer = { .ptr = b->fb, .size = sizeof(b->fb) },
+        .user_data = b,
+    });
+    // 16 different ink colors, video mode 0
+    for (uint8_t i = 0; i < 16; i++) {
+        am40010_write(&b->ga, i);
+        am40010_write(&b->ga, (uint8_t)(0x40 | i));
+    }
+    am40010_write(&b->ga, 0x80|0x0C);
+}
+
+static void init_i8255(i8255_bench_t* b) {
+    memset(b, 0, sizeof(i8255_bench_t));
+    i8255_init(&b->ppi);
+    // mode 0, port A and C output, port B input
+    uint64_t pins = I8255_CS|I8255_WR|I8255_A0|I8255_A1;
+    I8255_SET_DATA(pins, I8255_CTRL_CONTROL_MODE|I8255_CTRL_B_INPUT);
+    i8255_tick(&b->ppi, pins);
+}
+
+static void z80ctc_write(z80ctc_t* ctc, int chn, uint8_t val) {
+    uint64_t pins = Z80CTC_CE|Z80CTC_IORQ|((uint64_t)chn * Z80CTC_CS0);
+    Z80CTC_SET_DATA(pins, val);
+    z80ctc_tick(ctc, pins);
+}
+
+static void init_z80ctc(z80ctc_bench_t* b) {
+    memset(b, 0, sizeof(z80ctc_bench_t));
+    z80ctc_init(&b->ctc);
+    // channels 0..2 in timer mode, channel 3 in counter mode
+    const uint8_t ctrl[4][2] = { { 0x05, 0x20 }, { 0x25, 0x08 }, { 0x05, 0x80 }, { 0x45, 0x04 } };
+    for (int i = 0; i < 4; i++) {
+        z80ctc_write(&b->ctc, i, ctrl[i][0]);
+        z80ctc_write(&b->ctc, i, ctrl[i][1]);
+    }
+}
+
+static void init_z80pio(z80pio_bench_t* b) {
+    memset(b, 0, sizeof(z80pio_bench_t));
+    z80pio_init(&b->pio);
+    // port A in output mode, port B in input mode
+    uint64_t pins = Z80PIO_CE|Z80PIO_IORQ|Z80PIO_CDSEL;
+    Z80PIO_SET_DATA(pins, (Z80PIO_MODE_OUTPUT<<6)|0x0F);
+    z80pio_tick(&b->pio, pins);
+    pins = Z80PIO_CE|Z80PIO_IORQ|Z80PIO_CDSEL|Z80PIO_BASEL;
+    Z80PIO_SET_DATA(pins, (Z80PIO_MODE_INPUT<<6)|0x0F);
+    z80pio_tick(&b->pio, pins);
+}
+
+static void init_beeper(beeper_bench_t* b) {
+    memset(b, 0, sizeof(beeper_bench_t));
+    beeper_init(&b->beeper, &(beeper_desc_t){
+        .tick_hz = ZX_FREQ,
+        .sound_hz = SOUND_HZ,
+        .base_volume = 1.0f,
+    });
+}
+
+// a single-sided disk with one 512-byte sector (id 0xC1) on each track
+static int upd765_seektrack(int drive, int track, void* user_data) {
+    (void)drive; (void)track; (void)user_data;
+    return UPD765_RESULT_SUCCESS;
+}
+
+static int upd765_seeksector(int drive, int side, upd765_sectorinfo_t* inout_info, void* user_data) {
+    (void)drive; (void)side;
+    upd765_bench_t* b = (upd765_bench_t*) user_data;
+    b->sector_pos = 0;
+    return (inout_info->r == 0xC1) ? UPD765_RESULT_SUCCESS : UPD765_RESULT_NOT_FOUND;
+}
+
+static int upd765_read(int drive, int side, void* user_data, uint8_t* out_data) {
+    (void)drive; (void)side;
+    upd765_bench_t* b = (upd765_bench_t*) user_data;
+    *out_data = (uint8_t)(b->sector_pos * 7);
+    return (++b->sector_pos == 512) ? UPD765_RESULT_END_OF_SECTOR : UPD765_RESULT_SUCCESS;
+}
+
+static int upd765_trackinfo(int drive, int side, void* user_data, upd765_sectorinfo_t* out_info) {
+    (void)drive; (void)side; (void)user_data;
+    out_info->physical_track = 0;
+    out_info->c = 0;
+    out_info->h = 0;
+    out_info->r = 0xC1;
+    out_info->n = 2;
+    return UPD765_RESULT_SUCCESS;
+}
+
+static void upd765_driveinfo(int drive, void* user_data, upd765_driveinfo_t* out_info) {
+    (void)drive; (void)user_data;
+    out_info->physical_track = 0;
+    out_info->sides = 1;
+    out_info->head = 0;
+    out_info->ready = true;
+    out_info->write_protected = false;
+    out_info->fault = false;
+}
+
+static void init_upd765(upd765_bench_t* b) {
+    memset(b, 0, sizeof(upd765_bench_t));
+    upd765_init(&b->fdc, &(upd765_desc_t){
+        .seektrack_cb = upd765_seektrack,
+        .seeksector_cb = upd765_seeksector,
+        .read_cb = upd765_read,
+        .trackinfo_cb = upd765_trackinfo,
+        .driveinfo_cb = upd765_driveinfo,
+        .user_data = b,
+    });
+}
+
+int main(int argc, char* argv[]) {
+    bool csv = false;
+    uint32_t num_seconds = BENCH_DEFAULT_SECONDS;
+    const char* tag = 0;
+    for (int i = 1; i < argc; i++) {
+        if (0 == strcmp(argv[i], "-csv")) {
+            csv = true;
+        }
+        else if ((0 == strcmp(argv[i], "-seconds")) && ((i + 1) < argc)) {
+            num_seconds = (uint32_t) atoi(argv[++i]);
+        }
+        else if ((0 == strcmp(argv[i], "-tag")) && ((i + 1) < argc)) {
+            tag = argv[++i];
+        }
+        else {
+            fprintf(stderr, "usage: %s [-csv] [-seconds N] [-tag TAG]\n", argv[0]);
+            return 10;
+        }
+    }
+
+    init_z80(&z80_bench);
+    init_m6502(&m6502_bench);
+    init_m6502x(&m6502x_bench);
+    init_ay38910(&ay38910_bench);
+    init_m6581(&m6581_bench);
+    init_m6526(&m6526_bench);
+    init_m6569(&m6569_bench);
+    init_m6522(&m6522_bench);
+    init_m6561(&m6561_bench);
+    init_mc6845(&mc6845_bench);
+    init_mc6847(&mc6847_bench);
+    init_am40010(&am40010_bench);
+    init_i8255(&i8255_bench);
+    init_z80ctc(&z80ctc_bench);
+    init_z80pio(&z80pio_bench);
+    init_beeper(&beeper_bench);
+    init_upd765(&upd765_bench);
+    const bench_desc_t descs[] = {
+        { .name = "z80", .exec = exec_z80, .sys = &z80_bench, .freq_hz = Z80_FREQ },
+        { .name = "m6502", .exec = exec_m6502, .sys = &m6502_bench, .freq_hz = M6502_FREQ },
+        { .name = "m6502x", .exec = exec_m6502x, .sys = &m6502x_bench, .freq_hz = M6502_FREQ * M6502X_LANES },
+        { .name = "ay38910", .exec = exec_ay38910, .sys = &ay38910_bench, .freq_hz = AY_FREQ },
+        { .name = "m6581", .exec = exec_m6581, .sys = &m6581_bench, .freq_hz = SID_FREQ },
+        { .name = "m6526", .exec = exec_m6526, .sys = &m6526_bench, .freq_hz = C64_FREQ },
+        { .name = "m6569", .exec = exec_m6569, .sys = &m6569_bench, .freq_hz = C64_FREQ },
+        { .name = "m6522", .exec = exec_m6522, .sys = &m6522_bench, .freq_hz = VIC20_FREQ },
+        { .name = "m6561", .exec = exec_m6561, .sys = &m6561_bench, .freq_hz = VIC20_FREQ },
+        { .name = "mc6845", .exec = exec_mc6845, .sys = &mc6845_bench, .freq_hz = CCLK_FREQ },
+        { .name = "mc6847", .exec = exec_mc6847, .sys = &mc6847_bench, .freq_hz = ATOM_FREQ },
+        { .name = "am40010", .exec = exec_am40010, .sys = &am40010_bench, .freq_hz = CPC_FREQ },
+        { .name = "i8255", .exec = exec_i8255, .sys = &i8255_bench, .freq_hz = CPC_FREQ },
+        { .name = "z80ctc", .exec = exec_z80ctc, .sys = &z80ctc_bench, .freq_hz = KC85_FREQ },
+        { .name = "z80pio", .exec = exec_z80pio, .sys = &z80pio_bench, .freq_hz = KC85_FREQ },
+        { .name = "beeper", .exec = exec_beeper, .sys = &beeper_bench, .freq_hz = ZX_FREQ },
+        { .name = "upd765", .exec = exec_upd765, .sys = &upd765_bench, .freq_hz = FDC_FREQ },
+    };
+    if (csv) {
+        bench_print_csv_header(stdout);
+    }
+    for (size_t i = 0; i < (sizeof(descs) / sizeof(descs[0])); i++) {
+        bench_desc_t desc = descs[i];
+        desc.tag = tag;
+        desc.num_seconds = num_seconds;
+        const bench_result_t res = bench_run(&desc);
+        if (csv) {
+            bench_print_csv(stdout, &res);
+        }
+        else {
+            bench_print_json(stdout, &res);
+        }
+    }
+    return 0;
+}
@@ -16,6 +16,10 @@
     CHIPS_ASSERT(c)
     ~~~
 
+    The pixel decoder uses SSSE3 (when compiled with SSSE3 or AVX enabled)
+    or NEON (on ARM64) instructions, define AM40010_NO_SIMD before including
+    the implementation to use the portable C code instead.
+
     Include the following files before am40010.h:
 
         chips/chips_common.h
@@ -45,7 +49,18 @@
     **************************************
 
     ## Notes
-    (TODO)
+
+    The CRT emulation hashes each visible scanline after it has been decoded
+    (see chips_display_hash() in chips_common.h), and stores the hash of the
+    last completed frame in am40010_t.crt.frame_hash. Scanlines aren't
+    hashed while the debug visualization or headless mode is active.
+
+    If am40010_desc_t.video_band has a callback, it is called from the CRT
+    emulation each time a band of framebuffer rows has been decoded (see
+    'Video Bands' in chips_common.h). With the debug visualization active,
+    the rows cover the entire 1024x312 framebuffer, and the beam position
+    marker at the end of the last reported row is only removed when the
+    next row starts.
 
     ## Links
 
@@ -208,6 +223,7 @@ typedef struct am40010_desc_t {
     am40010_cclk_t cclk_cb;             // the 1 MHz CCLK callback
     chips_range_t ram;                  // direct pointer to the gate-array-visible 4*16 KByte RAM banks
     chips_range_t framebuffer;          // pointer to framebuffer (at least 1024 * 312 bytes)
+    chips_video_band_desc_t video_band; // optional callback for partially decoded frames
     void* user_data;                    // optional userdata for callbacks
 } am40010_desc_t;
 
@@ -242,11 +258,14 @@ typedef struct am40010_crt_t {
     bool sync;          // last syns state for sync raise detection
     bool h_blank;       // true if currently in horizontal blanking
     bool v_blank;       // true if currently in vertical blanking
+    uint64_t line_hash;     // running hash of the visible scanlines of the current frame
+    uint64_t frame_hash;    // hash of the visible area of the last completed frame
 } am40010_crt_t;
 
 // AM40010 state
 typedef struct am40010_t {
     bool dbg_vis;               // debug visualization currently enabled?
+    bool video_off;             // if true, don't write to the framebuffer (headless mode)
     am40010_cpc_type_t cpc_type;
     uint32_t seq_tick_count;    // gate array sequencer ticks
     uint64_t crtc_pins;         // previous crtc pins
@@ -257,6 +276,7 @@ typedef struct am40010_t {
     am40010_crt_t crt;
     am40010_bankswitch_t bankswitch_cb;
     am40010_cclk_t cclk_cb;
+    chips_video_band_t video_band;
     const uint8_t* ram;
     void* user_data;
     uint64_t pins;              // only for debug inspection
@@ -285,6 +305,13 @@ void am40010_iorq(am40010_t* ga, uint64_t cpu_pins);
         AM40010_INT/Z80_INT    - interrupt request from the gate array was triggered
 */
 uint64_t am40010_tick(am40010_t* ga, uint64_t cpu_pins);
+/*
+    Specialized versions of am40010_tick() without the per-tick check for
+    the debug visualization, use am40010_tick_dbgvis() when ga->dbg_vis
+    is true, and am40010_tick_novis() otherwise.
+*/
+uint64_t am40010_tick_novis(am40010_t* ga, uint64_t cpu_pins);
+uint64_t am40010_tick_dbgvis(am40010_t* ga, uint64_t cpu_pins);
 
 // prepare am40010_t snapshot before saving
 void am40010_snapshot_onsave(am40010_t* snapshot);
@@ -303,6 +330,16 @@ void am40010_snapshot_onload(am40010_t* snapshot, am40010_t* sys);
     #define CHIPS_ASSERT(c) assert(c)
 #endif
 
+#if !defined(AM40010_NO_SIMD)
+    #if defined(__SSSE3__) || defined(__AVX__)
+        #include <tmmintrin.h>
+        #define _AM40010_SSSE3
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #include <arm_neon.h>
+        #define _AM40010_NEON
+    #endif
+#endif
+
 #if defined(__GNUC__)
 #define _AM40010_UNREACHABLE __builtin_unreachable()
 #elif defined(_MSC_VER)
@@ -311,6 +348,14 @@ void am40010_snapshot_onload(am40010_t* snapshot, am40010_t* sys);
 #define _AM40010_UNREACHABLE
 #endif
 
+#if defined(_MSC_VER)
+#define _AM40010_FORCE_INLINE __forceinline
+#elif defined(__GNUC__)
+#define _AM40010_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define _AM40010_FORCE_INLINE inline
+#endif
+
 #define _AM40010_MAX_FB_SIZE (AM40010_DBG_DISPLAY_WIDTH*AM40010_DBG_DISPLAY_HEIGHT*4)
 
 // extract 8-bit data bus from 64-bit pin mask
@@ -378,6 +423,8 @@ static void _am40010_init_video(am40010_t* ga) {
 // initialize the crt init
 static void _am40010_init_crt(am40010_t* ga) {
     memset(&ga->crt, 0, sizeof(ga->crt));
+    ga->crt.line_hash = CHIPS_HASH_SEED;
+    ga->crt.frame_hash = CHIPS_HASH_SEED;
 }
 
 // initialize the hardware color palette
@@ -448,6 +495,7 @@ void am40010_init(am40010_t* ga, const am40010_desc_t* desc) {
     ga->ram = desc->ram.ptr;
     ga->fb = desc->framebuffer.ptr;
     ga->user_data = desc->user_data;
+    chips_video_band_init(&ga->video_band, &desc->video_band);
     _am40010_init_regs(ga);
     _am40010_init_video(ga);
     _am40010_init_crt(ga);
@@ -593,7 +641,22 @@ static void _am40010_crt_tick(am40010_t* ga, bool sync) {
             new_line = true;
         }
     }
+    // the frame hash is only tracked for the regular visible area
+    const bool hash_lines = !ga->video_off && !ga->dbg_vis;
     if (new_line) {
+        // hash the completed scanline
+        if (hash_lines && (crt->v_pos >= _AM40010_CRT_VIS_Y0) && (crt->v_pos < _AM40010_CRT_VIS_Y1)) {
+            const uint8_t* src = ga->fb + (size_t)(crt->v_pos - _AM40010_CRT_VIS_Y0) * AM40010_FRAMEBUFFER_WIDTH;
+            crt->line_hash = chips_hash(crt->line_hash, src, AM40010_DISPLAY_WIDTH);
+        }
+        // report the completed framebuffer row
+        if (ga->video_band.callback.func && !ga->video_off) {
+            if (ga->dbg_vis) {
+                chips_video_band_row(&ga->video_band, crt->v_pos);
+            } else if ((crt->v_pos >= _AM40010_CRT_VIS_Y0) && (crt->v_pos < _AM40010_CRT_VIS_Y1)) {
+                chips_video_band_row(&ga->video_band, crt->v_pos - _AM40010_CRT_VIS_Y0);
+            }
+        }
         // new scanline
         crt->h_pos = 0;
         crt->v_pos++;
@@ -611,7 +674,13 @@ static void _am40010_crt_tick(am40010_t* ga, bool sync) {
         }
     }
     if (new_frame) {
+        // only frames which covered the entire visible area update the frame hash
+        if (hash_lines && (crt->v_pos >= _AM40010_CRT_VIS_Y1)) {
+            crt->frame_hash = crt->line_hash;
+        }
         crt->v_pos = 0;
+        crt->line_hash = CHIPS_HASH_SEED;
+        chips_video_band_frame(&ga->video_band);
     }
 
     // compute visible beam state
@@ -713,82 +782,77 @@ static uint8_t _am40010_vid_read(am40010_t* ga, uint64_t crtc_pins, uint16_t ccl
     return ga->ram[addr];
 }
 
-static void _am40010_decode_pixels(am40010_t* ga, uint8_t* dst) {
-    uint8_t c;
-    uint8_t p;
-    switch (ga->video.mode) {
-        case 0:
-            /*
-                160x200 @ 16 colors (2 pixels per byte)
-                pixel    bit mask
-                0:       |1|5|3|7|
-                1:       |0|4|2|6|
-            */
-            for (size_t i = 0; i < 2; i++) {
-                c = ga->video.latch[i];
-                p = ga->regs.ink[((c>>7)&0x1)|((c>>2)&0x2)|((c>>3)&0x4)|((c<<2)&0x8)];
-                *dst++ = p; *dst++ = p; *dst++ = p; *dst++ = p;
-                p = ga->regs.ink[((c>>6)&0x1)|((c>>1)&0x2)|((c>>2)&0x4)|((c<<3)&0x8)];
-                *dst++ = p; *dst++ = p; *dst++ = p; *dst++ = p;
-            }
-            break;
-        case 1:
-            /*
-                320x200 @ 4 colors (4 pixels per byte)
-                pixel    bit mask
-                0:       |3|7|
-                1:       |2|6|
-                2:       |1|5|
-                3:       |0|4|
-            */
-            for (size_t i = 0; i < 2; i++) {
-                c = ga->video.latch[i];
-                p = ga->regs.ink[((c>>2)&2)|((c>>7)&1)];
-                *dst++ = p; *dst++ = p;
-                p = ga->regs.ink[((c>>1)&2)|((c>>6)&1)];
-                *dst++ = p; *dst++ = p;
-                p = ga->regs.ink[((c>>0)&2)|((c>>5)&1)];
-                *dst++ = p; *dst++ = p;
-                p = ga->regs.ink[((c<<1)&2)|((c>>4)&1)];
-                *dst++ = p; *dst++ = p;
-            }
-            break;
-        case 2:
-            // 640x200 @ 2 colors (8 pixels per byte)
-            for (size_t i = 0; i < 2; i++) {
-                c = ga->video.latch[i];
-                *dst++ = ga->regs.ink[(c>>7)&1];
-                *dst++ = ga->regs.ink[(c>>6)&1];
-                *dst++ = ga->regs.ink[(c>>5)&1];
-                *dst++ = ga->regs.ink[(c>>4)&1];
-                *dst++ = ga->regs.ink[(c>>3)&1];
-                *dst++ = ga->regs.ink[(c>>2)&1];
-                *dst++ = ga->regs.ink[(c>>1)&1];
-                *dst++ = ga->regs.ink[(c>>0)&1];
-            }
-            break;
-        case 3:
-            /*  undocumented mode 3:
-                160x200 @ 4 colors (2 pixels per byte)
-                pixel    bit mask
-                0:       |x|x|3|7|
-                1:       |x|x|2|6|
-            */
-            for (size_t i = 0; i < 2; i++) {
-                c = ga->video.latch[i];
-                p = ga->regs.ink[((c>>7)&0x1)|((c>>2)&0x2)];
-                *dst++ = p; *dst++ = p; *dst++ = p; *dst++ = p;
-                p = ga->regs.ink[((c>>6)&0x1)|((c>>1)&0x2)];
-                *dst++ = p; *dst++ = p; *dst++ = p; *dst++ = p;
-            }
-            break;
-        default: _AM40010_UNREACHABLE;
-    }
+/*  Pen lookup table, for each video mode and video memory byte the pen
+    indices of the 8 pixels in the framebuffer, decoding 2 latched bytes is
+    then a 16-byte table lookup into the ink registers, which is a single
+    byte shuffle with SSSE3 or NEON.
+
+    The table is expanded at compile time by the macros below, so that
+    am40010_init() doesn't need to write to shared state.
+
+    mode 0: 160x200 @ 16 colors (2 pixels per byte)
+        pixel    bit mask
+        0:       |1|5|3|7|
+        1:       |0|4|2|6|
+
+    mode 1: 320x200 @ 4 colors (4 pixels per byte)
+        pixel    bit mask
+        0:       |3|7|
+        1:       |2|6|
+        2:       |1|5|
+        3:       |0|4|
+
+    mode 2: 640x200 @ 2 colors (8 pixels per byte)
+
+    undocumented mode 3: 160x200 @ 4 colors (2 pixels per byte)
+        pixel    bit mask
+        0:       |x|x|3|7|
+        1:       |x|x|2|6|
+*/
+#define _AM40010_M0A(c) ((((c)>>7)&0x1)|(((c)>>2)&0x2)|(((c)>>3)&0x4)|(((c)<<2)&0x8))
+#define _AM40010_M0B(c) ((((c)>>6)&0x1)|(((c)>>1)&0x2)|(((c)>>2)&0x4)|(((c)<<3)&0x8))
+#define _AM40010_M0(c) { _AM40010_M0A(c), _AM40010_M0A(c), _AM40010_M0A(c), _AM40010_M0A(c), _AM40010_M0B(c), _AM40010_M0B(c), _AM40010_M0B(c), _AM40010_M0B(c) },
+#define _AM40010_M1P(c,s) (((((c)<<1)>>(s))&2)|(((c)>>(4+(s)))&1))
+#define _AM40010_M1(c) { _AM40010_M1P(c,3), _AM40010_M1P(c,3), _AM40010_M1P(c,2), _AM40010_M1P(c,2), _AM40010_M1P(c,1), _AM40010_M1P(c,1), _AM40010_M1P(c,0), _AM40010_M1P(c,0) },
+#define _AM40010_M2(c) { ((c)>>7)&1, ((c)>>6)&1, ((c)>>5)&1, ((c)>>4)&1, ((c)>>3)&1, ((c)>>2)&1, ((c)>>1)&1, (c)&1 },
+#define _AM40010_M3A(c) ((((c)>>7)&0x1)|(((c)>>2)&0x2))
+#define _AM40010_M3B(c) ((((c)>>6)&0x1)|(((c)>>1)&0x2))
+#define _AM40010_M3(c) { _AM40010_M3A(c), _AM40010_M3A(c), _AM40010_M3A(c), _AM40010_M3A(c), _AM40010_M3B(c), _AM40010_M3B(c), _AM40010_M3B(c), _AM40010_M3B(c) },
+#define _AM40010_R4(m,c) m(c) m((c)+1) m((c)+2) m((c)+3)
+#define _AM40010_R16(m,c) _AM40010_R4(m,c) _AM40010_R4(m,(c)+4) _AM40010_R4(m,(c)+8) _AM40010_R4(m,(c)+12)
+#define _AM40010_R64(m,c) _AM40010_R16(m,c) _AM40010_R16(m,(c)+16) _AM40010_R16(m,(c)+32) _AM40010_R16(m,(c)+48)
+#define _AM40010_R256(m) { _AM40010_R64(m,0) _AM40010_R64(m,64) _AM40010_R64(m,128) _AM40010_R64(m,192) }
+
+static const uint8_t _am40010_pens[4][256][8] = {
+    _AM40010_R256(_AM40010_M0),
+    _AM40010_R256(_AM40010_M1),
+    _AM40010_R256(_AM40010_M2),
+    _AM40010_R256(_AM40010_M3),
+};
+
+// decode the 2 latched video memory bytes into 16 framebuffer pixels
+static inline void _am40010_decode_pixels(am40010_t* ga, uint8_t* dst) {
+    const uint8_t* p0 = _am40010_pens[ga->video.mode][ga->video.latch[0]];
+    const uint8_t* p1 = _am40010_pens[ga->video.mode][ga->video.latch[1]];
+    #if defined(_AM40010_SSSE3)
+        const __m128i ink = _mm_loadu_si128((const __m128i*)ga->regs.ink);
+        const __m128i pens = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)p0), _mm_loadl_epi64((const __m128i*)p1));
+        _mm_storeu_si128((__m128i*)dst, _mm_shuffle_epi8(ink, pens));
+    #elif defined(_AM40010_NEON)
+        const uint8x16_t ink = vld1q_u8(ga->regs.ink);
+        const uint8x16_t pens = vcombine_u8(vld1_u8(p0), vld1_u8(p1));
+        vst1q_u8(dst, vqtbl1q_u8(ink, pens));
+    #else
+        for (size_t i = 0; i < 8; i++) {
+            dst[i] = ga->regs.ink[p0[i]];
+            dst[i + 8] = ga->regs.ink[p1[i]];
+        }
+    #endif
 }
 
 // video signal generator, call this at 1 MHz frequency
-static void _am40010_decode_video(am40010_t* ga, uint64_t crtc_pins) {
-    if (ga->dbg_vis) {
+static _AM40010_FORCE_INLINE void _am40010_decode_video(am40010_t* ga, uint64_t crtc_pins, bool dbg_vis) {
+    if (dbg_vis) {
         size_t dst_x = ga->crt.h_pos * 16;
         size_t dst_y = ga->crt.v_pos;
         if ((dst_x <= (AM40010_FRAMEBUFFER_WIDTH-16)) && (dst_y < AM40010_FRAMEBUFFER_HEIGHT)) {
@@ -850,8 +914,8 @@ static void _am40010_decode_video(am40010_t* ga, uint64_t crtc_pins) {
     }
 }
 
-// the tick function must be called at 4 MHz
-uint64_t am40010_tick(am40010_t* ga, uint64_t pins) {
+// the tick function must be called at 4 MHz, dbg_vis is a compile-time constant
+static _AM40010_FORCE_INLINE uint64_t _am40010_tick(am40010_t* ga, uint64_t pins, bool dbg_vis) {
     /* The hardware has a 'main sequencer' with a rotating bit
         pattern which defines when the different actions happen in
         the 16 MHz ticks.
@@ -895,7 +959,9 @@ uint64_t am40010_tick(am40010_t* ga, uint64_t pins) {
     if (cclk1) {
         // read second video ram byte
         ga->video.latch[1] = _am40010_vid_read(ga, ga->crtc_pins, 1);
-        _am40010_decode_video(ga, ga->crtc_pins);
+        if (!ga->video_off) {
+            _am40010_decode_video(ga, ga->crtc_pins, dbg_vis);
+        }
     }
 
     // perform the per-4Mhz-tick actions, the AM40010_READY pin is also the Z80_WAIT pin
@@ -922,10 +988,27 @@ uint64_t am40010_tick(am40010_t* ga, uint64_t pins) {
     return pins;
 }
 
+uint64_t am40010_tick_novis(am40010_t* ga, uint64_t pins) {
+    return _am40010_tick(ga, pins, false);
+}
+
+uint64_t am40010_tick_dbgvis(am40010_t* ga, uint64_t pins) {
+    return _am40010_tick(ga, pins, true);
+}
+
+uint64_t am40010_tick(am40010_t* ga, uint64_t pins) {
+    if (ga->dbg_vis) {
+        return am40010_tick_dbgvis(ga, pins);
+    } else {
+        return am40010_tick_novis(ga, pins);
+    }
+}
+
 void am40010_snapshot_onsave(am40010_t* snapshot) {
     CHIPS_ASSERT(snapshot);
     snapshot->bankswitch_cb = 0;
     snapshot->cclk_cb = 0;
+    chips_video_band_snapshot_onsave(&snapshot->video_band);
     snapshot->user_data = 0;
     snapshot->ram = 0;
     snapshot->fb = 0;
@@ -935,9 +1018,12 @@ void am40010_snapshot_onload(am40010_t* snapshot, am40010_t* sys) {
     CHIPS_ASSERT(snapshot && sys);
     snapshot->bankswitch_cb = sys->bankswitch_cb;
     snapshot->cclk_cb = sys->cclk_cb;
+    chips_video_band_snapshot_onload(&snapshot->video_band, &sys->video_band);
     snapshot->user_data = sys->user_data;
     snapshot->ram = sys->ram;
     snapshot->fb = sys->fb;
+    // headless mode is a host setting, not part of the emulator state
+    snapshot->video_off = sys->video_off;
 }
 
 #endif // CHIPS_IMPL
@@ -11,6 +11,11 @@
 
     CHIPS_ASSERT(c)     -- your own assert macro (default: assert(c))
 
+    Include the following files before ay38910.h:
+
+        chips/chips_common.h
+        chips/chips_audio.h
+
     EMULATED PINS:
 
              +-----------+
@@ -33,6 +38,37 @@
       a CP1610 CPU
     - the RESET pin state is ignored, instead call ay38910_reset()
 
+    LAZY MODE:
+
+    Instead of calling ay38910_tick() for every tick, a system emulator
+    can count the ticks and advance the chip in bulk with ay38910_advance()
+    when the chip state is needed (before an ay38910_iorq() call, before
+    reading the current sample, and at the end of the exec function):
+
+        while (num_ticks > 0) {
+            if (ay38910_advance(&ay, &num_ticks)) {
+                // new sample is ready in ay.sample
+            }
+        }
+
+    ay38910_advance() executes ticks until the next sample is ready or the
+    requested number of ticks has been executed, and subtracts the executed
+    ticks from num_ticks. The tone, noise and envelope counters are updated
+    arithmetically instead of tick by tick, the resulting chip state and
+    samples are identical to calling ay38910_tick() the same number of times.
+    Ticks where none of the audible generators changes its output are
+    skipped in one go.
+
+    SOUND OUTPUT:
+
+    The chip output level is only computed when a tone, noise or envelope
+    generator changes its output or a register is written, and is recorded
+    as a band-limited step (see 'Band-limited Audio' in chips_audio.h).
+    The output samples are DC-adjusted before they are stored in
+    ay38910_t.sample. The output levels, band-limited synthesis and DC
+    adjustment use fixed-point integer math, and the output sample is a
+    fixed-point value too (see CHIPS_AUDIO_FIXEDPOINT_SCALE).
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -161,8 +197,6 @@ extern "C" {
 #define AY38910_REG_IO_PORT_B           (15)    // not on AY-3-8912/3
 // number of registers
 #define AY38910_NUM_REGISTERS (16)
-// error-accumulation precision boost
-#define AY38910_FIXEDPOINT_SCALE (16)
 // number of channels
 #define AY38910_NUM_CHANNELS (3)
 // DC adjustment buffer length
@@ -263,13 +297,12 @@ typedef struct {
     uint64_t pins;          // last pin state for debug inspection
 
     // sample generation state
-    int sample_period;
-    int sample_counter;
-    float mag;
-    float sample;
-    float dcadj_sum;
+    chips_blip_t blip;
+    int32_t volumes[16];    // volume table scaled by the output magnitude (fixed-point)
+    int32_t sample;         // last output sample (fixed-point)
+    int32_t dcadj_sum;
     uint32_t dcadj_pos;
-    float dcadj_buf[AY38910_DCADJ_BUFLEN];
+    int32_t dcadj_buf[AY38910_DCADJ_BUFLEN];
 } ay38910_t;
 
 // extract 8-bit data bus from 64-bit pins
@@ -289,6 +322,8 @@ void ay38910_reset(ay38910_t* ay);
 uint64_t ay38910_iorq(ay38910_t* ay, uint64_t pins);
 // tick the AY-3-8910, return true if a new sample is ready
 bool ay38910_tick(ay38910_t* ay);
+// run up to num_ticks ticks in bulk, stops at the next sample, returns true if a new sample is ready
+bool ay38910_advance(ay38910_t* ay, uint32_t* num_ticks);
 // helper functions to directly write register values and update dependent state, not intended for regular operation!
 void ay38910_set_register(ay38910_t* ay, uint8_t addr, uint8_t data);
 void ay38910_set_addr_latch(ay38910_t* ay, uint8_t addr);
@@ -385,7 +420,7 @@ static const uint8_t _ay38910_shapes[16][32] = {
    from the chip simulation which is >0.0 gets converted to
    a +/- sample value)
 */
-static float _ay38910_dcadjust(ay38910_t* ay, float s) {
+static int32_t _ay38910_dcadjust(ay38910_t* ay, int32_t s) {
     ay->dcadj_sum -= ay->dcadj_buf[ay->dcadj_pos];
     ay->dcadj_sum += s;
     ay->dcadj_buf[ay->dcadj_pos] = s;
@@ -433,6 +468,28 @@ static void _ay38910_restart_env_shape(ay38910_t* ay) {
     }
 }
 
+// compute the output level from the current generator state, and record it as band-limited step
+static void _ay38910_update_level(ay38910_t* ay) {
+    int32_t sm = 0;
+    for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
+        const ay38910_tone_t* chn = &ay->tone[i];
+        int32_t vol;
+        if (0 == (ay->reg[AY38910_REG_AMP_A+i] & (1<<4))) {
+            // fixed amplitude
+            vol = ay->volumes[ay->reg[AY38910_REG_AMP_A+i] & 0x0F];
+        }
+        else {
+            // envelope control
+            vol = ay->volumes[ay->env.shape_state];
+        }
+        int vol_enable = (chn->bit|chn->tone_disable) & ((ay->noise.rng&1)|(chn->noise_disable));
+        if (vol_enable) {
+            sm += vol;
+        }
+    }
+    chips_blip_set(&ay->blip, sm);
+}
+
 void ay38910_init(ay38910_t* ay, const ay38910_desc_t* desc) {
     CHIPS_ASSERT(ay && desc);
     CHIPS_ASSERT(desc->tick_hz > 0);
@@ -444,11 +501,13 @@ void ay38910_init(ay38910_t* ay, const ay38910_desc_t* desc) {
     ay->user_data = desc->user_data;
     ay->type = desc->type;
     ay->noise.rng = 1;
-    ay->sample_period = (desc->tick_hz * AY38910_FIXEDPOINT_SCALE) / desc->sound_hz;
-    ay->sample_counter = ay->sample_period;
-    ay->mag = desc->magnitude;
+    chips_blip_init(&ay->blip, desc->tick_hz, desc->sound_hz);
+    for (int i = 0; i < 16; i++) {
+        ay->volumes[i] = (int32_t)(_ay38910_volumes[i] * desc->magnitude * CHIPS_AUDIO_FIXEDPOINT_SCALE);
+    }
     _ay38910_update_values(ay);
     _ay38910_restart_env_shape(ay);
+    _ay38910_update_level(ay);
 }
 
 void ay38910_reset(ay38910_t* ay) {
@@ -460,9 +519,11 @@ void ay38910_reset(ay38910_t* ay) {
     }
     _ay38910_update_values(ay);
     _ay38910_restart_env_shape(ay);
+    _ay38910_update_level(ay);
 }
 
 bool ay38910_tick(ay38910_t* ay) {
+    bool changed = false;
     ay->tick++;
     if ((ay->tick & 7) == 0) {
         // tick the tone channels
@@ -471,6 +532,7 @@ bool ay38910_tick(ay38910_t* ay) {
             if (++chn->counter >= chn->period) {
                 chn->counter = 0;
                 chn->bit ^= 1;
+                changed = true;
             }
         }
 
@@ -486,6 +548,7 @@ bool ay38910_tick(ay38910_t* ay) {
                 // (bit0 is the output). This was verified on AY-3-8910 and YM2149 chips.
                 ay->noise.rng ^= (((ay->noise.rng & 1) ^ ((ay->noise.rng >> 3) & 1)) << 17);
                 ay->noise.rng >>= 1;
+                changed = true;
             }
         }
     }
@@ -501,35 +564,158 @@ bool ay38910_tick(ay38910_t* ay) {
                 }
             }
             ay->env.shape_state = _ay38910_shapes[ay->env_shape_cycle][ay->env.shape_counter];
+            changed = true;
         }
     }
 
     // generate new sample?
-    ay->sample_counter -= AY38910_FIXEDPOINT_SCALE;
-    if (ay->sample_counter <= 0) {
-        ay->sample_counter += ay->sample_period;
-        float sm = 0.0f;
-        for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
-            const ay38910_tone_t* chn = &ay->tone[i];
-            float vol;
-            if (0 == (ay->reg[AY38910_REG_AMP_A+i] & (1<<4))) {
-                // fixed amplitude
-                vol = _ay38910_volumes[ay->reg[AY38910_REG_AMP_A+i] & 0x0F];
+    const bool sample_ready = chips_blip_advance(&ay->blip, 1);
+    if (changed) {
+        _ay38910_update_level(ay);
+    }
+    if (sample_ready) {
+        ay->sample = _ay38910_dcadjust(ay, chips_blip_sample(&ay->blip));
+    }
+    return sample_ready;
+}
+
+/* advance a counter by a number of steps, a step increments the counter
+   and wraps it to zero when it reaches the period, returns the number of wraps
+*/
+static uint32_t _ay38910_count(uint16_t* counter, uint16_t period, uint32_t steps) {
+    uint32_t c = *counter;
+    uint32_t wraps = 0;
+    // the period may have been reprogrammed below the current counter value
+    if (c >= period) {
+        c = 0;
+        wraps = 1;
+        steps--;
+    }
+    c += steps;
+    wraps += c / period;
+    *counter = (uint16_t)(c % period);
+    return wraps;
+}
+
+// number of steps until a counter wraps
+static inline uint32_t _ay38910_steps_to_wrap(uint16_t counter, uint16_t period) {
+    return (counter >= period) ? 1 : (uint32_t)(period - counter);
+}
+
+/* number of ticks until the next tick where a generator which is currently
+   audible may change its output, generators which don't contribute to the
+   output don't need to be stepped one by one
+*/
+static uint32_t _ay38910_ticks_to_event(const ay38910_t* ay) {
+    uint32_t steps8 = UINT32_MAX;
+    bool noise_audible = false;
+    bool env_audible = false;
+    for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
+        const ay38910_tone_t* chn = &ay->tone[i];
+        const uint8_t amp = ay->reg[AY38910_REG_AMP_A+i];
+        if ((amp & 0x1F) == 0) {
+            continue;
+        }
+        if (amp & (1<<4)) {
+            env_audible = true;
+        }
+        if (!chn->tone_disable) {
+            uint32_t steps = _ay38910_steps_to_wrap(chn->counter, chn->period);
+            if (steps < steps8) {
+                steps8 = steps;
             }
-            else {
-                // envelope control
-                vol = _ay38910_volumes[ay->env.shape_state];
+        }
+        if (!chn->noise_disable) {
+            noise_audible = true;
+        }
+    }
+    if (noise_audible) {
+        uint32_t steps = _ay38910_steps_to_wrap(ay->noise.counter, ay->noise.period);
+        if (steps < steps8) {
+            steps8 = steps;
+        }
+    }
+    uint32_t ticks = UINT32_MAX;
+    if (steps8 != UINT32_MAX) {
+        ticks = (steps8 << 3) - (ay->tick & 7);
+    }
+    if (env_audible && !ay->env.shape_holding) {
+        uint32_t env_ticks = (_ay38910_steps_to_wrap(ay->env.counter, ay->env.period) << 4) - (ay->tick & 15);
+        if (env_ticks < ticks) {
+            ticks = env_ticks;
+        }
+    }
+    return ticks;
+}
+
+bool ay38910_advance(ay38910_t* ay, uint32_t* num_ticks) {
+    CHIPS_ASSERT(ay && num_ticks);
+    uint32_t n = *num_ticks;
+    if (n == 0) {
+        return false;
+    }
+    // stop at the tick which generates the next sample...
+    bool sample_ready = false;
+    uint32_t ticks_to_sample = chips_blip_ticks_to_sample(&ay->blip);
+    if (ticks_to_sample == 0) {
+        ticks_to_sample = 1;
+    }
+    if (ticks_to_sample <= n) {
+        n = ticks_to_sample;
+        sample_ready = true;
+    }
+    // ...or at the next tick which may change the output level
+    bool event = false;
+    const uint32_t ticks_to_event = _ay38910_ticks_to_event(ay);
+    if (ticks_to_event <= n) {
+        event = true;
+        if (ticks_to_event < n) {
+            n = ticks_to_event;
+            sample_ready = false;
+        }
+    }
+    *num_ticks -= n;
+
+    // tone and noise generators step every 8 ticks, the envelope generator every 16 ticks
+    const uint32_t steps8 = ((ay->tick & 7) + n) >> 3;
+    const uint32_t steps16 = ((ay->tick & 15) + n) >> 4;
+    ay->tick += n;
+    if (steps8 > 0) {
+        for (int i = 0; i < AY38910_NUM_CHANNELS; i++) {
+            ay38910_tone_t* chn = &ay->tone[i];
+            chn->bit ^= _ay38910_count(&chn->counter, chn->period, steps8) & 1;
+        }
+        // the noise RNG is clocked on every second wrap, see ay38910_tick()
+        uint32_t wraps = _ay38910_count(&ay->noise.counter, ay->noise.period, steps8);
+        for (; wraps > 0; wraps--) {
+            ay->noise.bit ^= 1;
+            if (ay->noise.bit) {
+                ay->noise.rng ^= (((ay->noise.rng & 1) ^ ((ay->noise.rng >> 3) & 1)) << 17);
+                ay->noise.rng >>= 1;
             }
-            int vol_enable = (chn->bit|chn->tone_disable) & ((ay->noise.rng&1)|(chn->noise_disable));
-            if (vol_enable) {
-                sm += vol;
+        }
+    }
+    if (steps16 > 0) {
+        uint32_t wraps = _ay38910_count(&ay->env.counter, ay->env.period, steps16);
+        for (; wraps > 0; wraps--) {
+            if (!ay->env.shape_holding) {
+                ay->env.shape_counter = (ay->env.shape_counter + 1) & 0x1F;
+                if (ay->env.shape_hold && (0x1F == ay->env.shape_counter)) {
+                    ay->env.shape_holding = true;
+                }
             }
+            ay->env.shape_state = _ay38910_shapes[ay->env_shape_cycle][ay->env.shape_counter];
         }
-        ay->sample = _ay38910_dcadjust(ay, sm) * ay->mag;
-        return true; // new sample is ready
     }
-    // fallthrough: no new sample ready yet
-    return false;
+
+    chips_blip_advance(&ay->blip, n);
+    if (event) {
+        _ay38910_update_level(ay);
+    }
+    if (sample_ready) {
+        ay->sample = _ay38910_dcadjust(ay, chips_blip_sample(&ay->blip));
+    }
+    return sample_ready;
 }
 
 uint64_t ay38910_iorq(ay38910_t* ay, uint64_t pins) {
@@ -551,6 +737,7 @@ uint64_t ay38910_iorq(ay38910_t* ay, uint64_t pins) {
                 // write register content, and update dependent values
                 ay->reg[ay->addr] = data & _ay38910_reg_mask[ay->addr];
                 _ay38910_update_values(ay);
+                _ay38910_update_level(ay);
                 if (ay->addr == AY38910_REG_ENV_SHAPE_CYCLE) {
                     _ay38910_restart_env_shape(ay);
                 }
@@ -646,6 +833,7 @@ void ay38910_set_register(ay38910_t* ay, uint8_t addr, uint8_t data) {
     CHIPS_ASSERT(ay && (addr < AY38910_NUM_REGISTERS));
     ay->reg[addr] = data & _ay38910_reg_mask[addr];
     _ay38910_update_values(ay);
+    _ay38910_update_level(ay);
     if (addr == AY38910_REG_ENV_SHAPE_CYCLE) {
         _ay38910_restart_env_shape(ay);
     }
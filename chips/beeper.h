@@ -4,6 +4,16 @@
 
     TODO: docs
 
+    Include the following files before beeper.h:
+
+        chips/chips_common.h
+        chips/chips_audio.h
+
+    The output is generated with band-limited step synthesis (see
+    'Band-limited Audio' in chips_audio.h), the beeper state and volume
+    functions record a fixed-point amplitude step, and beeper_tick() only
+    advances the sample clock.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -29,11 +39,6 @@
 extern "C" {
 #endif
 
-// error-accumulation precision boost
-#define BEEPER_FIXEDPOINT_SCALE (16)
-// DC adjust buffer size
-#define BEEPER_DCADJ_BUFLEN (128)
-
 // initialization parameters
 typedef struct {
     int tick_hz;
@@ -44,34 +49,49 @@ typedef struct {
 // beeper state
 typedef struct {
     int state;
-    int period;
-    int counter;
     float base_volume;
     float volume;
-    float sample;
-    float dcadj_sum;
-    uint32_t dcadj_pos;
-    float dcadj_buf[BEEPER_DCADJ_BUFLEN];
+    int32_t level;      // output amplitude in 'on' state (fixed-point)
+    int32_t sample;     // last output sample (fixed-point)
+    chips_blip_t blip;
 } beeper_t;
 
 // initialize beeper instance
 void beeper_init(beeper_t* beeper, const beeper_desc_t* desc);
 // reset the beeper instance
 void beeper_reset(beeper_t* beeper);
+// record the current output amplitude
+static inline void _beeper_update(beeper_t* beeper) {
+    chips_blip_set(&beeper->blip, beeper->state ? beeper->level : 0);
+}
 // set current on/off state
 static inline void beeper_set(beeper_t* beeper, bool state) {
-    beeper->state = state ? 1 : 0;
+    if (beeper->state != (state ? 1 : 0)) {
+        beeper->state = state ? 1 : 0;
+        _beeper_update(beeper);
+    }
 }
 // toggle current state (on->off or off->on)
 static inline void beeper_toggle(beeper_t* beeper) {
     beeper->state = !beeper->state;
+    _beeper_update(beeper);
 }
 // set current volume 0.0 to 1.0
 static inline void beeper_set_volume(beeper_t* beeper, float vol) {
-    beeper->volume = vol;
+    if (beeper->volume != vol) {
+        beeper->volume = vol;
+        beeper->level = (int32_t)(vol * beeper->base_volume * CHIPS_AUDIO_FIXEDPOINT_SCALE);
+        _beeper_update(beeper);
+    }
 }
 // tick the beeper, return true if a new sample is ready
-bool beeper_tick(beeper_t* beeper);
+static inline bool beeper_tick(beeper_t* beeper) {
+    if (chips_blip_advance(&beeper->blip, 1)) {
+        beeper->sample = chips_blip_sample(&beeper->blip);
+        return true;
+    }
+    return false;
+}
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -88,43 +108,18 @@ void beeper_init(beeper_t* b, const beeper_desc_t* desc) {
     CHIPS_ASSERT(b && desc);
     CHIPS_ASSERT((desc->tick_hz > 0) && (desc->sound_hz > 0));
     *b = (beeper_t){
-        .period = (desc->tick_hz * BEEPER_FIXEDPOINT_SCALE) / desc->sound_hz,
-        .counter = b->period,
         .base_volume = desc->base_volume,
         .volume = 1.0f,
+        .level = (int32_t)(desc->base_volume * CHIPS_AUDIO_FIXEDPOINT_SCALE),
     };
+    chips_blip_init(&b->blip, desc->tick_hz, desc->sound_hz);
 }
 
 void beeper_reset(beeper_t* b) {
     CHIPS_ASSERT(b);
     b->state = 0;
-    b->counter = b->period;
     b->sample = 0;
+    chips_blip_reset(&b->blip);
 }
 
-/* DC adjustment filter from StSound, this moves an "offcenter"
-   signal back to the zero-line (e.g. the volume-level output
-   from the chip simulation which is >0.0 gets converted to
-   a +/- sample value)
-*/
-static void _beeper_dcadjust(beeper_t* bp, float s) {
-    bp->dcadj_sum -= bp->dcadj_buf[bp->dcadj_pos];
-    bp->dcadj_sum += s;
-    bp->dcadj_buf[bp->dcadj_pos] = s;
-    bp->dcadj_pos = (bp->dcadj_pos + 1) & (BEEPER_DCADJ_BUFLEN-1);
-}
-
-bool beeper_tick(beeper_t* bp) {
-    _beeper_dcadjust(bp, (float)bp->state * bp->volume * bp->base_volume);
-    /* generate a new sample? */
-    bp->counter -= BEEPER_FIXEDPOINT_SCALE;
-    if (bp->counter <= 0) {
-        bp->counter += bp->period;
-        bp->sample = bp->dcadj_sum / BEEPER_DCADJ_BUFLEN;
-        return true;
-    }
-    return false;
-}
-
-
 #endif /* CHIPS_IMPL */
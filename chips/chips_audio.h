@@ -0,0 +1,478 @@
+#pragma once
+/*#
+    # chips_audio.h
+
+    Band-limited synthesis for the sound chip emulations, audio output
+    formats and a lock-free audio ring buffer.
+
+    Do this:
+    ~~~C
+    #define CHIPS_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    You need to include the following headers before including chips_audio.h:
+
+    - chips/chips_common.h
+
+    ## Band-limited Audio
+
+    The sound chip emulations (beeper.h, ay38910.h and m6581.h) don't pick
+    or average their output at the sample rate, instead they record each
+    change of their output amplitude in a chips_blip_t together with the
+    time of the change, and the chips_blip_t turns these steps into a
+    band-limited output signal (the "BLEP" or "blip buffer" technique):
+
+    ~~~C
+    // once per tick, returns true when an output sample is due
+    if (chips_blip_advance(&blip, 1)) {
+        float s = chips_blip_sample(&blip);
+    }
+    // whenever the output amplitude changes
+    chips_blip_set(&blip, level);
+    ~~~
+
+    chips_blip_set() adds a band-limited step (a windowed-sinc step with
+    CHIPS_BLIP_PHASES sub-sample positions) into a small buffer of pending
+    output sample deltas, and chips_blip_sample() retires one output sample
+    from that buffer. Ticks where the amplitude doesn't change only cost
+    an integer subtraction, which also allows advancing the clock by many
+    ticks at once. The output is delayed by CHIPS_BLIP_WIDTH/2 samples.
+
+    Amplitudes are fixed-point integers where CHIPS_AUDIO_FIXEDPOINT_SCALE
+    is 1.0, so that the sound chips don't need any floating point math
+    per tick or per amplitude step. The output samples of the sound chips
+    are fixed-point too, the system emulators mix them as integers and only
+    convert the mixed sample into the output format (see below).
+
+    ## Audio Output Formats
+
+    The audio callback receives float samples by default. For hosts which
+    want signed 16-bit samples, set the output format in the system's
+    audio desc and provide the callback in .func_s16 instead of .func:
+
+    ~~~C
+    static void audio_cb(const int16_t* samples, int num_samples, void* user_data) {
+        ...
+    }
+
+    c64_init(&sys, &(c64_desc_t){
+        ...
+        .audio = {
+            .format = CHIPS_AUDIO_FORMAT_S16,
+            .callback = { .func_s16 = audio_cb },
+        },
+    });
+    ~~~
+
+    The system emulators mix the fixed-point samples of their sound chips
+    and store the result with chips_audio_store() either as float or as
+    signed 16-bit sample into their sample buffers, so the 16-bit output
+    path doesn't use any floating point math.
+
+    The audio ring buffer (see below) always stores float samples, when
+    a ring buffer is provided, the system emulators ignore the .format item
+    and produce float samples. Use chips_audio_ring_pop_s16() to pull signed
+    16-bit samples out of the ring buffer.
+
+    ## Audio Ring Buffer
+
+    By default the system emulators call the audio callback from inside
+    the tick function each time their sample buffer is full, so a slow
+    callback (for instance one which blocks on the audio device) also
+    stalls the emulation. Alternatively, the host can provide a
+    chips_audio_ring_t, the emulator then pushes its samples into the
+    ring buffer without calling back, and the audio thread pulls the
+    samples out of the ring buffer at its own pace:
+
+    ~~~C
+    static float ring_buffer[4096];     // number of samples must be a power of 2
+    static chips_audio_ring_t ring;
+    chips_audio_ring_init(&ring, ring_buffer, 4096);
+
+    zx_init(&sys, &(zx_desc_t){
+        ...
+        .audio = {
+            .callback = { .ring = &ring },
+        },
+    });
+
+    // on the audio thread:
+    static void stream_cb(float* buffer, int num_samples) {
+        chips_audio_ring_pop(&ring, buffer, num_samples);
+    }
+    ~~~
+
+    The ring buffer is lock-free, but only safe for a single producer
+    (the emulator thread) and a single consumer (the audio thread). When
+    the ring buffer is full, the new samples are dropped and counted in
+    chips_audio_ring_t.num_overruns. When the consumer requests more samples
+    than are available, the missing samples are filled with silence and
+    counted in chips_audio_ring_t.num_underruns. Each counter is only written
+    by one side, the other side may read it for statistics.
+
+    ## zlib/libpng license
+
+    Copyright (c) 2018 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// size of a cache line, used to keep the ring buffer positions apart
+#define CHIPS_AUDIO_RING_CACHE_LINE (64)
+
+// lock-free single-producer/single-consumer audio sample ring buffer
+typedef struct chips_audio_ring_t {
+    float* buffer;              // sample storage provided by the host
+    uint32_t mask;              // number of samples in buffer minus 1
+    uint32_t num_overruns;      // number of samples dropped because the ring buffer was full (producer)
+    uint8_t _pad0[CHIPS_AUDIO_RING_CACHE_LINE - sizeof(float*) - 2*sizeof(uint32_t)];
+    uint32_t write_pos;         // only written by the producer
+    uint8_t _pad1[CHIPS_AUDIO_RING_CACHE_LINE - sizeof(uint32_t)];
+    uint32_t read_pos;          // only written by the consumer
+    uint32_t num_underruns;     // number of missing samples filled with silence (consumer)
+} chips_audio_ring_t;
+
+// fixed-point sample value of 1.0 in the sound chip emulations
+#define CHIPS_AUDIO_FIXEDPOINT_SCALE (1<<15)
+
+// fixed-point precision of the band-limited synthesis sample clock
+#define CHIPS_BLIP_FIXEDPOINT_SCALE (16)
+// number of sub-sample positions of a band-limited step
+#define CHIPS_BLIP_PHASES (32)
+// width of a band-limited step in output samples (must be a power of 2)
+#define CHIPS_BLIP_WIDTH (16)
+
+// clamp range of band-limited synthesis input amplitudes
+#define CHIPS_BLIP_MAX_LEVEL (4 * CHIPS_AUDIO_FIXEDPOINT_SCALE)
+
+// band-limited step synthesis state
+typedef struct {
+    int period;             // output sample period in ticks (fixed-point)
+    int counter;            // countdown to the next output sample (fixed-point)
+    uint32_t phase_mul;     // converts elapsed ticks to a step phase (16.16 fixed-point)
+    int32_t level;          // current input amplitude
+    int32_t output;         // current output amplitude
+    uint32_t pos;           // delta buffer position of the next output sample
+    int32_t delta[CHIPS_BLIP_WIDTH];    // pending output sample deltas
+} chips_blip_t;
+
+// initialize an audio ring buffer, num_samples must be a power of 2
+void chips_audio_ring_init(chips_audio_ring_t* ring, float* buffer, uint32_t num_samples);
+// producer: push samples, returns number of pushed samples (the others are dropped)
+int chips_audio_ring_push(chips_audio_ring_t* ring, const float* samples, int num_samples);
+// consumer: number of samples which can be popped
+int chips_audio_ring_count(chips_audio_ring_t* ring);
+// consumer: pop samples, fills missing samples with silence, returns number of popped samples
+int chips_audio_ring_pop(chips_audio_ring_t* ring, float* dst, int num_samples);
+// consumer: same as chips_audio_ring_pop(), but converts to signed 16-bit samples
+int chips_audio_ring_pop_s16(chips_audio_ring_t* ring, int16_t* dst, int num_samples);
+// called by the system emulators when their sample buffer is full, passes either samples or samples_s16 to the host
+void chips_audio_flush(const chips_audio_callback_t* callback, chips_audio_format_t format, const float* samples, const int16_t* samples_s16, int num_samples);
+// the sample format a system emulator must produce for a requested format (always float with a ring buffer)
+static inline chips_audio_format_t chips_audio_format(const chips_audio_callback_t* callback, chips_audio_format_t format) {
+    return callback->ring ? CHIPS_AUDIO_FORMAT_FLOAT : format;
+}
+// convert a fixed-point sample to float
+static inline float chips_audio_fixed_to_float(int32_t sample) {
+    return (float)sample * (1.0f / CHIPS_AUDIO_FIXEDPOINT_SCALE);
+}
+// convert a fixed-point sample to a clamped signed 16-bit sample
+static inline int16_t chips_audio_fixed_to_s16(int32_t sample) {
+    // CHIPS_AUDIO_FIXEDPOINT_SCALE is 1<<15, so this only needs to clamp
+    if (sample > 32767) {
+        return 32767;
+    }
+    else if (sample < -32768) {
+        return -32768;
+    }
+    return (int16_t)sample;
+}
+// store a fixed-point sample in the float or the signed 16-bit sample buffer
+static inline void chips_audio_store(chips_audio_format_t format, float* samples, int16_t* samples_s16, int pos, int32_t sample) {
+    if (format == CHIPS_AUDIO_FORMAT_S16) {
+        samples_s16[pos] = chips_audio_fixed_to_s16(sample);
+    }
+    else {
+        samples[pos] = chips_audio_fixed_to_float(sample);
+    }
+}
+// initialize band-limited step synthesis
+void chips_blip_init(chips_blip_t* blip, int tick_hz, int sound_hz);
+// reset to silence, and restart the output sample clock
+void chips_blip_reset(chips_blip_t* blip);
+// change the input amplitude (fixed-point) at the current tick
+void chips_blip_set(chips_blip_t* blip, int32_t level);
+// number of ticks until the next output sample is due
+uint32_t chips_blip_ticks_to_sample(const chips_blip_t* blip);
+// retire the next output sample (fixed-point), call when chips_blip_advance() returns true
+int32_t chips_blip_sample(chips_blip_t* blip);
+// advance the sample clock, returns true when an output sample is due
+static inline bool chips_blip_advance(chips_blip_t* blip, uint32_t num_ticks) {
+    blip->counter -= (int)num_ticks * CHIPS_BLIP_FIXEDPOINT_SCALE;
+    return blip->counter <= 0;
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/*--- IMPLEMENTATION ---------------------------------------------------------*/
+#ifdef CHIPS_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+/* the ring buffer positions are free-running counters, the producer
+   publishes its samples with a release-store of write_pos which pairs with
+   the acquire-load in the consumer, and vice versa for read_pos
+*/
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    #define _CHIPS_ATOMIC_LOAD(ptr) ((uint32_t)_InterlockedOr((volatile long*)(ptr), 0))
+    #define _CHIPS_ATOMIC_STORE(ptr, val) _InterlockedExchange((volatile long*)(ptr), (long)(val))
+#elif defined(__GNUC__)
+    #define _CHIPS_ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+    #define _CHIPS_ATOMIC_STORE(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#else
+    // FIXME: no memory ordering guarantees on other compilers
+    #define _CHIPS_ATOMIC_LOAD(ptr) (*(volatile uint32_t*)(ptr))
+    #define _CHIPS_ATOMIC_STORE(ptr, val) (*(volatile uint32_t*)(ptr) = (val))
+#endif
+
+void chips_audio_ring_init(chips_audio_ring_t* ring, float* buffer, uint32_t num_samples) {
+    CHIPS_ASSERT(ring && buffer);
+    CHIPS_ASSERT((num_samples > 0) && ((num_samples & (num_samples - 1)) == 0));
+    memset(ring, 0, sizeof(chips_audio_ring_t));
+    ring->buffer = buffer;
+    ring->mask = num_samples - 1;
+}
+
+int chips_audio_ring_push(chips_audio_ring_t* ring, const float* samples, int num_samples) {
+    CHIPS_ASSERT(ring && ring->buffer && samples && (num_samples >= 0));
+    const uint32_t wr = ring->write_pos;
+    const uint32_t rd = _CHIPS_ATOMIC_LOAD(&ring->read_pos);
+    const uint32_t num_free = (ring->mask + 1) - (wr - rd);
+    uint32_t num = (uint32_t)num_samples;
+    if (num > num_free) {
+        ring->num_overruns += num - num_free;
+        num = num_free;
+    }
+    const uint32_t pos = wr & ring->mask;
+    const uint32_t num_0 = ((pos + num) > (ring->mask + 1)) ? (ring->mask + 1 - pos) : num;
+    memcpy(&ring->buffer[pos], samples, num_0 * sizeof(float));
+    memcpy(&ring->buffer[0], &samples[num_0], (num - num_0) * sizeof(float));
+    _CHIPS_ATOMIC_STORE(&ring->write_pos, wr + num);
+    return (int)num;
+}
+
+int chips_audio_ring_count(chips_audio_ring_t* ring) {
+    CHIPS_ASSERT(ring);
+    return (int)(_CHIPS_ATOMIC_LOAD(&ring->write_pos) - ring->read_pos);
+}
+
+int chips_audio_ring_pop(chips_audio_ring_t* ring, float* dst, int num_samples) {
+    CHIPS_ASSERT(ring && ring->buffer && dst && (num_samples >= 0));
+    const uint32_t rd = ring->read_pos;
+    const uint32_t wr = _CHIPS_ATOMIC_LOAD(&ring->write_pos);
+    uint32_t num = (uint32_t)num_samples;
+    if (num > (wr - rd)) {
+        num = wr - rd;
+        ring->num_underruns += (uint32_t)num_samples - num;
+        memset(&dst[num], 0, ((uint32_t)num_samples - num) * sizeof(float));
+    }
+    const uint32_t pos = rd & ring->mask;
+    const uint32_t num_0 = ((pos + num) > (ring->mask + 1)) ? (ring->mask + 1 - pos) : num;
+    memcpy(dst, &ring->buffer[pos], num_0 * sizeof(float));
+    memcpy(&dst[num_0], &ring->buffer[0], (num - num_0) * sizeof(float));
+    _CHIPS_ATOMIC_STORE(&ring->read_pos, rd + num);
+    return (int)num;
+}
+
+static inline int16_t _chips_audio_to_s16(float s) {
+    int v = (int)(s * 32767.0f);
+    if (v > 32767) {
+        v = 32767;
+    }
+    else if (v < -32768) {
+        v = -32768;
+    }
+    return (int16_t)v;
+}
+
+int chips_audio_ring_pop_s16(chips_audio_ring_t* ring, int16_t* dst, int num_samples) {
+    CHIPS_ASSERT(ring && ring->buffer && dst && (num_samples >= 0));
+    // same as chips_audio_ring_pop(), but converts directly out of the ring buffer
+    const uint32_t rd = ring->read_pos;
+    const uint32_t wr = _CHIPS_ATOMIC_LOAD(&ring->write_pos);
+    uint32_t num = (uint32_t)num_samples;
+    if (num > (wr - rd)) {
+        num = wr - rd;
+        ring->num_underruns += (uint32_t)num_samples - num;
+        memset(&dst[num], 0, ((uint32_t)num_samples - num) * sizeof(int16_t));
+    }
+    for (uint32_t i = 0; i < num; i++) {
+        dst[i] = _chips_audio_to_s16(ring->buffer[(rd + i) & ring->mask]);
+    }
+    _CHIPS_ATOMIC_STORE(&ring->read_pos, rd + num);
+    return (int)num;
+}
+
+void chips_audio_flush(const chips_audio_callback_t* callback, chips_audio_format_t format, const float* samples, const int16_t* samples_s16, int num_samples) {
+    if (callback->ring) {
+        CHIPS_ASSERT(format == CHIPS_AUDIO_FORMAT_FLOAT);
+        chips_audio_ring_push(callback->ring, samples, num_samples);
+    }
+    else if (format == CHIPS_AUDIO_FORMAT_S16) {
+        if (callback->func_s16) {
+            callback->func_s16(samples_s16, num_samples, callback->user_data);
+        }
+    }
+    else if (callback->func) {
+        callback->func(samples, num_samples, callback->user_data);
+    }
+}
+
+/* band-limited step kernels (Kaiser-windowed sinc, cutoff at 0.42 x the
+   sample rate), one row of output sample deltas per sub-sample position
+   of the step, in 1.13 fixed-point, each row sums to exactly 1<<13
+*/
+#define _CHIPS_BLIP_KERNEL_SHIFT (13)
+static const int16_t _chips_blip_kernel[CHIPS_BLIP_PHASES][CHIPS_BLIP_WIDTH] = {
+    {     6,   -32,    80,  -123,    95,   117,  -735,  4581,  4758,  -668,    70,   122,  -135,    83,   -32,     5 },
+    {     6,   -31,    76,  -111,    68,   162,  -792,  4397,  4925,  -592,    21,   149,  -146,    86,   -31,     5 },
+    {     6,   -31,    72,   -99,    42,   203,  -841,  4207,  5092,  -508,   -31,   176,  -157,    88,   -31,     4 },
+    {     6,   -30,    68,   -86,    16,   242,  -881,  4012,  5245,  -414,   -85,   203,  -167,    89,   -30,     4 },
+    {     6,   -29,    63,   -73,    -9,   277,  -912,  3813,  5388,  -311,  -140,   230,  -176,    91,   -29,     3 },
+    {     6,   -28,    58,   -60,   -32,   309,  -936,  3610,  5525,  -199,  -197,   256,  -185,    91,   -28,     2 },
+    {     6,   -27,    53,   -48,   -55,   338,  -951,  3405,  5648,   -78,  -254,   281,  -192,    91,   -26,     1 },
+    {     6,   -26,    48,   -35,   -76,   363,  -959,  3197,  5762,    51,  -312,   305,  -198,    90,   -24,     0 },
+    {     6,   -25,    43,   -23,   -96,   385,  -959,  2989,  5863,   189,  -370,   328,  -203,    88,   -22,    -1 },
+    {     6,   -23,    38,   -11,  -114,   403,  -952,  2780,  5951,   335,  -428,   349,  -207,    86,   -19,    -2 },
+    {     5,   -22,    32,     0,  -131,   417,  -939,  2571,  6033,   489,  -485,   369,  -210,    83,   -16,    -4 },
+    {     5,   -20,    27,    11,  -147,   428,  -920,  2363,  6097,   651,  -541,   387,  -210,    79,   -13,    -5 },
+    {     5,   -18,    22,    21,  -160,   436,  -895,  2157,  6150,   820,  -596,   402,  -210,    74,    -9,    -7 },
+    {     5,   -17,    17,    31,  -173,   440,  -864,  1954,  6190,   995,  -649,   415,  -208,    69,    -5,    -8 },
+    {     4,   -15,    12,    40,  -183,   441,  -829,  1754,  6217,  1176,  -699,   426,  -204,    63,    -1,   -10 },
+    {     4,   -13,     7,    48,  -192,   439,  -789,  1557,  6231,  1363,  -746,   434,  -199,    56,     3,   -11 },
+    {     4,   -11,     3,    56,  -199,   434,  -746,  1365,  6231,  1555,  -789,   439,  -192,    48,     7,   -13 },
+    {     3,   -10,    -1,    63,  -204,   426,  -699,  1178,  6218,  1752,  -829,   441,  -183,    40,    12,   -15 },
+    {     3,    -8,    -5,    69,  -208,   415,  -649,   997,  6192,  1952,  -864,   440,  -173,    31,    17,   -17 },
+    {     3,    -7,    -9,    74,  -210,   402,  -596,   822,  6151,  2156,  -895,   436,  -160,    21,    22,   -18 },
+    {     2,    -5,   -13,    79,  -210,   387,  -541,   654,  6098,  2362,  -920,   428,  -147,    11,    27,   -20 },
+    {     2,    -4,   -16,    83,  -210,   369,  -485,   492,  6034,  2570,  -939,   417,  -131,     0,    32,   -22 },
+    {     2,    -2,   -19,    86,  -207,   349,  -428,   338,  5953,  2779,  -952,   403,  -114,   -11,    38,   -23 },
+    {     2,    -1,   -22,    88,  -203,   328,  -370,   192,  5865,  2988,  -959,   385,   -96,   -23,    43,   -25 },
+    {     1,     0,   -24,    90,  -198,   305,  -312,    54,  5764,  3197,  -959,   363,   -76,   -35,    48,   -26 },
+    {     1,     1,   -26,    91,  -192,   281,  -254,   -75,  5651,  3404,  -951,   338,   -55,   -48,    53,   -27 },
+    {     1,     2,   -28,    91,  -185,   256,  -197,  -196,  5527,  3610,  -936,   309,   -32,   -60,    58,   -28 },
+    {     1,     3,   -29,    91,  -176,   230,  -140,  -308,  5390,  3813,  -912,   277,    -9,   -73,    63,   -29 },
+    {     1,     4,   -30,    89,  -167,   203,   -85,  -411,  5247,  4012,  -881,   242,    16,   -86,    68,   -30 },
+    {     0,     4,   -31,    88,  -157,   176,   -31,  -505,  5095,  4207,  -841,   203,    42,   -99,    72,   -31 },
+    {     0,     5,   -31,    86,  -146,   149,    21,  -589,  4928,  4397,  -792,   162,    68,  -111,    76,   -31 },
+    {     0,     5,   -32,    83,  -135,   122,    70,  -665,  4761,  4581,  -735,   117,    95,  -123,    80,   -32 },
+};
+
+void chips_blip_init(chips_blip_t* blip, int tick_hz, int sound_hz) {
+    CHIPS_ASSERT(blip && (tick_hz > 0) && (sound_hz > 0) && (tick_hz >= sound_hz));
+    memset(blip, 0, sizeof(chips_blip_t));
+    blip->period = (tick_hz * CHIPS_BLIP_FIXEDPOINT_SCALE) / sound_hz;
+    blip->counter = blip->period;
+    blip->phase_mul = (CHIPS_BLIP_PHASES << 16) / (uint32_t)blip->period;
+}
+
+void chips_blip_reset(chips_blip_t* blip) {
+    CHIPS_ASSERT(blip);
+    const int period = blip->period;
+    const uint32_t phase_mul = blip->phase_mul;
+    memset(blip, 0, sizeof(chips_blip_t));
+    blip->period = period;
+    blip->counter = period;
+    blip->phase_mul = phase_mul;
+}
+
+void chips_blip_set(chips_blip_t* blip, int32_t level) {
+    if (level > CHIPS_BLIP_MAX_LEVEL) {
+        level = CHIPS_BLIP_MAX_LEVEL;
+    }
+    else if (level < -CHIPS_BLIP_MAX_LEVEL) {
+        level = -CHIPS_BLIP_MAX_LEVEL;
+    }
+    const int32_t delta = level - blip->level;
+    if (delta == 0) {
+        return;
+    }
+    blip->level = level;
+    // position of the step inside the current output sample period
+    const int elapsed = blip->period - blip->counter;
+    uint32_t phase = 0;
+    if (elapsed >= blip->period) {
+        phase = CHIPS_BLIP_PHASES - 1;
+    }
+    else if (elapsed > 0) {
+        phase = ((uint32_t)elapsed * blip->phase_mul) >> 16;
+    }
+    // add the step to the ring buffer of output sample deltas as two linear runs
+    const int16_t* kernel = _chips_blip_kernel[phase];
+    int32_t* dst = &blip->delta[blip->pos];
+    const uint32_t num0 = CHIPS_BLIP_WIDTH - blip->pos;
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < num0; i++) {
+        const int32_t d = (delta * kernel[i] + (1 << (_CHIPS_BLIP_KERNEL_SHIFT - 1))) >> _CHIPS_BLIP_KERNEL_SHIFT;
+        dst[i] += d;
+        sum += d;
+    }
+    for (uint32_t i = num0; i < CHIPS_BLIP_WIDTH; i++) {
+        const int32_t d = (delta * kernel[i] + (1 << (_CHIPS_BLIP_KERNEL_SHIFT - 1))) >> _CHIPS_BLIP_KERNEL_SHIFT;
+        blip->delta[i - num0] += d;
+        sum += d;
+    }
+    // the rounding error goes into the center tap, so that the step integrates exactly to delta
+    blip->delta[(blip->pos + CHIPS_BLIP_WIDTH/2) & (CHIPS_BLIP_WIDTH - 1)] += delta - sum;
+}
+
+uint32_t chips_blip_ticks_to_sample(const chips_blip_t* blip) {
+    if (blip->counter <= 0) {
+        return 0;
+    }
+    return (uint32_t)((blip->counter + CHIPS_BLIP_FIXEDPOINT_SCALE - 1) / CHIPS_BLIP_FIXEDPOINT_SCALE);
+}
+
+int32_t chips_blip_sample(chips_blip_t* blip) {
+    blip->counter += blip->period;
+    blip->output += blip->delta[blip->pos];
+    blip->delta[blip->pos] = 0;
+    blip->pos = (blip->pos + 1) & (CHIPS_BLIP_WIDTH - 1);
+    return blip->output;
+}
+
+#endif // CHIPS_IMPL
@@ -4,6 +4,65 @@
 
     Common data types for chips system headers.
 
+    The display conversion functions are in chips_display.h, the band-limited
+    audio synthesis, audio output formats and audio ring buffer are in
+    chips_audio.h.
+
+    ## Frame Hashing
+
+    For visual regression tests, chips_display_hash() computes a 64-bit hash
+    of the visible screen rectangle of a display (the framebuffer content,
+    without the palette). The hash is computed row by row
+    with chips_hash() starting at CHIPS_HASH_SEED:
+
+    ~~~C
+    uint64_t hash = CHIPS_HASH_SEED;
+    for (int y = 0; y < info.screen.height; y++) {
+        hash = chips_hash(hash, row_ptr(y), row_size);
+    }
+    ~~~
+
+    Video chips which decode the display line by line (am40010, mc6847 and
+    the ZX Spectrum) use the same computation to hash each scanline right
+    after it has been decoded, so the frame hash of the last completed
+    frame is available at no extra cost (see the *_frame_hash() functions
+    in the system headers).
+
+    chips_hash() isn't a cryptographic hash, and hash values depend on the
+    host byte order.
+
+    ## Video Bands
+
+    Frontends which want to display or stream a frame before it is
+    complete ("beam racing") can provide a chips_video_band_desc_t in the
+    desc struct of systems which support it (currently the CPC, C64 and
+    ZX Spectrum). The callback is invoked from inside the tick function each
+    time a band of framebuffer rows has been decoded:
+
+    ~~~C
+    static void band_cb(int first_row, int num_rows, void* user_data) {
+        // framebuffer rows first_row .. first_row+num_rows-1 are complete
+    }
+
+    cpc_init(&sys, &(cpc_desc_t){
+        ...
+        .video_band = {
+            .callback = { .func = band_cb, .user_data = ... },
+            .num_rows = 16,
+        },
+    });
+    ~~~
+
+    Row numbers are framebuffer rows (see chips_display_info_t.frame), and
+    bands are delivered in top-to-bottom order. The last band of a frame
+    may be shorter than .num_rows (default: CHIPS_VIDEO_BAND_DEFAULT_ROWS),
+    it is delivered when the video chip starts a new frame. The callback
+    isn't called in headless mode.
+
+    Video chips use a chips_video_band_t to track the rows, call
+    chips_video_band_row() after a framebuffer row has been decoded, and
+    chips_video_band_frame() at the start of a new frame.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -26,6 +85,15 @@
 #include <stdbool.h>
 #include <stddef.h>
 
+// used for the configuration-specialized tick functions in the system headers
+#if defined(_MSC_VER)
+    #define CHIPS_FORCE_INLINE __forceinline
+#elif defined(__GNUC__)
+    #define CHIPS_FORCE_INLINE inline __attribute__((always_inline))
+#else
+    #define CHIPS_FORCE_INLINE inline
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -54,9 +122,20 @@ typedef struct {
     bool portrait;
 } chips_display_info_t;
 
+// initial value for chaining chips_hash() calls
+#define CHIPS_HASH_SEED (0xCBF29CE484222325ULL)
+
+// audio output sample formats
+typedef enum {
+    CHIPS_AUDIO_FORMAT_FLOAT = 0,   // float samples passed to chips_audio_callback_t.func (default)
+    CHIPS_AUDIO_FORMAT_S16,         // signed 16-bit samples passed to chips_audio_callback_t.func_s16
+} chips_audio_format_t;
+
 typedef struct {
     void (*func)(const float* samples, int num_samples, void* user_data);
+    void (*func_s16)(const int16_t* samples, int num_samples, void* user_data);
     void* user_data;
+    struct chips_audio_ring_t* ring;    // optional: push samples into a ring buffer instead of calling func (see chips_audio.h)
 } chips_audio_callback_t;
 
 typedef void (*chips_debug_func_t)(void* user_data, uint64_t pins);
@@ -70,11 +149,52 @@ typedef struct {
 
 typedef struct {
     chips_audio_callback_t callback;
+    chips_audio_format_t format;
     int num_samples;
     int sample_rate;
     float volume;
 } chips_audio_desc_t;
 
+// default number of framebuffer rows per video band
+#define CHIPS_VIDEO_BAND_DEFAULT_ROWS (16)
+
+// called when a band of framebuffer rows has been decoded
+typedef struct {
+    void (*func)(int first_row, int num_rows, void* user_data);
+    void* user_data;
+} chips_video_band_callback_t;
+
+// setup parameters for partial frame delivery
+typedef struct {
+    chips_video_band_callback_t callback;
+    int num_rows;           // framebuffer rows per band (default: CHIPS_VIDEO_BAND_DEFAULT_ROWS)
+} chips_video_band_desc_t;
+
+// partial frame delivery state
+typedef struct {
+    chips_video_band_callback_t callback;
+    int num_rows;
+    int first_row;          // first row of the current band
+    int next_row;           // one past the last completed row
+} chips_video_band_t;
+
+// stop conditions for the *_exec_until() functions (currently in zx.h, cpc.h and c64.h)
+#define CHIPS_EXEC_UNTIL_TICKS  (1<<0)  // tick limit reached (always active)
+#define CHIPS_EXEC_UNTIL_VSYNC  (1<<1)  // a video frame has been completed
+#define CHIPS_EXEC_UNTIL_AUDIO  (1<<2)  // the audio sample buffer has been flushed
+#define CHIPS_EXEC_UNTIL_PC     (1<<3)  // the CPU is about to execute the instruction at 'pc'
+
+typedef struct {
+    uint32_t conditions;    // combination of CHIPS_EXEC_UNTIL_* flags
+    uint32_t max_ticks;     // max number of ticks to execute
+    uint16_t pc;            // instruction address for CHIPS_EXEC_UNTIL_PC
+} chips_exec_until_t;
+
+typedef struct {
+    uint32_t reason;        // CHIPS_EXEC_UNTIL_* flags of the conditions that fired
+    uint32_t ticks;         // number of executed ticks
+} chips_exec_result_t;
+
 // prepare chips_audio_t snapshot for saving
 void chips_audio_callback_snapshot_onsave(chips_audio_callback_t* snapshot);
 // fixup chips_audio_t snapshot after loading
@@ -83,6 +203,20 @@ void chips_audio_callback_snapshot_onload(chips_audio_callback_t* snapshot, chip
 void chips_debug_snapshot_onsave(chips_debug_t* snapshot);
 // fixup chips_debug_t snapshot after loading
 void chips_debug_snapshot_onload(chips_debug_t* snapshot, chips_debug_t* sys);
+// initialize video band tracking
+void chips_video_band_init(chips_video_band_t* band, const chips_video_band_desc_t* desc);
+// a framebuffer row has been completed, invokes the callback when a band is complete
+void chips_video_band_row(chips_video_band_t* band, int row);
+// a new frame has started, delivers the remaining rows of the previous frame
+void chips_video_band_frame(chips_video_band_t* band);
+// prepare chips_video_band_t snapshot for saving
+void chips_video_band_snapshot_onsave(chips_video_band_t* snapshot);
+// fixup chips_video_band_t snapshot after loading
+void chips_video_band_snapshot_onload(chips_video_band_t* snapshot, chips_video_band_t* sys);
+// fast 64-bit hash of a memory range, pass the previous hash as seed to chain calls
+uint64_t chips_hash(uint64_t seed, const void* ptr, size_t num_bytes);
+// hash the visible screen rectangle of a display row by row
+uint64_t chips_display_hash(const chips_display_info_t* info);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -90,15 +224,24 @@ void chips_debug_snapshot_onload(chips_debug_t* snapshot, chips_debug_t* sys);
 
 /*--- IMPLEMENTATION ---------------------------------------------------------*/
 #ifdef CHIPS_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
 
 void chips_audio_callback_snapshot_onsave(chips_audio_callback_t* snapshot) {
     snapshot->func = 0;
+    snapshot->func_s16 = 0;
     snapshot->user_data = 0;
+    snapshot->ring = 0;
 }
 
 void chips_audio_callback_snapshot_onload(chips_audio_callback_t* snapshot, chips_audio_callback_t* sys) {
     snapshot->func = sys->func;
+    snapshot->func_s16 = sys->func_s16;
     snapshot->user_data = sys->user_data;
+    snapshot->ring = sys->ring;
 }
 
 void chips_debug_snapshot_onsave(chips_debug_t* snapshot) {
@@ -113,4 +256,107 @@ void chips_debug_snapshot_onload(chips_debug_t* snapshot, chips_debug_t* sys) {
     snapshot->stopped = sys->stopped;
 }
 
+void chips_video_band_init(chips_video_band_t* band, const chips_video_band_desc_t* desc) {
+    CHIPS_ASSERT(band && desc && (desc->num_rows >= 0));
+    memset(band, 0, sizeof(chips_video_band_t));
+    band->callback = desc->callback;
+    band->num_rows = (desc->num_rows > 0) ? desc->num_rows : CHIPS_VIDEO_BAND_DEFAULT_ROWS;
+}
+
+void chips_video_band_row(chips_video_band_t* band, int row) {
+    if (!band->callback.func) {
+        return;
+    }
+    // flush the pending rows if the beam jumped (e.g. frame restarted mid-band)
+    if ((row != band->next_row) && (band->next_row > band->first_row)) {
+        band->callback.func(band->first_row, band->next_row - band->first_row, band->callback.user_data);
+    }
+    if (row != band->next_row) {
+        band->first_row = row;
+    }
+    band->next_row = row + 1;
+    if ((band->next_row - band->first_row) >= band->num_rows) {
+        band->callback.func(band->first_row, band->next_row - band->first_row, band->callback.user_data);
+        band->first_row = band->next_row;
+    }
+}
+
+void chips_video_band_frame(chips_video_band_t* band) {
+    if (band->callback.func && (band->next_row > band->first_row)) {
+        band->callback.func(band->first_row, band->next_row - band->first_row, band->callback.user_data);
+    }
+    band->first_row = 0;
+    band->next_row = 0;
+}
+
+void chips_video_band_snapshot_onsave(chips_video_band_t* snapshot) {
+    snapshot->callback.func = 0;
+    snapshot->callback.user_data = 0;
+}
+
+void chips_video_band_snapshot_onload(chips_video_band_t* snapshot, chips_video_band_t* sys) {
+    snapshot->callback = sys->callback;
+    snapshot->num_rows = sys->num_rows;
+}
+
+static inline uint64_t _chips_hash_round(uint64_t h, uint64_t v) {
+    h = (h ^ v) * 0x9E3779B97F4A7C15ULL;
+    return h ^ (h >> 32);
+}
+
+static inline uint64_t _chips_hash_load(const uint8_t* ptr) {
+    uint64_t v;
+    memcpy(&v, ptr, sizeof(v));
+    return v;
+}
+
+/* 4 independent lanes hide the multiply latency, a framebuffer row is
+    hashed at several bytes per clock cycle
+*/
+uint64_t chips_hash(uint64_t seed, const void* ptr, size_t num_bytes) {
+    CHIPS_ASSERT(ptr || (num_bytes == 0));
+    const uint8_t* p = (const uint8_t*) ptr;
+    size_t n = num_bytes;
+    uint64_t h0 = seed;
+    uint64_t h1 = seed ^ 0x243F6A8885A308D3ULL;
+    uint64_t h2 = seed ^ 0x13198A2E03707344ULL;
+    uint64_t h3 = seed ^ 0xA4093822299F31D0ULL;
+    for (; n >= 32; p += 32, n -= 32) {
+        h0 = _chips_hash_round(h0, _chips_hash_load(p + 0));
+        h1 = _chips_hash_round(h1, _chips_hash_load(p + 8));
+        h2 = _chips_hash_round(h2, _chips_hash_load(p + 16));
+        h3 = _chips_hash_round(h3, _chips_hash_load(p + 24));
+    }
+    uint64_t h = h0 ^ ((h1 << 17) | (h1 >> 47)) ^ ((h2 << 31) | (h2 >> 33)) ^ ((h3 << 47) | (h3 >> 17));
+    h = _chips_hash_round(h, (uint64_t)num_bytes);
+    for (; n >= 8; p += 8, n -= 8) {
+        h = _chips_hash_round(h, _chips_hash_load(p));
+    }
+    if (n > 0) {
+        uint64_t v = 0;
+        memcpy(&v, p, n);
+        h = _chips_hash_round(h, v);
+    }
+    // final avalanche (from splitmix64)
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
+
+uint64_t chips_display_hash(const chips_display_info_t* info) {
+    CHIPS_ASSERT(info && info->frame.buffer.ptr);
+    const size_t bpp = info->frame.bytes_per_pixel;
+    const size_t pitch = (size_t)info->frame.dim.width * bpp;
+    const size_t row_size = (size_t)info->screen.width * bpp;
+    const uint8_t* src = (const uint8_t*)info->frame.buffer.ptr + (size_t)info->screen.y * pitch + (size_t)info->screen.x * bpp;
+    uint64_t hash = CHIPS_HASH_SEED;
+    for (int y = 0; y < info->screen.height; y++) {
+        hash = chips_hash(hash, src + (size_t)y * pitch, row_size);
+    }
+    return hash;
+}
+
 #endif // CHIPS_IMPL
@@ -0,0 +1,396 @@
+#pragma once
+/*#
+    # chips_display.h
+
+    Convert the indexed framebuffer of the system emulators into RGBA8 or
+    RGB565 pixels on the CPU.
+
+    Do this:
+    ~~~C
+    #define CHIPS_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    You need to include the following headers before including chips_display.h:
+
+    - chips/chips_common.h
+
+    ## Display Conversion
+
+    The system emulators render into an 8-bit indexed framebuffer and
+    describe it with a chips_display_info_t struct (framebuffer, visible
+    screen rectangle and color palette). For screenshot pipelines and
+    frontends without a GPU, chips_display_to_rgba() and chips_display_to_rgb565()
+    resolve the palette on the CPU:
+
+    ~~~C
+    chips_display_info_t info = zx_display_info(&sys);
+    chips_dim_t dim = chips_display_convert_dim(&info, true, 1);
+    static uint32_t pixels[320 * 256];
+    chips_display_to_rgba(&info, &(chips_display_convert_t){
+        .crop = true,
+        .dst = { .ptr = pixels, .size = sizeof(pixels) },
+    });
+    ~~~
+
+    Set .crop to true to only convert the chips_display_info_t.screen
+    rectangle, and .downscale to an integer factor (up to
+    CHIPS_DISPLAY_MAX_DOWNSCALE) to average NxN pixel blocks into one
+    destination pixel. To stream the output into smaller buffers, use .first_row
+    and .num_rows to convert a band of destination rows at a time. The row
+    at .first_row is written to the start of the .dst buffer. Both functions
+    return the number of converted rows.
+
+    RGBA8 output has the same byte order as the palette (R in the lowest
+    byte), RGB565 output packs 5 bits of red in the top bits of a uint16_t.
+    Framebuffers with 4 bytes per pixel (Bomb Jack) are already RGBA8 and
+    are copied or converted without a palette lookup. The portrait flag is
+    ignored, rotation is left to the host.
+
+    When compiled with SSSE3 (or AVX) or on ARM64, the palette lookup of
+    palettes with up to 16 colors uses byte-shuffle instructions to convert
+    16 pixels at a time. Define CHIPS_DISPLAY_NO_SIMD before including the
+    implementation to use the portable C code instead.
+
+    ## zlib/libpng license
+
+    Copyright (c) 2018 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// max integer downscale factor for chips_display_to_rgba() and chips_display_to_rgb565()
+#define CHIPS_DISPLAY_MAX_DOWNSCALE (16)
+
+// parameters for chips_display_to_rgba() and chips_display_to_rgb565()
+typedef struct {
+    bool crop;              // if true, only convert the chips_display_info_t.screen rectangle
+    int downscale;          // integer downscale factor, averages NxN pixel blocks (default: 1)
+    int first_row;          // first destination row to convert
+    int num_rows;           // number of destination rows to convert (default: all remaining rows)
+    chips_range_t dst;      // destination buffer, receives the row at first_row first
+    size_t dst_pitch;       // destination bytes per row (default: tightly packed)
+} chips_display_convert_t;
+
+// get the destination dimensions of a display conversion
+chips_dim_t chips_display_convert_dim(const chips_display_info_t* info, bool crop, int downscale);
+// convert display rows to RGBA8, returns number of converted rows
+int chips_display_to_rgba(const chips_display_info_t* info, const chips_display_convert_t* desc);
+// convert display rows to RGB565, returns number of converted rows
+int chips_display_to_rgb565(const chips_display_info_t* info, const chips_display_convert_t* desc);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/*--- IMPLEMENTATION ---------------------------------------------------------*/
+#ifdef CHIPS_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+#if !defined(CHIPS_DISPLAY_NO_SIMD)
+    #if defined(__SSSE3__) || defined(__AVX__)
+        #include <tmmintrin.h>
+        #define _CHIPS_DISPLAY_SSSE3
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #include <arm_neon.h>
+        #define _CHIPS_DISPLAY_NEON
+    #endif
+#endif
+
+// palette lookup tables, colors outside the palette resolve to 0
+typedef struct {
+    uint32_t rgba[256];
+    uint16_t rgb565[256];
+    bool simd;      // true if the palette fits into the 16-entry SIMD lookup tables
+    #if defined(_CHIPS_DISPLAY_SSSE3) || defined(_CHIPS_DISPLAY_NEON)
+    uint8_t rgba_planes[4][16];     // [channel][color]
+    uint8_t rgb565_planes[2][16];   // [lo/hi byte][color]
+    #endif
+} _chips_display_lut_t;
+
+static inline uint16_t _chips_display_rgba_to_rgb565(uint32_t c) {
+    const uint32_t r = c & 0xFF;
+    const uint32_t g = (c >> 8) & 0xFF;
+    const uint32_t b = (c >> 16) & 0xFF;
+    return (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+static void _chips_display_init_lut(_chips_display_lut_t* lut, const chips_display_info_t* info) {
+    memset(lut, 0, sizeof(_chips_display_lut_t));
+    size_t num_colors = info->palette.ptr ? (info->palette.size / sizeof(uint32_t)) : 0;
+    if (num_colors > 256) {
+        num_colors = 256;
+    }
+    if (num_colors > 0) {
+        memcpy(lut->rgba, info->palette.ptr, num_colors * sizeof(uint32_t));
+    }
+    for (size_t i = 0; i < 256; i++) {
+        lut->rgb565[i] = _chips_display_rgba_to_rgb565(lut->rgba[i]);
+    }
+    #if defined(_CHIPS_DISPLAY_SSSE3) || defined(_CHIPS_DISPLAY_NEON)
+    lut->simd = num_colors <= 16;
+    for (size_t i = 0; i < 16; i++) {
+        const uint32_t c = lut->rgba[i];
+        lut->rgba_planes[0][i] = (uint8_t)c;
+        lut->rgba_planes[1][i] = (uint8_t)(c >> 8);
+        lut->rgba_planes[2][i] = (uint8_t)(c >> 16);
+        lut->rgba_planes[3][i] = (uint8_t)(c >> 24);
+        lut->rgb565_planes[0][i] = (uint8_t)lut->rgb565[i];
+        lut->rgb565_planes[1][i] = (uint8_t)(lut->rgb565[i] >> 8);
+    }
+    #endif
+}
+
+/* convert a row of color indices to RGBA8
+
+    The SIMD path resolves 16 pixels through 4 byte-shuffle lookups (one per
+    color channel) and interleaves the channels into RGBA8 pixels. Palettes
+    with more than 16 colors use the scalar lookup, chaining several
+    shuffle tables per channel is slower than the scalar loads.
+*/
+static void _chips_display_row_rgba(const _chips_display_lut_t* lut, const uint8_t* src, uint32_t* dst, int width) {
+    int x = 0;
+    #if defined(_CHIPS_DISPLAY_SSSE3)
+    if (lut->simd) {
+        const __m128i r_tbl = _mm_loadu_si128((const __m128i*)lut->rgba_planes[0]);
+        const __m128i g_tbl = _mm_loadu_si128((const __m128i*)lut->rgba_planes[1]);
+        const __m128i b_tbl = _mm_loadu_si128((const __m128i*)lut->rgba_planes[2]);
+        const __m128i a_tbl = _mm_loadu_si128((const __m128i*)lut->rgba_planes[3]);
+        // indices >= 16 get the top bit set, which makes the shuffle return 0
+        const __m128i clamp = _mm_set1_epi8(0x70);
+        for (; (x + 16) <= width; x += 16) {
+            const __m128i idx = _mm_adds_epu8(_mm_loadu_si128((const __m128i*)(src + x)), clamp);
+            const __m128i r = _mm_shuffle_epi8(r_tbl, idx);
+            const __m128i g = _mm_shuffle_epi8(g_tbl, idx);
+            const __m128i b = _mm_shuffle_epi8(b_tbl, idx);
+            const __m128i a = _mm_shuffle_epi8(a_tbl, idx);
+            const __m128i rg_lo = _mm_unpacklo_epi8(r, g);
+            const __m128i rg_hi = _mm_unpackhi_epi8(r, g);
+            const __m128i ba_lo = _mm_unpacklo_epi8(b, a);
+            const __m128i ba_hi = _mm_unpackhi_epi8(b, a);
+            _mm_storeu_si128((__m128i*)(dst + x + 0),  _mm_unpacklo_epi16(rg_lo, ba_lo));
+            _mm_storeu_si128((__m128i*)(dst + x + 4),  _mm_unpackhi_epi16(rg_lo, ba_lo));
+            _mm_storeu_si128((__m128i*)(dst + x + 8),  _mm_unpacklo_epi16(rg_hi, ba_hi));
+            _mm_storeu_si128((__m128i*)(dst + x + 12), _mm_unpackhi_epi16(rg_hi, ba_hi));
+        }
+    }
+    #elif defined(_CHIPS_DISPLAY_NEON)
+    if (lut->simd) {
+        const uint8x16_t r_tbl = vld1q_u8(lut->rgba_planes[0]);
+        const uint8x16_t g_tbl = vld1q_u8(lut->rgba_planes[1]);
+        const uint8x16_t b_tbl = vld1q_u8(lut->rgba_planes[2]);
+        const uint8x16_t a_tbl = vld1q_u8(lut->rgba_planes[3]);
+        for (; (x + 16) <= width; x += 16) {
+            // out-of-range indices return 0
+            const uint8x16_t idx = vld1q_u8(src + x);
+            uint8x16x4_t c;
+            c.val[0] = vqtbl1q_u8(r_tbl, idx);
+            c.val[1] = vqtbl1q_u8(g_tbl, idx);
+            c.val[2] = vqtbl1q_u8(b_tbl, idx);
+            c.val[3] = vqtbl1q_u8(a_tbl, idx);
+            vst4q_u8((uint8_t*)(dst + x), c);
+        }
+    }
+    #endif
+    for (; x < width; x++) {
+        dst[x] = lut->rgba[src[x]];
+    }
+}
+
+// convert a row of color indices to RGB565
+static void _chips_display_row_rgb565(const _chips_display_lut_t* lut, const uint8_t* src, uint16_t* dst, int width) {
+    int x = 0;
+    #if defined(_CHIPS_DISPLAY_SSSE3)
+    if (lut->simd) {
+        const __m128i lo_tbl = _mm_loadu_si128((const __m128i*)lut->rgb565_planes[0]);
+        const __m128i hi_tbl = _mm_loadu_si128((const __m128i*)lut->rgb565_planes[1]);
+        const __m128i clamp = _mm_set1_epi8(0x70);
+        for (; (x + 16) <= width; x += 16) {
+            const __m128i idx = _mm_adds_epu8(_mm_loadu_si128((const __m128i*)(src + x)), clamp);
+            const __m128i lo = _mm_shuffle_epi8(lo_tbl, idx);
+            const __m128i hi = _mm_shuffle_epi8(hi_tbl, idx);
+            _mm_storeu_si128((__m128i*)(dst + x + 0), _mm_unpacklo_epi8(lo, hi));
+            _mm_storeu_si128((__m128i*)(dst + x + 8), _mm_unpackhi_epi8(lo, hi));
+        }
+    }
+    #elif defined(_CHIPS_DISPLAY_NEON)
+    if (lut->simd) {
+        const uint8x16_t lo_tbl = vld1q_u8(lut->rgb565_planes[0]);
+        const uint8x16_t hi_tbl = vld1q_u8(lut->rgb565_planes[1]);
+        for (; (x + 16) <= width; x += 16) {
+            const uint8x16_t idx = vld1q_u8(src + x);
+            uint8x16x2_t c;
+            c.val[0] = vqtbl1q_u8(lo_tbl, idx);
+            c.val[1] = vqtbl1q_u8(hi_tbl, idx);
+            vst2q_u8((uint8_t*)(dst + x), c);
+        }
+    }
+    #endif
+    for (; x < width; x++) {
+        dst[x] = lut->rgb565[src[x]];
+    }
+}
+
+/* convert a row of NxN pixel blocks to RGBA8 by averaging the color channels,
+    two 8-bit channels are accumulated per 32-bit value, with at most
+    16x16 pixels per block the 16-bit sums can't overflow
+*/
+static void _chips_display_row_scaled(const _chips_display_lut_t* lut, const uint8_t* src, size_t src_pitch, size_t bpp, int scale, uint32_t* dst, int width) {
+    const uint32_t n = (uint32_t)(scale * scale);
+    for (int x = 0; x < width; x++) {
+        uint32_t rb = 0, ga = 0;
+        for (int sy = 0; sy < scale; sy++) {
+            const uint8_t* row = src + (size_t)sy * src_pitch + (size_t)x * (size_t)scale * bpp;
+            for (int sx = 0; sx < scale; sx++) {
+                uint32_t c;
+                if (bpp == 1) {
+                    c = lut->rgba[row[sx]];
+                } else {
+                    memcpy(&c, row + sx * 4, sizeof(c));
+                }
+                rb += c & 0x00FF00FF;
+                ga += (c >> 8) & 0x00FF00FF;
+            }
+        }
+        const uint32_t r = ((rb & 0xFFFF) + n/2) / n;
+        const uint32_t b = ((rb >> 16) + n/2) / n;
+        const uint32_t g = ((ga & 0xFFFF) + n/2) / n;
+        const uint32_t a = ((ga >> 16) + n/2) / n;
+        dst[x] = (a << 24) | (b << 16) | (g << 8) | r;
+    }
+}
+
+static chips_rect_t _chips_display_src_rect(const chips_display_info_t* info, bool crop) {
+    if (crop) {
+        return info->screen;
+    }
+    else {
+        const chips_rect_t rect = { 0, 0, info->frame.dim.width, info->frame.dim.height };
+        return rect;
+    }
+}
+
+chips_dim_t chips_display_convert_dim(const chips_display_info_t* info, bool crop, int downscale) {
+    CHIPS_ASSERT(info);
+    const int scale = (downscale > 0) ? downscale : 1;
+    CHIPS_ASSERT(scale <= CHIPS_DISPLAY_MAX_DOWNSCALE);
+    const chips_rect_t rect = _chips_display_src_rect(info, crop);
+    const chips_dim_t dim = { rect.width / scale, rect.height / scale };
+    return dim;
+}
+
+static int _chips_display_convert(const chips_display_info_t* info, const chips_display_convert_t* desc, bool rgb565) {
+    CHIPS_ASSERT(info && desc && info->frame.buffer.ptr);
+    CHIPS_ASSERT((info->frame.bytes_per_pixel == 1) || (info->frame.bytes_per_pixel == 4));
+    const int scale = (desc->downscale > 0) ? desc->downscale : 1;
+    const chips_rect_t rect = _chips_display_src_rect(info, desc->crop);
+    CHIPS_ASSERT((rect.x >= 0) && (rect.y >= 0));
+    CHIPS_ASSERT(((rect.x + rect.width) <= info->frame.dim.width) && ((rect.y + rect.height) <= info->frame.dim.height));
+    const chips_dim_t dim = chips_display_convert_dim(info, desc->crop, scale);
+    CHIPS_ASSERT((desc->first_row >= 0) && (desc->first_row <= dim.height));
+    int num_rows = dim.height - desc->first_row;
+    if ((desc->num_rows > 0) && (desc->num_rows < num_rows)) {
+        num_rows = desc->num_rows;
+    }
+    if ((num_rows <= 0) || (dim.width <= 0)) {
+        return 0;
+    }
+    const size_t dst_bpp = rgb565 ? sizeof(uint16_t) : sizeof(uint32_t);
+    const size_t dst_row_size = (size_t)dim.width * dst_bpp;
+    const size_t dst_pitch = (desc->dst_pitch > 0) ? desc->dst_pitch : dst_row_size;
+    CHIPS_ASSERT(dst_pitch >= dst_row_size);
+    CHIPS_ASSERT(desc->dst.ptr && (desc->dst.size >= ((size_t)(num_rows - 1) * dst_pitch + dst_row_size)));
+
+    const size_t bpp = info->frame.bytes_per_pixel;
+    const size_t src_pitch = (size_t)info->frame.dim.width * bpp;
+    const uint8_t* src = (const uint8_t*)info->frame.buffer.ptr + (size_t)rect.y * src_pitch + (size_t)rect.x * bpp;
+    uint8_t* dst = (uint8_t*) desc->dst.ptr;
+
+    // the lookup tables are only needed for indexed framebuffers
+    _chips_display_lut_t lut;
+    if (bpp == 1) {
+        _chips_display_init_lut(&lut, info);
+    }
+    for (int i = 0; i < num_rows; i++) {
+        const uint8_t* src_row = src + (size_t)(desc->first_row + i) * (size_t)scale * src_pitch;
+        uint8_t* dst_row = dst + (size_t)i * dst_pitch;
+        if (scale > 1) {
+            if (rgb565) {
+                // downscale into a small RGBA8 buffer, then convert to RGB565
+                uint32_t tmp[64];
+                for (int x = 0; x < dim.width; x += 64) {
+                    const int n = ((dim.width - x) < 64) ? (dim.width - x) : 64;
+                    _chips_display_row_scaled(&lut, src_row + (size_t)x * (size_t)scale * bpp, src_pitch, bpp, scale, tmp, n);
+                    for (int ix = 0; ix < n; ix++) {
+                        ((uint16_t*)dst_row)[x + ix] = _chips_display_rgba_to_rgb565(tmp[ix]);
+                    }
+                }
+            }
+            else {
+                _chips_display_row_scaled(&lut, src_row, src_pitch, bpp, scale, (uint32_t*)dst_row, dim.width);
+            }
+        }
+        else if (bpp == 1) {
+            if (rgb565) {
+                _chips_display_row_rgb565(&lut, src_row, (uint16_t*)dst_row, dim.width);
+            }
+            else {
+                _chips_display_row_rgba(&lut, src_row, (uint32_t*)dst_row, dim.width);
+            }
+        }
+        else {
+            if (rgb565) {
+                for (int x = 0; x < dim.width; x++) {
+                    uint32_t c;
+                    memcpy(&c, src_row + x * 4, sizeof(c));
+                    ((uint16_t*)dst_row)[x] = _chips_display_rgba_to_rgb565(c);
+                }
+            }
+            else {
+                memcpy(dst_row, src_row, dst_row_size);
+            }
+        }
+    }
+    return num_rows;
+}
+
+int chips_display_to_rgba(const chips_display_info_t* info, const chips_display_convert_t* desc) {
+    return _chips_display_convert(info, desc, false);
+}
+
+int chips_display_to_rgb565(const chips_display_info_t* info, const chips_display_convert_t* desc) {
+    return _chips_display_convert(info, desc, true);
+}
+
+#endif // CHIPS_IMPL
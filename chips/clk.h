@@ -25,6 +25,11 @@
     ~~~
         Convert micro-seconds to system ticks.
 
+    ~~~C
+    uint32_t clk_ticks_to_us(uint64_t freq_hz, uint32_t ticks)
+    ~~~
+        Convert system ticks to micro-seconds.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -51,6 +56,8 @@ extern "C" {
 
 // helper func to convert micro_seconds into ticks
 uint32_t clk_us_to_ticks(uint64_t freq_hz, uint32_t micro_seconds);
+// helper func to convert ticks into micro_seconds
+uint32_t clk_ticks_to_us(uint64_t freq_hz, uint32_t ticks);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -66,4 +73,9 @@ uint32_t clk_us_to_ticks(uint64_t freq_hz, uint32_t micro_seconds);
 uint32_t clk_us_to_ticks(uint64_t freq_hz, uint32_t micro_seconds) {
     return (uint32_t) ((freq_hz * micro_seconds) / 1000000);
 }
+
+uint32_t clk_ticks_to_us(uint64_t freq_hz, uint32_t ticks) {
+    CHIPS_ASSERT(freq_hz > 0);
+    return (uint32_t) ((ticks * 1000000ULL) / freq_hz);
+}
 #endif
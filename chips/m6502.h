@@ -3095,6 +3095,7 @@ uint64_t m6502_tick(m6502_t* c, uint64_t pins) {
 #endif
 
 #undef _SA
+#undef _GA
 #undef _SAD
 #undef _FETCH
 #undef _SD
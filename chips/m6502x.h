@@ -0,0 +1,2934 @@
+#pragma once
+/*#
+    # m6502x.h
+
+    Lockstep execution of multiple MOS Technology 6502 CPUs with a
+    structure-of-arrays CPU state.
+
+    Project repo: https://github.com/floooh/chips/
+
+    NOTE: the instruction decoder in this file is code-generated from
+    m6502_gen.py in the 'codegen' directory.
+
+    Do this:
+    ~~~C
+    #define CHIPS_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+
+    ~~~C
+    M6502X_LANES
+    ~~~
+        the number of CPUs running in lockstep, must be 8, 16 or 32
+        (default: 8)
+
+    ~~~C
+    M6502X_NO_SIMD
+    ~~~
+        define this to disable the SSE2, AVX2 or NEON code path for
+        grouping the lanes by decoder step
+
+    Include the following headers before including m6502x.h:
+
+    - m6502.h
+
+    ## Overview
+
+    m6502x.h runs M6502X_LANES instances of the cycle-stepped 6502 CPU
+    emulation from m6502.h in lockstep. This is useful for running the same
+    program thousands of times with different inputs (for instance when
+    fuzzing ROM code), where the CPUs are mostly executing the same
+    instructions.
+
+    Instead of one m6502_t struct per CPU, the CPU state lives in a single
+    m6502x_t struct with one array per register (the 'structure-of-arrays'
+    layout), where each array item belongs to one CPU 'lane'. The
+    instruction decoder is the same as in m6502.h, but instead of
+    dispatching on the decoder step once per CPU, the lanes are grouped
+    by their current decoder step, and the decoder step is executed
+    for the whole group in a loop over the lanes with a lane mask. In the
+    common case where all lanes run the same code, there's only one
+    dispatch per tick for all lanes.
+
+    Finding the lanes which are at the same decoder step happens at least
+    once per tick and is done with SSE2, AVX2 (for 16 or 32 lanes) or NEON
+    compare instructions if available. The decoder steps themselves are
+    plain C loops over the lane mask which are left to the compiler's
+    auto-vectorizer. Hand-vectorizing the ~1100 decoder steps isn't
+    worth it: most of them only touch one or two 8- or 16-bit registers
+    and the 64-bit pin mask, so there's little work per lane to spread
+    over vector lanes. For reference, in a tight loop with 8 lanes running
+    the same code on an x86-64 machine, one CPU tick costs about 9 ns per
+    CPU with m6502_tick() and about 6 ns per lane with m6502x_tick();
+    an extra unmasked loop for the 'all lanes at the same step' case
+    gained another 5% but doubled the compile time, and moving the
+    interrupt/RDY checks before the decoder into vector code was measured
+    as slightly slower than the scalar loop, so neither is done.
+
+    Note that the generated decoder is big, compiling the implementation
+    takes noticeably longer than for m6502.h.
+
+    The differences to m6502.h are:
+
+    - the m6510 IO port is not emulated
+    - there are no snapshot functions, but the state of a single lane
+      can be copied from and to a regular m6502_t struct with
+      m6502x_get_lane() and m6502x_set_lane()
+
+    ## Functions
+
+    ~~~C
+    void m6502x_init(m6502x_t* cpu, const m6502_desc_t* desc, uint64_t* pins)
+    ~~~
+        Initialize all lanes of a m6502x_t instance, 'desc' is the same
+        desc struct as used by m6502_init(). The initial pin mask
+        of each lane is written to the 'pins' array, which must have
+        room for M6502X_LANES items. All lanes will be at the start
+        of the RESET sequence.
+
+    ~~~C
+    void m6502x_tick(m6502x_t* cpu, uint64_t* pins)
+    ~~~
+        Tick all lanes for one clock cycle. The 'pins' array contains one
+        64-bit pin mask per lane, and is updated in place. After calling
+        m6502x_tick(), perform a memory access for each lane just like
+        with m6502_tick():
+
+        ~~~C
+        uint64_t pins[M6502X_LANES];
+        m6502x_init(&cpu, &(m6502_desc_t){ 0 }, pins);
+        while (...) {
+            m6502x_tick(&cpu, pins);
+            for (int l = 0; l < M6502X_LANES; l++) {
+                const uint16_t addr = M6502_GET_ADDR(pins[l]);
+                if (pins[l] & M6502_RW) {
+                    M6502_SET_DATA(pins[l], mem[l][addr]);
+                }
+                else {
+                    mem[l][addr] = M6502_GET_DATA(pins[l]);
+                }
+            }
+        }
+        ~~~
+
+    ~~~C
+    void m6502x_get_lane(m6502x_t* cpu, int lane, m6502_t* out_cpu)
+    ~~~
+        Copy the CPU state of one lane into a m6502_t struct (for instance
+        to inspect the registers with the m6502_*() getter functions).
+
+    ~~~C
+    void m6502x_set_lane(m6502x_t* cpu, int lane, const m6502_t* in_cpu)
+    ~~~
+        Copy the CPU state of a m6502_t struct into one lane (for instance
+        to start all lanes from the same state).
+
+    ## zlib/libpng license
+
+    Copyright (c) 2018 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdalign.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef M6502X_LANES
+#define M6502X_LANES (8)
+#endif
+
+// CPU state, one array item per lane
+typedef struct {
+    alignas(64) uint16_t IR[M6502X_LANES];
+    alignas(64) uint16_t PC[M6502X_LANES];
+    alignas(64) uint16_t AD[M6502X_LANES];
+    alignas(64) uint8_t A[M6502X_LANES];
+    alignas(64) uint8_t X[M6502X_LANES];
+    alignas(64) uint8_t Y[M6502X_LANES];
+    alignas(64) uint8_t S[M6502X_LANES];
+    alignas(64) uint8_t P[M6502X_LANES];
+    alignas(64) uint64_t PINS[M6502X_LANES];
+    alignas(64) uint16_t irq_pip[M6502X_LANES];
+    alignas(64) uint16_t nmi_pip[M6502X_LANES];
+    alignas(64) uint8_t brk_flags[M6502X_LANES];
+    alignas(64) uint8_t bcd_enabled[M6502X_LANES];
+} m6502x_t;
+
+// initialize all lanes, and write initial pin masks
+void m6502x_init(m6502x_t* cpu, const m6502_desc_t* desc, uint64_t* pins);
+// execute one tick on all lanes
+void m6502x_tick(m6502x_t* cpu, uint64_t* pins);
+// copy CPU state of one lane into a m6502_t struct
+void m6502x_get_lane(m6502x_t* cpu, int lane, m6502_t* out_cpu);
+// copy CPU state from a m6502_t struct into one lane
+void m6502x_set_lane(m6502x_t* cpu, int lane, const m6502_t* in_cpu);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+#if (M6502X_LANES != 8) && (M6502X_LANES != 16) && (M6502X_LANES != 32)
+#error "M6502X_LANES must be 8, 16 or 32"
+#endif
+
+#define _M6502X_ALL_LANES ((uint32_t)(((uint64_t)1<<M6502X_LANES)-1))
+
+#if defined(__GNUC__)
+#define _M6502X_UNREACHABLE __builtin_unreachable()
+#elif defined(_MSC_VER)
+#define _M6502X_UNREACHABLE __assume(0)
+#else
+#define _M6502X_UNREACHABLE
+#endif
+
+#if !defined(M6502X_NO_SIMD)
+    #if defined(__AVX2__)
+        #include <immintrin.h>
+        #define _M6502X_AVX2
+        #define _M6502X_SSE2
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #include <emmintrin.h>
+        #define _M6502X_SSE2
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #include <arm_neon.h>
+        #define _M6502X_NEON
+    #endif
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+static inline int _m6502x_first_lane(uint32_t mask) {
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+}
+#else
+static inline int _m6502x_first_lane(uint32_t mask) {
+    return __builtin_ctz(mask);
+}
+#endif
+
+// returns a lane mask with all lanes which are at decoder step 'ir'
+static inline uint32_t _m6502x_ir_lanes(const uint16_t* irs, uint16_t ir) {
+    uint32_t lanes = 0;
+    #if defined(_M6502X_AVX2) && (M6502X_LANES >= 16)
+        const __m256i vir = _mm256_set1_epi16((short)ir);
+        for (int l = 0; l < M6502X_LANES; l += 16) {
+            const __m256i eq = _mm256_cmpeq_epi16(_mm256_load_si256((const __m256i*)&irs[l]), vir);
+            // narrow to 8-bit (packs works per 128-bit half, so fix up the order)
+            const __m256i eq8 = _mm256_permute4x64_epi64(_mm256_packs_epi16(eq, eq), _MM_SHUFFLE(3,1,2,0));
+            lanes |= ((uint32_t)_mm256_movemask_epi8(eq8) & 0xFFFF) << l;
+        }
+    #elif defined(_M6502X_SSE2)
+        const __m128i vir = _mm_set1_epi16((short)ir);
+        for (int l = 0; l < M6502X_LANES; l += 8) {
+            const __m128i eq = _mm_cmpeq_epi16(_mm_load_si128((const __m128i*)&irs[l]), vir);
+            lanes |= ((uint32_t)_mm_movemask_epi8(_mm_packs_epi16(eq, eq)) & 0xFF) << l;
+        }
+    #elif defined(_M6502X_NEON)
+        static const uint8_t bits[8] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+        const uint8x8_t vbits = vld1_u8(bits);
+        const uint16x8_t vir = vdupq_n_u16(ir);
+        for (int l = 0; l < M6502X_LANES; l += 8) {
+            const uint8x8_t eq = vmovn_u16(vceqq_u16(vld1q_u16(&irs[l]), vir));
+            lanes |= (uint32_t)vaddv_u8(vand_u8(eq, vbits)) << l;
+        }
+    #else
+        for (int l = 0; l < M6502X_LANES; l++) {
+            lanes |= (uint32_t)(irs[l] == ir) << l;
+        }
+    #endif
+    return lanes;
+}
+
+/* helper macros and functions for code-generated instruction decoder */
+#define _M6502X_NZ(p,v) ((p&~(M6502_NF|M6502_ZF))|((v&0xFF)?(v&M6502_NF):M6502_ZF))
+
+static inline void _m6502x_adc(m6502x_t* c, int l, uint8_t val) {
+    if (c->bcd_enabled[l] && (c->P[l] & M6502_DF)) {
+        /* decimal mode (credit goes to MAME) */
+        uint8_t carry = c->P[l] & M6502_CF ? 1 : 0;
+        c->P[l] &= ~(M6502_NF|M6502_VF|M6502_ZF|M6502_CF);
+        uint8_t al = (c->A[l] & 0x0F) + (val & 0x0F) + carry;
+        if (al > 9) {
+            al += 6;
+        }
+        uint8_t ah = (c->A[l] >> 4) + (val >> 4) + (al > 0x0F);
+        if (0 == (uint8_t)(c->A[l] + val + carry)) {
+            c->P[l] |= M6502_ZF;
+        }
+        else if (ah & 0x08) {
+            c->P[l] |= M6502_NF;
+        }
+        if (~(c->A[l]^val) & (c->A[l]^(ah<<4)) & 0x80) {
+            c->P[l] |= M6502_VF;
+        }
+        if (ah > 9) {
+            ah += 6;
+        }
+        if (ah > 15) {
+            c->P[l] |= M6502_CF;
+        }
+        c->A[l] = (ah<<4) | (al & 0x0F);
+    }
+    else {
+        /* default mode */
+        uint16_t sum = c->A[l] + val + (c->P[l] & M6502_CF ? 1:0);
+        c->P[l] &= ~(M6502_VF|M6502_CF);
+        c->P[l] = _M6502X_NZ(c->P[l],sum);
+        if (~(c->A[l]^val) & (c->A[l]^sum) & 0x80) {
+            c->P[l] |= M6502_VF;
+        }
+        if (sum & 0xFF00) {
+            c->P[l] |= M6502_CF;
+        }
+        c->A[l] = sum & 0xFF;
+    }
+}
+
+static inline void _m6502x_sbc(m6502x_t* c, int l, uint8_t val) {
+    if (c->bcd_enabled[l] && (c->P[l] & M6502_DF)) {
+        /* decimal mode (credit goes to MAME) */
+        uint8_t carry = c->P[l] & M6502_CF ? 0 : 1;
+        c->P[l] &= ~(M6502_NF|M6502_VF|M6502_ZF|M6502_CF);
+        uint16_t diff = c->A[l] - val - carry;
+        uint8_t al = (c->A[l] & 0x0F) - (val & 0x0F) - carry;
+        if ((int8_t)al < 0) {
+            al -= 6;
+        }
+        uint8_t ah = (c->A[l]>>4) - (val>>4) - ((int8_t)al < 0);
+        if (0 == (uint8_t)diff) {
+            c->P[l] |= M6502_ZF;
+        }
+        else if (diff & 0x80) {
+            c->P[l] |= M6502_NF;
+        }
+        if ((c->A[l]^val) & (c->A[l]^diff) & 0x80) {
+            c->P[l] |= M6502_VF;
+        }
+        if (!(diff & 0xFF00)) {
+            c->P[l] |= M6502_CF;
+        }
+        if (ah & 0x80) {
+            ah -= 6;
+        }
+        c->A[l] = (ah<<4) | (al & 0x0F);
+    }
+    else {
+        /* default mode */
+        uint16_t diff = c->A[l] - val - (c->P[l] & M6502_CF ? 0 : 1);
+        c->P[l] &= ~(M6502_VF|M6502_CF);
+        c->P[l] = _M6502X_NZ(c->P[l], (uint8_t)diff);
+        if ((c->A[l]^val) & (c->A[l]^diff) & 0x80) {
+            c->P[l] |= M6502_VF;
+        }
+        if (!(diff & 0xFF00)) {
+            c->P[l] |= M6502_CF;
+        }
+        c->A[l] = diff & 0xFF;
+    }
+}
+
+static inline void _m6502x_cmp(m6502x_t* c, int l, uint8_t r, uint8_t v) {
+    uint16_t t = r - v;
+    c->P[l] = (_M6502X_NZ(c->P[l], (uint8_t)t) & ~M6502_CF) | ((t & 0xFF00) ? 0:M6502_CF);
+}
+
+static inline uint8_t _m6502x_asl(m6502x_t* c, int l, uint8_t v) {
+    c->P[l] = (_M6502X_NZ(c->P[l], v<<1) & ~M6502_CF) | ((v & 0x80) ? M6502_CF:0);
+    return v<<1;
+}
+
+static inline uint8_t _m6502x_lsr(m6502x_t* c, int l, uint8_t v) {
+    c->P[l] = (_M6502X_NZ(c->P[l], v>>1) & ~M6502_CF) | ((v & 0x01) ? M6502_CF:0);
+    return v>>1;
+}
+
+static inline uint8_t _m6502x_rol(m6502x_t* c, int l, uint8_t v) {
+    bool carry = c->P[l] & M6502_CF;
+    c->P[l] &= ~(M6502_NF|M6502_ZF|M6502_CF);
+    if (v & 0x80) {
+        c->P[l] |= M6502_CF;
+    }
+    v <<= 1;
+    if (carry) {
+        v |= 1;
+    }
+    c->P[l] = _M6502X_NZ(c->P[l], v);
+    return v;
+}
+
+static inline uint8_t _m6502x_ror(m6502x_t* c, int l, uint8_t v) {
+    bool carry = c->P[l] & M6502_CF;
+    c->P[l] &= ~(M6502_NF|M6502_ZF|M6502_CF);
+    if (v & 1) {
+        c->P[l] |= M6502_CF;
+    }
+    v >>= 1;
+    if (carry) {
+        v |= 0x80;
+    }
+    c->P[l] = _M6502X_NZ(c->P[l], v);
+    return v;
+}
+
+static inline void _m6502x_bit(m6502x_t* c, int l, uint8_t v) {
+    uint8_t t = c->A[l] & v;
+    c->P[l] &= ~(M6502_NF|M6502_VF|M6502_ZF);
+    if (!t) {
+        c->P[l] |= M6502_ZF;
+    }
+    c->P[l] |= v & (M6502_NF|M6502_VF);
+}
+
+static inline void _m6502x_arr(m6502x_t* c, int l) {
+    /* undocumented, unreliable ARR instruction, but this is tested
+       by the Wolfgang Lorenz C64 test suite
+       implementation taken from MAME
+    */
+    if (c->bcd_enabled[l] && (c->P[l] & M6502_DF)) {
+        bool carry = c->P[l] & M6502_CF;
+        c->P[l] &= ~(M6502_NF|M6502_VF|M6502_ZF|M6502_CF);
+        uint8_t a = c->A[l]>>1;
+        if (carry) {
+            a |= 0x80;
+        }
+        c->P[l] = _M6502X_NZ(c->P[l],a);
+        if ((a ^ c->A[l]) & 0x40) {
+            c->P[l] |= M6502_VF;
+        }
+        if ((c->A[l] & 0xF) >= 5) {
+            a = ((a + 6) & 0xF) | (a & 0xF0);
+        }
+        if ((c->A[l] & 0xF0) >= 0x50) {
+            a += 0x60;
+            c->P[l] |= M6502_CF;
+        }
+        c->A[l] = a;
+    }
+    else {
+        bool carry = c->P[l] & M6502_CF;
+        c->P[l] &= ~(M6502_NF|M6502_VF|M6502_ZF|M6502_CF);
+        c->A[l] >>= 1;
+        if (carry) {
+            c->A[l] |= 0x80;
+        }
+        c->P[l] = _M6502X_NZ(c->P[l],c->A[l]);
+        if (c->A[l] & 0x40) {
+            c->P[l] |= M6502_VF|M6502_CF;
+        }
+        if (c->A[l] & 0x20) {
+            c->P[l] ^= M6502_VF;
+        }
+    }
+}
+
+/* undocumented SBX instruction:
+    AND X register with accumulator and store result in X register, then
+    subtract byte from X register (without borrow) where the
+    subtract works like a CMP instruction
+*/
+static inline void _m6502x_sbx(m6502x_t* c, int l, uint8_t v) {
+    uint16_t t = (c->A[l] & c->X[l]) - v;
+    c->P[l] = _M6502X_NZ(c->P[l], t) & ~M6502_CF;
+    if (!(t & 0xFF00)) {
+        c->P[l] |= M6502_CF;
+    }
+    c->X[l] = (uint8_t)t;
+}
+#undef _M6502X_NZ
+void m6502x_init(m6502x_t* c, const m6502_desc_t* desc, uint64_t* pins) {
+    CHIPS_ASSERT(c && desc && pins);
+    memset(c, 0, sizeof(*c));
+    for (int l = 0; l < M6502X_LANES; l++) {
+        c->P[l] = M6502_ZF;
+        c->bcd_enabled[l] = !desc->bcd_disabled;
+        c->PINS[l] = M6502_RW | M6502_SYNC | M6502_RES;
+        pins[l] = c->PINS[l];
+    }
+}
+
+void m6502x_get_lane(m6502x_t* c, int l, m6502_t* cpu) {
+    CHIPS_ASSERT(c && cpu && (l >= 0) && (l < M6502X_LANES));
+    memset(cpu, 0, sizeof(*cpu));
+    cpu->IR = c->IR[l];
+    cpu->PC = c->PC[l];
+    cpu->AD = c->AD[l];
+    cpu->A = c->A[l];
+    cpu->X = c->X[l];
+    cpu->Y = c->Y[l];
+    cpu->S = c->S[l];
+    cpu->P = c->P[l];
+    cpu->PINS = c->PINS[l];
+    cpu->irq_pip = c->irq_pip[l];
+    cpu->nmi_pip = c->nmi_pip[l];
+    cpu->brk_flags = c->brk_flags[l];
+    cpu->bcd_enabled = c->bcd_enabled[l];
+}
+
+void m6502x_set_lane(m6502x_t* c, int l, const m6502_t* cpu) {
+    CHIPS_ASSERT(c && cpu && (l >= 0) && (l < M6502X_LANES));
+    c->IR[l] = cpu->IR;
+    c->PC[l] = cpu->PC;
+    c->AD[l] = cpu->AD;
+    c->A[l] = cpu->A;
+    c->X[l] = cpu->X;
+    c->Y[l] = cpu->Y;
+    c->S[l] = cpu->S;
+    c->P[l] = cpu->P;
+    c->PINS[l] = cpu->PINS;
+    c->irq_pip[l] = cpu->irq_pip;
+    c->nmi_pip[l] = cpu->nmi_pip;
+    c->brk_flags[l] = cpu->brk_flags;
+    c->bcd_enabled[l] = cpu->bcd_enabled;
+}
+
+/* set 16-bit address in 64-bit pin mask */
+#define _SA(addr) pins[l]=(pins[l]&~0xFFFF)|((addr)&0xFFFFULL)
+/* extract 16-bit addess from pin mask */
+#define _GA() ((uint16_t)(pins[l]&0xFFFFULL))
+/* set 16-bit address and 8-bit data in 64-bit pin mask */
+#define _SAD(addr,data) pins[l]=(pins[l]&~0xFFFFFF)|((((data)&0xFF)<<16)&0xFF0000ULL)|((addr)&0xFFFFULL)
+/* fetch next opcode byte */
+#define _FETCH() _SA(c->PC[l]);_ON(M6502_SYNC);
+/* set 8-bit data in 64-bit pin mask */
+#define _SD(data) pins[l]=((pins[l]&~0xFF0000ULL)|(((data&0xFF)<<16)&0xFF0000ULL))
+/* extract 8-bit data from 64-bit pin mask */
+#define _GD() ((uint8_t)((pins[l]&0xFF0000ULL)>>16))
+/* enable control pins */
+#define _ON(m) pins[l]|=(m)
+/* disable control pins */
+#define _OFF(m) pins[l]&=~(m)
+/* a memory write tick */
+#define _WR() _OFF(M6502_RW);
+/* set N and Z flags depending on value */
+#define _NZ(v) c->P[l]=((c->P[l]&~(M6502_NF|M6502_ZF))|((v&0xFF)?(v&M6502_NF):M6502_ZF))
+/* execute a decoder step on all lanes in the 'lanes' mask */
+#define _LANES(...) for(int l=0;l<M6502X_LANES;l++){if(lanes&(1U<<l)){c->IR[l]++;__VA_ARGS__}}
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable:4244)   /* conversion from 'uint16_t' to 'uint8_t', possible loss of data */
+#endif
+
+void m6502x_tick(m6502x_t* c, uint64_t* pins) {
+    // interrupt and RDY handling, and instruction fetch (see m6502_tick() for details)
+    uint32_t active = _M6502X_ALL_LANES;
+    for (int l = 0; l < M6502X_LANES; l++) {
+        if (pins[l] & (M6502_SYNC|M6502_IRQ|M6502_NMI|M6502_RDY|M6502_RES)) {
+            if (0 != ((pins[l] & (pins[l] ^ c->PINS[l])) & M6502_NMI)) {
+                c->nmi_pip[l] |= 0x100;
+            }
+            if ((pins[l] & M6502_IRQ) && (0 == (c->P[l] & M6502_IF))) {
+                c->irq_pip[l] |= 0x100;
+            }
+            if ((pins[l] & (M6502_RW|M6502_RDY)) == (M6502_RW|M6502_RDY)) {
+                c->PINS[l] = pins[l];
+                c->irq_pip[l] <<= 1;
+                active &= ~(1U<<l);
+                continue;
+            }
+            if (pins[l] & M6502_SYNC) {
+                c->IR[l] = _GD()<<3;
+                _OFF(M6502_SYNC);
+                if (0 != (c->irq_pip[l] & 0x400)) {
+                    c->brk_flags[l] |= M6502_BRK_IRQ;
+                }
+                if (0 != (c->nmi_pip[l] & 0xFC00)) {
+                    c->brk_flags[l] |= M6502_BRK_NMI;
+                }
+                if (0 != (pins[l] & M6502_RES)) {
+                    c->brk_flags[l] |= M6502_BRK_RESET;
+                }
+                c->irq_pip[l] &= 0x3FF;
+                c->nmi_pip[l] &= 0x3FF;
+                if (c->brk_flags[l]) {
+                    c->IR[l] = 0;
+                    c->P[l] &= ~M6502_BF;
+                    pins[l] &= ~M6502_RES;
+                }
+                else {
+                    c->PC[l]++;
+                }
+            }
+        }
+        // reads are default, writes are special
+        _ON(M6502_RW);
+    }
+
+    // execute the decoder step for each group of lanes which are at the same decoder step
+    uint32_t pending = active;
+    while (pending) {
+        const uint16_t ir = c->IR[_m6502x_first_lane(pending)];
+        const uint32_t lanes = _m6502x_ir_lanes(c->IR, ir) & pending;
+        pending &= ~lanes;
+        switch (ir) {
+        // <% decoder
+    /* BRK  */
+        case (0x00<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x00<<3)|1: _LANES(if(0==(c->brk_flags[l]&(M6502_BRK_IRQ|M6502_BRK_NMI))){c->PC[l]++;}_SAD(0x0100|c->S[l]--,c->PC[l]>>8);if(0==(c->brk_flags[l]&M6502_BRK_RESET)){_WR();});break;
+        case (0x00<<3)|2: _LANES(_SAD(0x0100|c->S[l]--,c->PC[l]);if(0==(c->brk_flags[l]&M6502_BRK_RESET)){_WR();});break;
+        case (0x00<<3)|3: _LANES(_SAD(0x0100|c->S[l]--,c->P[l]|M6502_XF);if(c->brk_flags[l]&M6502_BRK_RESET){c->AD[l]=0xFFFC;}else{_WR();if(c->brk_flags[l]&M6502_BRK_NMI){c->AD[l]=0xFFFA;}else{c->AD[l]=0xFFFE;}});break;
+        case (0x00<<3)|4: _LANES(_SA(c->AD[l]++);c->P[l]|=(M6502_IF|M6502_BF);c->brk_flags[l]=0; /* RES/NMI hijacking */);break;
+        case (0x00<<3)|5: _LANES(_SA(c->AD[l]);c->AD[l]=_GD(); /* NMI "half-hijacking" not possible */);break;
+        case (0x00<<3)|6: _LANES(c->PC[l]=(_GD()<<8)|c->AD[l];_FETCH(););break;
+        case (0x00<<3)|7: assert(false);break;
+    /* ORA (zp,X) */
+        case (0x01<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x01<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x01<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0x01<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x01<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x01<<3)|5: _LANES(c->A[l]|=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x01<<3)|6: assert(false);break;
+        case (0x01<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0x02<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x02<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0x02<<3)|2: assert(false);break;
+        case (0x02<<3)|3: assert(false);break;
+        case (0x02<<3)|4: assert(false);break;
+        case (0x02<<3)|5: assert(false);break;
+        case (0x02<<3)|6: assert(false);break;
+        case (0x02<<3)|7: assert(false);break;
+    /* SLO (zp,X) (undoc) */
+        case (0x03<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x03<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x03<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0x03<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x03<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x03<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x03<<3)|6: _LANES(c->AD[l]=_m6502x_asl(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]|=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x03<<3)|7: _LANES(_FETCH(););break;
+    /* NOP zp (undoc) */
+        case (0x04<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x04<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x04<<3)|2: _LANES(_FETCH(););break;
+        case (0x04<<3)|3: assert(false);break;
+        case (0x04<<3)|4: assert(false);break;
+        case (0x04<<3)|5: assert(false);break;
+        case (0x04<<3)|6: assert(false);break;
+        case (0x04<<3)|7: assert(false);break;
+    /* ORA zp */
+        case (0x05<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x05<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x05<<3)|2: _LANES(c->A[l]|=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x05<<3)|3: assert(false);break;
+        case (0x05<<3)|4: assert(false);break;
+        case (0x05<<3)|5: assert(false);break;
+        case (0x05<<3)|6: assert(false);break;
+        case (0x05<<3)|7: assert(false);break;
+    /* ASL zp */
+        case (0x06<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x06<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x06<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x06<<3)|3: _LANES(_SD(_m6502x_asl(c,l,c->AD[l]));_WR(););break;
+        case (0x06<<3)|4: _LANES(_FETCH(););break;
+        case (0x06<<3)|5: assert(false);break;
+        case (0x06<<3)|6: assert(false);break;
+        case (0x06<<3)|7: assert(false);break;
+    /* SLO zp (undoc) */
+        case (0x07<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x07<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x07<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x07<<3)|3: _LANES(c->AD[l]=_m6502x_asl(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]|=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x07<<3)|4: _LANES(_FETCH(););break;
+        case (0x07<<3)|5: assert(false);break;
+        case (0x07<<3)|6: assert(false);break;
+        case (0x07<<3)|7: assert(false);break;
+    /* PHP  */
+        case (0x08<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x08<<3)|1: _LANES(_SAD(0x0100|c->S[l]--,c->P[l]|M6502_XF);_WR(););break;
+        case (0x08<<3)|2: _LANES(_FETCH(););break;
+        case (0x08<<3)|3: assert(false);break;
+        case (0x08<<3)|4: assert(false);break;
+        case (0x08<<3)|5: assert(false);break;
+        case (0x08<<3)|6: assert(false);break;
+        case (0x08<<3)|7: assert(false);break;
+    /* ORA # */
+        case (0x09<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x09<<3)|1: _LANES(c->A[l]|=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x09<<3)|2: assert(false);break;
+        case (0x09<<3)|3: assert(false);break;
+        case (0x09<<3)|4: assert(false);break;
+        case (0x09<<3)|5: assert(false);break;
+        case (0x09<<3)|6: assert(false);break;
+        case (0x09<<3)|7: assert(false);break;
+    /* ASLA  */
+        case (0x0A<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x0A<<3)|1: _LANES(c->A[l]=_m6502x_asl(c,l,c->A[l]);_FETCH(););break;
+        case (0x0A<<3)|2: assert(false);break;
+        case (0x0A<<3)|3: assert(false);break;
+        case (0x0A<<3)|4: assert(false);break;
+        case (0x0A<<3)|5: assert(false);break;
+        case (0x0A<<3)|6: assert(false);break;
+        case (0x0A<<3)|7: assert(false);break;
+    /* ANC # (undoc) */
+        case (0x0B<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x0B<<3)|1: _LANES(c->A[l]&=_GD();_NZ(c->A[l]);if(c->A[l]&0x80){c->P[l]|=M6502_CF;}else{c->P[l]&=~M6502_CF;}_FETCH(););break;
+        case (0x0B<<3)|2: assert(false);break;
+        case (0x0B<<3)|3: assert(false);break;
+        case (0x0B<<3)|4: assert(false);break;
+        case (0x0B<<3)|5: assert(false);break;
+        case (0x0B<<3)|6: assert(false);break;
+        case (0x0B<<3)|7: assert(false);break;
+    /* NOP abs (undoc) */
+        case (0x0C<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x0C<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x0C<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x0C<<3)|3: _LANES(_FETCH(););break;
+        case (0x0C<<3)|4: assert(false);break;
+        case (0x0C<<3)|5: assert(false);break;
+        case (0x0C<<3)|6: assert(false);break;
+        case (0x0C<<3)|7: assert(false);break;
+    /* ORA abs */
+        case (0x0D<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x0D<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x0D<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x0D<<3)|3: _LANES(c->A[l]|=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x0D<<3)|4: assert(false);break;
+        case (0x0D<<3)|5: assert(false);break;
+        case (0x0D<<3)|6: assert(false);break;
+        case (0x0D<<3)|7: assert(false);break;
+    /* ASL abs */
+        case (0x0E<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x0E<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x0E<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x0E<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x0E<<3)|4: _LANES(_SD(_m6502x_asl(c,l,c->AD[l]));_WR(););break;
+        case (0x0E<<3)|5: _LANES(_FETCH(););break;
+        case (0x0E<<3)|6: assert(false);break;
+        case (0x0E<<3)|7: assert(false);break;
+    /* SLO abs (undoc) */
+        case (0x0F<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x0F<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x0F<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x0F<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x0F<<3)|4: _LANES(c->AD[l]=_m6502x_asl(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]|=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x0F<<3)|5: _LANES(_FETCH(););break;
+        case (0x0F<<3)|6: assert(false);break;
+        case (0x0F<<3)|7: assert(false);break;
+    /* BPL # */
+        case (0x10<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x10<<3)|1: _LANES(_SA(c->PC[l]);c->AD[l]=c->PC[l]+(int8_t)_GD();if((c->P[l]&0x80)!=0x0){_FETCH();};);break;
+        case (0x10<<3)|2: _LANES(_SA((c->PC[l]&0xFF00)|(c->AD[l]&0x00FF));if((c->AD[l]&0xFF00)==(c->PC[l]&0xFF00)){c->PC[l]=c->AD[l];c->irq_pip[l]>>=1;c->nmi_pip[l]>>=1;_FETCH();};);break;
+        case (0x10<<3)|3: _LANES(c->PC[l]=c->AD[l];_FETCH(););break;
+        case (0x10<<3)|4: assert(false);break;
+        case (0x10<<3)|5: assert(false);break;
+        case (0x10<<3)|6: assert(false);break;
+        case (0x10<<3)|7: assert(false);break;
+    /* ORA (zp),Y */
+        case (0x11<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x11<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x11<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x11<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0x11<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x11<<3)|5: _LANES(c->A[l]|=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x11<<3)|6: assert(false);break;
+        case (0x11<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0x12<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x12<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0x12<<3)|2: assert(false);break;
+        case (0x12<<3)|3: assert(false);break;
+        case (0x12<<3)|4: assert(false);break;
+        case (0x12<<3)|5: assert(false);break;
+        case (0x12<<3)|6: assert(false);break;
+        case (0x12<<3)|7: assert(false);break;
+    /* SLO (zp),Y (undoc) */
+        case (0x13<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x13<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x13<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x13<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x13<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x13<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x13<<3)|6: _LANES(c->AD[l]=_m6502x_asl(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]|=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x13<<3)|7: _LANES(_FETCH(););break;
+    /* NOP zp,X (undoc) */
+        case (0x14<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x14<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x14<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x14<<3)|3: _LANES(_FETCH(););break;
+        case (0x14<<3)|4: assert(false);break;
+        case (0x14<<3)|5: assert(false);break;
+        case (0x14<<3)|6: assert(false);break;
+        case (0x14<<3)|7: assert(false);break;
+    /* ORA zp,X */
+        case (0x15<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x15<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x15<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x15<<3)|3: _LANES(c->A[l]|=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x15<<3)|4: assert(false);break;
+        case (0x15<<3)|5: assert(false);break;
+        case (0x15<<3)|6: assert(false);break;
+        case (0x15<<3)|7: assert(false);break;
+    /* ASL zp,X */
+        case (0x16<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x16<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x16<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x16<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x16<<3)|4: _LANES(_SD(_m6502x_asl(c,l,c->AD[l]));_WR(););break;
+        case (0x16<<3)|5: _LANES(_FETCH(););break;
+        case (0x16<<3)|6: assert(false);break;
+        case (0x16<<3)|7: assert(false);break;
+    /* SLO zp,X (undoc) */
+        case (0x17<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x17<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x17<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x17<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x17<<3)|4: _LANES(c->AD[l]=_m6502x_asl(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]|=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x17<<3)|5: _LANES(_FETCH(););break;
+        case (0x17<<3)|6: assert(false);break;
+        case (0x17<<3)|7: assert(false);break;
+    /* CLC  */
+        case (0x18<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x18<<3)|1: _LANES(c->P[l]&=~0x1;_FETCH(););break;
+        case (0x18<<3)|2: assert(false);break;
+        case (0x18<<3)|3: assert(false);break;
+        case (0x18<<3)|4: assert(false);break;
+        case (0x18<<3)|5: assert(false);break;
+        case (0x18<<3)|6: assert(false);break;
+        case (0x18<<3)|7: assert(false);break;
+    /* ORA abs,Y */
+        case (0x19<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x19<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x19<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0x19<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x19<<3)|4: _LANES(c->A[l]|=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x19<<3)|5: assert(false);break;
+        case (0x19<<3)|6: assert(false);break;
+        case (0x19<<3)|7: assert(false);break;
+    /* NOP  (undoc) */
+        case (0x1A<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x1A<<3)|1: _LANES(_FETCH(););break;
+        case (0x1A<<3)|2: assert(false);break;
+        case (0x1A<<3)|3: assert(false);break;
+        case (0x1A<<3)|4: assert(false);break;
+        case (0x1A<<3)|5: assert(false);break;
+        case (0x1A<<3)|6: assert(false);break;
+        case (0x1A<<3)|7: assert(false);break;
+    /* SLO abs,Y (undoc) */
+        case (0x1B<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x1B<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x1B<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x1B<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x1B<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x1B<<3)|5: _LANES(c->AD[l]=_m6502x_asl(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]|=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x1B<<3)|6: _LANES(_FETCH(););break;
+        case (0x1B<<3)|7: assert(false);break;
+    /* NOP abs,X (undoc) */
+        case (0x1C<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x1C<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x1C<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0x1C<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x1C<<3)|4: _LANES(_FETCH(););break;
+        case (0x1C<<3)|5: assert(false);break;
+        case (0x1C<<3)|6: assert(false);break;
+        case (0x1C<<3)|7: assert(false);break;
+    /* ORA abs,X */
+        case (0x1D<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x1D<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x1D<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0x1D<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x1D<<3)|4: _LANES(c->A[l]|=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x1D<<3)|5: assert(false);break;
+        case (0x1D<<3)|6: assert(false);break;
+        case (0x1D<<3)|7: assert(false);break;
+    /* ASL abs,X */
+        case (0x1E<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x1E<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x1E<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0x1E<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x1E<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x1E<<3)|5: _LANES(_SD(_m6502x_asl(c,l,c->AD[l]));_WR(););break;
+        case (0x1E<<3)|6: _LANES(_FETCH(););break;
+        case (0x1E<<3)|7: assert(false);break;
+    /* SLO abs,X (undoc) */
+        case (0x1F<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x1F<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x1F<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0x1F<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x1F<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x1F<<3)|5: _LANES(c->AD[l]=_m6502x_asl(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]|=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x1F<<3)|6: _LANES(_FETCH(););break;
+        case (0x1F<<3)|7: assert(false);break;
+    /* JSR  */
+        case (0x20<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x20<<3)|1: _LANES(_SA(0x0100|c->S[l]);c->AD[l]=_GD(););break;
+        case (0x20<<3)|2: _LANES(_SAD(0x0100|c->S[l]--,c->PC[l]>>8);_WR(););break;
+        case (0x20<<3)|3: _LANES(_SAD(0x0100|c->S[l]--,c->PC[l]);_WR(););break;
+        case (0x20<<3)|4: _LANES(_SA(c->PC[l]););break;
+        case (0x20<<3)|5: _LANES(c->PC[l]=(_GD()<<8)|c->AD[l];_FETCH(););break;
+        case (0x20<<3)|6: assert(false);break;
+        case (0x20<<3)|7: assert(false);break;
+    /* AND (zp,X) */
+        case (0x21<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x21<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x21<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0x21<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x21<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x21<<3)|5: _LANES(c->A[l]&=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x21<<3)|6: assert(false);break;
+        case (0x21<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0x22<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x22<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0x22<<3)|2: assert(false);break;
+        case (0x22<<3)|3: assert(false);break;
+        case (0x22<<3)|4: assert(false);break;
+        case (0x22<<3)|5: assert(false);break;
+        case (0x22<<3)|6: assert(false);break;
+        case (0x22<<3)|7: assert(false);break;
+    /* RLA (zp,X) (undoc) */
+        case (0x23<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x23<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x23<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0x23<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x23<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x23<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x23<<3)|6: _LANES(c->AD[l]=_m6502x_rol(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]&=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x23<<3)|7: _LANES(_FETCH(););break;
+    /* BIT zp */
+        case (0x24<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x24<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x24<<3)|2: _LANES(_m6502x_bit(c,l,_GD());_FETCH(););break;
+        case (0x24<<3)|3: assert(false);break;
+        case (0x24<<3)|4: assert(false);break;
+        case (0x24<<3)|5: assert(false);break;
+        case (0x24<<3)|6: assert(false);break;
+        case (0x24<<3)|7: assert(false);break;
+    /* AND zp */
+        case (0x25<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x25<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x25<<3)|2: _LANES(c->A[l]&=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x25<<3)|3: assert(false);break;
+        case (0x25<<3)|4: assert(false);break;
+        case (0x25<<3)|5: assert(false);break;
+        case (0x25<<3)|6: assert(false);break;
+        case (0x25<<3)|7: assert(false);break;
+    /* ROL zp */
+        case (0x26<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x26<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x26<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x26<<3)|3: _LANES(_SD(_m6502x_rol(c,l,c->AD[l]));_WR(););break;
+        case (0x26<<3)|4: _LANES(_FETCH(););break;
+        case (0x26<<3)|5: assert(false);break;
+        case (0x26<<3)|6: assert(false);break;
+        case (0x26<<3)|7: assert(false);break;
+    /* RLA zp (undoc) */
+        case (0x27<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x27<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x27<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x27<<3)|3: _LANES(c->AD[l]=_m6502x_rol(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]&=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x27<<3)|4: _LANES(_FETCH(););break;
+        case (0x27<<3)|5: assert(false);break;
+        case (0x27<<3)|6: assert(false);break;
+        case (0x27<<3)|7: assert(false);break;
+    /* PLP  */
+        case (0x28<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x28<<3)|1: _LANES(_SA(0x0100|c->S[l]++););break;
+        case (0x28<<3)|2: _LANES(_SA(0x0100|c->S[l]););break;
+        case (0x28<<3)|3: _LANES(c->P[l]=(_GD()|M6502_BF)&~M6502_XF;_FETCH(););break;
+        case (0x28<<3)|4: assert(false);break;
+        case (0x28<<3)|5: assert(false);break;
+        case (0x28<<3)|6: assert(false);break;
+        case (0x28<<3)|7: assert(false);break;
+    /* AND # */
+        case (0x29<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x29<<3)|1: _LANES(c->A[l]&=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x29<<3)|2: assert(false);break;
+        case (0x29<<3)|3: assert(false);break;
+        case (0x29<<3)|4: assert(false);break;
+        case (0x29<<3)|5: assert(false);break;
+        case (0x29<<3)|6: assert(false);break;
+        case (0x29<<3)|7: assert(false);break;
+    /* ROLA  */
+        case (0x2A<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x2A<<3)|1: _LANES(c->A[l]=_m6502x_rol(c,l,c->A[l]);_FETCH(););break;
+        case (0x2A<<3)|2: assert(false);break;
+        case (0x2A<<3)|3: assert(false);break;
+        case (0x2A<<3)|4: assert(false);break;
+        case (0x2A<<3)|5: assert(false);break;
+        case (0x2A<<3)|6: assert(false);break;
+        case (0x2A<<3)|7: assert(false);break;
+    /* ANC # (undoc) */
+        case (0x2B<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x2B<<3)|1: _LANES(c->A[l]&=_GD();_NZ(c->A[l]);if(c->A[l]&0x80){c->P[l]|=M6502_CF;}else{c->P[l]&=~M6502_CF;}_FETCH(););break;
+        case (0x2B<<3)|2: assert(false);break;
+        case (0x2B<<3)|3: assert(false);break;
+        case (0x2B<<3)|4: assert(false);break;
+        case (0x2B<<3)|5: assert(false);break;
+        case (0x2B<<3)|6: assert(false);break;
+        case (0x2B<<3)|7: assert(false);break;
+    /* BIT abs */
+        case (0x2C<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x2C<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x2C<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x2C<<3)|3: _LANES(_m6502x_bit(c,l,_GD());_FETCH(););break;
+        case (0x2C<<3)|4: assert(false);break;
+        case (0x2C<<3)|5: assert(false);break;
+        case (0x2C<<3)|6: assert(false);break;
+        case (0x2C<<3)|7: assert(false);break;
+    /* AND abs */
+        case (0x2D<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x2D<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x2D<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x2D<<3)|3: _LANES(c->A[l]&=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x2D<<3)|4: assert(false);break;
+        case (0x2D<<3)|5: assert(false);break;
+        case (0x2D<<3)|6: assert(false);break;
+        case (0x2D<<3)|7: assert(false);break;
+    /* ROL abs */
+        case (0x2E<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x2E<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x2E<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x2E<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x2E<<3)|4: _LANES(_SD(_m6502x_rol(c,l,c->AD[l]));_WR(););break;
+        case (0x2E<<3)|5: _LANES(_FETCH(););break;
+        case (0x2E<<3)|6: assert(false);break;
+        case (0x2E<<3)|7: assert(false);break;
+    /* RLA abs (undoc) */
+        case (0x2F<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x2F<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x2F<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x2F<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x2F<<3)|4: _LANES(c->AD[l]=_m6502x_rol(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]&=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x2F<<3)|5: _LANES(_FETCH(););break;
+        case (0x2F<<3)|6: assert(false);break;
+        case (0x2F<<3)|7: assert(false);break;
+    /* BMI # */
+        case (0x30<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x30<<3)|1: _LANES(_SA(c->PC[l]);c->AD[l]=c->PC[l]+(int8_t)_GD();if((c->P[l]&0x80)!=0x80){_FETCH();};);break;
+        case (0x30<<3)|2: _LANES(_SA((c->PC[l]&0xFF00)|(c->AD[l]&0x00FF));if((c->AD[l]&0xFF00)==(c->PC[l]&0xFF00)){c->PC[l]=c->AD[l];c->irq_pip[l]>>=1;c->nmi_pip[l]>>=1;_FETCH();};);break;
+        case (0x30<<3)|3: _LANES(c->PC[l]=c->AD[l];_FETCH(););break;
+        case (0x30<<3)|4: assert(false);break;
+        case (0x30<<3)|5: assert(false);break;
+        case (0x30<<3)|6: assert(false);break;
+        case (0x30<<3)|7: assert(false);break;
+    /* AND (zp),Y */
+        case (0x31<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x31<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x31<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x31<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0x31<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x31<<3)|5: _LANES(c->A[l]&=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x31<<3)|6: assert(false);break;
+        case (0x31<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0x32<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x32<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0x32<<3)|2: assert(false);break;
+        case (0x32<<3)|3: assert(false);break;
+        case (0x32<<3)|4: assert(false);break;
+        case (0x32<<3)|5: assert(false);break;
+        case (0x32<<3)|6: assert(false);break;
+        case (0x32<<3)|7: assert(false);break;
+    /* RLA (zp),Y (undoc) */
+        case (0x33<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x33<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x33<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x33<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x33<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x33<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x33<<3)|6: _LANES(c->AD[l]=_m6502x_rol(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]&=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x33<<3)|7: _LANES(_FETCH(););break;
+    /* NOP zp,X (undoc) */
+        case (0x34<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x34<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x34<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x34<<3)|3: _LANES(_FETCH(););break;
+        case (0x34<<3)|4: assert(false);break;
+        case (0x34<<3)|5: assert(false);break;
+        case (0x34<<3)|6: assert(false);break;
+        case (0x34<<3)|7: assert(false);break;
+    /* AND zp,X */
+        case (0x35<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x35<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x35<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x35<<3)|3: _LANES(c->A[l]&=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x35<<3)|4: assert(false);break;
+        case (0x35<<3)|5: assert(false);break;
+        case (0x35<<3)|6: assert(false);break;
+        case (0x35<<3)|7: assert(false);break;
+    /* ROL zp,X */
+        case (0x36<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x36<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x36<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x36<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x36<<3)|4: _LANES(_SD(_m6502x_rol(c,l,c->AD[l]));_WR(););break;
+        case (0x36<<3)|5: _LANES(_FETCH(););break;
+        case (0x36<<3)|6: assert(false);break;
+        case (0x36<<3)|7: assert(false);break;
+    /* RLA zp,X (undoc) */
+        case (0x37<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x37<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x37<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x37<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x37<<3)|4: _LANES(c->AD[l]=_m6502x_rol(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]&=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x37<<3)|5: _LANES(_FETCH(););break;
+        case (0x37<<3)|6: assert(false);break;
+        case (0x37<<3)|7: assert(false);break;
+    /* SEC  */
+        case (0x38<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x38<<3)|1: _LANES(c->P[l]|=0x1;_FETCH(););break;
+        case (0x38<<3)|2: assert(false);break;
+        case (0x38<<3)|3: assert(false);break;
+        case (0x38<<3)|4: assert(false);break;
+        case (0x38<<3)|5: assert(false);break;
+        case (0x38<<3)|6: assert(false);break;
+        case (0x38<<3)|7: assert(false);break;
+    /* AND abs,Y */
+        case (0x39<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x39<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x39<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0x39<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x39<<3)|4: _LANES(c->A[l]&=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x39<<3)|5: assert(false);break;
+        case (0x39<<3)|6: assert(false);break;
+        case (0x39<<3)|7: assert(false);break;
+    /* NOP  (undoc) */
+        case (0x3A<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x3A<<3)|1: _LANES(_FETCH(););break;
+        case (0x3A<<3)|2: assert(false);break;
+        case (0x3A<<3)|3: assert(false);break;
+        case (0x3A<<3)|4: assert(false);break;
+        case (0x3A<<3)|5: assert(false);break;
+        case (0x3A<<3)|6: assert(false);break;
+        case (0x3A<<3)|7: assert(false);break;
+    /* RLA abs,Y (undoc) */
+        case (0x3B<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x3B<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x3B<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x3B<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x3B<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x3B<<3)|5: _LANES(c->AD[l]=_m6502x_rol(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]&=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x3B<<3)|6: _LANES(_FETCH(););break;
+        case (0x3B<<3)|7: assert(false);break;
+    /* NOP abs,X (undoc) */
+        case (0x3C<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x3C<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x3C<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0x3C<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x3C<<3)|4: _LANES(_FETCH(););break;
+        case (0x3C<<3)|5: assert(false);break;
+        case (0x3C<<3)|6: assert(false);break;
+        case (0x3C<<3)|7: assert(false);break;
+    /* AND abs,X */
+        case (0x3D<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x3D<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x3D<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0x3D<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x3D<<3)|4: _LANES(c->A[l]&=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x3D<<3)|5: assert(false);break;
+        case (0x3D<<3)|6: assert(false);break;
+        case (0x3D<<3)|7: assert(false);break;
+    /* ROL abs,X */
+        case (0x3E<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x3E<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x3E<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0x3E<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x3E<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x3E<<3)|5: _LANES(_SD(_m6502x_rol(c,l,c->AD[l]));_WR(););break;
+        case (0x3E<<3)|6: _LANES(_FETCH(););break;
+        case (0x3E<<3)|7: assert(false);break;
+    /* RLA abs,X (undoc) */
+        case (0x3F<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x3F<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x3F<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0x3F<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x3F<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x3F<<3)|5: _LANES(c->AD[l]=_m6502x_rol(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]&=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x3F<<3)|6: _LANES(_FETCH(););break;
+        case (0x3F<<3)|7: assert(false);break;
+    /* RTI  */
+        case (0x40<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x40<<3)|1: _LANES(_SA(0x0100|c->S[l]++););break;
+        case (0x40<<3)|2: _LANES(_SA(0x0100|c->S[l]++););break;
+        case (0x40<<3)|3: _LANES(_SA(0x0100|c->S[l]++);c->P[l]=(_GD()|M6502_BF)&~M6502_XF;);break;
+        case (0x40<<3)|4: _LANES(_SA(0x0100|c->S[l]);c->AD[l]=_GD(););break;
+        case (0x40<<3)|5: _LANES(c->PC[l]=(_GD()<<8)|c->AD[l];_FETCH(););break;
+        case (0x40<<3)|6: assert(false);break;
+        case (0x40<<3)|7: assert(false);break;
+    /* EOR (zp,X) */
+        case (0x41<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x41<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x41<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0x41<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x41<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x41<<3)|5: _LANES(c->A[l]^=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x41<<3)|6: assert(false);break;
+        case (0x41<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0x42<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x42<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0x42<<3)|2: assert(false);break;
+        case (0x42<<3)|3: assert(false);break;
+        case (0x42<<3)|4: assert(false);break;
+        case (0x42<<3)|5: assert(false);break;
+        case (0x42<<3)|6: assert(false);break;
+        case (0x42<<3)|7: assert(false);break;
+    /* SRE (zp,X) (undoc) */
+        case (0x43<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x43<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x43<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0x43<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x43<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x43<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x43<<3)|6: _LANES(c->AD[l]=_m6502x_lsr(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]^=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x43<<3)|7: _LANES(_FETCH(););break;
+    /* NOP zp (undoc) */
+        case (0x44<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x44<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x44<<3)|2: _LANES(_FETCH(););break;
+        case (0x44<<3)|3: assert(false);break;
+        case (0x44<<3)|4: assert(false);break;
+        case (0x44<<3)|5: assert(false);break;
+        case (0x44<<3)|6: assert(false);break;
+        case (0x44<<3)|7: assert(false);break;
+    /* EOR zp */
+        case (0x45<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x45<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x45<<3)|2: _LANES(c->A[l]^=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x45<<3)|3: assert(false);break;
+        case (0x45<<3)|4: assert(false);break;
+        case (0x45<<3)|5: assert(false);break;
+        case (0x45<<3)|6: assert(false);break;
+        case (0x45<<3)|7: assert(false);break;
+    /* LSR zp */
+        case (0x46<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x46<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x46<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x46<<3)|3: _LANES(_SD(_m6502x_lsr(c,l,c->AD[l]));_WR(););break;
+        case (0x46<<3)|4: _LANES(_FETCH(););break;
+        case (0x46<<3)|5: assert(false);break;
+        case (0x46<<3)|6: assert(false);break;
+        case (0x46<<3)|7: assert(false);break;
+    /* SRE zp (undoc) */
+        case (0x47<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x47<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x47<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x47<<3)|3: _LANES(c->AD[l]=_m6502x_lsr(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]^=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x47<<3)|4: _LANES(_FETCH(););break;
+        case (0x47<<3)|5: assert(false);break;
+        case (0x47<<3)|6: assert(false);break;
+        case (0x47<<3)|7: assert(false);break;
+    /* PHA  */
+        case (0x48<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x48<<3)|1: _LANES(_SAD(0x0100|c->S[l]--,c->A[l]);_WR(););break;
+        case (0x48<<3)|2: _LANES(_FETCH(););break;
+        case (0x48<<3)|3: assert(false);break;
+        case (0x48<<3)|4: assert(false);break;
+        case (0x48<<3)|5: assert(false);break;
+        case (0x48<<3)|6: assert(false);break;
+        case (0x48<<3)|7: assert(false);break;
+    /* EOR # */
+        case (0x49<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x49<<3)|1: _LANES(c->A[l]^=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x49<<3)|2: assert(false);break;
+        case (0x49<<3)|3: assert(false);break;
+        case (0x49<<3)|4: assert(false);break;
+        case (0x49<<3)|5: assert(false);break;
+        case (0x49<<3)|6: assert(false);break;
+        case (0x49<<3)|7: assert(false);break;
+    /* LSRA  */
+        case (0x4A<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x4A<<3)|1: _LANES(c->A[l]=_m6502x_lsr(c,l,c->A[l]);_FETCH(););break;
+        case (0x4A<<3)|2: assert(false);break;
+        case (0x4A<<3)|3: assert(false);break;
+        case (0x4A<<3)|4: assert(false);break;
+        case (0x4A<<3)|5: assert(false);break;
+        case (0x4A<<3)|6: assert(false);break;
+        case (0x4A<<3)|7: assert(false);break;
+    /* ASR # (undoc) */
+        case (0x4B<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x4B<<3)|1: _LANES(c->A[l]&=_GD();c->A[l]=_m6502x_lsr(c,l,c->A[l]);_FETCH(););break;
+        case (0x4B<<3)|2: assert(false);break;
+        case (0x4B<<3)|3: assert(false);break;
+        case (0x4B<<3)|4: assert(false);break;
+        case (0x4B<<3)|5: assert(false);break;
+        case (0x4B<<3)|6: assert(false);break;
+        case (0x4B<<3)|7: assert(false);break;
+    /* JMP  */
+        case (0x4C<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x4C<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x4C<<3)|2: _LANES(c->PC[l]=(_GD()<<8)|c->AD[l];_FETCH(););break;
+        case (0x4C<<3)|3: assert(false);break;
+        case (0x4C<<3)|4: assert(false);break;
+        case (0x4C<<3)|5: assert(false);break;
+        case (0x4C<<3)|6: assert(false);break;
+        case (0x4C<<3)|7: assert(false);break;
+    /* EOR abs */
+        case (0x4D<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x4D<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x4D<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x4D<<3)|3: _LANES(c->A[l]^=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x4D<<3)|4: assert(false);break;
+        case (0x4D<<3)|5: assert(false);break;
+        case (0x4D<<3)|6: assert(false);break;
+        case (0x4D<<3)|7: assert(false);break;
+    /* LSR abs */
+        case (0x4E<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x4E<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x4E<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x4E<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x4E<<3)|4: _LANES(_SD(_m6502x_lsr(c,l,c->AD[l]));_WR(););break;
+        case (0x4E<<3)|5: _LANES(_FETCH(););break;
+        case (0x4E<<3)|6: assert(false);break;
+        case (0x4E<<3)|7: assert(false);break;
+    /* SRE abs (undoc) */
+        case (0x4F<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x4F<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x4F<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x4F<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x4F<<3)|4: _LANES(c->AD[l]=_m6502x_lsr(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]^=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x4F<<3)|5: _LANES(_FETCH(););break;
+        case (0x4F<<3)|6: assert(false);break;
+        case (0x4F<<3)|7: assert(false);break;
+    /* BVC # */
+        case (0x50<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x50<<3)|1: _LANES(_SA(c->PC[l]);c->AD[l]=c->PC[l]+(int8_t)_GD();if((c->P[l]&0x40)!=0x0){_FETCH();};);break;
+        case (0x50<<3)|2: _LANES(_SA((c->PC[l]&0xFF00)|(c->AD[l]&0x00FF));if((c->AD[l]&0xFF00)==(c->PC[l]&0xFF00)){c->PC[l]=c->AD[l];c->irq_pip[l]>>=1;c->nmi_pip[l]>>=1;_FETCH();};);break;
+        case (0x50<<3)|3: _LANES(c->PC[l]=c->AD[l];_FETCH(););break;
+        case (0x50<<3)|4: assert(false);break;
+        case (0x50<<3)|5: assert(false);break;
+        case (0x50<<3)|6: assert(false);break;
+        case (0x50<<3)|7: assert(false);break;
+    /* EOR (zp),Y */
+        case (0x51<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x51<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x51<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x51<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0x51<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x51<<3)|5: _LANES(c->A[l]^=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x51<<3)|6: assert(false);break;
+        case (0x51<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0x52<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x52<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0x52<<3)|2: assert(false);break;
+        case (0x52<<3)|3: assert(false);break;
+        case (0x52<<3)|4: assert(false);break;
+        case (0x52<<3)|5: assert(false);break;
+        case (0x52<<3)|6: assert(false);break;
+        case (0x52<<3)|7: assert(false);break;
+    /* SRE (zp),Y (undoc) */
+        case (0x53<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x53<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x53<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x53<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x53<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x53<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x53<<3)|6: _LANES(c->AD[l]=_m6502x_lsr(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]^=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x53<<3)|7: _LANES(_FETCH(););break;
+    /* NOP zp,X (undoc) */
+        case (0x54<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x54<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x54<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x54<<3)|3: _LANES(_FETCH(););break;
+        case (0x54<<3)|4: assert(false);break;
+        case (0x54<<3)|5: assert(false);break;
+        case (0x54<<3)|6: assert(false);break;
+        case (0x54<<3)|7: assert(false);break;
+    /* EOR zp,X */
+        case (0x55<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x55<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x55<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x55<<3)|3: _LANES(c->A[l]^=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x55<<3)|4: assert(false);break;
+        case (0x55<<3)|5: assert(false);break;
+        case (0x55<<3)|6: assert(false);break;
+        case (0x55<<3)|7: assert(false);break;
+    /* LSR zp,X */
+        case (0x56<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x56<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x56<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x56<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x56<<3)|4: _LANES(_SD(_m6502x_lsr(c,l,c->AD[l]));_WR(););break;
+        case (0x56<<3)|5: _LANES(_FETCH(););break;
+        case (0x56<<3)|6: assert(false);break;
+        case (0x56<<3)|7: assert(false);break;
+    /* SRE zp,X (undoc) */
+        case (0x57<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x57<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x57<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x57<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x57<<3)|4: _LANES(c->AD[l]=_m6502x_lsr(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]^=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x57<<3)|5: _LANES(_FETCH(););break;
+        case (0x57<<3)|6: assert(false);break;
+        case (0x57<<3)|7: assert(false);break;
+    /* CLI  */
+        case (0x58<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x58<<3)|1: _LANES(c->P[l]&=~0x4;_FETCH(););break;
+        case (0x58<<3)|2: assert(false);break;
+        case (0x58<<3)|3: assert(false);break;
+        case (0x58<<3)|4: assert(false);break;
+        case (0x58<<3)|5: assert(false);break;
+        case (0x58<<3)|6: assert(false);break;
+        case (0x58<<3)|7: assert(false);break;
+    /* EOR abs,Y */
+        case (0x59<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x59<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x59<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0x59<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x59<<3)|4: _LANES(c->A[l]^=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x59<<3)|5: assert(false);break;
+        case (0x59<<3)|6: assert(false);break;
+        case (0x59<<3)|7: assert(false);break;
+    /* NOP  (undoc) */
+        case (0x5A<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x5A<<3)|1: _LANES(_FETCH(););break;
+        case (0x5A<<3)|2: assert(false);break;
+        case (0x5A<<3)|3: assert(false);break;
+        case (0x5A<<3)|4: assert(false);break;
+        case (0x5A<<3)|5: assert(false);break;
+        case (0x5A<<3)|6: assert(false);break;
+        case (0x5A<<3)|7: assert(false);break;
+    /* SRE abs,Y (undoc) */
+        case (0x5B<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x5B<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x5B<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x5B<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x5B<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x5B<<3)|5: _LANES(c->AD[l]=_m6502x_lsr(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]^=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x5B<<3)|6: _LANES(_FETCH(););break;
+        case (0x5B<<3)|7: assert(false);break;
+    /* NOP abs,X (undoc) */
+        case (0x5C<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x5C<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x5C<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0x5C<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x5C<<3)|4: _LANES(_FETCH(););break;
+        case (0x5C<<3)|5: assert(false);break;
+        case (0x5C<<3)|6: assert(false);break;
+        case (0x5C<<3)|7: assert(false);break;
+    /* EOR abs,X */
+        case (0x5D<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x5D<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x5D<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0x5D<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x5D<<3)|4: _LANES(c->A[l]^=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x5D<<3)|5: assert(false);break;
+        case (0x5D<<3)|6: assert(false);break;
+        case (0x5D<<3)|7: assert(false);break;
+    /* LSR abs,X */
+        case (0x5E<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x5E<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x5E<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0x5E<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x5E<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x5E<<3)|5: _LANES(_SD(_m6502x_lsr(c,l,c->AD[l]));_WR(););break;
+        case (0x5E<<3)|6: _LANES(_FETCH(););break;
+        case (0x5E<<3)|7: assert(false);break;
+    /* SRE abs,X (undoc) */
+        case (0x5F<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x5F<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x5F<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0x5F<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x5F<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x5F<<3)|5: _LANES(c->AD[l]=_m6502x_lsr(c,l,c->AD[l]);_SD(c->AD[l]);c->A[l]^=c->AD[l];_NZ(c->A[l]);_WR(););break;
+        case (0x5F<<3)|6: _LANES(_FETCH(););break;
+        case (0x5F<<3)|7: assert(false);break;
+    /* RTS  */
+        case (0x60<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x60<<3)|1: _LANES(_SA(0x0100|c->S[l]++););break;
+        case (0x60<<3)|2: _LANES(_SA(0x0100|c->S[l]++););break;
+        case (0x60<<3)|3: _LANES(_SA(0x0100|c->S[l]);c->AD[l]=_GD(););break;
+        case (0x60<<3)|4: _LANES(c->PC[l]=(_GD()<<8)|c->AD[l];_SA(c->PC[l]++););break;
+        case (0x60<<3)|5: _LANES(_FETCH(););break;
+        case (0x60<<3)|6: assert(false);break;
+        case (0x60<<3)|7: assert(false);break;
+    /* ADC (zp,X) */
+        case (0x61<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x61<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x61<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0x61<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x61<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x61<<3)|5: _LANES(_m6502x_adc(c,l,_GD());_FETCH(););break;
+        case (0x61<<3)|6: assert(false);break;
+        case (0x61<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0x62<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x62<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0x62<<3)|2: assert(false);break;
+        case (0x62<<3)|3: assert(false);break;
+        case (0x62<<3)|4: assert(false);break;
+        case (0x62<<3)|5: assert(false);break;
+        case (0x62<<3)|6: assert(false);break;
+        case (0x62<<3)|7: assert(false);break;
+    /* RRA (zp,X) (undoc) */
+        case (0x63<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x63<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x63<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0x63<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x63<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x63<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x63<<3)|6: _LANES(c->AD[l]=_m6502x_ror(c,l,c->AD[l]);_SD(c->AD[l]);_m6502x_adc(c,l,c->AD[l]);_WR(););break;
+        case (0x63<<3)|7: _LANES(_FETCH(););break;
+    /* NOP zp (undoc) */
+        case (0x64<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x64<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x64<<3)|2: _LANES(_FETCH(););break;
+        case (0x64<<3)|3: assert(false);break;
+        case (0x64<<3)|4: assert(false);break;
+        case (0x64<<3)|5: assert(false);break;
+        case (0x64<<3)|6: assert(false);break;
+        case (0x64<<3)|7: assert(false);break;
+    /* ADC zp */
+        case (0x65<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x65<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x65<<3)|2: _LANES(_m6502x_adc(c,l,_GD());_FETCH(););break;
+        case (0x65<<3)|3: assert(false);break;
+        case (0x65<<3)|4: assert(false);break;
+        case (0x65<<3)|5: assert(false);break;
+        case (0x65<<3)|6: assert(false);break;
+        case (0x65<<3)|7: assert(false);break;
+    /* ROR zp */
+        case (0x66<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x66<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x66<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x66<<3)|3: _LANES(_SD(_m6502x_ror(c,l,c->AD[l]));_WR(););break;
+        case (0x66<<3)|4: _LANES(_FETCH(););break;
+        case (0x66<<3)|5: assert(false);break;
+        case (0x66<<3)|6: assert(false);break;
+        case (0x66<<3)|7: assert(false);break;
+    /* RRA zp (undoc) */
+        case (0x67<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x67<<3)|1: _LANES(_SA(_GD()););break;
+        case (0x67<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x67<<3)|3: _LANES(c->AD[l]=_m6502x_ror(c,l,c->AD[l]);_SD(c->AD[l]);_m6502x_adc(c,l,c->AD[l]);_WR(););break;
+        case (0x67<<3)|4: _LANES(_FETCH(););break;
+        case (0x67<<3)|5: assert(false);break;
+        case (0x67<<3)|6: assert(false);break;
+        case (0x67<<3)|7: assert(false);break;
+    /* PLA  */
+        case (0x68<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x68<<3)|1: _LANES(_SA(0x0100|c->S[l]++););break;
+        case (0x68<<3)|2: _LANES(_SA(0x0100|c->S[l]););break;
+        case (0x68<<3)|3: _LANES(c->A[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x68<<3)|4: assert(false);break;
+        case (0x68<<3)|5: assert(false);break;
+        case (0x68<<3)|6: assert(false);break;
+        case (0x68<<3)|7: assert(false);break;
+    /* ADC # */
+        case (0x69<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x69<<3)|1: _LANES(_m6502x_adc(c,l,_GD());_FETCH(););break;
+        case (0x69<<3)|2: assert(false);break;
+        case (0x69<<3)|3: assert(false);break;
+        case (0x69<<3)|4: assert(false);break;
+        case (0x69<<3)|5: assert(false);break;
+        case (0x69<<3)|6: assert(false);break;
+        case (0x69<<3)|7: assert(false);break;
+    /* RORA  */
+        case (0x6A<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x6A<<3)|1: _LANES(c->A[l]=_m6502x_ror(c,l,c->A[l]);_FETCH(););break;
+        case (0x6A<<3)|2: assert(false);break;
+        case (0x6A<<3)|3: assert(false);break;
+        case (0x6A<<3)|4: assert(false);break;
+        case (0x6A<<3)|5: assert(false);break;
+        case (0x6A<<3)|6: assert(false);break;
+        case (0x6A<<3)|7: assert(false);break;
+    /* ARR # (undoc) */
+        case (0x6B<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x6B<<3)|1: _LANES(c->A[l]&=_GD();_m6502x_arr(c,l);_FETCH(););break;
+        case (0x6B<<3)|2: assert(false);break;
+        case (0x6B<<3)|3: assert(false);break;
+        case (0x6B<<3)|4: assert(false);break;
+        case (0x6B<<3)|5: assert(false);break;
+        case (0x6B<<3)|6: assert(false);break;
+        case (0x6B<<3)|7: assert(false);break;
+    /* JMPI  */
+        case (0x6C<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x6C<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x6C<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA(c->AD[l]););break;
+        case (0x6C<<3)|3: _LANES(_SA((c->AD[l]&0xFF00)|((c->AD[l]+1)&0x00FF));c->AD[l]=_GD(););break;
+        case (0x6C<<3)|4: _LANES(c->PC[l]=(_GD()<<8)|c->AD[l];_FETCH(););break;
+        case (0x6C<<3)|5: assert(false);break;
+        case (0x6C<<3)|6: assert(false);break;
+        case (0x6C<<3)|7: assert(false);break;
+    /* ADC abs */
+        case (0x6D<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x6D<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x6D<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x6D<<3)|3: _LANES(_m6502x_adc(c,l,_GD());_FETCH(););break;
+        case (0x6D<<3)|4: assert(false);break;
+        case (0x6D<<3)|5: assert(false);break;
+        case (0x6D<<3)|6: assert(false);break;
+        case (0x6D<<3)|7: assert(false);break;
+    /* ROR abs */
+        case (0x6E<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x6E<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x6E<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x6E<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x6E<<3)|4: _LANES(_SD(_m6502x_ror(c,l,c->AD[l]));_WR(););break;
+        case (0x6E<<3)|5: _LANES(_FETCH(););break;
+        case (0x6E<<3)|6: assert(false);break;
+        case (0x6E<<3)|7: assert(false);break;
+    /* RRA abs (undoc) */
+        case (0x6F<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x6F<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x6F<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0x6F<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x6F<<3)|4: _LANES(c->AD[l]=_m6502x_ror(c,l,c->AD[l]);_SD(c->AD[l]);_m6502x_adc(c,l,c->AD[l]);_WR(););break;
+        case (0x6F<<3)|5: _LANES(_FETCH(););break;
+        case (0x6F<<3)|6: assert(false);break;
+        case (0x6F<<3)|7: assert(false);break;
+    /* BVS # */
+        case (0x70<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x70<<3)|1: _LANES(_SA(c->PC[l]);c->AD[l]=c->PC[l]+(int8_t)_GD();if((c->P[l]&0x40)!=0x40){_FETCH();};);break;
+        case (0x70<<3)|2: _LANES(_SA((c->PC[l]&0xFF00)|(c->AD[l]&0x00FF));if((c->AD[l]&0xFF00)==(c->PC[l]&0xFF00)){c->PC[l]=c->AD[l];c->irq_pip[l]>>=1;c->nmi_pip[l]>>=1;_FETCH();};);break;
+        case (0x70<<3)|3: _LANES(c->PC[l]=c->AD[l];_FETCH(););break;
+        case (0x70<<3)|4: assert(false);break;
+        case (0x70<<3)|5: assert(false);break;
+        case (0x70<<3)|6: assert(false);break;
+        case (0x70<<3)|7: assert(false);break;
+    /* ADC (zp),Y */
+        case (0x71<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x71<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x71<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x71<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0x71<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x71<<3)|5: _LANES(_m6502x_adc(c,l,_GD());_FETCH(););break;
+        case (0x71<<3)|6: assert(false);break;
+        case (0x71<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0x72<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x72<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0x72<<3)|2: assert(false);break;
+        case (0x72<<3)|3: assert(false);break;
+        case (0x72<<3)|4: assert(false);break;
+        case (0x72<<3)|5: assert(false);break;
+        case (0x72<<3)|6: assert(false);break;
+        case (0x72<<3)|7: assert(false);break;
+    /* RRA (zp),Y (undoc) */
+        case (0x73<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x73<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x73<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x73<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x73<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x73<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x73<<3)|6: _LANES(c->AD[l]=_m6502x_ror(c,l,c->AD[l]);_SD(c->AD[l]);_m6502x_adc(c,l,c->AD[l]);_WR(););break;
+        case (0x73<<3)|7: _LANES(_FETCH(););break;
+    /* NOP zp,X (undoc) */
+        case (0x74<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x74<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x74<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x74<<3)|3: _LANES(_FETCH(););break;
+        case (0x74<<3)|4: assert(false);break;
+        case (0x74<<3)|5: assert(false);break;
+        case (0x74<<3)|6: assert(false);break;
+        case (0x74<<3)|7: assert(false);break;
+    /* ADC zp,X */
+        case (0x75<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x75<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x75<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x75<<3)|3: _LANES(_m6502x_adc(c,l,_GD());_FETCH(););break;
+        case (0x75<<3)|4: assert(false);break;
+        case (0x75<<3)|5: assert(false);break;
+        case (0x75<<3)|6: assert(false);break;
+        case (0x75<<3)|7: assert(false);break;
+    /* ROR zp,X */
+        case (0x76<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x76<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x76<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x76<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x76<<3)|4: _LANES(_SD(_m6502x_ror(c,l,c->AD[l]));_WR(););break;
+        case (0x76<<3)|5: _LANES(_FETCH(););break;
+        case (0x76<<3)|6: assert(false);break;
+        case (0x76<<3)|7: assert(false);break;
+    /* RRA zp,X (undoc) */
+        case (0x77<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x77<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x77<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0x77<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x77<<3)|4: _LANES(c->AD[l]=_m6502x_ror(c,l,c->AD[l]);_SD(c->AD[l]);_m6502x_adc(c,l,c->AD[l]);_WR(););break;
+        case (0x77<<3)|5: _LANES(_FETCH(););break;
+        case (0x77<<3)|6: assert(false);break;
+        case (0x77<<3)|7: assert(false);break;
+    /* SEI  */
+        case (0x78<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x78<<3)|1: _LANES(c->P[l]|=0x4;_FETCH(););break;
+        case (0x78<<3)|2: assert(false);break;
+        case (0x78<<3)|3: assert(false);break;
+        case (0x78<<3)|4: assert(false);break;
+        case (0x78<<3)|5: assert(false);break;
+        case (0x78<<3)|6: assert(false);break;
+        case (0x78<<3)|7: assert(false);break;
+    /* ADC abs,Y */
+        case (0x79<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x79<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x79<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0x79<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x79<<3)|4: _LANES(_m6502x_adc(c,l,_GD());_FETCH(););break;
+        case (0x79<<3)|5: assert(false);break;
+        case (0x79<<3)|6: assert(false);break;
+        case (0x79<<3)|7: assert(false);break;
+    /* NOP  (undoc) */
+        case (0x7A<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x7A<<3)|1: _LANES(_FETCH(););break;
+        case (0x7A<<3)|2: assert(false);break;
+        case (0x7A<<3)|3: assert(false);break;
+        case (0x7A<<3)|4: assert(false);break;
+        case (0x7A<<3)|5: assert(false);break;
+        case (0x7A<<3)|6: assert(false);break;
+        case (0x7A<<3)|7: assert(false);break;
+    /* RRA abs,Y (undoc) */
+        case (0x7B<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x7B<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x7B<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x7B<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0x7B<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x7B<<3)|5: _LANES(c->AD[l]=_m6502x_ror(c,l,c->AD[l]);_SD(c->AD[l]);_m6502x_adc(c,l,c->AD[l]);_WR(););break;
+        case (0x7B<<3)|6: _LANES(_FETCH(););break;
+        case (0x7B<<3)|7: assert(false);break;
+    /* NOP abs,X (undoc) */
+        case (0x7C<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x7C<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x7C<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0x7C<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x7C<<3)|4: _LANES(_FETCH(););break;
+        case (0x7C<<3)|5: assert(false);break;
+        case (0x7C<<3)|6: assert(false);break;
+        case (0x7C<<3)|7: assert(false);break;
+    /* ADC abs,X */
+        case (0x7D<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x7D<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x7D<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0x7D<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x7D<<3)|4: _LANES(_m6502x_adc(c,l,_GD());_FETCH(););break;
+        case (0x7D<<3)|5: assert(false);break;
+        case (0x7D<<3)|6: assert(false);break;
+        case (0x7D<<3)|7: assert(false);break;
+    /* ROR abs,X */
+        case (0x7E<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x7E<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x7E<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0x7E<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x7E<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x7E<<3)|5: _LANES(_SD(_m6502x_ror(c,l,c->AD[l]));_WR(););break;
+        case (0x7E<<3)|6: _LANES(_FETCH(););break;
+        case (0x7E<<3)|7: assert(false);break;
+    /* RRA abs,X (undoc) */
+        case (0x7F<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x7F<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x7F<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0x7F<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0x7F<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0x7F<<3)|5: _LANES(c->AD[l]=_m6502x_ror(c,l,c->AD[l]);_SD(c->AD[l]);_m6502x_adc(c,l,c->AD[l]);_WR(););break;
+        case (0x7F<<3)|6: _LANES(_FETCH(););break;
+        case (0x7F<<3)|7: assert(false);break;
+    /* NOP # (undoc) */
+        case (0x80<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x80<<3)|1: _LANES(_FETCH(););break;
+        case (0x80<<3)|2: assert(false);break;
+        case (0x80<<3)|3: assert(false);break;
+        case (0x80<<3)|4: assert(false);break;
+        case (0x80<<3)|5: assert(false);break;
+        case (0x80<<3)|6: assert(false);break;
+        case (0x80<<3)|7: assert(false);break;
+    /* STA (zp,X) */
+        case (0x81<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x81<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x81<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0x81<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x81<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]);_SD(c->A[l]);_WR(););break;
+        case (0x81<<3)|5: _LANES(_FETCH(););break;
+        case (0x81<<3)|6: assert(false);break;
+        case (0x81<<3)|7: assert(false);break;
+    /* NOP # (undoc) */
+        case (0x82<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x82<<3)|1: _LANES(_FETCH(););break;
+        case (0x82<<3)|2: assert(false);break;
+        case (0x82<<3)|3: assert(false);break;
+        case (0x82<<3)|4: assert(false);break;
+        case (0x82<<3)|5: assert(false);break;
+        case (0x82<<3)|6: assert(false);break;
+        case (0x82<<3)|7: assert(false);break;
+    /* SAX (zp,X) (undoc) */
+        case (0x83<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x83<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x83<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0x83<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x83<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]);_SD(c->A[l]&c->X[l]);_WR(););break;
+        case (0x83<<3)|5: _LANES(_FETCH(););break;
+        case (0x83<<3)|6: assert(false);break;
+        case (0x83<<3)|7: assert(false);break;
+    /* STY zp */
+        case (0x84<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x84<<3)|1: _LANES(_SA(_GD());_SD(c->Y[l]);_WR(););break;
+        case (0x84<<3)|2: _LANES(_FETCH(););break;
+        case (0x84<<3)|3: assert(false);break;
+        case (0x84<<3)|4: assert(false);break;
+        case (0x84<<3)|5: assert(false);break;
+        case (0x84<<3)|6: assert(false);break;
+        case (0x84<<3)|7: assert(false);break;
+    /* STA zp */
+        case (0x85<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x85<<3)|1: _LANES(_SA(_GD());_SD(c->A[l]);_WR(););break;
+        case (0x85<<3)|2: _LANES(_FETCH(););break;
+        case (0x85<<3)|3: assert(false);break;
+        case (0x85<<3)|4: assert(false);break;
+        case (0x85<<3)|5: assert(false);break;
+        case (0x85<<3)|6: assert(false);break;
+        case (0x85<<3)|7: assert(false);break;
+    /* STX zp */
+        case (0x86<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x86<<3)|1: _LANES(_SA(_GD());_SD(c->X[l]);_WR(););break;
+        case (0x86<<3)|2: _LANES(_FETCH(););break;
+        case (0x86<<3)|3: assert(false);break;
+        case (0x86<<3)|4: assert(false);break;
+        case (0x86<<3)|5: assert(false);break;
+        case (0x86<<3)|6: assert(false);break;
+        case (0x86<<3)|7: assert(false);break;
+    /* SAX zp (undoc) */
+        case (0x87<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x87<<3)|1: _LANES(_SA(_GD());_SD(c->A[l]&c->X[l]);_WR(););break;
+        case (0x87<<3)|2: _LANES(_FETCH(););break;
+        case (0x87<<3)|3: assert(false);break;
+        case (0x87<<3)|4: assert(false);break;
+        case (0x87<<3)|5: assert(false);break;
+        case (0x87<<3)|6: assert(false);break;
+        case (0x87<<3)|7: assert(false);break;
+    /* DEY  */
+        case (0x88<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x88<<3)|1: _LANES(c->Y[l]--;_NZ(c->Y[l]);_FETCH(););break;
+        case (0x88<<3)|2: assert(false);break;
+        case (0x88<<3)|3: assert(false);break;
+        case (0x88<<3)|4: assert(false);break;
+        case (0x88<<3)|5: assert(false);break;
+        case (0x88<<3)|6: assert(false);break;
+        case (0x88<<3)|7: assert(false);break;
+    /* NOP # (undoc) */
+        case (0x89<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x89<<3)|1: _LANES(_FETCH(););break;
+        case (0x89<<3)|2: assert(false);break;
+        case (0x89<<3)|3: assert(false);break;
+        case (0x89<<3)|4: assert(false);break;
+        case (0x89<<3)|5: assert(false);break;
+        case (0x89<<3)|6: assert(false);break;
+        case (0x89<<3)|7: assert(false);break;
+    /* TXA  */
+        case (0x8A<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x8A<<3)|1: _LANES(c->A[l]=c->X[l];_NZ(c->A[l]);_FETCH(););break;
+        case (0x8A<<3)|2: assert(false);break;
+        case (0x8A<<3)|3: assert(false);break;
+        case (0x8A<<3)|4: assert(false);break;
+        case (0x8A<<3)|5: assert(false);break;
+        case (0x8A<<3)|6: assert(false);break;
+        case (0x8A<<3)|7: assert(false);break;
+    /* ANE # (undoc) */
+        case (0x8B<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x8B<<3)|1: _LANES(c->A[l]=(c->A[l]|0xEE)&c->X[l]&_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0x8B<<3)|2: assert(false);break;
+        case (0x8B<<3)|3: assert(false);break;
+        case (0x8B<<3)|4: assert(false);break;
+        case (0x8B<<3)|5: assert(false);break;
+        case (0x8B<<3)|6: assert(false);break;
+        case (0x8B<<3)|7: assert(false);break;
+    /* STY abs */
+        case (0x8C<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x8C<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x8C<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]);_SD(c->Y[l]);_WR(););break;
+        case (0x8C<<3)|3: _LANES(_FETCH(););break;
+        case (0x8C<<3)|4: assert(false);break;
+        case (0x8C<<3)|5: assert(false);break;
+        case (0x8C<<3)|6: assert(false);break;
+        case (0x8C<<3)|7: assert(false);break;
+    /* STA abs */
+        case (0x8D<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x8D<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x8D<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]);_SD(c->A[l]);_WR(););break;
+        case (0x8D<<3)|3: _LANES(_FETCH(););break;
+        case (0x8D<<3)|4: assert(false);break;
+        case (0x8D<<3)|5: assert(false);break;
+        case (0x8D<<3)|6: assert(false);break;
+        case (0x8D<<3)|7: assert(false);break;
+    /* STX abs */
+        case (0x8E<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x8E<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x8E<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]);_SD(c->X[l]);_WR(););break;
+        case (0x8E<<3)|3: _LANES(_FETCH(););break;
+        case (0x8E<<3)|4: assert(false);break;
+        case (0x8E<<3)|5: assert(false);break;
+        case (0x8E<<3)|6: assert(false);break;
+        case (0x8E<<3)|7: assert(false);break;
+    /* SAX abs (undoc) */
+        case (0x8F<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x8F<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x8F<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]);_SD(c->A[l]&c->X[l]);_WR(););break;
+        case (0x8F<<3)|3: _LANES(_FETCH(););break;
+        case (0x8F<<3)|4: assert(false);break;
+        case (0x8F<<3)|5: assert(false);break;
+        case (0x8F<<3)|6: assert(false);break;
+        case (0x8F<<3)|7: assert(false);break;
+    /* BCC # */
+        case (0x90<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x90<<3)|1: _LANES(_SA(c->PC[l]);c->AD[l]=c->PC[l]+(int8_t)_GD();if((c->P[l]&0x1)!=0x0){_FETCH();};);break;
+        case (0x90<<3)|2: _LANES(_SA((c->PC[l]&0xFF00)|(c->AD[l]&0x00FF));if((c->AD[l]&0xFF00)==(c->PC[l]&0xFF00)){c->PC[l]=c->AD[l];c->irq_pip[l]>>=1;c->nmi_pip[l]>>=1;_FETCH();};);break;
+        case (0x90<<3)|3: _LANES(c->PC[l]=c->AD[l];_FETCH(););break;
+        case (0x90<<3)|4: assert(false);break;
+        case (0x90<<3)|5: assert(false);break;
+        case (0x90<<3)|6: assert(false);break;
+        case (0x90<<3)|7: assert(false);break;
+    /* STA (zp),Y */
+        case (0x91<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x91<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x91<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x91<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x91<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]);_SD(c->A[l]);_WR(););break;
+        case (0x91<<3)|5: _LANES(_FETCH(););break;
+        case (0x91<<3)|6: assert(false);break;
+        case (0x91<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0x92<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x92<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0x92<<3)|2: assert(false);break;
+        case (0x92<<3)|3: assert(false);break;
+        case (0x92<<3)|4: assert(false);break;
+        case (0x92<<3)|5: assert(false);break;
+        case (0x92<<3)|6: assert(false);break;
+        case (0x92<<3)|7: assert(false);break;
+    /* SHA (zp),Y (undoc) */
+        case (0x93<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x93<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x93<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0x93<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x93<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]);_SD(c->A[l]&c->X[l]&(uint8_t)((_GA()>>8)+1));_WR(););break;
+        case (0x93<<3)|5: _LANES(_FETCH(););break;
+        case (0x93<<3)|6: assert(false);break;
+        case (0x93<<3)|7: assert(false);break;
+    /* STY zp,X */
+        case (0x94<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x94<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x94<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF);_SD(c->Y[l]);_WR(););break;
+        case (0x94<<3)|3: _LANES(_FETCH(););break;
+        case (0x94<<3)|4: assert(false);break;
+        case (0x94<<3)|5: assert(false);break;
+        case (0x94<<3)|6: assert(false);break;
+        case (0x94<<3)|7: assert(false);break;
+    /* STA zp,X */
+        case (0x95<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x95<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x95<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF);_SD(c->A[l]);_WR(););break;
+        case (0x95<<3)|3: _LANES(_FETCH(););break;
+        case (0x95<<3)|4: assert(false);break;
+        case (0x95<<3)|5: assert(false);break;
+        case (0x95<<3)|6: assert(false);break;
+        case (0x95<<3)|7: assert(false);break;
+    /* STX zp,Y */
+        case (0x96<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x96<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x96<<3)|2: _LANES(_SA((c->AD[l]+c->Y[l])&0x00FF);_SD(c->X[l]);_WR(););break;
+        case (0x96<<3)|3: _LANES(_FETCH(););break;
+        case (0x96<<3)|4: assert(false);break;
+        case (0x96<<3)|5: assert(false);break;
+        case (0x96<<3)|6: assert(false);break;
+        case (0x96<<3)|7: assert(false);break;
+    /* SAX zp,Y (undoc) */
+        case (0x97<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x97<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0x97<<3)|2: _LANES(_SA((c->AD[l]+c->Y[l])&0x00FF);_SD(c->A[l]&c->X[l]);_WR(););break;
+        case (0x97<<3)|3: _LANES(_FETCH(););break;
+        case (0x97<<3)|4: assert(false);break;
+        case (0x97<<3)|5: assert(false);break;
+        case (0x97<<3)|6: assert(false);break;
+        case (0x97<<3)|7: assert(false);break;
+    /* TYA  */
+        case (0x98<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x98<<3)|1: _LANES(c->A[l]=c->Y[l];_NZ(c->A[l]);_FETCH(););break;
+        case (0x98<<3)|2: assert(false);break;
+        case (0x98<<3)|3: assert(false);break;
+        case (0x98<<3)|4: assert(false);break;
+        case (0x98<<3)|5: assert(false);break;
+        case (0x98<<3)|6: assert(false);break;
+        case (0x98<<3)|7: assert(false);break;
+    /* STA abs,Y */
+        case (0x99<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x99<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x99<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x99<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]);_SD(c->A[l]);_WR(););break;
+        case (0x99<<3)|4: _LANES(_FETCH(););break;
+        case (0x99<<3)|5: assert(false);break;
+        case (0x99<<3)|6: assert(false);break;
+        case (0x99<<3)|7: assert(false);break;
+    /* TXS  */
+        case (0x9A<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0x9A<<3)|1: _LANES(c->S[l]=c->X[l];_FETCH(););break;
+        case (0x9A<<3)|2: assert(false);break;
+        case (0x9A<<3)|3: assert(false);break;
+        case (0x9A<<3)|4: assert(false);break;
+        case (0x9A<<3)|5: assert(false);break;
+        case (0x9A<<3)|6: assert(false);break;
+        case (0x9A<<3)|7: assert(false);break;
+    /* SHS abs,Y (undoc) */
+        case (0x9B<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x9B<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x9B<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x9B<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]);c->S[l]=c->A[l]&c->X[l];_SD(c->S[l]&(uint8_t)((_GA()>>8)+1));_WR(););break;
+        case (0x9B<<3)|4: _LANES(_FETCH(););break;
+        case (0x9B<<3)|5: assert(false);break;
+        case (0x9B<<3)|6: assert(false);break;
+        case (0x9B<<3)|7: assert(false);break;
+    /* SHY abs,X (undoc) */
+        case (0x9C<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x9C<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x9C<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0x9C<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]);_SD(c->Y[l]&(uint8_t)((_GA()>>8)+1));_WR(););break;
+        case (0x9C<<3)|4: _LANES(_FETCH(););break;
+        case (0x9C<<3)|5: assert(false);break;
+        case (0x9C<<3)|6: assert(false);break;
+        case (0x9C<<3)|7: assert(false);break;
+    /* STA abs,X */
+        case (0x9D<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x9D<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x9D<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0x9D<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]);_SD(c->A[l]);_WR(););break;
+        case (0x9D<<3)|4: _LANES(_FETCH(););break;
+        case (0x9D<<3)|5: assert(false);break;
+        case (0x9D<<3)|6: assert(false);break;
+        case (0x9D<<3)|7: assert(false);break;
+    /* SHX abs,Y (undoc) */
+        case (0x9E<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x9E<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x9E<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x9E<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]);_SD(c->X[l]&(uint8_t)((_GA()>>8)+1));_WR(););break;
+        case (0x9E<<3)|4: _LANES(_FETCH(););break;
+        case (0x9E<<3)|5: assert(false);break;
+        case (0x9E<<3)|6: assert(false);break;
+        case (0x9E<<3)|7: assert(false);break;
+    /* SHA abs,Y (undoc) */
+        case (0x9F<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0x9F<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0x9F<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0x9F<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]);_SD(c->A[l]&c->X[l]&(uint8_t)((_GA()>>8)+1));_WR(););break;
+        case (0x9F<<3)|4: _LANES(_FETCH(););break;
+        case (0x9F<<3)|5: assert(false);break;
+        case (0x9F<<3)|6: assert(false);break;
+        case (0x9F<<3)|7: assert(false);break;
+    /* LDY # */
+        case (0xA0<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xA0<<3)|1: _LANES(c->Y[l]=_GD();_NZ(c->Y[l]);_FETCH(););break;
+        case (0xA0<<3)|2: assert(false);break;
+        case (0xA0<<3)|3: assert(false);break;
+        case (0xA0<<3)|4: assert(false);break;
+        case (0xA0<<3)|5: assert(false);break;
+        case (0xA0<<3)|6: assert(false);break;
+        case (0xA0<<3)|7: assert(false);break;
+    /* LDA (zp,X) */
+        case (0xA1<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xA1<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xA1<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0xA1<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xA1<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xA1<<3)|5: _LANES(c->A[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xA1<<3)|6: assert(false);break;
+        case (0xA1<<3)|7: assert(false);break;
+    /* LDX # */
+        case (0xA2<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xA2<<3)|1: _LANES(c->X[l]=_GD();_NZ(c->X[l]);_FETCH(););break;
+        case (0xA2<<3)|2: assert(false);break;
+        case (0xA2<<3)|3: assert(false);break;
+        case (0xA2<<3)|4: assert(false);break;
+        case (0xA2<<3)|5: assert(false);break;
+        case (0xA2<<3)|6: assert(false);break;
+        case (0xA2<<3)|7: assert(false);break;
+    /* LAX (zp,X) (undoc) */
+        case (0xA3<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xA3<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xA3<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0xA3<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xA3<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xA3<<3)|5: _LANES(c->A[l]=c->X[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xA3<<3)|6: assert(false);break;
+        case (0xA3<<3)|7: assert(false);break;
+    /* LDY zp */
+        case (0xA4<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xA4<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xA4<<3)|2: _LANES(c->Y[l]=_GD();_NZ(c->Y[l]);_FETCH(););break;
+        case (0xA4<<3)|3: assert(false);break;
+        case (0xA4<<3)|4: assert(false);break;
+        case (0xA4<<3)|5: assert(false);break;
+        case (0xA4<<3)|6: assert(false);break;
+        case (0xA4<<3)|7: assert(false);break;
+    /* LDA zp */
+        case (0xA5<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xA5<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xA5<<3)|2: _LANES(c->A[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xA5<<3)|3: assert(false);break;
+        case (0xA5<<3)|4: assert(false);break;
+        case (0xA5<<3)|5: assert(false);break;
+        case (0xA5<<3)|6: assert(false);break;
+        case (0xA5<<3)|7: assert(false);break;
+    /* LDX zp */
+        case (0xA6<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xA6<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xA6<<3)|2: _LANES(c->X[l]=_GD();_NZ(c->X[l]);_FETCH(););break;
+        case (0xA6<<3)|3: assert(false);break;
+        case (0xA6<<3)|4: assert(false);break;
+        case (0xA6<<3)|5: assert(false);break;
+        case (0xA6<<3)|6: assert(false);break;
+        case (0xA6<<3)|7: assert(false);break;
+    /* LAX zp (undoc) */
+        case (0xA7<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xA7<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xA7<<3)|2: _LANES(c->A[l]=c->X[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xA7<<3)|3: assert(false);break;
+        case (0xA7<<3)|4: assert(false);break;
+        case (0xA7<<3)|5: assert(false);break;
+        case (0xA7<<3)|6: assert(false);break;
+        case (0xA7<<3)|7: assert(false);break;
+    /* TAY  */
+        case (0xA8<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xA8<<3)|1: _LANES(c->Y[l]=c->A[l];_NZ(c->Y[l]);_FETCH(););break;
+        case (0xA8<<3)|2: assert(false);break;
+        case (0xA8<<3)|3: assert(false);break;
+        case (0xA8<<3)|4: assert(false);break;
+        case (0xA8<<3)|5: assert(false);break;
+        case (0xA8<<3)|6: assert(false);break;
+        case (0xA8<<3)|7: assert(false);break;
+    /* LDA # */
+        case (0xA9<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xA9<<3)|1: _LANES(c->A[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xA9<<3)|2: assert(false);break;
+        case (0xA9<<3)|3: assert(false);break;
+        case (0xA9<<3)|4: assert(false);break;
+        case (0xA9<<3)|5: assert(false);break;
+        case (0xA9<<3)|6: assert(false);break;
+        case (0xA9<<3)|7: assert(false);break;
+    /* TAX  */
+        case (0xAA<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xAA<<3)|1: _LANES(c->X[l]=c->A[l];_NZ(c->X[l]);_FETCH(););break;
+        case (0xAA<<3)|2: assert(false);break;
+        case (0xAA<<3)|3: assert(false);break;
+        case (0xAA<<3)|4: assert(false);break;
+        case (0xAA<<3)|5: assert(false);break;
+        case (0xAA<<3)|6: assert(false);break;
+        case (0xAA<<3)|7: assert(false);break;
+    /* LXA # (undoc) */
+        case (0xAB<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xAB<<3)|1: _LANES(c->A[l]=c->X[l]=(c->A[l]|0xEE)&_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xAB<<3)|2: assert(false);break;
+        case (0xAB<<3)|3: assert(false);break;
+        case (0xAB<<3)|4: assert(false);break;
+        case (0xAB<<3)|5: assert(false);break;
+        case (0xAB<<3)|6: assert(false);break;
+        case (0xAB<<3)|7: assert(false);break;
+    /* LDY abs */
+        case (0xAC<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xAC<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xAC<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xAC<<3)|3: _LANES(c->Y[l]=_GD();_NZ(c->Y[l]);_FETCH(););break;
+        case (0xAC<<3)|4: assert(false);break;
+        case (0xAC<<3)|5: assert(false);break;
+        case (0xAC<<3)|6: assert(false);break;
+        case (0xAC<<3)|7: assert(false);break;
+    /* LDA abs */
+        case (0xAD<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xAD<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xAD<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xAD<<3)|3: _LANES(c->A[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xAD<<3)|4: assert(false);break;
+        case (0xAD<<3)|5: assert(false);break;
+        case (0xAD<<3)|6: assert(false);break;
+        case (0xAD<<3)|7: assert(false);break;
+    /* LDX abs */
+        case (0xAE<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xAE<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xAE<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xAE<<3)|3: _LANES(c->X[l]=_GD();_NZ(c->X[l]);_FETCH(););break;
+        case (0xAE<<3)|4: assert(false);break;
+        case (0xAE<<3)|5: assert(false);break;
+        case (0xAE<<3)|6: assert(false);break;
+        case (0xAE<<3)|7: assert(false);break;
+    /* LAX abs (undoc) */
+        case (0xAF<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xAF<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xAF<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xAF<<3)|3: _LANES(c->A[l]=c->X[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xAF<<3)|4: assert(false);break;
+        case (0xAF<<3)|5: assert(false);break;
+        case (0xAF<<3)|6: assert(false);break;
+        case (0xAF<<3)|7: assert(false);break;
+    /* BCS # */
+        case (0xB0<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xB0<<3)|1: _LANES(_SA(c->PC[l]);c->AD[l]=c->PC[l]+(int8_t)_GD();if((c->P[l]&0x1)!=0x1){_FETCH();};);break;
+        case (0xB0<<3)|2: _LANES(_SA((c->PC[l]&0xFF00)|(c->AD[l]&0x00FF));if((c->AD[l]&0xFF00)==(c->PC[l]&0xFF00)){c->PC[l]=c->AD[l];c->irq_pip[l]>>=1;c->nmi_pip[l]>>=1;_FETCH();};);break;
+        case (0xB0<<3)|3: _LANES(c->PC[l]=c->AD[l];_FETCH(););break;
+        case (0xB0<<3)|4: assert(false);break;
+        case (0xB0<<3)|5: assert(false);break;
+        case (0xB0<<3)|6: assert(false);break;
+        case (0xB0<<3)|7: assert(false);break;
+    /* LDA (zp),Y */
+        case (0xB1<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xB1<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xB1<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xB1<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0xB1<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xB1<<3)|5: _LANES(c->A[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xB1<<3)|6: assert(false);break;
+        case (0xB1<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0xB2<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xB2<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0xB2<<3)|2: assert(false);break;
+        case (0xB2<<3)|3: assert(false);break;
+        case (0xB2<<3)|4: assert(false);break;
+        case (0xB2<<3)|5: assert(false);break;
+        case (0xB2<<3)|6: assert(false);break;
+        case (0xB2<<3)|7: assert(false);break;
+    /* LAX (zp),Y (undoc) */
+        case (0xB3<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xB3<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xB3<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xB3<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0xB3<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xB3<<3)|5: _LANES(c->A[l]=c->X[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xB3<<3)|6: assert(false);break;
+        case (0xB3<<3)|7: assert(false);break;
+    /* LDY zp,X */
+        case (0xB4<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xB4<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xB4<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0xB4<<3)|3: _LANES(c->Y[l]=_GD();_NZ(c->Y[l]);_FETCH(););break;
+        case (0xB4<<3)|4: assert(false);break;
+        case (0xB4<<3)|5: assert(false);break;
+        case (0xB4<<3)|6: assert(false);break;
+        case (0xB4<<3)|7: assert(false);break;
+    /* LDA zp,X */
+        case (0xB5<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xB5<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xB5<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0xB5<<3)|3: _LANES(c->A[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xB5<<3)|4: assert(false);break;
+        case (0xB5<<3)|5: assert(false);break;
+        case (0xB5<<3)|6: assert(false);break;
+        case (0xB5<<3)|7: assert(false);break;
+    /* LDX zp,Y */
+        case (0xB6<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xB6<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xB6<<3)|2: _LANES(_SA((c->AD[l]+c->Y[l])&0x00FF););break;
+        case (0xB6<<3)|3: _LANES(c->X[l]=_GD();_NZ(c->X[l]);_FETCH(););break;
+        case (0xB6<<3)|4: assert(false);break;
+        case (0xB6<<3)|5: assert(false);break;
+        case (0xB6<<3)|6: assert(false);break;
+        case (0xB6<<3)|7: assert(false);break;
+    /* LAX zp,Y (undoc) */
+        case (0xB7<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xB7<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xB7<<3)|2: _LANES(_SA((c->AD[l]+c->Y[l])&0x00FF););break;
+        case (0xB7<<3)|3: _LANES(c->A[l]=c->X[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xB7<<3)|4: assert(false);break;
+        case (0xB7<<3)|5: assert(false);break;
+        case (0xB7<<3)|6: assert(false);break;
+        case (0xB7<<3)|7: assert(false);break;
+    /* CLV  */
+        case (0xB8<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xB8<<3)|1: _LANES(c->P[l]&=~0x40;_FETCH(););break;
+        case (0xB8<<3)|2: assert(false);break;
+        case (0xB8<<3)|3: assert(false);break;
+        case (0xB8<<3)|4: assert(false);break;
+        case (0xB8<<3)|5: assert(false);break;
+        case (0xB8<<3)|6: assert(false);break;
+        case (0xB8<<3)|7: assert(false);break;
+    /* LDA abs,Y */
+        case (0xB9<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xB9<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xB9<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0xB9<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xB9<<3)|4: _LANES(c->A[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xB9<<3)|5: assert(false);break;
+        case (0xB9<<3)|6: assert(false);break;
+        case (0xB9<<3)|7: assert(false);break;
+    /* TSX  */
+        case (0xBA<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xBA<<3)|1: _LANES(c->X[l]=c->S[l];_NZ(c->X[l]);_FETCH(););break;
+        case (0xBA<<3)|2: assert(false);break;
+        case (0xBA<<3)|3: assert(false);break;
+        case (0xBA<<3)|4: assert(false);break;
+        case (0xBA<<3)|5: assert(false);break;
+        case (0xBA<<3)|6: assert(false);break;
+        case (0xBA<<3)|7: assert(false);break;
+    /* LAS abs,Y (undoc) */
+        case (0xBB<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xBB<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xBB<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0xBB<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xBB<<3)|4: _LANES(c->A[l]=c->X[l]=c->S[l]=_GD()&c->S[l];_NZ(c->A[l]);_FETCH(););break;
+        case (0xBB<<3)|5: assert(false);break;
+        case (0xBB<<3)|6: assert(false);break;
+        case (0xBB<<3)|7: assert(false);break;
+    /* LDY abs,X */
+        case (0xBC<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xBC<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xBC<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0xBC<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0xBC<<3)|4: _LANES(c->Y[l]=_GD();_NZ(c->Y[l]);_FETCH(););break;
+        case (0xBC<<3)|5: assert(false);break;
+        case (0xBC<<3)|6: assert(false);break;
+        case (0xBC<<3)|7: assert(false);break;
+    /* LDA abs,X */
+        case (0xBD<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xBD<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xBD<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0xBD<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0xBD<<3)|4: _LANES(c->A[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xBD<<3)|5: assert(false);break;
+        case (0xBD<<3)|6: assert(false);break;
+        case (0xBD<<3)|7: assert(false);break;
+    /* LDX abs,Y */
+        case (0xBE<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xBE<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xBE<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0xBE<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xBE<<3)|4: _LANES(c->X[l]=_GD();_NZ(c->X[l]);_FETCH(););break;
+        case (0xBE<<3)|5: assert(false);break;
+        case (0xBE<<3)|6: assert(false);break;
+        case (0xBE<<3)|7: assert(false);break;
+    /* LAX abs,Y (undoc) */
+        case (0xBF<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xBF<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xBF<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0xBF<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xBF<<3)|4: _LANES(c->A[l]=c->X[l]=_GD();_NZ(c->A[l]);_FETCH(););break;
+        case (0xBF<<3)|5: assert(false);break;
+        case (0xBF<<3)|6: assert(false);break;
+        case (0xBF<<3)|7: assert(false);break;
+    /* CPY # */
+        case (0xC0<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xC0<<3)|1: _LANES(_m6502x_cmp(c,l, c->Y[l], _GD());_FETCH(););break;
+        case (0xC0<<3)|2: assert(false);break;
+        case (0xC0<<3)|3: assert(false);break;
+        case (0xC0<<3)|4: assert(false);break;
+        case (0xC0<<3)|5: assert(false);break;
+        case (0xC0<<3)|6: assert(false);break;
+        case (0xC0<<3)|7: assert(false);break;
+    /* CMP (zp,X) */
+        case (0xC1<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xC1<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xC1<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0xC1<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xC1<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xC1<<3)|5: _LANES(_m6502x_cmp(c,l, c->A[l], _GD());_FETCH(););break;
+        case (0xC1<<3)|6: assert(false);break;
+        case (0xC1<<3)|7: assert(false);break;
+    /* NOP # (undoc) */
+        case (0xC2<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xC2<<3)|1: _LANES(_FETCH(););break;
+        case (0xC2<<3)|2: assert(false);break;
+        case (0xC2<<3)|3: assert(false);break;
+        case (0xC2<<3)|4: assert(false);break;
+        case (0xC2<<3)|5: assert(false);break;
+        case (0xC2<<3)|6: assert(false);break;
+        case (0xC2<<3)|7: assert(false);break;
+    /* DCP (zp,X) (undoc) */
+        case (0xC3<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xC3<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xC3<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0xC3<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xC3<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xC3<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xC3<<3)|6: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_m6502x_cmp(c,l, c->A[l], c->AD[l]);_WR(););break;
+        case (0xC3<<3)|7: _LANES(_FETCH(););break;
+    /* CPY zp */
+        case (0xC4<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xC4<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xC4<<3)|2: _LANES(_m6502x_cmp(c,l, c->Y[l], _GD());_FETCH(););break;
+        case (0xC4<<3)|3: assert(false);break;
+        case (0xC4<<3)|4: assert(false);break;
+        case (0xC4<<3)|5: assert(false);break;
+        case (0xC4<<3)|6: assert(false);break;
+        case (0xC4<<3)|7: assert(false);break;
+    /* CMP zp */
+        case (0xC5<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xC5<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xC5<<3)|2: _LANES(_m6502x_cmp(c,l, c->A[l], _GD());_FETCH(););break;
+        case (0xC5<<3)|3: assert(false);break;
+        case (0xC5<<3)|4: assert(false);break;
+        case (0xC5<<3)|5: assert(false);break;
+        case (0xC5<<3)|6: assert(false);break;
+        case (0xC5<<3)|7: assert(false);break;
+    /* DEC zp */
+        case (0xC6<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xC6<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xC6<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xC6<<3)|3: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_WR(););break;
+        case (0xC6<<3)|4: _LANES(_FETCH(););break;
+        case (0xC6<<3)|5: assert(false);break;
+        case (0xC6<<3)|6: assert(false);break;
+        case (0xC6<<3)|7: assert(false);break;
+    /* DCP zp (undoc) */
+        case (0xC7<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xC7<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xC7<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xC7<<3)|3: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_m6502x_cmp(c,l, c->A[l], c->AD[l]);_WR(););break;
+        case (0xC7<<3)|4: _LANES(_FETCH(););break;
+        case (0xC7<<3)|5: assert(false);break;
+        case (0xC7<<3)|6: assert(false);break;
+        case (0xC7<<3)|7: assert(false);break;
+    /* INY  */
+        case (0xC8<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xC8<<3)|1: _LANES(c->Y[l]++;_NZ(c->Y[l]);_FETCH(););break;
+        case (0xC8<<3)|2: assert(false);break;
+        case (0xC8<<3)|3: assert(false);break;
+        case (0xC8<<3)|4: assert(false);break;
+        case (0xC8<<3)|5: assert(false);break;
+        case (0xC8<<3)|6: assert(false);break;
+        case (0xC8<<3)|7: assert(false);break;
+    /* CMP # */
+        case (0xC9<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xC9<<3)|1: _LANES(_m6502x_cmp(c,l, c->A[l], _GD());_FETCH(););break;
+        case (0xC9<<3)|2: assert(false);break;
+        case (0xC9<<3)|3: assert(false);break;
+        case (0xC9<<3)|4: assert(false);break;
+        case (0xC9<<3)|5: assert(false);break;
+        case (0xC9<<3)|6: assert(false);break;
+        case (0xC9<<3)|7: assert(false);break;
+    /* DEX  */
+        case (0xCA<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xCA<<3)|1: _LANES(c->X[l]--;_NZ(c->X[l]);_FETCH(););break;
+        case (0xCA<<3)|2: assert(false);break;
+        case (0xCA<<3)|3: assert(false);break;
+        case (0xCA<<3)|4: assert(false);break;
+        case (0xCA<<3)|5: assert(false);break;
+        case (0xCA<<3)|6: assert(false);break;
+        case (0xCA<<3)|7: assert(false);break;
+    /* SBX # (undoc) */
+        case (0xCB<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xCB<<3)|1: _LANES(_m6502x_sbx(c,l, _GD());_FETCH(););break;
+        case (0xCB<<3)|2: assert(false);break;
+        case (0xCB<<3)|3: assert(false);break;
+        case (0xCB<<3)|4: assert(false);break;
+        case (0xCB<<3)|5: assert(false);break;
+        case (0xCB<<3)|6: assert(false);break;
+        case (0xCB<<3)|7: assert(false);break;
+    /* CPY abs */
+        case (0xCC<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xCC<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xCC<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xCC<<3)|3: _LANES(_m6502x_cmp(c,l, c->Y[l], _GD());_FETCH(););break;
+        case (0xCC<<3)|4: assert(false);break;
+        case (0xCC<<3)|5: assert(false);break;
+        case (0xCC<<3)|6: assert(false);break;
+        case (0xCC<<3)|7: assert(false);break;
+    /* CMP abs */
+        case (0xCD<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xCD<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xCD<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xCD<<3)|3: _LANES(_m6502x_cmp(c,l, c->A[l], _GD());_FETCH(););break;
+        case (0xCD<<3)|4: assert(false);break;
+        case (0xCD<<3)|5: assert(false);break;
+        case (0xCD<<3)|6: assert(false);break;
+        case (0xCD<<3)|7: assert(false);break;
+    /* DEC abs */
+        case (0xCE<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xCE<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xCE<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xCE<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xCE<<3)|4: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_WR(););break;
+        case (0xCE<<3)|5: _LANES(_FETCH(););break;
+        case (0xCE<<3)|6: assert(false);break;
+        case (0xCE<<3)|7: assert(false);break;
+    /* DCP abs (undoc) */
+        case (0xCF<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xCF<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xCF<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xCF<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xCF<<3)|4: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_m6502x_cmp(c,l, c->A[l], c->AD[l]);_WR(););break;
+        case (0xCF<<3)|5: _LANES(_FETCH(););break;
+        case (0xCF<<3)|6: assert(false);break;
+        case (0xCF<<3)|7: assert(false);break;
+    /* BNE # */
+        case (0xD0<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xD0<<3)|1: _LANES(_SA(c->PC[l]);c->AD[l]=c->PC[l]+(int8_t)_GD();if((c->P[l]&0x2)!=0x0){_FETCH();};);break;
+        case (0xD0<<3)|2: _LANES(_SA((c->PC[l]&0xFF00)|(c->AD[l]&0x00FF));if((c->AD[l]&0xFF00)==(c->PC[l]&0xFF00)){c->PC[l]=c->AD[l];c->irq_pip[l]>>=1;c->nmi_pip[l]>>=1;_FETCH();};);break;
+        case (0xD0<<3)|3: _LANES(c->PC[l]=c->AD[l];_FETCH(););break;
+        case (0xD0<<3)|4: assert(false);break;
+        case (0xD0<<3)|5: assert(false);break;
+        case (0xD0<<3)|6: assert(false);break;
+        case (0xD0<<3)|7: assert(false);break;
+    /* CMP (zp),Y */
+        case (0xD1<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xD1<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xD1<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xD1<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0xD1<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xD1<<3)|5: _LANES(_m6502x_cmp(c,l, c->A[l], _GD());_FETCH(););break;
+        case (0xD1<<3)|6: assert(false);break;
+        case (0xD1<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0xD2<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xD2<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0xD2<<3)|2: assert(false);break;
+        case (0xD2<<3)|3: assert(false);break;
+        case (0xD2<<3)|4: assert(false);break;
+        case (0xD2<<3)|5: assert(false);break;
+        case (0xD2<<3)|6: assert(false);break;
+        case (0xD2<<3)|7: assert(false);break;
+    /* DCP (zp),Y (undoc) */
+        case (0xD3<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xD3<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xD3<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xD3<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0xD3<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xD3<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xD3<<3)|6: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_m6502x_cmp(c,l, c->A[l], c->AD[l]);_WR(););break;
+        case (0xD3<<3)|7: _LANES(_FETCH(););break;
+    /* NOP zp,X (undoc) */
+        case (0xD4<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xD4<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xD4<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0xD4<<3)|3: _LANES(_FETCH(););break;
+        case (0xD4<<3)|4: assert(false);break;
+        case (0xD4<<3)|5: assert(false);break;
+        case (0xD4<<3)|6: assert(false);break;
+        case (0xD4<<3)|7: assert(false);break;
+    /* CMP zp,X */
+        case (0xD5<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xD5<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xD5<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0xD5<<3)|3: _LANES(_m6502x_cmp(c,l, c->A[l], _GD());_FETCH(););break;
+        case (0xD5<<3)|4: assert(false);break;
+        case (0xD5<<3)|5: assert(false);break;
+        case (0xD5<<3)|6: assert(false);break;
+        case (0xD5<<3)|7: assert(false);break;
+    /* DEC zp,X */
+        case (0xD6<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xD6<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xD6<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0xD6<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xD6<<3)|4: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_WR(););break;
+        case (0xD6<<3)|5: _LANES(_FETCH(););break;
+        case (0xD6<<3)|6: assert(false);break;
+        case (0xD6<<3)|7: assert(false);break;
+    /* DCP zp,X (undoc) */
+        case (0xD7<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xD7<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xD7<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0xD7<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xD7<<3)|4: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_m6502x_cmp(c,l, c->A[l], c->AD[l]);_WR(););break;
+        case (0xD7<<3)|5: _LANES(_FETCH(););break;
+        case (0xD7<<3)|6: assert(false);break;
+        case (0xD7<<3)|7: assert(false);break;
+    /* CLD  */
+        case (0xD8<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xD8<<3)|1: _LANES(c->P[l]&=~0x8;_FETCH(););break;
+        case (0xD8<<3)|2: assert(false);break;
+        case (0xD8<<3)|3: assert(false);break;
+        case (0xD8<<3)|4: assert(false);break;
+        case (0xD8<<3)|5: assert(false);break;
+        case (0xD8<<3)|6: assert(false);break;
+        case (0xD8<<3)|7: assert(false);break;
+    /* CMP abs,Y */
+        case (0xD9<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xD9<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xD9<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0xD9<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xD9<<3)|4: _LANES(_m6502x_cmp(c,l, c->A[l], _GD());_FETCH(););break;
+        case (0xD9<<3)|5: assert(false);break;
+        case (0xD9<<3)|6: assert(false);break;
+        case (0xD9<<3)|7: assert(false);break;
+    /* NOP  (undoc) */
+        case (0xDA<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xDA<<3)|1: _LANES(_FETCH(););break;
+        case (0xDA<<3)|2: assert(false);break;
+        case (0xDA<<3)|3: assert(false);break;
+        case (0xDA<<3)|4: assert(false);break;
+        case (0xDA<<3)|5: assert(false);break;
+        case (0xDA<<3)|6: assert(false);break;
+        case (0xDA<<3)|7: assert(false);break;
+    /* DCP abs,Y (undoc) */
+        case (0xDB<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xDB<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xDB<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0xDB<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xDB<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xDB<<3)|5: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_m6502x_cmp(c,l, c->A[l], c->AD[l]);_WR(););break;
+        case (0xDB<<3)|6: _LANES(_FETCH(););break;
+        case (0xDB<<3)|7: assert(false);break;
+    /* NOP abs,X (undoc) */
+        case (0xDC<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xDC<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xDC<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0xDC<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0xDC<<3)|4: _LANES(_FETCH(););break;
+        case (0xDC<<3)|5: assert(false);break;
+        case (0xDC<<3)|6: assert(false);break;
+        case (0xDC<<3)|7: assert(false);break;
+    /* CMP abs,X */
+        case (0xDD<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xDD<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xDD<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0xDD<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0xDD<<3)|4: _LANES(_m6502x_cmp(c,l, c->A[l], _GD());_FETCH(););break;
+        case (0xDD<<3)|5: assert(false);break;
+        case (0xDD<<3)|6: assert(false);break;
+        case (0xDD<<3)|7: assert(false);break;
+    /* DEC abs,X */
+        case (0xDE<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xDE<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xDE<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0xDE<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0xDE<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xDE<<3)|5: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_WR(););break;
+        case (0xDE<<3)|6: _LANES(_FETCH(););break;
+        case (0xDE<<3)|7: assert(false);break;
+    /* DCP abs,X (undoc) */
+        case (0xDF<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xDF<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xDF<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0xDF<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0xDF<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xDF<<3)|5: _LANES(c->AD[l]--;_NZ(c->AD[l]);_SD(c->AD[l]);_m6502x_cmp(c,l, c->A[l], c->AD[l]);_WR(););break;
+        case (0xDF<<3)|6: _LANES(_FETCH(););break;
+        case (0xDF<<3)|7: assert(false);break;
+    /* CPX # */
+        case (0xE0<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xE0<<3)|1: _LANES(_m6502x_cmp(c,l, c->X[l], _GD());_FETCH(););break;
+        case (0xE0<<3)|2: assert(false);break;
+        case (0xE0<<3)|3: assert(false);break;
+        case (0xE0<<3)|4: assert(false);break;
+        case (0xE0<<3)|5: assert(false);break;
+        case (0xE0<<3)|6: assert(false);break;
+        case (0xE0<<3)|7: assert(false);break;
+    /* SBC (zp,X) */
+        case (0xE1<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xE1<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xE1<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0xE1<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xE1<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xE1<<3)|5: _LANES(_m6502x_sbc(c,l,_GD());_FETCH(););break;
+        case (0xE1<<3)|6: assert(false);break;
+        case (0xE1<<3)|7: assert(false);break;
+    /* NOP # (undoc) */
+        case (0xE2<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xE2<<3)|1: _LANES(_FETCH(););break;
+        case (0xE2<<3)|2: assert(false);break;
+        case (0xE2<<3)|3: assert(false);break;
+        case (0xE2<<3)|4: assert(false);break;
+        case (0xE2<<3)|5: assert(false);break;
+        case (0xE2<<3)|6: assert(false);break;
+        case (0xE2<<3)|7: assert(false);break;
+    /* ISB (zp,X) (undoc) */
+        case (0xE3<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xE3<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xE3<<3)|2: _LANES(c->AD[l]=(c->AD[l]+c->X[l])&0xFF;_SA(c->AD[l]););break;
+        case (0xE3<<3)|3: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xE3<<3)|4: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xE3<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xE3<<3)|6: _LANES(c->AD[l]++;_SD(c->AD[l]);_m6502x_sbc(c,l,c->AD[l]);_WR(););break;
+        case (0xE3<<3)|7: _LANES(_FETCH(););break;
+    /* CPX zp */
+        case (0xE4<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xE4<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xE4<<3)|2: _LANES(_m6502x_cmp(c,l, c->X[l], _GD());_FETCH(););break;
+        case (0xE4<<3)|3: assert(false);break;
+        case (0xE4<<3)|4: assert(false);break;
+        case (0xE4<<3)|5: assert(false);break;
+        case (0xE4<<3)|6: assert(false);break;
+        case (0xE4<<3)|7: assert(false);break;
+    /* SBC zp */
+        case (0xE5<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xE5<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xE5<<3)|2: _LANES(_m6502x_sbc(c,l,_GD());_FETCH(););break;
+        case (0xE5<<3)|3: assert(false);break;
+        case (0xE5<<3)|4: assert(false);break;
+        case (0xE5<<3)|5: assert(false);break;
+        case (0xE5<<3)|6: assert(false);break;
+        case (0xE5<<3)|7: assert(false);break;
+    /* INC zp */
+        case (0xE6<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xE6<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xE6<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xE6<<3)|3: _LANES(c->AD[l]++;_NZ(c->AD[l]);_SD(c->AD[l]);_WR(););break;
+        case (0xE6<<3)|4: _LANES(_FETCH(););break;
+        case (0xE6<<3)|5: assert(false);break;
+        case (0xE6<<3)|6: assert(false);break;
+        case (0xE6<<3)|7: assert(false);break;
+    /* ISB zp (undoc) */
+        case (0xE7<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xE7<<3)|1: _LANES(_SA(_GD()););break;
+        case (0xE7<<3)|2: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xE7<<3)|3: _LANES(c->AD[l]++;_SD(c->AD[l]);_m6502x_sbc(c,l,c->AD[l]);_WR(););break;
+        case (0xE7<<3)|4: _LANES(_FETCH(););break;
+        case (0xE7<<3)|5: assert(false);break;
+        case (0xE7<<3)|6: assert(false);break;
+        case (0xE7<<3)|7: assert(false);break;
+    /* INX  */
+        case (0xE8<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xE8<<3)|1: _LANES(c->X[l]++;_NZ(c->X[l]);_FETCH(););break;
+        case (0xE8<<3)|2: assert(false);break;
+        case (0xE8<<3)|3: assert(false);break;
+        case (0xE8<<3)|4: assert(false);break;
+        case (0xE8<<3)|5: assert(false);break;
+        case (0xE8<<3)|6: assert(false);break;
+        case (0xE8<<3)|7: assert(false);break;
+    /* SBC # */
+        case (0xE9<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xE9<<3)|1: _LANES(_m6502x_sbc(c,l,_GD());_FETCH(););break;
+        case (0xE9<<3)|2: assert(false);break;
+        case (0xE9<<3)|3: assert(false);break;
+        case (0xE9<<3)|4: assert(false);break;
+        case (0xE9<<3)|5: assert(false);break;
+        case (0xE9<<3)|6: assert(false);break;
+        case (0xE9<<3)|7: assert(false);break;
+    /* NOP  */
+        case (0xEA<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xEA<<3)|1: _LANES(_FETCH(););break;
+        case (0xEA<<3)|2: assert(false);break;
+        case (0xEA<<3)|3: assert(false);break;
+        case (0xEA<<3)|4: assert(false);break;
+        case (0xEA<<3)|5: assert(false);break;
+        case (0xEA<<3)|6: assert(false);break;
+        case (0xEA<<3)|7: assert(false);break;
+    /* SBC # (undoc) */
+        case (0xEB<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xEB<<3)|1: _LANES(_m6502x_sbc(c,l,_GD());_FETCH(););break;
+        case (0xEB<<3)|2: assert(false);break;
+        case (0xEB<<3)|3: assert(false);break;
+        case (0xEB<<3)|4: assert(false);break;
+        case (0xEB<<3)|5: assert(false);break;
+        case (0xEB<<3)|6: assert(false);break;
+        case (0xEB<<3)|7: assert(false);break;
+    /* CPX abs */
+        case (0xEC<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xEC<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xEC<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xEC<<3)|3: _LANES(_m6502x_cmp(c,l, c->X[l], _GD());_FETCH(););break;
+        case (0xEC<<3)|4: assert(false);break;
+        case (0xEC<<3)|5: assert(false);break;
+        case (0xEC<<3)|6: assert(false);break;
+        case (0xEC<<3)|7: assert(false);break;
+    /* SBC abs */
+        case (0xED<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xED<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xED<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xED<<3)|3: _LANES(_m6502x_sbc(c,l,_GD());_FETCH(););break;
+        case (0xED<<3)|4: assert(false);break;
+        case (0xED<<3)|5: assert(false);break;
+        case (0xED<<3)|6: assert(false);break;
+        case (0xED<<3)|7: assert(false);break;
+    /* INC abs */
+        case (0xEE<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xEE<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xEE<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xEE<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xEE<<3)|4: _LANES(c->AD[l]++;_NZ(c->AD[l]);_SD(c->AD[l]);_WR(););break;
+        case (0xEE<<3)|5: _LANES(_FETCH(););break;
+        case (0xEE<<3)|6: assert(false);break;
+        case (0xEE<<3)|7: assert(false);break;
+    /* ISB abs (undoc) */
+        case (0xEF<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xEF<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xEF<<3)|2: _LANES(_SA((_GD()<<8)|c->AD[l]););break;
+        case (0xEF<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xEF<<3)|4: _LANES(c->AD[l]++;_SD(c->AD[l]);_m6502x_sbc(c,l,c->AD[l]);_WR(););break;
+        case (0xEF<<3)|5: _LANES(_FETCH(););break;
+        case (0xEF<<3)|6: assert(false);break;
+        case (0xEF<<3)|7: assert(false);break;
+    /* BEQ # */
+        case (0xF0<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xF0<<3)|1: _LANES(_SA(c->PC[l]);c->AD[l]=c->PC[l]+(int8_t)_GD();if((c->P[l]&0x2)!=0x2){_FETCH();};);break;
+        case (0xF0<<3)|2: _LANES(_SA((c->PC[l]&0xFF00)|(c->AD[l]&0x00FF));if((c->AD[l]&0xFF00)==(c->PC[l]&0xFF00)){c->PC[l]=c->AD[l];c->irq_pip[l]>>=1;c->nmi_pip[l]>>=1;_FETCH();};);break;
+        case (0xF0<<3)|3: _LANES(c->PC[l]=c->AD[l];_FETCH(););break;
+        case (0xF0<<3)|4: assert(false);break;
+        case (0xF0<<3)|5: assert(false);break;
+        case (0xF0<<3)|6: assert(false);break;
+        case (0xF0<<3)|7: assert(false);break;
+    /* SBC (zp),Y */
+        case (0xF1<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xF1<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xF1<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xF1<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0xF1<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xF1<<3)|5: _LANES(_m6502x_sbc(c,l,_GD());_FETCH(););break;
+        case (0xF1<<3)|6: assert(false);break;
+        case (0xF1<<3)|7: assert(false);break;
+    /* JAM INVALID (undoc) */
+        case (0xF2<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xF2<<3)|1: _LANES(_SAD(0xFFFF,0xFF);c->IR[l]--;);break;
+        case (0xF2<<3)|2: assert(false);break;
+        case (0xF2<<3)|3: assert(false);break;
+        case (0xF2<<3)|4: assert(false);break;
+        case (0xF2<<3)|5: assert(false);break;
+        case (0xF2<<3)|6: assert(false);break;
+        case (0xF2<<3)|7: assert(false);break;
+    /* ISB (zp),Y (undoc) */
+        case (0xF3<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xF3<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xF3<<3)|2: _LANES(_SA((c->AD[l]+1)&0xFF);c->AD[l]=_GD(););break;
+        case (0xF3<<3)|3: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0xF3<<3)|4: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xF3<<3)|5: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xF3<<3)|6: _LANES(c->AD[l]++;_SD(c->AD[l]);_m6502x_sbc(c,l,c->AD[l]);_WR(););break;
+        case (0xF3<<3)|7: _LANES(_FETCH(););break;
+    /* NOP zp,X (undoc) */
+        case (0xF4<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xF4<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xF4<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0xF4<<3)|3: _LANES(_FETCH(););break;
+        case (0xF4<<3)|4: assert(false);break;
+        case (0xF4<<3)|5: assert(false);break;
+        case (0xF4<<3)|6: assert(false);break;
+        case (0xF4<<3)|7: assert(false);break;
+    /* SBC zp,X */
+        case (0xF5<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xF5<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xF5<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0xF5<<3)|3: _LANES(_m6502x_sbc(c,l,_GD());_FETCH(););break;
+        case (0xF5<<3)|4: assert(false);break;
+        case (0xF5<<3)|5: assert(false);break;
+        case (0xF5<<3)|6: assert(false);break;
+        case (0xF5<<3)|7: assert(false);break;
+    /* INC zp,X */
+        case (0xF6<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xF6<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xF6<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0xF6<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xF6<<3)|4: _LANES(c->AD[l]++;_NZ(c->AD[l]);_SD(c->AD[l]);_WR(););break;
+        case (0xF6<<3)|5: _LANES(_FETCH(););break;
+        case (0xF6<<3)|6: assert(false);break;
+        case (0xF6<<3)|7: assert(false);break;
+    /* ISB zp,X (undoc) */
+        case (0xF7<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xF7<<3)|1: _LANES(c->AD[l]=_GD();_SA(c->AD[l]););break;
+        case (0xF7<<3)|2: _LANES(_SA((c->AD[l]+c->X[l])&0x00FF););break;
+        case (0xF7<<3)|3: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xF7<<3)|4: _LANES(c->AD[l]++;_SD(c->AD[l]);_m6502x_sbc(c,l,c->AD[l]);_WR(););break;
+        case (0xF7<<3)|5: _LANES(_FETCH(););break;
+        case (0xF7<<3)|6: assert(false);break;
+        case (0xF7<<3)|7: assert(false);break;
+    /* SED  */
+        case (0xF8<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xF8<<3)|1: _LANES(c->P[l]|=0x8;_FETCH(););break;
+        case (0xF8<<3)|2: assert(false);break;
+        case (0xF8<<3)|3: assert(false);break;
+        case (0xF8<<3)|4: assert(false);break;
+        case (0xF8<<3)|5: assert(false);break;
+        case (0xF8<<3)|6: assert(false);break;
+        case (0xF8<<3)|7: assert(false);break;
+    /* SBC abs,Y */
+        case (0xF9<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xF9<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xF9<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->Y[l])>>8)))&1;);break;
+        case (0xF9<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xF9<<3)|4: _LANES(_m6502x_sbc(c,l,_GD());_FETCH(););break;
+        case (0xF9<<3)|5: assert(false);break;
+        case (0xF9<<3)|6: assert(false);break;
+        case (0xF9<<3)|7: assert(false);break;
+    /* NOP  (undoc) */
+        case (0xFA<<3)|0: _LANES(_SA(c->PC[l]););break;
+        case (0xFA<<3)|1: _LANES(_FETCH(););break;
+        case (0xFA<<3)|2: assert(false);break;
+        case (0xFA<<3)|3: assert(false);break;
+        case (0xFA<<3)|4: assert(false);break;
+        case (0xFA<<3)|5: assert(false);break;
+        case (0xFA<<3)|6: assert(false);break;
+        case (0xFA<<3)|7: assert(false);break;
+    /* ISB abs,Y (undoc) */
+        case (0xFB<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xFB<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xFB<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->Y[l])&0xFF)););break;
+        case (0xFB<<3)|3: _LANES(_SA(c->AD[l]+c->Y[l]););break;
+        case (0xFB<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xFB<<3)|5: _LANES(c->AD[l]++;_SD(c->AD[l]);_m6502x_sbc(c,l,c->AD[l]);_WR(););break;
+        case (0xFB<<3)|6: _LANES(_FETCH(););break;
+        case (0xFB<<3)|7: assert(false);break;
+    /* NOP abs,X (undoc) */
+        case (0xFC<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xFC<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xFC<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0xFC<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0xFC<<3)|4: _LANES(_FETCH(););break;
+        case (0xFC<<3)|5: assert(false);break;
+        case (0xFC<<3)|6: assert(false);break;
+        case (0xFC<<3)|7: assert(false);break;
+    /* SBC abs,X */
+        case (0xFD<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xFD<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xFD<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF));c->IR[l]+=(~((c->AD[l]>>8)-((c->AD[l]+c->X[l])>>8)))&1;);break;
+        case (0xFD<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0xFD<<3)|4: _LANES(_m6502x_sbc(c,l,_GD());_FETCH(););break;
+        case (0xFD<<3)|5: assert(false);break;
+        case (0xFD<<3)|6: assert(false);break;
+        case (0xFD<<3)|7: assert(false);break;
+    /* INC abs,X */
+        case (0xFE<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xFE<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xFE<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0xFE<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0xFE<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xFE<<3)|5: _LANES(c->AD[l]++;_NZ(c->AD[l]);_SD(c->AD[l]);_WR(););break;
+        case (0xFE<<3)|6: _LANES(_FETCH(););break;
+        case (0xFE<<3)|7: assert(false);break;
+    /* ISB abs,X (undoc) */
+        case (0xFF<<3)|0: _LANES(_SA(c->PC[l]++););break;
+        case (0xFF<<3)|1: _LANES(_SA(c->PC[l]++);c->AD[l]=_GD(););break;
+        case (0xFF<<3)|2: _LANES(c->AD[l]|=_GD()<<8;_SA((c->AD[l]&0xFF00)|((c->AD[l]+c->X[l])&0xFF)););break;
+        case (0xFF<<3)|3: _LANES(_SA(c->AD[l]+c->X[l]););break;
+        case (0xFF<<3)|4: _LANES(c->AD[l]=_GD();_WR(););break;
+        case (0xFF<<3)|5: _LANES(c->AD[l]++;_SD(c->AD[l]);_m6502x_sbc(c,l,c->AD[l]);_WR(););break;
+        case (0xFF<<3)|6: _LANES(_FETCH(););break;
+        case (0xFF<<3)|7: assert(false);break;
+        // %>
+            default: _M6502X_UNREACHABLE;
+        }
+    }
+
+    for (int l = 0; l < M6502X_LANES; l++) {
+        if (active & (1U<<l)) {
+            c->PINS[l] = pins[l];
+            c->irq_pip[l] <<= 1;
+            c->nmi_pip[l] <<= 1;
+        }
+    }
+}
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#undef _SA
+#undef _GA
+#undef _SAD
+#undef _FETCH
+#undef _SD
+#undef _GD
+#undef _ON
+#undef _OFF
+#undef _WR
+#undef _NZ
+#undef _LANES
+#undef _M6502X_ALL_LANES
+#undef _M6502X_UNREACHABLE
+#undef _M6502X_AVX2
+#undef _M6502X_SSE2
+#undef _M6502X_NEON
+#endif /* CHIPS_IMPL */
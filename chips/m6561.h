@@ -16,6 +16,11 @@
     CHIPS_ASSERT(c)
     ~~~
 
+    Include the following files before m6561.h:
+
+        chips/chips_common.h
+        chips/chips_audio.h
+
     ## Emulated Pins
     TODO
 
@@ -208,13 +213,13 @@ typedef struct {
     uint8_t volume;
     int sample_period;
     int sample_counter;
-    float sample_accum;
-    float sample_accum_count;
-    float sample_mag;
-    float sample;
-    float dcadj_sum;
+    int32_t sample_accum;
+    int32_t sample_accum_count;
+    int32_t sample_mag;     // output magnitude (fixed-point)
+    int32_t sample;         // last output sample (fixed-point)
+    int32_t dcadj_sum;
     uint32_t dcadj_pos;
-    float dcadj_buf[M6561_DCADJ_BUFLEN];
+    int32_t dcadj_buf[M6561_DCADJ_BUFLEN];
 } m6561_sound_t;
 
 // the m6561_t state struct
@@ -320,7 +325,7 @@ void m6561_init(m6561_t* vic, const m6561_desc_t* desc) {
     vic->user_data = desc->user_data;
     vic->sound.sample_period = (desc->tick_hz * _M6561_FIXEDPOINT_SCALE) / desc->sound_hz;
     vic->sound.sample_counter = vic->sound.sample_period;
-    vic->sound.sample_mag = desc->sound_magnitude;
+    vic->sound.sample_mag = (int32_t)(desc->sound_magnitude * CHIPS_AUDIO_FIXEDPOINT_SCALE);
     vic->sound.noise.shift = 0x7FFFFC;
 }
 
@@ -550,7 +555,7 @@ static void _m6561_tick_video(m6561_t* vic) {
 
 /*--- audio engine code ---*/
 #define _M6561_BIT(val,bitnr) ((val>>bitnr)&1)
-static inline float _m6561_noise_ampl(uint32_t noise_shift) {
+static inline int32_t _m6561_noise_ampl(uint32_t noise_shift) {
     uint32_t amp = (_M6561_BIT(noise_shift,22)<<7) |
                    (_M6561_BIT(noise_shift,20)<<6) |
                    (_M6561_BIT(noise_shift,16)<<5) |
@@ -559,11 +564,11 @@ static inline float _m6561_noise_ampl(uint32_t noise_shift) {
                    (_M6561_BIT(noise_shift,7)<<2) |
                    (_M6561_BIT(noise_shift,4)<<1) |
                    (_M6561_BIT(noise_shift,2)<<0);
-    return ((float)amp) / 256.0f;
+    return (int32_t)amp;
 }
 
 /* center positive volume value around zero */
-static inline float _m6561_dcadjust(m6561_sound_t* snd, float s) {
+static inline int32_t _m6561_dcadjust(m6561_sound_t* snd, int32_t s) {
     snd->dcadj_sum -= snd->dcadj_buf[snd->dcadj_pos];
     snd->dcadj_sum += s;
     snd->dcadj_buf[snd->dcadj_pos] = s;
@@ -585,7 +590,7 @@ static uint64_t _m6561_tick_audio(m6561_t* vic, uint64_t pins) {
             voice->count--;
         }
         if (voice->bit && voice->enabled) {
-            snd->sample_accum += 1.0f;
+            snd->sample_accum += 256;
         }
     }
     /* tick noice channel */
@@ -608,16 +613,17 @@ static uint64_t _m6561_tick_audio(m6561_t* vic, uint64_t pins) {
             snd->sample_accum += _m6561_noise_ampl(noise->shift);
         }
     }
-    snd->sample_accum_count += 1.0f;
+    snd->sample_accum_count++;
 
     /* output a new sample */
     snd->sample_counter -= _M6561_FIXEDPOINT_SCALE;
     if (snd->sample_counter <= 0) {
         snd->sample_counter += snd->sample_period;
-        float sm = (snd->sample_accum / snd->sample_accum_count) * (snd->volume / 15.0f);
-        snd->sample_accum = 0.0f;
-        snd->sample_accum_count = 0.0f;
-        snd->sample = _m6561_dcadjust(snd, sm) * snd->sample_mag;
+        // the accumulator counts 256 per active voice, scale down to fixed-point
+        int32_t sm = (int32_t)(((int64_t)snd->sample_accum * snd->volume * CHIPS_AUDIO_FIXEDPOINT_SCALE) / ((int64_t)snd->sample_accum_count * 256 * 15));
+        snd->sample_accum = 0;
+        snd->sample_accum_count = 0;
+        snd->sample = (int32_t)(((int64_t)_m6561_dcadjust(snd, sm) * snd->sample_mag) / CHIPS_AUDIO_FIXEDPOINT_SCALE);
         pins |= M6561_SAMPLE;
     }
     else {
@@ -37,6 +37,11 @@
     The real VIC-II has multiplexed address bus pins, the emulation
     doesn't.
 
+    If m6569_desc_t.video_band has a callback, it is called from the tick
+    function each time a band of framebuffer rows has been decoded (see
+    'Video Bands' in chips_common.h). With the debug visualization active,
+    the rows cover the entire framebuffer.
+
     TODO: Documentation
 
     ## zlib/libpng license
@@ -161,6 +166,8 @@ typedef struct {
     m6569_fetch_t fetch_cb;
     // optional user-data for fetch callback
     void* user_data;
+    // optional callback for partially decoded frames
+    chips_video_band_desc_t video_band;
 } m6569_desc_t;
 
 // register bank
@@ -298,6 +305,7 @@ typedef struct {
 // the m6569 state structure
 typedef struct {
     bool debug_vis;             // toggle this to switch debug visualization on/off
+    bool video_off;             // toggle this to skip framebuffer writes (headless mode)
     m6569_registers_t reg;
     m6569_crt_t crt;
     m6569_border_unit_t brd;
@@ -306,6 +314,7 @@ typedef struct {
     m6569_graphics_unit_t gunit;
     m6569_sprite_unit_t sunit;
     m6569_video_matrix_t vm;
+    chips_video_band_t video_band;
     uint64_t pins;
 } m6569_t;
 
@@ -401,6 +410,7 @@ void m6569_init(m6569_t* vic, const m6569_desc_t* desc) {
     _m6569_init_crt(&vic->crt, desc);
     vic->mem.fetch_cb = desc->fetch_cb;
     vic->mem.user_data = desc->user_data;
+    chips_video_band_init(&vic->video_band, &desc->video_band);
 }
 
 /*--- reset ------------------------------------------------------------------*/
@@ -1066,17 +1076,122 @@ static inline uint8_t _m6569_color_multiplex(uint16_t bmc, uint16_t sc, uint8_t
     return c;
 }
 
+/*
+    Resolve the graphics mode and the c_data value into a table of up to
+    4 colors for the fast-path pixel decoder, returns true if the table
+    must be indexed with the 2 bits from the half-frequency output (outp2),
+    or false if it must be indexed with the single bit from outp.
+
+    The foreground/background masks in the top 8 bits of the graphics
+    colors are only needed for the sprite multiplexer and collision
+    detection, so they are dropped here.
+*/
+static inline bool _m6569_gunit_colors(const m6569_t* vic, uint8_t mode, uint16_t c_data, uint8_t* colors) {
+    const m6569_graphics_unit_t* gu = &vic->gunit;
+    switch (mode) {
+        case 0:
+            colors[0] = (uint8_t) gu->bg[0];
+            colors[1] = (c_data>>8) & 0xF;
+            return false;
+        case 1:
+            colors[0] = (uint8_t) gu->bg[0];
+            if (c_data & (1<<11)) {
+                colors[1] = (uint8_t) gu->bg[1];
+                colors[2] = (uint8_t) gu->bg[2];
+                colors[3] = (c_data>>8) & 0x7;
+                return true;
+            } else {
+                colors[1] = (c_data>>8) & 0x7;
+                return false;
+            }
+        case 2:
+            colors[0] = c_data & 0xF;
+            colors[1] = (c_data>>4) & 0xF;
+            return false;
+        case 3:
+            colors[0] = (uint8_t) gu->bg[0];
+            colors[1] = (c_data>>4) & 0xF;
+            colors[2] = c_data & 0xF;
+            colors[3] = (c_data>>8) & 0xF;
+            return true;
+        case 4:
+            colors[0] = (uint8_t) gu->bg[(c_data>>6) & 3];
+            colors[1] = (c_data>>8) & 0xF;
+            return false;
+        case 5: case 6: case 7:
+            // illegal modes output black
+            colors[0] = colors[1] = 0;
+            return false;
+        default: _M6569_UNREACHABLE;
+    }
+}
+
+/*
+    Fast-path decoder for 8 pixels when no sprite is displayed on the
+    current raster line. Without sprites there's no need for sprite
+    decoding, collision detection or the priority multiplexer, and the
+    graphics mode only needs to be resolved into a color table once
+    at the start of the 8-pixel group, and once more when the pixel
+    shifter is reloaded (which may happen anywhere inside the 8 pixels
+    because of xscroll). The graphics sequencer state is kept in local
+    variables during the pixel loop, and written back at the end, the
+    result is identical to the per-pixel path in _m6569_decode_pixels().
+*/
+static inline void _m6569_decode_pixels_nosprites(m6569_t* vic, uint8_t g_data, uint8_t* dst) {
+    m6569_graphics_unit_t* gu = &vic->gunit;
+    const uint8_t mode = gu->mode;
+    const bool brd = vic->brd.vert | vic->brd.main;
+    const uint8_t brd_color = vic->brd.main ? vic->brd.bc : gu->bg[0];
+    uint8_t count = gu->count;
+    uint8_t shift = gu->shift;
+    uint8_t outp = gu->outp;
+    uint8_t outp2 = gu->outp2;
+    uint16_t c_data = gu->c_data;
+    uint8_t colors[4] = { brd_color, brd_color, brd_color, brd_color };
+    bool mc = false;
+    if (!brd) {
+        mc = _m6569_gunit_colors(vic, mode, c_data, colors);
+    }
+    for (size_t i = 0; i < 8; i++) {
+        // same as _m6569_gunit_tick()
+        if (count == 0) {
+            count = 7;
+            shift |= g_data;
+            c_data = gu->enabled ? vic->vm.line[vic->vm.vmli] : 0;
+            if (!brd) {
+                mc = _m6569_gunit_colors(vic, mode, c_data, colors);
+            }
+        } else {
+            count--;
+        }
+        outp = shift;
+        if (0 != (count & 1)) {
+            outp2 = shift;
+        }
+        shift <<= 1;
+        dst[i] = colors[mc ? ((outp2>>6) & 3) : (outp>>7)];
+    }
+    gu->count = count;
+    gu->shift = shift;
+    gu->outp = outp;
+    gu->outp2 = outp2;
+    gu->c_data = c_data;
+}
+
 // decode the next 8 pixels
 static inline void _m6569_decode_pixels(m6569_t* vic, uint8_t g_data, uint8_t* dst) {
     const uint8_t hpos = vic->rs.h_count;
     m6569_sprite_unit_t* su = &vic->sunit;
-    if (su->disp_enabled != 0) {
-        for (size_t i = 0; i < 8; i++) {
-            if ((su->disp_enabled & (1<<i)) && (hpos == su->h_first[i])) {
-                su->delay_count[i] = su->h_offset[i];
-                su->outp2_count[i] = 0;
-                su->xexp_count[i] = 0;
-            }
+    if (su->disp_enabled == 0) {
+        // no sprites on this raster line, take the fast path
+        _m6569_decode_pixels_nosprites(vic, g_data, dst);
+        return;
+    }
+    for (size_t i = 0; i < 8; i++) {
+        if ((su->disp_enabled & (1<<i)) && (hpos == su->h_first[i])) {
+            su->delay_count[i] = su->h_offset[i];
+            su->outp2_count[i] = 0;
+            su->xexp_count[i] = 0;
         }
     }
 
@@ -1128,6 +1243,22 @@ static inline void _m6569_decode_pixels(m6569_t* vic, uint8_t g_data, uint8_t* d
     }
 }
 
+/* headless mode: update the graphics sequencer state, sprite sequencer
+    state and collision flags exactly like _m6569_decode_pixels(), but
+    without computing colors and writing to the framebuffer
+*/
+static inline void _m6569_skip_pixels(m6569_t* vic, uint8_t g_data) {
+    if (vic->sunit.disp_enabled != 0) {
+        // sprites may collide, run the complete decoder into a scratch buffer
+        uint8_t dummy[8];
+        _m6569_decode_pixels(vic, g_data, dummy);
+    } else {
+        for (size_t i = 0; i < 8; i++) {
+            _m6569_gunit_tick(vic, g_data);
+        }
+    }
+}
+
 /* decode the next 8 pixels as debug visualization */
 static void _m6569_decode_pixels_debug(m6569_t* vic, uint8_t g_data, bool ba_pin, uint8_t* dst) {
     _m6569_decode_pixels(vic, g_data, dst);
@@ -1276,6 +1407,14 @@ static inline void _m6569_rs_rewind_vc_vmli_rc(m6569_t* vic) {
 }
 
 static inline void _m6569_crt_next_crtline(m6569_t* vic) {
+    if (!vic->debug_vis && vic->video_band.callback.func && !vic->video_off) {
+        if ((vic->crt.y >= vic->crt.vis_y0) && (vic->crt.y < vic->crt.vis_y1)) {
+            chips_video_band_row(&vic->video_band, vic->crt.y - vic->crt.vis_y0);
+        }
+        if (vic->rs.v_count == _M6569_VRETRACEPOS) {
+            chips_video_band_frame(&vic->video_band);
+        }
+    }
     vic->crt.x = 0;
     if (vic->rs.v_count == _M6569_VRETRACEPOS) {
         vic->crt.y = 0;
@@ -1597,11 +1736,29 @@ static uint64_t _m6569_tick(m6569_t* vic, uint64_t pins) {
     }
 
     //--- decode pixels into framebuffer
-    if (vic->debug_vis) {
+    if (vic->video_off) {
+        if ((vic->crt.x >= vic->crt.vis_x0) && (vic->crt.x < vic->crt.vis_x1) &&
+            (vic->crt.y >= vic->crt.vis_y0) && (vic->crt.y < vic->crt.vis_y1))
+        {
+            _m6569_skip_pixels(vic, g_data);
+        }
+    }
+    else if (vic->debug_vis) {
         const size_t x = vic->rs.h_count;
         const size_t y = vic->rs.v_count;
         uint8_t* dst = vic->crt.fb + (y * M6569_FRAMEBUFFER_WIDTH) + (x * M6569_PIXELS_PER_TICK);
         _m6569_decode_pixels_debug(vic, g_data, 0 != (pins & M6569_BA), dst);
+        /* the first pixels of a raster line also restore the beam marker at
+           the end of the previous line, which completes the previous row
+        */
+        if ((x == 0) && vic->video_band.callback.func) {
+            if (y == 0) {
+                chips_video_band_row(&vic->video_band, M6569_VTOTAL - 1);
+                chips_video_band_frame(&vic->video_band);
+            } else {
+                chips_video_band_row(&vic->video_band, (int)y - 1);
+            }
+        }
     }
     else if ((vic->crt.x >= vic->crt.vis_x0) && (vic->crt.x < vic->crt.vis_x1) &&
              (vic->crt.y >= vic->crt.vis_y0) && (vic->crt.y < vic->crt.vis_y1))
@@ -1735,6 +1892,7 @@ void m6569_snapshot_onsave(m6569_t* snapshot) {
     snapshot->mem.fetch_cb = 0;
     snapshot->mem.user_data = 0;
     snapshot->crt.fb = 0;
+    chips_video_band_snapshot_onsave(&snapshot->video_band);
 }
 
 void m6569_snapshot_onload(m6569_t* snapshot, m6569_t* sys) {
@@ -1742,6 +1900,9 @@ void m6569_snapshot_onload(m6569_t* snapshot, m6569_t* sys) {
     snapshot->mem.fetch_cb = sys->mem.fetch_cb;
     snapshot->mem.user_data = sys->mem.user_data;
     snapshot->crt.fb = sys->crt.fb;
+    chips_video_band_snapshot_onload(&snapshot->video_band, &sys->video_band);
+    // headless mode is a host setting, not part of the emulator state
+    snapshot->video_off = sys->video_off;
 }
 
 #endif // CHIPS_IMPL
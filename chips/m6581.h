@@ -18,6 +18,11 @@
     CHIPS_ASSERT(c)
     ~~~
 
+    Include the following files before m6581.h:
+
+        chips/chips_common.h
+        chips/chips_audio.h
+
     ## Emulated Pins
 
     ***********************************
@@ -36,6 +41,42 @@
     The emulation has an additional "virtual pin" which is set to active
     whenever a new sample is ready (M6581_SAMPLE).
 
+    ## Sound Output
+
+    The mixer output is averaged over M6581_BLIP_TICKS ticks, and the
+    averages are converted to output samples with band-limited step
+    synthesis (see 'Band-limited Audio' in chips_audio.h). The sound
+    generation, filter and mixer only use integer math, floating point
+    math is only used when the filter registers are written. The output
+    sample in m6581_t.sample is a fixed-point value (see
+    CHIPS_AUDIO_FIXEDPOINT_SCALE).
+
+    ## Block Processing
+
+    Instead of calling m6581_tick() for every tick, a system emulator can
+    count the ticks and run the sound generation in blocks with
+    m6581_advance() when the chip state is needed (before a register
+    access, and at the end of the exec function), and access the
+    registers with m6581_iorq():
+
+    ~~~C
+    while (num_ticks > 0) {
+        if (m6581_advance(&sid, &num_ticks)) {
+            // new sample is ready in sid.sample
+        }
+    }
+    pins = m6581_iorq(&sid, pins);
+    ~~~
+
+    m6581_advance() runs up to M6581_BLOCK_TICKS ticks until the next sample
+    is ready or the requested number of ticks has been executed, and
+    subtracts the executed ticks from num_ticks. Inside a block, the voices
+    are processed one after another with the waveform selection resolved
+    outside the tick loop (as long as no voice uses hard sync or ring
+    modulation, which couple the voices on every tick), followed by the
+    mixer and filter loop over the whole block. The resulting chip state and
+    samples are identical to calling m6581_tick() the same number of times.
+
     ## Links
 
     - http://blog.kevtris.org/?p=13
@@ -108,6 +149,9 @@ extern "C" {
 #define M6581_CS        (1ULL<<M6581_PIN_CS)
 #define M6581_SAMPLE    (1ULL<<M6581_PIN_SAMPLE)
 
+// max number of ticks processed in one block by m6581_advance()
+#define M6581_BLOCK_TICKS (64)
+
 // registers
 #define M6581_V1_FREQ_LO    (0)
 #define M6581_V1_FREQ_HI    (1)
@@ -232,12 +276,11 @@ typedef struct {
     // filter state
     m6581_filter_t filter;
     // sample generation state
-    int sample_period;
-    int sample_counter;
-    float sample_accum;
-    float sample_accum_count;
-    float sample_mag;
-    float sample;
+    chips_blip_t blip;
+    int sample_accum;           // mixer output accumulated over M6581_BLIP_TICKS ticks
+    int sample_accum_count;
+    int32_t sample_mag;         // output magnitude (fixed-point)
+    int32_t sample;             // last output sample (fixed-point)
     // debug inspection
     uint64_t pins;
 } m6581_t;
@@ -248,6 +291,10 @@ void m6581_init(m6581_t* sid, const m6581_desc_t* desc);
 void m6581_reset(m6581_t* sid);
 // tick a m6581_t instance
 uint64_t m6581_tick(m6581_t* sid, uint64_t pins);
+// run up to num_ticks ticks in a block, stops at the next sample, returns true if a new sample is ready
+bool m6581_advance(m6581_t* sid, uint32_t* num_ticks);
+// perform a register read or write without ticking the chip (for use with m6581_advance())
+uint64_t m6581_iorq(m6581_t* sid, uint64_t pins);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -269,8 +316,8 @@ uint64_t m6581_tick(m6581_t* sid, uint64_t pins);
 #define M6581_GET_DATA(p) ((uint8_t)(((p)&0xFF0000ULL)>>16))
 /* merge 8-bit data bus value into 64-bit pins */
 #define M6581_SET_DATA(p,d) {p=(((p)&~0xFF0000ULL)|(((d)<<16)&0xFF0000ULL));}
-/* fixed point precision for sample period */
-#define M6581_FIXEDPOINT_SCALE (16)
+/* number of ticks averaged into one band-limited step */
+#define M6581_BLIP_TICKS (8)
 /* move bit into first position */
 #define M6581_BIT(val,bitnr) ((val>>bitnr)&1)
 /* filter constants */
@@ -335,10 +382,8 @@ void m6581_init(m6581_t* sid, const m6581_desc_t* desc) {
     CHIPS_ASSERT(desc->sound_hz > 0);
     memset(sid, 0, sizeof(*sid));
     sid->sound_hz = desc->sound_hz;
-    sid->sample_period = (desc->tick_hz * M6581_FIXEDPOINT_SCALE) / desc->sound_hz;
-    sid->sample_counter = sid->sample_period;
-    sid->sample_mag = desc->magnitude;
-    sid->sample_accum_count = 1.0f;
+    chips_blip_init(&sid->blip, desc->tick_hz, desc->sound_hz);
+    sid->sample_mag = (int32_t)(desc->magnitude * CHIPS_AUDIO_FIXEDPOINT_SCALE);
     for (int i = 0; i < 3; i++) {
         _m6581_init_voice(&sid->voice[i]);
     }
@@ -354,10 +399,10 @@ void m6581_reset(m6581_t* sid) {
         _m6581_init_voice(&sid->voice[i]);
     }
     _m6581_init_filter(&sid->filter, sid->sound_hz);
-    sid->sample_counter = sid->sample_period;
-    sid->sample = 0.0f;
-    sid->sample_accum = 0.0f;
-    sid->sample_accum_count = 1.0f;
+    chips_blip_reset(&sid->blip);
+    sid->sample = 0;
+    sid->sample_accum = 0;
+    sid->sample_accum_count = 0;
     sid->pins = 0;
 }
 
@@ -498,10 +543,8 @@ static inline uint16_t _m6581_noise(m6581_voice_t* v) {
            (M6581_BIT(s,2)<<4);
 }
 
-static inline void _m6581_voice_tick(m6581_t* sid, int voice_index) {
-    m6581_voice_t* v = &sid->voice[voice_index];
-
-    /* waveform generator */
+/* step the frequency accumulator and noise generator */
+static inline void _m6581_wave_tick(m6581_voice_t* v) {
     if (0 == (v->ctrl & M6581_CTRL_TEST)) {
         /* frequency accumulator */
         uint32_t prev_accum = v->wav_accum;
@@ -515,23 +558,25 @@ static inline void _m6581_voice_tick(m6581_t* sid, int voice_index) {
         /* sync state */
         v->sync = (v->wav_accum & 0x00800000) && !(prev_accum & 0x00800000);
     }
-    m6581_voice_t* v_sync = &sid->voice[(voice_index+2)%3];
-    uint32_t sm;
-    switch ((v->ctrl>>4) & 0x0F) {
-        case 0: sm = _m6581_wavnone(v); break;
-        case 1: sm = _m6581_triangle(v, v_sync); break;
-        case 2: sm = _m6581_sawtooth(v); break;
-        case 3: sm = _m6581_trisaw(v, v_sync); break;
-        case 4: sm = _m6581_pulse(v); break;
-        case 5: sm = _m6581_tripulse(v, v_sync); break;
-        case 6: sm = _m6581_sawpulse(v); break;
-        case 7: sm = _m6581_trisawpulse(v, v_sync); break;
-        case 8: sm = _m6581_noise(v); break;
-        default: sm = 0; break;
-    }
-    v->wav_output = sm;
+}
 
-    /* envelope generator */
+/* compute the waveform output, 'wave' is the waveform selection from the control register */
+static CHIPS_FORCE_INLINE uint32_t _m6581_wave_output(m6581_voice_t* v, m6581_voice_t* v_sync, int wave) {
+    switch (wave) {
+        case 0: return _m6581_wavnone(v);
+        case 1: return _m6581_triangle(v, v_sync);
+        case 2: return _m6581_sawtooth(v);
+        case 3: return _m6581_trisaw(v, v_sync);
+        case 4: return _m6581_pulse(v);
+        case 5: return _m6581_tripulse(v, v_sync);
+        case 6: return _m6581_sawpulse(v);
+        case 7: return _m6581_trisawpulse(v, v_sync);
+        case 8: return _m6581_noise(v);
+        default: return 0;
+    }
+}
+
+static inline void _m6581_env_tick(m6581_voice_t* v) {
     uint32_t lfsr = v->env_counter;
     if (lfsr != _m6581_rate_count_period[v->env_counter_compare & 0x0F]) {
         const uint32_t feedback = ((lfsr >> 14) ^ (lfsr >> 13)) & 1;
@@ -573,6 +618,14 @@ static inline void _m6581_voice_tick(m6581_t* sid, int voice_index) {
     }
 }
 
+static inline void _m6581_voice_tick(m6581_t* sid, int voice_index) {
+    m6581_voice_t* v = &sid->voice[voice_index];
+    m6581_voice_t* v_sync = &sid->voice[(voice_index+2)%3];
+    _m6581_wave_tick(v);
+    v->wav_output = _m6581_wave_output(v, v_sync, (v->ctrl>>4) & 0x0F);
+    _m6581_env_tick(v);
+}
+
 static inline void _m6581_voice_sync(m6581_t* sid, int voice_index) {
     m6581_voice_t* v = &sid->voice[voice_index];
     m6581_voice_t* v_sync = &sid->voice[(voice_index+2)%3];
@@ -644,6 +697,11 @@ static inline int _m6581_filter_output(m6581_filter_t* f, int vi) {
     return vf * (1<<7);
 }
 
+/* scale the averaged mixer output to a fixed-point band-limited step amplitude */
+static inline int32_t _m6581_blip_level(const m6581_t* sid) {
+    return (int32_t)(((int64_t)sid->sample_accum * sid->sample_mag) / (M6581_BLIP_TICKS * 16384));
+}
+
 /* tick the sound generation, return true when new sample ready */
 static uint64_t _m6581_tick(m6581_t* sid, uint64_t pins) {
     /* decay the last written register value */
@@ -681,18 +739,17 @@ static uint64_t _m6581_tick(m6581_t* sid, uint64_t pins) {
         }
     }
     int accu = (sum_outp + _m6581_filter_output(&sid->filter, sum_filtered_outp) + M6581_DCMIXER) * sid->filter.volume;
-    int sample = accu / (1<<12);
-    sid->sample_accum += (sample / 16384.0f);
-    sid->sample_accum_count += 1.0f;
+    sid->sample_accum += accu / (1<<12);
+    if (++sid->sample_accum_count == M6581_BLIP_TICKS) {
+        /* the averaged output becomes a band-limited step */
+        chips_blip_set(&sid->blip, _m6581_blip_level(sid));
+        sid->sample_accum = 0;
+        sid->sample_accum_count = 0;
+    }
 
     /* new sample? */
-    sid->sample_counter -= M6581_FIXEDPOINT_SCALE;
-    if (sid->sample_counter <= 0) {
-        sid->sample_counter += sid->sample_period;
-        float s = sid->sample_accum / sid->sample_accum_count;
-        sid->sample = sid->sample_mag * s;
-        sid->sample_accum = 0.0f;
-        sid->sample_accum_count = 0.0f;
+    if (chips_blip_advance(&sid->blip, 1)) {
+        sid->sample = chips_blip_sample(&sid->blip);
         pins |= M6581_SAMPLE;
     }
     else {
@@ -701,6 +758,163 @@ static uint64_t _m6581_tick(m6581_t* sid, uint64_t pins) {
     return pins;
 }
 
+/*--- BLOCK PROCESSING --------------------------------------------------------*/
+
+/* the voice block 'template', 'wave' is a compile-time constant in the
+   specialized calls from _m6581_voice_block(), only used when the voice
+   isn't coupled to its neighbour by sync or ring modulation
+*/
+static CHIPS_FORCE_INLINE void _m6581_voice_block_wave(m6581_voice_t* v, uint32_t num_ticks, int* out, int wave, bool mute) {
+    uint32_t wav_out = v->wav_output;
+    for (uint32_t i = 0; i < num_ticks; i++) {
+        _m6581_wave_tick(v);
+        wav_out = _m6581_wave_output(v, v, wave);
+        _m6581_env_tick(v);
+        out[i] = ((mute ? 0 : (int)wav_out) - M6581_DCWAVE) * (int)v->env_cur_level + M6581_DCVOICE;
+    }
+    v->wav_output = wav_out;
+}
+
+static void _m6581_voice_block(m6581_voice_t* v, uint32_t num_ticks, int* out, bool mute) {
+    switch ((v->ctrl>>4) & 0x0F) {
+        case 0: _m6581_voice_block_wave(v, num_ticks, out, 0, mute); break;
+        case 1: _m6581_voice_block_wave(v, num_ticks, out, 1, mute); break;
+        case 2: _m6581_voice_block_wave(v, num_ticks, out, 2, mute); break;
+        case 3: _m6581_voice_block_wave(v, num_ticks, out, 3, mute); break;
+        case 4: _m6581_voice_block_wave(v, num_ticks, out, 4, mute); break;
+        case 5: _m6581_voice_block_wave(v, num_ticks, out, 5, mute); break;
+        case 6: _m6581_voice_block_wave(v, num_ticks, out, 6, mute); break;
+        case 7: _m6581_voice_block_wave(v, num_ticks, out, 7, mute); break;
+        case 8: _m6581_voice_block_wave(v, num_ticks, out, 8, mute); break;
+        default: _m6581_voice_block_wave(v, num_ticks, out, 9, mute); break;
+    }
+}
+
+/* run the sound generation for a block of ticks, must not cross an output sample */
+static void _m6581_run_block(m6581_t* sid, uint32_t num_ticks) {
+    CHIPS_ASSERT((num_ticks > 0) && (num_ticks <= M6581_BLOCK_TICKS));
+    int voice_out[3][M6581_BLOCK_TICKS];
+    int mix_out[M6581_BLOCK_TICKS];
+
+    /* decay the last written register value */
+    if (sid->bus_decay > 0) {
+        if (sid->bus_decay <= num_ticks) {
+            sid->bus_decay = 0;
+            sid->bus_value = 0;
+        }
+        else {
+            sid->bus_decay -= (uint16_t)num_ticks;
+        }
+    }
+
+    /* voice outputs, a muted voice is only silent when not routed through the filter */
+    const uint8_t filt_voices = sid->filter.voices;
+    bool coupled = false;
+    for (int i = 0; i < 3; i++) {
+        if (sid->voice[i].ctrl & (M6581_CTRL_SYNC|M6581_CTRL_RINGMOD)) {
+            coupled = true;
+        }
+    }
+    if (!coupled) {
+        for (int i = 0; i < 3; i++) {
+            const bool mute = sid->voice[i].muted && !(filt_voices & (1<<i));
+            _m6581_voice_block(&sid->voice[i], num_ticks, voice_out[i], mute);
+        }
+    }
+    else {
+        for (uint32_t t = 0; t < num_ticks; t++) {
+            for (int i = 0; i < 3; i++) {
+                _m6581_voice_tick(sid, i);
+            }
+            for (int i = 0; i < 3; i++) {
+                _m6581_voice_sync(sid, i);
+            }
+            for (int i = 0; i < 3; i++) {
+                const m6581_voice_t* v = &sid->voice[i];
+                const bool mute = v->muted && !(filt_voices & (1<<i));
+                voice_out[i][t] = ((mute ? 0 : (int)v->wav_output) - M6581_DCWAVE) * (int)v->env_cur_level + M6581_DCVOICE;
+            }
+        }
+    }
+
+    /* mixer and filter, same as _m6581_filter_output() with the filter state in locals */
+    {
+        m6581_filter_t* f = &sid->filter;
+        const int w0_dt = f->w0 / (1<<6);
+        const int res_coeff = f->resonance_coeff_div_1024;
+        const int volume = f->volume;
+        const int mask_lp = (f->mode & M6581_FILTER_LP) ? -1 : 0;
+        const int mask_bp = (f->mode & M6581_FILTER_BP) ? -1 : 0;
+        const int mask_hp = (f->mode & M6581_FILTER_HP) ? -1 : 0;
+        int v_lp = f->v_lp;
+        int v_bp = f->v_bp;
+        int v_hp = f->v_hp;
+        for (uint32_t t = 0; t < num_ticks; t++) {
+            int sum_filtered_outp = 0;
+            int sum_outp = 0;
+            for (int i = 0; i < 3; i++) {
+                if (filt_voices & (1<<i)) {
+                    sum_filtered_outp += voice_out[i][t];
+                }
+                else {
+                    sum_outp += voice_out[i][t];
+                }
+            }
+            const int vi = sum_filtered_outp / (1<<7);
+            v_lp -= (w0_dt * v_bp) / (1<<14);
+            v_bp -= (w0_dt * v_hp) / (1<<14);
+            v_hp = ((v_bp * res_coeff) / (1<<10)) - v_lp - vi;
+            const int vf = (v_lp & mask_lp) + (v_bp & mask_bp) + (v_hp & mask_hp);
+            mix_out[t] = ((sum_outp + vf * (1<<7) + M6581_DCMIXER) * volume) / (1<<12);
+        }
+        f->v_lp = v_lp;
+        f->v_bp = v_bp;
+        f->v_hp = v_hp;
+    }
+
+    /* average into band-limited steps, see _m6581_tick() */
+    uint32_t blip_ticks = 0;
+    for (uint32_t t = 0; t < num_ticks; t++) {
+        sid->sample_accum += mix_out[t];
+        if (++sid->sample_accum_count == M6581_BLIP_TICKS) {
+            chips_blip_advance(&sid->blip, t - blip_ticks);
+            blip_ticks = t;
+            chips_blip_set(&sid->blip, _m6581_blip_level(sid));
+            sid->sample_accum = 0;
+            sid->sample_accum_count = 0;
+        }
+    }
+    chips_blip_advance(&sid->blip, num_ticks - blip_ticks);
+}
+
+bool m6581_advance(m6581_t* sid, uint32_t* num_ticks) {
+    CHIPS_ASSERT(sid && num_ticks);
+    uint32_t n = *num_ticks;
+    if (n == 0) {
+        return false;
+    }
+    // stop at the tick which generates the next sample
+    bool sample_ready = false;
+    uint32_t ticks_to_sample = chips_blip_ticks_to_sample(&sid->blip);
+    if (ticks_to_sample == 0) {
+        ticks_to_sample = 1;
+    }
+    if (ticks_to_sample <= n) {
+        n = ticks_to_sample;
+        sample_ready = true;
+    }
+    if (n > M6581_BLOCK_TICKS) {
+        n = M6581_BLOCK_TICKS;
+        sample_ready = false;
+    }
+    *num_ticks -= n;
+    _m6581_run_block(sid, n);
+    if (sample_ready) {
+        sid->sample = chips_blip_sample(&sid->blip);
+    }
+    return sample_ready;
+}
+
 /* read a register */
 static uint64_t _m6581_read(m6581_t* sid, uint64_t pins) {
     uint8_t reg = pins & M6581_ADDR_MASK;
@@ -822,6 +1036,11 @@ uint64_t m6581_tick(m6581_t* sid, uint64_t pins) {
     pins = _m6581_tick(sid, pins);
 
     /* register read/write */
+    return m6581_iorq(sid, pins);
+}
+
+uint64_t m6581_iorq(m6581_t* sid, uint64_t pins) {
+    CHIPS_ASSERT(sid);
     if (pins & M6581_CS) {
         if (pins & M6581_RW) {
             pins = _m6581_read(sid, pins);
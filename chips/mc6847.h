@@ -30,6 +30,10 @@
 
     FIXME: documentation
 
+    The tick function hashes each framebuffer line after it has been
+    decoded (see chips_display_hash() in chips_common.h), mc6847_t.frame_hash
+    is the hash of the last completed frame.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -278,6 +282,11 @@ typedef struct {
     // true during field-sync
     bool fs;
 
+    // running hash of the decoded lines of the current frame
+    uint64_t line_hash;
+    // hash of the visible area of the last completed frame
+    uint64_t frame_hash;
+
     // the fetch callback function
     mc6847_fetch_t fetch_cb;
     // optional user-data for the fetch-callback
@@ -324,6 +333,8 @@ void mc6847_init(mc6847_t* vdg, const mc6847_desc_t* desc) {
     vdg->fb = desc->framebuffer.ptr;
     vdg->fetch_cb = desc->fetch_cb;
     vdg->user_data = desc->user_data;
+    vdg->line_hash = CHIPS_HASH_SEED;
+    vdg->frame_hash = CHIPS_HASH_SEED;
 
     /* compute counter periods, the MC6847 is always clocked at 3.579 MHz,
        and the frequency of how the tick function is called must be
@@ -381,6 +392,7 @@ void mc6847_reset(mc6847_t* vdg) {
     CHIPS_ASSERT(vdg);
     vdg->h_count = 0;
     vdg->l_count = 0;
+    vdg->line_hash = CHIPS_HASH_SEED;
 }
 
 /*
@@ -649,24 +661,29 @@ uint64_t mc6847_tick(mc6847_t* vdg, uint64_t pins) {
             // rewind line counter, field sync off
             vdg->l_count = 0;
             vdg->fs = false;
+            vdg->frame_hash = vdg->line_hash;
+            vdg->line_hash = CHIPS_HASH_SEED;
         }
         if (vdg->l_count < MC6847_VBLANK_LINES) {
             // inside vblank area, nothing to do
         }
-        else if (vdg->l_count < MC6847_DISPLAY_START) {
-            // top border
-            size_t y = (size_t) (vdg->l_count - MC6847_VBLANK_LINES);
-            _mc6847_decode_border(vdg, pins, y);
-        }
-        else if (vdg->l_count < MC6847_DISPLAY_END) {
-            // visible area
-            size_t y = (size_t) (vdg->l_count - MC6847_DISPLAY_START);
-            pins = _mc6847_decode_scanline(vdg, pins, y);
-        }
         else if (vdg->l_count < MC6847_BOTTOM_BORDER_END) {
-            // bottom border
-            size_t y = (size_t) (vdg->l_count - MC6847_VBLANK_LINES);
-            _mc6847_decode_border(vdg, pins, y);
+            // framebuffer line, including top and bottom border
+            size_t fb_y = (size_t) (vdg->l_count - MC6847_VBLANK_LINES);
+            if (vdg->l_count < MC6847_DISPLAY_START) {
+                // top border
+                _mc6847_decode_border(vdg, pins, fb_y);
+            }
+            else if (vdg->l_count < MC6847_DISPLAY_END) {
+                // visible area
+                size_t y = (size_t) (vdg->l_count - MC6847_DISPLAY_START);
+                pins = _mc6847_decode_scanline(vdg, pins, y);
+            }
+            else {
+                // bottom border
+                _mc6847_decode_border(vdg, pins, fb_y);
+            }
+            vdg->line_hash = chips_hash(vdg->line_hash, &vdg->fb[fb_y * MC6847_FRAMEBUFFER_WIDTH], MC6847_DISPLAY_WIDTH);
         }
     }
     vdg->pins = pins;
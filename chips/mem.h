@@ -25,6 +25,7 @@
     - memory pages can be mapped as RAM, ROM or RAM-behind-ROM (where
       read accesses are mapped to a different memory page then write accesses)
     - 4 independent page-table layers to simplify bank-switching implementations
+    - dirty-page tracking for memory writes
 
     ## Usage
 
@@ -82,6 +83,37 @@
     - **unmapped page**: the read-pointer points to the internal junk-read-page, and
       the write-pointer to the internal junk-write-page
 
+    ## Dirty-Page Tracking
+
+    Each write through **mem_wr()** (or **mem_layer_wr()**) marks the
+    written page as 'dirty' in a 64-bit bitmap per layer (one bit per
+    1 KByte page). Writes to ROM or unmapped pages are not recorded.
+
+    Call **mem_dirty_pages()** to get the bitmap of written pages in a
+    layer (bit N is set if page N was written since the last call to
+    **mem_clear_dirty()**), and **mem_clear_dirty()** to reset the
+    bitmaps of all layers, for instance:
+
+    ~~~C
+    uint64_t dirty = mem_dirty_pages(&sys->mem, 0);
+    for (size_t page = 0; page < MEM_NUM_PAGES; page++) {
+        if (dirty & (1ULL<<page)) {
+            // host memory of the page at m->layers[0][page].write_ptr has changed
+            ...
+        }
+    }
+    mem_clear_dirty(&sys->mem);
+    ~~~
+
+    Note that the bitmaps track layer pages, not host memory. When a layer
+    page is remapped to a different host memory location, the dirty-bit
+    of the page is not changed, so inspect (and clear) the bitmaps before
+    changing the memory mapping if the actual host memory location matters.
+    If a page with its dirty-bit set is remapped to different host memory,
+    **mem_dirty_remapped()** returns true until the next call to
+    **mem_clear_dirty()**, this means that the bitmaps no longer tell
+    which host memory pages have been written.
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -132,6 +164,12 @@ typedef struct {
     mem_page_t page_table[MEM_NUM_PAGES];
     /* memory-mapped layers, layer 0 is highest priority */
     mem_page_t layers[MEM_NUM_LAYERS][MEM_NUM_PAGES];
+    /* the layer of each CPU-visible page (MEM_NUM_LAYERS for read-only or unmapped pages) */
+    uint8_t page_layer[MEM_NUM_PAGES];
+    /* dirty-page bitmaps, one per layer plus one for writes to read-only or unmapped pages */
+    uint64_t dirty[MEM_NUM_LAYERS + 1];
+    /* true if a dirty page was remapped to different host memory */
+    bool dirty_remapped;
 } mem_t;
 
 /* initialize a new mem instance */
@@ -157,7 +195,9 @@ static inline uint8_t mem_rd(mem_t* mem, uint16_t addr) {
 }
 /* write a byte to 16-bit address */
 static inline void mem_wr(mem_t* mem, uint16_t addr, uint8_t data) {
-    mem->page_table[addr>>MEM_PAGE_SHIFT].write_ptr[addr & MEM_PAGE_MASK] = data;
+    const uint16_t page = addr>>MEM_PAGE_SHIFT;
+    mem->page_table[page].write_ptr[addr & MEM_PAGE_MASK] = data;
+    mem->dirty[mem->page_layer[page]] |= 1ULL<<page;
 }
 /* helper method to write a 16-bit value, does 2 mem_wr() */
 static inline void mem_wr16(mem_t* mem, uint16_t addr, uint16_t data) {
@@ -175,6 +215,12 @@ static inline uint16_t mem_rd16(mem_t* mem, uint16_t addr) {
 uint8_t mem_layer_rd(mem_t* mem, size_t layer, uint16_t addr);
 /* write a byte to a specific layer (slow!) */
 void mem_layer_wr(mem_t* mem, size_t layer, uint16_t addr, uint8_t data);
+/* get the dirty-page bitmap of a layer (bit N is set if page N was written) */
+uint64_t mem_dirty_pages(mem_t* mem, size_t layer);
+/* clear the dirty-page bitmaps of all layers */
+void mem_clear_dirty(mem_t* mem);
+/* true if a dirty page was remapped to different host memory since the last mem_clear_dirty() */
+bool mem_dirty_remapped(mem_t* mem);
 
 /* convert any internal pointers to offsets (helper function for serialization) */
 void mem_snapshot_onsave(mem_t* snapshot, void* base);
@@ -205,6 +251,13 @@ void mem_init(mem_t* m) {
     mem_unmap_all(m);
 }
 
+/* called before a layer page is mapped to a different host memory location */
+static void _mem_check_remap(mem_t* m, size_t layer, size_t page_index, const uint8_t* write_ptr) {
+    if ((m->dirty[layer] & (1ULL<<page_index)) && (m->layers[layer][page_index].write_ptr != write_ptr)) {
+        m->dirty_remapped = true;
+    }
+}
+
 /* this sets the CPU-visible mapping of a page in the page-table */
 static void _mem_update_page_table(mem_t* m, size_t page_index) {
     /* find highest priority layer which maps this memory page */
@@ -247,11 +300,19 @@ static void _mem_update_page_table(mem_t* m, size_t page_index) {
 
         m->page_table[page_index].read_ptr = m->layers[layer_index][page_index].read_ptr;
         m->page_table[page_index].write_ptr = m->layers[layer_index][page_index].write_ptr;
+        /* writes to ROM pages go into the junk page and don't count as dirty */
+        if (m->page_table[page_index].write_ptr != _mem_junk_page) {
+            m->page_layer[page_index] = (uint8_t)layer_index;
+        }
+        else {
+            m->page_layer[page_index] = MEM_NUM_LAYERS;
+        }
     }
     else {
         /* no mapping exists for this page, set to special 'unmapped page' */
         m->page_table[page_index].read_ptr = _mem_unmapped_page;
         m->page_table[page_index].write_ptr = _mem_junk_page;
+        m->page_layer[page_index] = MEM_NUM_LAYERS;
     }
 }
 
@@ -269,13 +330,10 @@ static void _mem_map(mem_t* m, size_t layer, uint16_t addr, uint32_t size, const
         const uint16_t page_index = ((addr+offset) & MEM_ADDR_MASK) >> MEM_PAGE_SHIFT;
         CHIPS_ASSERT(page_index <= MEM_NUM_PAGES);
         mem_page_t* page = &m->layers[layer][page_index];
+        uint8_t* page_write_ptr = (0 != write_ptr) ? (write_ptr + offset) : _mem_junk_page;
+        _mem_check_remap(m, layer, page_index, page_write_ptr);
         page->read_ptr = (uint8_t*)read_ptr + offset;
-        if (0 != write_ptr) {
-            page->write_ptr = write_ptr + offset;
-        }
-        else {
-            page->write_ptr = _mem_junk_page;
-        }
+        page->write_ptr = page_write_ptr;
         _mem_update_page_table(m, page_index);
     }
 }
@@ -300,6 +358,7 @@ void mem_unmap_layer(mem_t* m, size_t layer) {
     CHIPS_ASSERT(layer < MEM_NUM_LAYERS);
     for (size_t page_index = 0; page_index < MEM_NUM_PAGES; page_index++) {
         mem_page_t* page = &m->layers[layer][page_index];
+        _mem_check_remap(m, layer, page_index, 0);
         page->read_ptr = 0;
         page->write_ptr = 0;
         _mem_update_page_table(m, page_index);
@@ -310,6 +369,7 @@ void mem_unmap_all(mem_t* m) {
     for (size_t layer_index = 0; layer_index < MEM_NUM_LAYERS; layer_index++) {
         for (size_t page_index = 0; page_index < MEM_NUM_PAGES; page_index++) {
             mem_page_t* page = &m->layers[layer_index][page_index];
+            _mem_check_remap(m, layer_index, page_index, 0);
             page->read_ptr = 0;
             page->write_ptr = 0;
         }
@@ -342,9 +402,32 @@ uint8_t mem_layer_rd(mem_t* mem, size_t layer, uint16_t addr) {
 
 void mem_layer_wr(mem_t* mem, size_t layer, uint16_t addr, uint8_t data) {
     CHIPS_ASSERT(layer < MEM_NUM_LAYERS);
-    if (mem->layers[layer][addr>>MEM_PAGE_SHIFT].write_ptr) {
-        mem->layers[layer][addr>>MEM_PAGE_SHIFT].write_ptr[addr&MEM_PAGE_MASK] = data;
+    uint8_t* write_ptr = mem->layers[layer][addr>>MEM_PAGE_SHIFT].write_ptr;
+    if (write_ptr) {
+        write_ptr[addr&MEM_PAGE_MASK] = data;
+        if (write_ptr != _mem_junk_page) {
+            mem->dirty[layer] |= 1ULL<<(addr>>MEM_PAGE_SHIFT);
+        }
+    }
+}
+
+uint64_t mem_dirty_pages(mem_t* mem, size_t layer) {
+    CHIPS_ASSERT(mem);
+    CHIPS_ASSERT(layer < MEM_NUM_LAYERS);
+    return mem->dirty[layer];
+}
+
+void mem_clear_dirty(mem_t* mem) {
+    CHIPS_ASSERT(mem);
+    for (size_t layer = 0; layer <= MEM_NUM_LAYERS; layer++) {
+        mem->dirty[layer] = 0;
     }
+    mem->dirty_remapped = false;
+}
+
+bool mem_dirty_remapped(mem_t* mem) {
+    CHIPS_ASSERT(mem);
+    return mem->dirty_remapped;
 }
 
 #define MEM_SPECIAL_OFFSET_NULLPTR (-1)
@@ -63,6 +63,23 @@
         Helper function to detect whether the z80_t instance has completed
         an instruction.
 
+    ~~~C
+    uint32_t z80_exec_op(z80_t* cpu, uint64_t* pins, z80_bus_t bus)
+    ~~~
+        Execute one complete instruction (or interrupt request) in the
+        instruction-stepped fast path and return the number of executed
+        clock cycles. Memory and IO requests are not returned through
+        the pin mask, but are handled by calling the bus callback
+        (see below for details).
+
+    ~~~C
+    uint32_t z80_exec(z80_t* cpu, uint64_t* pins, uint32_t num_ticks, z80_bus_t bus)
+    ~~~
+        Run instructions in the instruction-stepped fast path until
+        at least num_ticks clock cycles have been executed, returns the
+        number of executed clock cycles (which may be slightly more
+        than num_ticks because instructions are never interrupted).
+
     ## HOWTO
 
     Initialize a new z80_t instance and start ticking it:
@@ -182,6 +199,64 @@
     To emulate a whole computer system, add the per-tick code for the rest of the system to the
     basic ticking code above.
 
+    ## Instruction-Stepped Fast Path
+
+    If the emulated system doesn't need to observe the CPU bus on each
+    clock cycle (for instance headless test runners), the Z80 can run entire
+    instructions with z80_exec_op() or z80_exec(). The instruction-stepped
+    decoder is generated from the same instruction descriptions as the
+    cycle-stepped decoder and produces the same register results and
+    clock cycle counts, but the decoder switch-case is only entered once
+    per instruction instead of once per clock cycle.
+
+    Memory and IO requests are handled in a bus callback which gets the
+    same pin mask as the cycle-stepped code would see after z80_tick()
+    (only for clock cycles with an actual memory read/write, IO read/write
+    or interrupt acknowledge request, refresh cycles are skipped):
+    ~~~C
+        static uint64_t bus(uint64_t pins, void* user_data) {
+            uint8_t* mem = (uint8_t*) user_data;
+            if (pins & Z80_MREQ) {
+                const uint16_t addr = Z80_GET_ADDR(pins);
+                if (pins & Z80_RD) {
+                    Z80_SET_DATA(pins, mem[addr]);
+                }
+                else if (pins & Z80_WR) {
+                    mem[addr] = Z80_GET_DATA(pins);
+                }
+            }
+            else if (pins & Z80_IORQ) {
+                ...
+            }
+            return pins;
+        }
+
+        ...
+        uint64_t pins = z80_init(&cpu);
+        while (!done) {
+            const uint32_t num_ticks = z80_exec_op(&cpu, &pins, (z80_bus_t){ .func = bus, .user_data = mem });
+            // tick the rest of the system for num_ticks clock cycles
+            ...
+        }
+    ~~~
+    Interrupt requests are sampled from the pin mask passed into z80_exec_op()
+    and from the pin masks returned by the bus callback, and are handled at
+    the next instruction boundary.
+
+    Switching between the cycle-stepped and instruction-stepped mode is
+    possible at any time, z80_exec_op() first finishes a partially executed
+    instruction with z80_tick(), and the pin mask returned by z80_exec_op()
+    is the same as returned by z80_tick() in the last clock cycle of an
+    instruction. The only exception is the virtual Z80_RETI pin: it is never
+    set in the pin mask passed to the bus callback, instead it is set in the
+    pin mask returned by z80_exec_op() after a RETI instruction, so that
+    daisychain devices ticked with the returned pin mask see it exactly once
+    (use z80_exec_op() instead of z80_exec() in systems with daisychain
+    devices).
+
+    !!! note
+        The Z80_WAIT pin is ignored in the instruction-stepped fast path.
+
     If the emulated system uses the Z80 daisychain interrupt protocol (for instance when using
     the Z80 family chips like the PIO or CTC), tick those chips in interrupt priority order and
     set the Z80_IEIO pin before the highest priority chip in the daisychain is ticked:
@@ -365,6 +440,12 @@ typedef struct {
     bool iff1, iff2;
 } z80_t;
 
+// bus callback for the instruction-stepped fast path
+typedef struct {
+    uint64_t (*func)(uint64_t pins, void* user_data);
+    void* user_data;
+} z80_bus_t;
+
 // initialize a new Z80 instance and return initial pin mask
 uint64_t z80_init(z80_t* cpu);
 // immediately put Z80 into reset state
@@ -375,6 +456,10 @@ uint64_t z80_tick(z80_t* cpu, uint64_t pins);
 uint64_t z80_prefetch(z80_t* cpu, uint16_t new_pc);
 // return true when full instruction has finished
 bool z80_opdone(z80_t* cpu);
+// execute one complete instruction via bus callback, return number of ticks
+uint32_t z80_exec_op(z80_t* cpu, uint64_t* pins, z80_bus_t bus);
+// execute instructions via bus callback for at least num_ticks, return number of ticks
+uint32_t z80_exec(z80_t* cpu, uint64_t* pins, uint32_t num_ticks, z80_bus_t bus);
 
 #ifdef __cplusplus
 } // extern C
@@ -2817,6 +2902,8 @@ step_to: {
 #undef _sadx
 #undef _gd
 #undef _skip
+#undef _goto
+#undef _fetch
 #undef _fetch_dd
 #undef _fetch_fd
 #undef _fetch_ed
@@ -2835,4 +2922,713 @@ step_to: {
 #undef _cc_p
 #undef _cc_m
 
+//=== INSTRUCTION-STEPPED FAST PATH ============================================
+
+// invoke the bus callback and track interrupt pins like the cycle-stepped decoder
+static inline uint64_t _z80_bus(z80_t* cpu, z80_bus_t* bus, uint64_t pins) {
+    pins = bus->func(pins, bus->user_data);
+    const uint64_t rising_nmi = (pins ^ cpu->pins) & pins; // NMI 0 => 1
+    cpu->pins = pins;
+    cpu->int_bits = ((cpu->int_bits | rising_nmi) & Z80_NMI) | (pins & Z80_INT);
+    return pins;
+}
+
+// check if the decoder is at the start of an instruction or interrupt request
+static inline bool _z80_at_op_start(z80_t* cpu) {
+    switch (cpu->step) {
+        case Z80_M1_T2:
+        case Z80_INT_IM0_STEP:
+        case Z80_INT_IM1_STEP:
+        case Z80_INT_IM2_STEP:
+        case Z80_NMI_STEP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// fast path helper macros
+#define _bus(p)             pins=_z80_bus(cpu,&bus,p)
+#define _gd()               _z80_get_db(pins)
+#define _mread(ab)          _bus(_z80_set_ab_x(pins&~Z80_CTRL_PIN_MASK,ab,Z80_MREQ|Z80_RD))
+#define _mwrite(ab,d)       _bus(_z80_set_ab_db_x(pins&~Z80_CTRL_PIN_MASK,ab,d,Z80_MREQ|Z80_WR))
+#define _ioread(ab)         _bus(_z80_set_ab_x(pins&~Z80_CTRL_PIN_MASK,ab,Z80_IORQ|Z80_RD))
+#define _iowrite(ab,d)      _bus(_z80_set_ab_db_x(pins&~Z80_CTRL_PIN_MASK,ab,d,Z80_IORQ|Z80_WR))
+#define _ioack()            _bus((pins&~Z80_CTRL_PIN_MASK)|Z80_M1|Z80_IORQ)
+#define _m1read()           _bus(_z80_set_ab_x(pins&~Z80_CTRL_PIN_MASK,cpu->pc++,Z80_M1|Z80_MREQ|Z80_RD))
+#define _ticks(n)           ticks+=n
+#define _skip(n,l)          {ticks+=n;goto l;}
+#define _dispatch(n,o)      {ticks+=n;op=o;goto dispatch;}
+#define _fetch(n)           {ticks+=n;goto fetch_next;}
+#define _fetch_post(n,a)    {ticks+=n;pins=_z80_fetch(cpu,pins&~Z80_CTRL_PIN_MASK);a;goto done;}
+#define _fetch_dd(n)        {ticks+=n;cpu->hlx_idx=1;goto fetch_ddfd;}
+#define _fetch_fd(n)        {ticks+=n;cpu->hlx_idx=2;goto fetch_ddfd;}
+#define _fetch_ed(n)        {ticks+=n;goto fetch_ed;}
+#define _fetch_cb(n)        {ticks+=n;goto fetch_cb;}
+#define _cc_nz              (!(cpu->f&Z80_ZF))
+#define _cc_z               (cpu->f&Z80_ZF)
+#define _cc_nc              (!(cpu->f&Z80_CF))
+#define _cc_c               (cpu->f&Z80_CF)
+#define _cc_po              (!(cpu->f&Z80_PF))
+#define _cc_pe              (cpu->f&Z80_PF)
+#define _cc_p               (!(cpu->f&Z80_SF))
+#define _cc_m               (cpu->f&Z80_SF)
+
+uint32_t z80_exec_op(z80_t* cpu, uint64_t* pins_ptr, z80_bus_t bus) {
+    CHIPS_ASSERT(cpu && pins_ptr && bus.func);
+    uint64_t pins = *pins_ptr;
+    uint32_t ticks = 0;
+    uint32_t op;
+
+    // finish a partially executed instruction in the cycle-stepped decoder
+    // (this is also the case after z80_init(), z80_reset() and z80_prefetch())
+    while (!_z80_at_op_start(cpu)) {
+        pins = z80_tick(cpu, pins);
+        ticks++;
+        if (!_z80_at_op_start(cpu) && (pins & (Z80_MREQ|Z80_IORQ))) {
+            pins = bus.func(pins, bus.user_data);
+        }
+    }
+    pins &= ~(Z80_CTRL_PIN_MASK|Z80_RETI);
+    // sample interrupt pins from the pin mask passed in from the outside
+    {
+        const uint64_t rising_nmi = (pins ^ cpu->pins) & pins; // NMI 0 => 1
+        cpu->pins = pins;
+        cpu->int_bits = ((cpu->int_bits | rising_nmi) & Z80_NMI) | (pins & Z80_INT);
+    }
+    if (cpu->step == Z80_M1_T2) {
+        // regular opcode fetch machine cycle, the PC has already been incremented in _z80_fetch()
+        cpu->pc--;
+        _m1read();
+        cpu->opcode = _gd();
+        pins = _z80_refresh(cpu, pins);
+        cpu->addr = cpu->hl;
+        ticks += 3;
+        op = cpu->opcode;
+    }
+    else {
+        // interrupt handling
+        op = cpu->step;
+    }
+dispatch:
+    switch (op) {
+        // <% fast_decoder
+        case    0: _fetch(1); // NOP
+        case    1: _mread(cpu->pc++);cpu->c=_gd();_mread(cpu->pc++);cpu->b=_gd();_fetch(7); // LD BC,nn
+        case    2: _mwrite(cpu->bc,cpu->a);cpu->wzl=cpu->c+1;cpu->wzh=cpu->a;_fetch(4); // LD (BC),A
+        case    3: cpu->bc++;_fetch(3); // INC BC
+        case    4: cpu->b=_z80_inc8(cpu,cpu->b);_fetch(1); // INC B
+        case    5: cpu->b=_z80_dec8(cpu,cpu->b);_fetch(1); // DEC B
+        case    6: _mread(cpu->pc++);cpu->b=_gd();_fetch(4); // LD B,n
+        case    7: _z80_rlca(cpu);_fetch(1); // RLCA
+        case    8: _z80_ex_af_af2(cpu);_fetch(1); // EX AF,AF'
+        case    9: _z80_add16(cpu,cpu->bc);_fetch(8); // ADD HL,BC
+        case   10: _mread(cpu->bc);cpu->a=_gd();cpu->wz=cpu->bc+1;_fetch(4); // LD A,(BC)
+        case   11: cpu->bc--;_fetch(3); // DEC BC
+        case   12: cpu->c=_z80_inc8(cpu,cpu->c);_fetch(1); // INC C
+        case   13: cpu->c=_z80_dec8(cpu,cpu->c);_fetch(1); // DEC C
+        case   14: _mread(cpu->pc++);cpu->c=_gd();_fetch(4); // LD C,n
+        case   15: _z80_rrca(cpu);_fetch(1); // RRCA
+        case   16: _mread(cpu->pc++);cpu->dlatch=_gd();if(--cpu->b==0){_skip(4,l_16_9);};cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;_ticks(9);l_16_9:_fetch(1); // DJNZ d
+        case   17: _mread(cpu->pc++);cpu->e=_gd();_mread(cpu->pc++);cpu->d=_gd();_fetch(7); // LD DE,nn
+        case   18: _mwrite(cpu->de,cpu->a);cpu->wzl=cpu->e+1;cpu->wzh=cpu->a;_fetch(4); // LD (DE),A
+        case   19: cpu->de++;_fetch(3); // INC DE
+        case   20: cpu->d=_z80_inc8(cpu,cpu->d);_fetch(1); // INC D
+        case   21: cpu->d=_z80_dec8(cpu,cpu->d);_fetch(1); // DEC D
+        case   22: _mread(cpu->pc++);cpu->d=_gd();_fetch(4); // LD D,n
+        case   23: _z80_rla(cpu);_fetch(1); // RLA
+        case   24: _mread(cpu->pc++);cpu->dlatch=_gd();cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;_fetch(9); // JR d
+        case   25: _z80_add16(cpu,cpu->de);_fetch(8); // ADD HL,DE
+        case   26: _mread(cpu->de);cpu->a=_gd();cpu->wz=cpu->de+1;_fetch(4); // LD A,(DE)
+        case   27: cpu->de--;_fetch(3); // DEC DE
+        case   28: cpu->e=_z80_inc8(cpu,cpu->e);_fetch(1); // INC E
+        case   29: cpu->e=_z80_dec8(cpu,cpu->e);_fetch(1); // DEC E
+        case   30: _mread(cpu->pc++);cpu->e=_gd();_fetch(4); // LD E,n
+        case   31: _z80_rra(cpu);_fetch(1); // RRA
+        case   32: _mread(cpu->pc++);cpu->dlatch=_gd();if(!(_cc_nz)){_skip(3,l_32_8);};cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;_ticks(8);l_32_8:_fetch(1); // JR NZ,d
+        case   33: _mread(cpu->pc++);cpu->hlx[cpu->hlx_idx].l=_gd();_mread(cpu->pc++);cpu->hlx[cpu->hlx_idx].h=_gd();_fetch(7); // LD HL,nn
+        case   34: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mwrite(cpu->wz++,cpu->hlx[cpu->hlx_idx].l);_mwrite(cpu->wz,cpu->hlx[cpu->hlx_idx].h);_fetch(13); // LD (nn),HL
+        case   35: cpu->hlx[cpu->hlx_idx].hl++;_fetch(3); // INC HL
+        case   36: cpu->hlx[cpu->hlx_idx].h=_z80_inc8(cpu,cpu->hlx[cpu->hlx_idx].h);_fetch(1); // INC H
+        case   37: cpu->hlx[cpu->hlx_idx].h=_z80_dec8(cpu,cpu->hlx[cpu->hlx_idx].h);_fetch(1); // DEC H
+        case   38: _mread(cpu->pc++);cpu->hlx[cpu->hlx_idx].h=_gd();_fetch(4); // LD H,n
+        case   39: _z80_daa(cpu);_fetch(1); // DAA
+        case   40: _mread(cpu->pc++);cpu->dlatch=_gd();if(!(_cc_z)){_skip(3,l_40_8);};cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;_ticks(8);l_40_8:_fetch(1); // JR Z,d
+        case   41: _z80_add16(cpu,cpu->hlx[cpu->hlx_idx].hl);_fetch(8); // ADD HL,HL
+        case   42: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mread(cpu->wz++);cpu->hlx[cpu->hlx_idx].l=_gd();_mread(cpu->wz);cpu->hlx[cpu->hlx_idx].h=_gd();_fetch(13); // LD HL,(nn)
+        case   43: cpu->hlx[cpu->hlx_idx].hl--;_fetch(3); // DEC HL
+        case   44: cpu->hlx[cpu->hlx_idx].l=_z80_inc8(cpu,cpu->hlx[cpu->hlx_idx].l);_fetch(1); // INC L
+        case   45: cpu->hlx[cpu->hlx_idx].l=_z80_dec8(cpu,cpu->hlx[cpu->hlx_idx].l);_fetch(1); // DEC L
+        case   46: _mread(cpu->pc++);cpu->hlx[cpu->hlx_idx].l=_gd();_fetch(4); // LD L,n
+        case   47: _z80_cpl(cpu);_fetch(1); // CPL
+        case   48: _mread(cpu->pc++);cpu->dlatch=_gd();if(!(_cc_nc)){_skip(3,l_48_8);};cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;_ticks(8);l_48_8:_fetch(1); // JR NC,d
+        case   49: _mread(cpu->pc++);cpu->spl=_gd();_mread(cpu->pc++);cpu->sph=_gd();_fetch(7); // LD SP,nn
+        case   50: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mwrite(cpu->wz++,cpu->a);cpu->wzh=cpu->a;_fetch(10); // LD (nn),A
+        case   51: cpu->sp++;_fetch(3); // INC SP
+        case   52: _mread(cpu->addr);cpu->dlatch=_gd();cpu->dlatch=_z80_inc8(cpu,cpu->dlatch);_mwrite(cpu->addr,cpu->dlatch);_fetch(8); // INC (HL)
+        case   53: _mread(cpu->addr);cpu->dlatch=_gd();cpu->dlatch=_z80_dec8(cpu,cpu->dlatch);_mwrite(cpu->addr,cpu->dlatch);_fetch(8); // DEC (HL)
+        case   54: _mread(cpu->pc++);cpu->dlatch=_gd();_mwrite(cpu->addr,cpu->dlatch);_fetch(7); // LD (HL),n
+        case   55: _z80_scf(cpu);_fetch(1); // SCF
+        case   56: _mread(cpu->pc++);cpu->dlatch=_gd();if(!(_cc_c)){_skip(3,l_56_8);};cpu->pc+=(int8_t)cpu->dlatch;cpu->wz=cpu->pc;_ticks(8);l_56_8:_fetch(1); // JR C,d
+        case   57: _z80_add16(cpu,cpu->sp);_fetch(8); // ADD HL,SP
+        case   58: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mread(cpu->wz++);cpu->a=_gd();_fetch(10); // LD A,(nn)
+        case   59: cpu->sp--;_fetch(3); // DEC SP
+        case   60: cpu->a=_z80_inc8(cpu,cpu->a);_fetch(1); // INC A
+        case   61: cpu->a=_z80_dec8(cpu,cpu->a);_fetch(1); // DEC A
+        case   62: _mread(cpu->pc++);cpu->a=_gd();_fetch(4); // LD A,n
+        case   63: _z80_ccf(cpu);_fetch(1); // CCF
+        case   64: cpu->b=cpu->b;_fetch(1); // LD B,B
+        case   65: cpu->b=cpu->c;_fetch(1); // LD B,C
+        case   66: cpu->b=cpu->d;_fetch(1); // LD B,D
+        case   67: cpu->b=cpu->e;_fetch(1); // LD B,E
+        case   68: cpu->b=cpu->hlx[cpu->hlx_idx].h;_fetch(1); // LD B,H
+        case   69: cpu->b=cpu->hlx[cpu->hlx_idx].l;_fetch(1); // LD B,L
+        case   70: _mread(cpu->addr);cpu->b=_gd();_fetch(4); // LD B,(HL)
+        case   71: cpu->b=cpu->a;_fetch(1); // LD B,A
+        case   72: cpu->c=cpu->b;_fetch(1); // LD C,B
+        case   73: cpu->c=cpu->c;_fetch(1); // LD C,C
+        case   74: cpu->c=cpu->d;_fetch(1); // LD C,D
+        case   75: cpu->c=cpu->e;_fetch(1); // LD C,E
+        case   76: cpu->c=cpu->hlx[cpu->hlx_idx].h;_fetch(1); // LD C,H
+        case   77: cpu->c=cpu->hlx[cpu->hlx_idx].l;_fetch(1); // LD C,L
+        case   78: _mread(cpu->addr);cpu->c=_gd();_fetch(4); // LD C,(HL)
+        case   79: cpu->c=cpu->a;_fetch(1); // LD C,A
+        case   80: cpu->d=cpu->b;_fetch(1); // LD D,B
+        case   81: cpu->d=cpu->c;_fetch(1); // LD D,C
+        case   82: cpu->d=cpu->d;_fetch(1); // LD D,D
+        case   83: cpu->d=cpu->e;_fetch(1); // LD D,E
+        case   84: cpu->d=cpu->hlx[cpu->hlx_idx].h;_fetch(1); // LD D,H
+        case   85: cpu->d=cpu->hlx[cpu->hlx_idx].l;_fetch(1); // LD D,L
+        case   86: _mread(cpu->addr);cpu->d=_gd();_fetch(4); // LD D,(HL)
+        case   87: cpu->d=cpu->a;_fetch(1); // LD D,A
+        case   88: cpu->e=cpu->b;_fetch(1); // LD E,B
+        case   89: cpu->e=cpu->c;_fetch(1); // LD E,C
+        case   90: cpu->e=cpu->d;_fetch(1); // LD E,D
+        case   91: cpu->e=cpu->e;_fetch(1); // LD E,E
+        case   92: cpu->e=cpu->hlx[cpu->hlx_idx].h;_fetch(1); // LD E,H
+        case   93: cpu->e=cpu->hlx[cpu->hlx_idx].l;_fetch(1); // LD E,L
+        case   94: _mread(cpu->addr);cpu->e=_gd();_fetch(4); // LD E,(HL)
+        case   95: cpu->e=cpu->a;_fetch(1); // LD E,A
+        case   96: cpu->hlx[cpu->hlx_idx].h=cpu->b;_fetch(1); // LD H,B
+        case   97: cpu->hlx[cpu->hlx_idx].h=cpu->c;_fetch(1); // LD H,C
+        case   98: cpu->hlx[cpu->hlx_idx].h=cpu->d;_fetch(1); // LD H,D
+        case   99: cpu->hlx[cpu->hlx_idx].h=cpu->e;_fetch(1); // LD H,E
+        case  100: cpu->hlx[cpu->hlx_idx].h=cpu->hlx[cpu->hlx_idx].h;_fetch(1); // LD H,H
+        case  101: cpu->hlx[cpu->hlx_idx].h=cpu->hlx[cpu->hlx_idx].l;_fetch(1); // LD H,L
+        case  102: _mread(cpu->addr);cpu->h=_gd();_fetch(4); // LD H,(HL)
+        case  103: cpu->hlx[cpu->hlx_idx].h=cpu->a;_fetch(1); // LD H,A
+        case  104: cpu->hlx[cpu->hlx_idx].l=cpu->b;_fetch(1); // LD L,B
+        case  105: cpu->hlx[cpu->hlx_idx].l=cpu->c;_fetch(1); // LD L,C
+        case  106: cpu->hlx[cpu->hlx_idx].l=cpu->d;_fetch(1); // LD L,D
+        case  107: cpu->hlx[cpu->hlx_idx].l=cpu->e;_fetch(1); // LD L,E
+        case  108: cpu->hlx[cpu->hlx_idx].l=cpu->hlx[cpu->hlx_idx].h;_fetch(1); // LD L,H
+        case  109: cpu->hlx[cpu->hlx_idx].l=cpu->hlx[cpu->hlx_idx].l;_fetch(1); // LD L,L
+        case  110: _mread(cpu->addr);cpu->l=_gd();_fetch(4); // LD L,(HL)
+        case  111: cpu->hlx[cpu->hlx_idx].l=cpu->a;_fetch(1); // LD L,A
+        case  112: _mwrite(cpu->addr,cpu->b);_fetch(4); // LD (HL),B
+        case  113: _mwrite(cpu->addr,cpu->c);_fetch(4); // LD (HL),C
+        case  114: _mwrite(cpu->addr,cpu->d);_fetch(4); // LD (HL),D
+        case  115: _mwrite(cpu->addr,cpu->e);_fetch(4); // LD (HL),E
+        case  116: _mwrite(cpu->addr,cpu->h);_fetch(4); // LD (HL),H
+        case  117: _mwrite(cpu->addr,cpu->l);_fetch(4); // LD (HL),L
+        case  118: pins=_z80_halt(cpu,pins);_fetch(1); // HALT
+        case  119: _mwrite(cpu->addr,cpu->a);_fetch(4); // LD (HL),A
+        case  120: cpu->a=cpu->b;_fetch(1); // LD A,B
+        case  121: cpu->a=cpu->c;_fetch(1); // LD A,C
+        case  122: cpu->a=cpu->d;_fetch(1); // LD A,D
+        case  123: cpu->a=cpu->e;_fetch(1); // LD A,E
+        case  124: cpu->a=cpu->hlx[cpu->hlx_idx].h;_fetch(1); // LD A,H
+        case  125: cpu->a=cpu->hlx[cpu->hlx_idx].l;_fetch(1); // LD A,L
+        case  126: _mread(cpu->addr);cpu->a=_gd();_fetch(4); // LD A,(HL)
+        case  127: cpu->a=cpu->a;_fetch(1); // LD A,A
+        case  128: _z80_add8(cpu,cpu->b);_fetch(1); // ADD B
+        case  129: _z80_add8(cpu,cpu->c);_fetch(1); // ADD C
+        case  130: _z80_add8(cpu,cpu->d);_fetch(1); // ADD D
+        case  131: _z80_add8(cpu,cpu->e);_fetch(1); // ADD E
+        case  132: _z80_add8(cpu,cpu->hlx[cpu->hlx_idx].h);_fetch(1); // ADD H
+        case  133: _z80_add8(cpu,cpu->hlx[cpu->hlx_idx].l);_fetch(1); // ADD L
+        case  134: _mread(cpu->addr);cpu->dlatch=_gd();_z80_add8(cpu,cpu->dlatch);_fetch(4); // ADD (HL)
+        case  135: _z80_add8(cpu,cpu->a);_fetch(1); // ADD A
+        case  136: _z80_adc8(cpu,cpu->b);_fetch(1); // ADC B
+        case  137: _z80_adc8(cpu,cpu->c);_fetch(1); // ADC C
+        case  138: _z80_adc8(cpu,cpu->d);_fetch(1); // ADC D
+        case  139: _z80_adc8(cpu,cpu->e);_fetch(1); // ADC E
+        case  140: _z80_adc8(cpu,cpu->hlx[cpu->hlx_idx].h);_fetch(1); // ADC H
+        case  141: _z80_adc8(cpu,cpu->hlx[cpu->hlx_idx].l);_fetch(1); // ADC L
+        case  142: _mread(cpu->addr);cpu->dlatch=_gd();_z80_adc8(cpu,cpu->dlatch);_fetch(4); // ADC (HL)
+        case  143: _z80_adc8(cpu,cpu->a);_fetch(1); // ADC A
+        case  144: _z80_sub8(cpu,cpu->b);_fetch(1); // SUB B
+        case  145: _z80_sub8(cpu,cpu->c);_fetch(1); // SUB C
+        case  146: _z80_sub8(cpu,cpu->d);_fetch(1); // SUB D
+        case  147: _z80_sub8(cpu,cpu->e);_fetch(1); // SUB E
+        case  148: _z80_sub8(cpu,cpu->hlx[cpu->hlx_idx].h);_fetch(1); // SUB H
+        case  149: _z80_sub8(cpu,cpu->hlx[cpu->hlx_idx].l);_fetch(1); // SUB L
+        case  150: _mread(cpu->addr);cpu->dlatch=_gd();_z80_sub8(cpu,cpu->dlatch);_fetch(4); // SUB (HL)
+        case  151: _z80_sub8(cpu,cpu->a);_fetch(1); // SUB A
+        case  152: _z80_sbc8(cpu,cpu->b);_fetch(1); // SBC B
+        case  153: _z80_sbc8(cpu,cpu->c);_fetch(1); // SBC C
+        case  154: _z80_sbc8(cpu,cpu->d);_fetch(1); // SBC D
+        case  155: _z80_sbc8(cpu,cpu->e);_fetch(1); // SBC E
+        case  156: _z80_sbc8(cpu,cpu->hlx[cpu->hlx_idx].h);_fetch(1); // SBC H
+        case  157: _z80_sbc8(cpu,cpu->hlx[cpu->hlx_idx].l);_fetch(1); // SBC L
+        case  158: _mread(cpu->addr);cpu->dlatch=_gd();_z80_sbc8(cpu,cpu->dlatch);_fetch(4); // SBC (HL)
+        case  159: _z80_sbc8(cpu,cpu->a);_fetch(1); // SBC A
+        case  160: _z80_and8(cpu,cpu->b);_fetch(1); // AND B
+        case  161: _z80_and8(cpu,cpu->c);_fetch(1); // AND C
+        case  162: _z80_and8(cpu,cpu->d);_fetch(1); // AND D
+        case  163: _z80_and8(cpu,cpu->e);_fetch(1); // AND E
+        case  164: _z80_and8(cpu,cpu->hlx[cpu->hlx_idx].h);_fetch(1); // AND H
+        case  165: _z80_and8(cpu,cpu->hlx[cpu->hlx_idx].l);_fetch(1); // AND L
+        case  166: _mread(cpu->addr);cpu->dlatch=_gd();_z80_and8(cpu,cpu->dlatch);_fetch(4); // AND (HL)
+        case  167: _z80_and8(cpu,cpu->a);_fetch(1); // AND A
+        case  168: _z80_xor8(cpu,cpu->b);_fetch(1); // XOR B
+        case  169: _z80_xor8(cpu,cpu->c);_fetch(1); // XOR C
+        case  170: _z80_xor8(cpu,cpu->d);_fetch(1); // XOR D
+        case  171: _z80_xor8(cpu,cpu->e);_fetch(1); // XOR E
+        case  172: _z80_xor8(cpu,cpu->hlx[cpu->hlx_idx].h);_fetch(1); // XOR H
+        case  173: _z80_xor8(cpu,cpu->hlx[cpu->hlx_idx].l);_fetch(1); // XOR L
+        case  174: _mread(cpu->addr);cpu->dlatch=_gd();_z80_xor8(cpu,cpu->dlatch);_fetch(4); // XOR (HL)
+        case  175: _z80_xor8(cpu,cpu->a);_fetch(1); // XOR A
+        case  176: _z80_or8(cpu,cpu->b);_fetch(1); // OR B
+        case  177: _z80_or8(cpu,cpu->c);_fetch(1); // OR C
+        case  178: _z80_or8(cpu,cpu->d);_fetch(1); // OR D
+        case  179: _z80_or8(cpu,cpu->e);_fetch(1); // OR E
+        case  180: _z80_or8(cpu,cpu->hlx[cpu->hlx_idx].h);_fetch(1); // OR H
+        case  181: _z80_or8(cpu,cpu->hlx[cpu->hlx_idx].l);_fetch(1); // OR L
+        case  182: _mread(cpu->addr);cpu->dlatch=_gd();_z80_or8(cpu,cpu->dlatch);_fetch(4); // OR (HL)
+        case  183: _z80_or8(cpu,cpu->a);_fetch(1); // OR A
+        case  184: _z80_cp8(cpu,cpu->b);_fetch(1); // CP B
+        case  185: _z80_cp8(cpu,cpu->c);_fetch(1); // CP C
+        case  186: _z80_cp8(cpu,cpu->d);_fetch(1); // CP D
+        case  187: _z80_cp8(cpu,cpu->e);_fetch(1); // CP E
+        case  188: _z80_cp8(cpu,cpu->hlx[cpu->hlx_idx].h);_fetch(1); // CP H
+        case  189: _z80_cp8(cpu,cpu->hlx[cpu->hlx_idx].l);_fetch(1); // CP L
+        case  190: _mread(cpu->addr);cpu->dlatch=_gd();_z80_cp8(cpu,cpu->dlatch);_fetch(4); // CP (HL)
+        case  191: _z80_cp8(cpu,cpu->a);_fetch(1); // CP A
+        case  192: if(!_cc_nz){_skip(1,l_192_7);};_mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_ticks(7);l_192_7:_fetch(1); // RET NZ
+        case  193: _mread(cpu->sp++);cpu->c=_gd();_mread(cpu->sp++);cpu->b=_gd();_fetch(7); // POP BC
+        case  194: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if(_cc_nz){cpu->pc=cpu->wz;};_fetch(7); // JP NZ,nn
+        case  195: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();cpu->pc=cpu->wz;_fetch(7); // JP nn
+        case  196: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if (!_cc_nz){_skip(6,l_196_13);};_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->pc=cpu->wz;_ticks(13);l_196_13:_fetch(1); // CALL NZ,nn
+        case  197: _mwrite(--cpu->sp,cpu->b);_mwrite(--cpu->sp,cpu->c);_fetch(8); // PUSH BC
+        case  198: _mread(cpu->pc++);cpu->dlatch=_gd();_z80_add8(cpu,cpu->dlatch);_fetch(4); // ADD n
+        case  199: _mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wz=0x00;cpu->pc=cpu->wz;_fetch(8); // RST 0h
+        case  200: if(!_cc_z){_skip(1,l_200_7);};_mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_ticks(7);l_200_7:_fetch(1); // RET Z
+        case  201: _mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_fetch(7); // RET
+        case  202: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if(_cc_z){cpu->pc=cpu->wz;};_fetch(7); // JP Z,nn
+        case  203: _fetch_cb(1); // CB prefix
+        case  204: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if (!_cc_z){_skip(6,l_204_13);};_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->pc=cpu->wz;_ticks(13);l_204_13:_fetch(1); // CALL Z,nn
+        case  205: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->pc=cpu->wz;_fetch(14); // CALL nn
+        case  206: _mread(cpu->pc++);cpu->dlatch=_gd();_z80_adc8(cpu,cpu->dlatch);_fetch(4); // ADC n
+        case  207: _mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wz=0x08;cpu->pc=cpu->wz;_fetch(8); // RST 8h
+        case  208: if(!_cc_nc){_skip(1,l_208_7);};_mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_ticks(7);l_208_7:_fetch(1); // RET NC
+        case  209: _mread(cpu->sp++);cpu->e=_gd();_mread(cpu->sp++);cpu->d=_gd();_fetch(7); // POP DE
+        case  210: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if(_cc_nc){cpu->pc=cpu->wz;};_fetch(7); // JP NC,nn
+        case  211: _mread(cpu->pc++);cpu->wzl=_gd();cpu->wzh=cpu->a;_iowrite(cpu->wz,cpu->a);cpu->wzl++;_fetch(8); // OUT (n),A
+        case  212: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if (!_cc_nc){_skip(6,l_212_13);};_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->pc=cpu->wz;_ticks(13);l_212_13:_fetch(1); // CALL NC,nn
+        case  213: _mwrite(--cpu->sp,cpu->d);_mwrite(--cpu->sp,cpu->e);_fetch(8); // PUSH DE
+        case  214: _mread(cpu->pc++);cpu->dlatch=_gd();_z80_sub8(cpu,cpu->dlatch);_fetch(4); // SUB n
+        case  215: _mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wz=0x10;cpu->pc=cpu->wz;_fetch(8); // RST 10h
+        case  216: if(!_cc_c){_skip(1,l_216_7);};_mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_ticks(7);l_216_7:_fetch(1); // RET C
+        case  217: _z80_exx(cpu);_fetch(1); // EXX
+        case  218: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if(_cc_c){cpu->pc=cpu->wz;};_fetch(7); // JP C,nn
+        case  219: _mread(cpu->pc++);cpu->wzl=_gd();cpu->wzh=cpu->a;_ioread(cpu->wz++);cpu->a=_gd();_fetch(8); // IN A,(n)
+        case  220: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if (!_cc_c){_skip(6,l_220_13);};_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->pc=cpu->wz;_ticks(13);l_220_13:_fetch(1); // CALL C,nn
+        case  221: _fetch_dd(1); // DD prefix
+        case  222: _mread(cpu->pc++);cpu->dlatch=_gd();_z80_sbc8(cpu,cpu->dlatch);_fetch(4); // SBC n
+        case  223: _mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wz=0x18;cpu->pc=cpu->wz;_fetch(8); // RST 18h
+        case  224: if(!_cc_po){_skip(1,l_224_7);};_mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_ticks(7);l_224_7:_fetch(1); // RET PO
+        case  225: _mread(cpu->sp++);cpu->hlx[cpu->hlx_idx].l=_gd();_mread(cpu->sp++);cpu->hlx[cpu->hlx_idx].h=_gd();_fetch(7); // POP HL
+        case  226: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if(_cc_po){cpu->pc=cpu->wz;};_fetch(7); // JP PO,nn
+        case  227: _mread(cpu->sp);cpu->wzl=_gd();_mread(cpu->sp+1);cpu->wzh=_gd();_mwrite(cpu->sp+1,cpu->hlx[cpu->hlx_idx].h);_mwrite(cpu->sp,cpu->hlx[cpu->hlx_idx].l);cpu->hlx[cpu->hlx_idx].hl=cpu->wz;_fetch(16); // EX (SP),HL
+        case  228: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if (!_cc_po){_skip(6,l_228_13);};_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->pc=cpu->wz;_ticks(13);l_228_13:_fetch(1); // CALL PO,nn
+        case  229: _mwrite(--cpu->sp,cpu->hlx[cpu->hlx_idx].h);_mwrite(--cpu->sp,cpu->hlx[cpu->hlx_idx].l);_fetch(8); // PUSH HL
+        case  230: _mread(cpu->pc++);cpu->dlatch=_gd();_z80_and8(cpu,cpu->dlatch);_fetch(4); // AND n
+        case  231: _mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wz=0x20;cpu->pc=cpu->wz;_fetch(8); // RST 20h
+        case  232: if(!_cc_pe){_skip(1,l_232_7);};_mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_ticks(7);l_232_7:_fetch(1); // RET PE
+        case  233: cpu->pc=cpu->hlx[cpu->hlx_idx].hl;_fetch(1); // JP HL
+        case  234: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if(_cc_pe){cpu->pc=cpu->wz;};_fetch(7); // JP PE,nn
+        case  235: _z80_ex_de_hl(cpu);_fetch(1); // EX DE,HL
+        case  236: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if (!_cc_pe){_skip(6,l_236_13);};_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->pc=cpu->wz;_ticks(13);l_236_13:_fetch(1); // CALL PE,nn
+        case  237: _fetch_ed(1); // ED prefix
+        case  238: _mread(cpu->pc++);cpu->dlatch=_gd();_z80_xor8(cpu,cpu->dlatch);_fetch(4); // XOR n
+        case  239: _mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wz=0x28;cpu->pc=cpu->wz;_fetch(8); // RST 28h
+        case  240: if(!_cc_p){_skip(1,l_240_7);};_mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_ticks(7);l_240_7:_fetch(1); // RET P
+        case  241: _mread(cpu->sp++);cpu->f=_gd();_mread(cpu->sp++);cpu->a=_gd();_fetch(7); // POP AF
+        case  242: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if(_cc_p){cpu->pc=cpu->wz;};_fetch(7); // JP P,nn
+        case  243: cpu->iff1=cpu->iff2=false;_fetch(1); // DI
+        case  244: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if (!_cc_p){_skip(6,l_244_13);};_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->pc=cpu->wz;_ticks(13);l_244_13:_fetch(1); // CALL P,nn
+        case  245: _mwrite(--cpu->sp,cpu->a);_mwrite(--cpu->sp,cpu->f);_fetch(8); // PUSH AF
+        case  246: _mread(cpu->pc++);cpu->dlatch=_gd();_z80_or8(cpu,cpu->dlatch);_fetch(4); // OR n
+        case  247: _mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wz=0x30;cpu->pc=cpu->wz;_fetch(8); // RST 30h
+        case  248: if(!_cc_m){_skip(1,l_248_7);};_mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_ticks(7);l_248_7:_fetch(1); // RET M
+        case  249: cpu->sp=cpu->hlx[cpu->hlx_idx].hl;_fetch(3); // LD SP,HL
+        case  250: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if(_cc_m){cpu->pc=cpu->wz;};_fetch(7); // JP M,nn
+        case  251: cpu->iff1=cpu->iff2=false;_fetch_post(1,cpu->iff1=cpu->iff2=true;); // EI
+        case  252: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();if (!_cc_m){_skip(6,l_252_13);};_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->pc=cpu->wz;_ticks(13);l_252_13:_fetch(1); // CALL M,nn
+        case  253: _fetch_fd(1); // FD prefix
+        case  254: _mread(cpu->pc++);cpu->dlatch=_gd();_z80_cp8(cpu,cpu->dlatch);_fetch(4); // CP n
+        case  255: _mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wz=0x38;cpu->pc=cpu->wz;_fetch(8); // RST 38h
+        case  256: _fetch(1); // ED NOP
+        case  257: _fetch(1); // ED NOP
+        case  258: _fetch(1); // ED NOP
+        case  259: _fetch(1); // ED NOP
+        case  260: _fetch(1); // ED NOP
+        case  261: _fetch(1); // ED NOP
+        case  262: _fetch(1); // ED NOP
+        case  263: _fetch(1); // ED NOP
+        case  264: _fetch(1); // ED NOP
+        case  265: _fetch(1); // ED NOP
+        case  266: _fetch(1); // ED NOP
+        case  267: _fetch(1); // ED NOP
+        case  268: _fetch(1); // ED NOP
+        case  269: _fetch(1); // ED NOP
+        case  270: _fetch(1); // ED NOP
+        case  271: _fetch(1); // ED NOP
+        case  272: _fetch(1); // ED NOP
+        case  273: _fetch(1); // ED NOP
+        case  274: _fetch(1); // ED NOP
+        case  275: _fetch(1); // ED NOP
+        case  276: _fetch(1); // ED NOP
+        case  277: _fetch(1); // ED NOP
+        case  278: _fetch(1); // ED NOP
+        case  279: _fetch(1); // ED NOP
+        case  280: _fetch(1); // ED NOP
+        case  281: _fetch(1); // ED NOP
+        case  282: _fetch(1); // ED NOP
+        case  283: _fetch(1); // ED NOP
+        case  284: _fetch(1); // ED NOP
+        case  285: _fetch(1); // ED NOP
+        case  286: _fetch(1); // ED NOP
+        case  287: _fetch(1); // ED NOP
+        case  288: _fetch(1); // ED NOP
+        case  289: _fetch(1); // ED NOP
+        case  290: _fetch(1); // ED NOP
+        case  291: _fetch(1); // ED NOP
+        case  292: _fetch(1); // ED NOP
+        case  293: _fetch(1); // ED NOP
+        case  294: _fetch(1); // ED NOP
+        case  295: _fetch(1); // ED NOP
+        case  296: _fetch(1); // ED NOP
+        case  297: _fetch(1); // ED NOP
+        case  298: _fetch(1); // ED NOP
+        case  299: _fetch(1); // ED NOP
+        case  300: _fetch(1); // ED NOP
+        case  301: _fetch(1); // ED NOP
+        case  302: _fetch(1); // ED NOP
+        case  303: _fetch(1); // ED NOP
+        case  304: _fetch(1); // ED NOP
+        case  305: _fetch(1); // ED NOP
+        case  306: _fetch(1); // ED NOP
+        case  307: _fetch(1); // ED NOP
+        case  308: _fetch(1); // ED NOP
+        case  309: _fetch(1); // ED NOP
+        case  310: _fetch(1); // ED NOP
+        case  311: _fetch(1); // ED NOP
+        case  312: _fetch(1); // ED NOP
+        case  313: _fetch(1); // ED NOP
+        case  314: _fetch(1); // ED NOP
+        case  315: _fetch(1); // ED NOP
+        case  316: _fetch(1); // ED NOP
+        case  317: _fetch(1); // ED NOP
+        case  318: _fetch(1); // ED NOP
+        case  319: _fetch(1); // ED NOP
+        case  320: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->b=_z80_in(cpu,cpu->dlatch);_fetch(5); // IN B,(C)
+        case  321: _iowrite(cpu->bc,cpu->b);cpu->wz=cpu->bc+1;_fetch(5); // OUT (C),B
+        case  322: _z80_sbc16(cpu,cpu->bc);_fetch(8); // SBC HL,BC
+        case  323: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mwrite(cpu->wz++,cpu->c);_mwrite(cpu->wz,cpu->b);_fetch(13); // LD (nn),BC
+        case  324: _z80_neg8(cpu);_fetch(1); // NEG
+        case  325: _mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_fetch_post(7,cpu->iff1=cpu->iff2;); // RETN
+        case  326: cpu->im=0;_fetch(1); // IM 0
+        case  327: cpu->i=cpu->a;_fetch(2); // LD I,A
+        case  328: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->c=_z80_in(cpu,cpu->dlatch);_fetch(5); // IN C,(C)
+        case  329: _iowrite(cpu->bc,cpu->c);cpu->wz=cpu->bc+1;_fetch(5); // OUT (C),C
+        case  330: _z80_adc16(cpu,cpu->bc);_fetch(8); // ADC HL,BC
+        case  331: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mread(cpu->wz++);cpu->c=_gd();_mread(cpu->wz);cpu->b=_gd();_fetch(13); // LD BC,(nn)
+        case  332: _z80_neg8(cpu);_fetch(1); // NEG
+        case  333: _mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_fetch_post(7,cpu->iff1=cpu->iff2;pins|=Z80_RETI;); // RETI
+        case  334: cpu->im=0;_fetch(1); // IM 0
+        case  335: cpu->r=cpu->a;_fetch(2); // LD R,A
+        case  336: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->d=_z80_in(cpu,cpu->dlatch);_fetch(5); // IN D,(C)
+        case  337: _iowrite(cpu->bc,cpu->d);cpu->wz=cpu->bc+1;_fetch(5); // OUT (C),D
+        case  338: _z80_sbc16(cpu,cpu->de);_fetch(8); // SBC HL,DE
+        case  339: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mwrite(cpu->wz++,cpu->e);_mwrite(cpu->wz,cpu->d);_fetch(13); // LD (nn),DE
+        case  340: _z80_neg8(cpu);_fetch(1); // NEG
+        case  341: _mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_fetch_post(7,cpu->iff1=cpu->iff2;pins|=Z80_RETI;); // RETI
+        case  342: cpu->im=1;_fetch(1); // IM 1
+        case  343: cpu->a=cpu->i;cpu->f=_z80_sziff2_flags(cpu, cpu->i);_fetch(2); // LD A,I
+        case  344: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->e=_z80_in(cpu,cpu->dlatch);_fetch(5); // IN E,(C)
+        case  345: _iowrite(cpu->bc,cpu->e);cpu->wz=cpu->bc+1;_fetch(5); // OUT (C),E
+        case  346: _z80_adc16(cpu,cpu->de);_fetch(8); // ADC HL,DE
+        case  347: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mread(cpu->wz++);cpu->e=_gd();_mread(cpu->wz);cpu->d=_gd();_fetch(13); // LD DE,(nn)
+        case  348: _z80_neg8(cpu);_fetch(1); // NEG
+        case  349: _mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_fetch_post(7,cpu->iff1=cpu->iff2;pins|=Z80_RETI;); // RETI
+        case  350: cpu->im=2;_fetch(1); // IM 2
+        case  351: cpu->a=cpu->r;cpu->f=_z80_sziff2_flags(cpu, cpu->r);_fetch(2); // LD A,R
+        case  352: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->h=_z80_in(cpu,cpu->dlatch);_fetch(5); // IN H,(C)
+        case  353: _iowrite(cpu->bc,cpu->h);cpu->wz=cpu->bc+1;_fetch(5); // OUT (C),H
+        case  354: _z80_sbc16(cpu,cpu->hl);_fetch(8); // SBC HL,HL
+        case  355: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mwrite(cpu->wz++,cpu->l);_mwrite(cpu->wz,cpu->h);_fetch(13); // LD (nn),HL
+        case  356: _z80_neg8(cpu);_fetch(1); // NEG
+        case  357: _mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_fetch_post(7,cpu->iff1=cpu->iff2;pins|=Z80_RETI;); // RETI
+        case  358: cpu->im=0;_fetch(1); // IM 0
+        case  359: _mread(cpu->hl);cpu->dlatch=_gd();cpu->dlatch=_z80_rrd(cpu,cpu->dlatch);_mwrite(cpu->hl,cpu->dlatch);cpu->wz=cpu->hl+1;_fetch(11); // RRD
+        case  360: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->l=_z80_in(cpu,cpu->dlatch);_fetch(5); // IN L,(C)
+        case  361: _iowrite(cpu->bc,cpu->l);cpu->wz=cpu->bc+1;_fetch(5); // OUT (C),L
+        case  362: _z80_adc16(cpu,cpu->hl);_fetch(8); // ADC HL,HL
+        case  363: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mread(cpu->wz++);cpu->l=_gd();_mread(cpu->wz);cpu->h=_gd();_fetch(13); // LD HL,(nn)
+        case  364: _z80_neg8(cpu);_fetch(1); // NEG
+        case  365: _mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_fetch_post(7,cpu->iff1=cpu->iff2;pins|=Z80_RETI;); // RETI
+        case  366: cpu->im=0;_fetch(1); // IM 0
+        case  367: _mread(cpu->hl);cpu->dlatch=_gd();cpu->dlatch=_z80_rld(cpu,cpu->dlatch);_mwrite(cpu->hl,cpu->dlatch);cpu->wz=cpu->hl+1;_fetch(11); // RLD
+        case  368: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc+1;_z80_in(cpu,cpu->dlatch);_fetch(5); // IN (C)
+        case  369: _iowrite(cpu->bc,0);cpu->wz=cpu->bc+1;_fetch(5); // OUT (C),0
+        case  370: _z80_sbc16(cpu,cpu->sp);_fetch(8); // SBC HL,SP
+        case  371: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mwrite(cpu->wz++,cpu->spl);_mwrite(cpu->wz,cpu->sph);_fetch(13); // LD (nn),SP
+        case  372: _z80_neg8(cpu);_fetch(1); // NEG
+        case  373: _mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_fetch_post(7,cpu->iff1=cpu->iff2;pins|=Z80_RETI;); // RETI
+        case  374: cpu->im=1;_fetch(1); // IM 1
+        case  375: _fetch(1); // ED NOP
+        case  376: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->a=_z80_in(cpu,cpu->dlatch);_fetch(5); // IN A,(C)
+        case  377: _iowrite(cpu->bc,cpu->a);cpu->wz=cpu->bc+1;_fetch(5); // OUT (C),A
+        case  378: _z80_adc16(cpu,cpu->sp);_fetch(8); // ADC HL,SP
+        case  379: _mread(cpu->pc++);cpu->wzl=_gd();_mread(cpu->pc++);cpu->wzh=_gd();_mread(cpu->wz++);cpu->spl=_gd();_mread(cpu->wz);cpu->sph=_gd();_fetch(13); // LD SP,(nn)
+        case  380: _z80_neg8(cpu);_fetch(1); // NEG
+        case  381: _mread(cpu->sp++);cpu->wzl=_gd();_mread(cpu->sp++);cpu->wzh=_gd();cpu->pc=cpu->wz;_fetch_post(7,cpu->iff1=cpu->iff2;pins|=Z80_RETI;); // RETI
+        case  382: cpu->im=2;_fetch(1); // IM 2
+        case  383: _fetch(1); // ED NOP
+        case  384: _fetch(1); // ED NOP
+        case  385: _fetch(1); // ED NOP
+        case  386: _fetch(1); // ED NOP
+        case  387: _fetch(1); // ED NOP
+        case  388: _fetch(1); // ED NOP
+        case  389: _fetch(1); // ED NOP
+        case  390: _fetch(1); // ED NOP
+        case  391: _fetch(1); // ED NOP
+        case  392: _fetch(1); // ED NOP
+        case  393: _fetch(1); // ED NOP
+        case  394: _fetch(1); // ED NOP
+        case  395: _fetch(1); // ED NOP
+        case  396: _fetch(1); // ED NOP
+        case  397: _fetch(1); // ED NOP
+        case  398: _fetch(1); // ED NOP
+        case  399: _fetch(1); // ED NOP
+        case  400: _fetch(1); // ED NOP
+        case  401: _fetch(1); // ED NOP
+        case  402: _fetch(1); // ED NOP
+        case  403: _fetch(1); // ED NOP
+        case  404: _fetch(1); // ED NOP
+        case  405: _fetch(1); // ED NOP
+        case  406: _fetch(1); // ED NOP
+        case  407: _fetch(1); // ED NOP
+        case  408: _fetch(1); // ED NOP
+        case  409: _fetch(1); // ED NOP
+        case  410: _fetch(1); // ED NOP
+        case  411: _fetch(1); // ED NOP
+        case  412: _fetch(1); // ED NOP
+        case  413: _fetch(1); // ED NOP
+        case  414: _fetch(1); // ED NOP
+        case  415: _fetch(1); // ED NOP
+        case  416: _mread(cpu->hl++);cpu->dlatch=_gd();_mwrite(cpu->de++,cpu->dlatch);_z80_ldi_ldd(cpu,cpu->dlatch);_fetch(9); // LDI
+        case  417: _mread(cpu->hl++);cpu->dlatch=_gd();cpu->wz++;_z80_cpi_cpd(cpu,cpu->dlatch);_fetch(9); // CPI
+        case  418: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->b--;;_mwrite(cpu->hl++,cpu->dlatch);_z80_ini_ind(cpu,cpu->dlatch,cpu->c+1);_fetch(9); // INI
+        case  419: _mread(cpu->hl++);cpu->dlatch=_gd();cpu->b--;_iowrite(cpu->bc,cpu->dlatch);cpu->wz=cpu->bc+1;_z80_outi_outd(cpu,cpu->dlatch);_fetch(9); // OUTI
+        case  420: _fetch(1); // ED NOP
+        case  421: _fetch(1); // ED NOP
+        case  422: _fetch(1); // ED NOP
+        case  423: _fetch(1); // ED NOP
+        case  424: _mread(cpu->hl--);cpu->dlatch=_gd();_mwrite(cpu->de--,cpu->dlatch);_z80_ldi_ldd(cpu,cpu->dlatch);_fetch(9); // LDD
+        case  425: _mread(cpu->hl--);cpu->dlatch=_gd();cpu->wz--;_z80_cpi_cpd(cpu,cpu->dlatch);_fetch(9); // CPD
+        case  426: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc-1;cpu->b--;;_mwrite(cpu->hl--,cpu->dlatch);_z80_ini_ind(cpu,cpu->dlatch,cpu->c-1);_fetch(9); // IND
+        case  427: _mread(cpu->hl--);cpu->dlatch=_gd();cpu->b--;_iowrite(cpu->bc,cpu->dlatch);cpu->wz=cpu->bc-1;_z80_outi_outd(cpu,cpu->dlatch);_fetch(9); // OUTD
+        case  428: _fetch(1); // ED NOP
+        case  429: _fetch(1); // ED NOP
+        case  430: _fetch(1); // ED NOP
+        case  431: _fetch(1); // ED NOP
+        case  432: _mread(cpu->hl++);cpu->dlatch=_gd();_mwrite(cpu->de++,cpu->dlatch);if(!_z80_ldi_ldd(cpu,cpu->dlatch)){_skip(7,l_432_12);};cpu->wz=--cpu->pc;--cpu->pc;;_ticks(12);l_432_12:_fetch(2); // LDIR
+        case  433: _mread(cpu->hl++);cpu->dlatch=_gd();cpu->wz++;if(!_z80_cpi_cpd(cpu,cpu->dlatch)){_skip(4,l_433_9);};cpu->wz=--cpu->pc;--cpu->pc;_ticks(9);l_433_9:_fetch(5); // CPIR
+        case  434: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc+1;cpu->b--;;_mwrite(cpu->hl++,cpu->dlatch);if (!_z80_ini_ind(cpu,cpu->dlatch,cpu->c+1)){_skip(7,l_434_12);};cpu->wz=--cpu->pc;--cpu->pc;_ticks(12);l_434_12:_fetch(2); // INIR
+        case  435: _mread(cpu->hl++);cpu->dlatch=_gd();cpu->b--;_iowrite(cpu->bc,cpu->dlatch);cpu->wz=cpu->bc+1;if(!_z80_outi_outd(cpu,cpu->dlatch)){_skip(7,l_435_12);};cpu->wz=--cpu->pc;--cpu->pc;_ticks(12);l_435_12:_fetch(2); // OTIR
+        case  436: _fetch(1); // ED NOP
+        case  437: _fetch(1); // ED NOP
+        case  438: _fetch(1); // ED NOP
+        case  439: _fetch(1); // ED NOP
+        case  440: _mread(cpu->hl--);cpu->dlatch=_gd();_mwrite(cpu->de--,cpu->dlatch);if(!_z80_ldi_ldd(cpu,cpu->dlatch)){_skip(7,l_440_12);};cpu->wz=--cpu->pc;--cpu->pc;;_ticks(12);l_440_12:_fetch(2); // LDDR
+        case  441: _mread(cpu->hl--);cpu->dlatch=_gd();cpu->wz--;if(!_z80_cpi_cpd(cpu,cpu->dlatch)){_skip(4,l_441_9);};cpu->wz=--cpu->pc;--cpu->pc;_ticks(9);l_441_9:_fetch(5); // CPDR
+        case  442: _ioread(cpu->bc);cpu->dlatch=_gd();cpu->wz=cpu->bc-1;cpu->b--;;_mwrite(cpu->hl--,cpu->dlatch);if (!_z80_ini_ind(cpu,cpu->dlatch,cpu->c-1)){_skip(7,l_442_12);};cpu->wz=--cpu->pc;--cpu->pc;_ticks(12);l_442_12:_fetch(2); // INDR
+        case  443: _mread(cpu->hl--);cpu->dlatch=_gd();cpu->b--;_iowrite(cpu->bc,cpu->dlatch);cpu->wz=cpu->bc-1;if(!_z80_outi_outd(cpu,cpu->dlatch)){_skip(7,l_443_12);};cpu->wz=--cpu->pc;--cpu->pc;_ticks(12);l_443_12:_fetch(2); // OTDR
+        case  444: _fetch(1); // ED NOP
+        case  445: _fetch(1); // ED NOP
+        case  446: _fetch(1); // ED NOP
+        case  447: _fetch(1); // ED NOP
+        case  448: _fetch(1); // ED NOP
+        case  449: _fetch(1); // ED NOP
+        case  450: _fetch(1); // ED NOP
+        case  451: _fetch(1); // ED NOP
+        case  452: _fetch(1); // ED NOP
+        case  453: _fetch(1); // ED NOP
+        case  454: _fetch(1); // ED NOP
+        case  455: _fetch(1); // ED NOP
+        case  456: _fetch(1); // ED NOP
+        case  457: _fetch(1); // ED NOP
+        case  458: _fetch(1); // ED NOP
+        case  459: _fetch(1); // ED NOP
+        case  460: _fetch(1); // ED NOP
+        case  461: _fetch(1); // ED NOP
+        case  462: _fetch(1); // ED NOP
+        case  463: _fetch(1); // ED NOP
+        case  464: _fetch(1); // ED NOP
+        case  465: _fetch(1); // ED NOP
+        case  466: _fetch(1); // ED NOP
+        case  467: _fetch(1); // ED NOP
+        case  468: _fetch(1); // ED NOP
+        case  469: _fetch(1); // ED NOP
+        case  470: _fetch(1); // ED NOP
+        case  471: _fetch(1); // ED NOP
+        case  472: _fetch(1); // ED NOP
+        case  473: _fetch(1); // ED NOP
+        case  474: _fetch(1); // ED NOP
+        case  475: _fetch(1); // ED NOP
+        case  476: _fetch(1); // ED NOP
+        case  477: _fetch(1); // ED NOP
+        case  478: _fetch(1); // ED NOP
+        case  479: _fetch(1); // ED NOP
+        case  480: _fetch(1); // ED NOP
+        case  481: _fetch(1); // ED NOP
+        case  482: _fetch(1); // ED NOP
+        case  483: _fetch(1); // ED NOP
+        case  484: _fetch(1); // ED NOP
+        case  485: _fetch(1); // ED NOP
+        case  486: _fetch(1); // ED NOP
+        case  487: _fetch(1); // ED NOP
+        case  488: _fetch(1); // ED NOP
+        case  489: _fetch(1); // ED NOP
+        case  490: _fetch(1); // ED NOP
+        case  491: _fetch(1); // ED NOP
+        case  492: _fetch(1); // ED NOP
+        case  493: _fetch(1); // ED NOP
+        case  494: _fetch(1); // ED NOP
+        case  495: _fetch(1); // ED NOP
+        case  496: _fetch(1); // ED NOP
+        case  497: _fetch(1); // ED NOP
+        case  498: _fetch(1); // ED NOP
+        case  499: _fetch(1); // ED NOP
+        case  500: _fetch(1); // ED NOP
+        case  501: _fetch(1); // ED NOP
+        case  502: _fetch(1); // ED NOP
+        case  503: _fetch(1); // ED NOP
+        case  504: _fetch(1); // ED NOP
+        case  505: _fetch(1); // ED NOP
+        case  506: _fetch(1); // ED NOP
+        case  507: _fetch(1); // ED NOP
+        case  508: _fetch(1); // ED NOP
+        case  509: _fetch(1); // ED NOP
+        case  510: _fetch(1); // ED NOP
+        case  511: _fetch(1); // ED NOP
+        case 1612: {uint8_t z=cpu->opcode&7;_z80_cb_action(cpu,z,z);};_fetch(1); // cb
+        case 1613: _mread(cpu->hl);cpu->dlatch=_gd();if(!_z80_cb_action(cpu,6,6)){_skip(3,l_1613_6);};_mwrite(cpu->hl,cpu->dlatch);_ticks(6);l_1613_6:_fetch(2); // cbhl
+        case 1621: _mread(cpu->pc++);_z80_ddfdcb_addr(cpu,pins);_mread(cpu->pc++);cpu->opcode=_gd();_mread(cpu->addr);cpu->dlatch=_gd();if(!_z80_cb_action(cpu,6,cpu->opcode&7)){_skip(10,l_1621_13);};_mwrite(cpu->addr,cpu->dlatch);_ticks(13);l_1621_13:_fetch(2); // ddfdcb
+        case 1636: cpu->iff1=cpu->iff2=false;_ioack();cpu->opcode=_z80_get_db(pins);pins=_z80_refresh(cpu,pins);cpu->addr=cpu->hl;_dispatch(5,cpu->opcode);_fetch(6); // int_im0
+        case 1642: cpu->iff1=cpu->iff2=false;_ioack();pins=_z80_refresh(cpu,pins);_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wz=cpu->pc=0x0038;_fetch(13); // int_im1
+        case 1655: cpu->iff1=cpu->iff2=false;_ioack();cpu->dlatch=_z80_get_db(pins);pins=_z80_refresh(cpu,pins);_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wzl=cpu->dlatch;cpu->wzh=cpu->i;_mread(cpu->wz++);cpu->dlatch=_gd();_mread(cpu->wz);cpu->wzh=_gd();cpu->wzl=cpu->dlatch;cpu->pc=cpu->wz;_fetch(19); // int_im2
+        case 1674: cpu->iff1=false;pins=_z80_refresh(cpu,pins);_mwrite(--cpu->sp,cpu->pch);_mwrite(--cpu->sp,cpu->pcl);cpu->wz=cpu->pc=0x0066;_fetch(11); // nmi
+        // %>
+        default: _Z80_UNREACHABLE;
+    }
+    //=== shared fetch machine cycle for DD/FD-prefixed ops
+fetch_ddfd:
+    cpu->prefix_active = true;
+    _m1read();
+    cpu->opcode = _gd();
+    pins = _z80_refresh(cpu, pins);
+    cpu->addr = cpu->hlx[cpu->hlx_idx].hl;
+    ticks += 3;
+    if (_z80_indirect_table[cpu->opcode]) {
+        //=== optional d-loading cycle for (IX+d), (IY+d)
+        _mread(cpu->pc++);
+        cpu->addr += (int8_t)_gd();
+        cpu->wz = cpu->addr;
+        ticks += 8;
+        if (cpu->opcode == 0x36) {
+            //--- special case LD (IX/IY+d),n
+            _mread(cpu->pc++);
+            cpu->dlatch = _gd();
+            _mwrite(cpu->addr, cpu->dlatch);
+            _fetch(4);
+        }
+    }
+    op = cpu->opcode;
+    goto dispatch;
+    //=== special opcode fetch machine cycle for ED-prefixed instructions
+fetch_ed:
+    cpu->hlx_idx = 0;
+    cpu->prefix_active = true;
+    _m1read();
+    cpu->opcode = _gd();
+    pins = _z80_refresh(cpu, pins);
+    ticks += 3;
+    op = cpu->opcode + 256;
+    goto dispatch;
+    //=== special opcode fetch machine cycle for CB-prefixed instructions
+fetch_cb:
+    cpu->prefix_active = true;
+    if (cpu->hlx_idx > 0) {
+        // DD+CB / FD+CB: the d-offset and opcode are loaded in the special DDCB/FDCB block
+        op = Z80_DDFDCB_STEP;
+        goto dispatch;
+    }
+    _m1read();
+    cpu->opcode = _gd();
+    pins = _z80_refresh(cpu, pins);
+    ticks += 3;
+    if ((cpu->opcode & 7) == 6) {
+        // this is a (HL) instruction
+        cpu->addr = cpu->hl;
+        op = Z80_CBHL_STEP;
+    }
+    else {
+        op = Z80_CB_STEP;
+    }
+    goto dispatch;
+fetch_next:
+    pins = _z80_fetch(cpu, pins & ~Z80_CTRL_PIN_MASK);
+done:
+    *pins_ptr = pins;
+    return ticks;
+}
+
+uint32_t z80_exec(z80_t* cpu, uint64_t* pins, uint32_t num_ticks, z80_bus_t bus) {
+    uint32_t ticks = 0;
+    while (ticks < num_ticks) {
+        ticks += z80_exec_op(cpu, pins, bus);
+    }
+    return ticks;
+}
+
+#undef _bus
+#undef _gd
+#undef _mread
+#undef _mwrite
+#undef _ioread
+#undef _iowrite
+#undef _ioack
+#undef _m1read
+#undef _ticks
+#undef _skip
+#undef _dispatch
+#undef _fetch
+#undef _fetch_post
+#undef _fetch_dd
+#undef _fetch_fd
+#undef _fetch_ed
+#undef _fetch_cb
+#undef _cc_nz
+#undef _cc_z
+#undef _cc_nc
+#undef _cc_c
+#undef _cc_po
+#undef _cc_pe
+#undef _cc_p
+#undef _cc_m
+
 #endif // CHIPS_IMPL
@@ -2,9 +2,11 @@
 #   m6502_decoder.py
 #   Generate instruction decoder for m6502.h emulator.
 #-------------------------------------------------------------------------------
+import re
 import templ
 
 INOUT_PATH = '../chips/m6502.h'
+LANES_INOUT_PATH = '../chips/m6502x.h'
 
 # flag bits
 CF = (1<<0)
@@ -131,16 +133,38 @@ def l(s) :
     global out_lines
     out_lines += s + '\n'
 
+#-------------------------------------------------------------------------------
+#   output a src line for the structure-of-arrays decoder in m6502x.h
+#
+lanes_out_lines = ''
+def lanes_l(s) :
+    global lanes_out_lines
+    lanes_out_lines += s + '\n'
+
+#-------------------------------------------------------------------------------
+#   convert a decoder step into its structure-of-arrays version, all CPU
+#   state members are indexed with the lane index 'l', and the helper
+#   functions are replaced with the m6502x.h versions
+#
+def to_lanes(src):
+    src = re.sub(r'c->(\w+)', r'c->\1[l]', src)
+    src = re.sub(r'_m6502_(\w+)\(c,', r'_m6502x_\1(c,l,', src)
+    src = re.sub(r'_m6502_(\w+)\(c\)', r'_m6502x_\1(c,l)', src)
+    return src
+
 #-------------------------------------------------------------------------------
 def write_op(op):
     if not op.cmt:
         op.cmt = '???'
     l('    /* {} */'.format(op.cmt if op.cmt else '???'))
+    lanes_l('    /* {} */'.format(op.cmt if op.cmt else '???'))
     for t in range(0, 8):
         if t < op.i:
             l('        case (0x{:02X}<<3)|{}: {}break;'.format(op.code, t, op.src[t]))
+            lanes_l('        case (0x{:02X}<<3)|{}: _LANES({});break;'.format(op.code, t, to_lanes(op.src[t])))
         else:
             l('        case (0x{:02X}<<3)|{}: assert(false);break;'.format(op.code, t))
+            lanes_l('        case (0x{:02X}<<3)|{}: assert(false);break;'.format(op.code, t))
 
 #-------------------------------------------------------------------------------
 def cmt(o,cmd):
@@ -853,6 +877,12 @@ def write_result():
     out_str = '\n'.join(lines) + '\n'
     with open(INOUT_PATH, 'w') as f:
         f.write(out_str)
+    with open(LANES_INOUT_PATH, 'r') as f:
+        lines = f.read().splitlines()
+        lines = templ.replace(lines, 'decoder', lanes_out_lines)
+    out_str = '\n'.join(lines) + '\n'
+    with open(LANES_INOUT_PATH, 'w') as f:
+        f.write(out_str)
 
 if __name__ == '__main__':
     for op in range(0, 256):
@@ -1,4 +1,4 @@
-import yaml, copy
+import yaml, copy, re
 import templ
 
 DESC_PATH  = 'z80_desc.yml'
@@ -261,6 +261,69 @@ def expand_optable():
     op_index += 1; stampout_op('', -1, op_index, find_opdesc('int_im2'))
     op_index += 1; stampout_op('', -1, op_index, find_opdesc('nmi'))
 
+# expand the machine cycles of an op into a list of (step_type, action, extra) tuples,
+# with one item per tcycle, step_type is one of:
+#   'tick':         a regular tcycle
+#   'fetch':        the overlapped tcycle which branches to the shared fetch block
+#   'post_fetch':   an overlapped tcycle with an action after the fetch (extra: post action)
+#   'prefix':       an overlapped tcycle which branches into a prefix fetch (extra: prefix name)
+def expand_steps(op):
+    steps = []
+
+    def tick(action):
+        steps.append(('tick', action, None))
+
+    for mcycle in op.mcycles:
+        action = (f"{mcycle.items['action']};" if 'action' in mcycle.items else '')
+        if mcycle.type == 'fetch':
+            pass
+        elif mcycle.type == 'mread':
+            addr = mcycle.items['ab']
+            store = mcycle.items['dst']
+            tick('')
+            tick(f'_wait();_mread({addr});')
+            tick(f'{store}=_gd();{action}')
+            for _ in range(3,mcycle.tcycles):
+                tick('')
+        elif mcycle.type == 'mwrite':
+            addr = mcycle.items['ab']
+            data = mcycle.items['db']
+            tick('')
+            tick(f'_wait();_mwrite({addr},{data});{action}')
+            tick('')
+            for _ in range(3,mcycle.tcycles):
+                tick('')
+        elif mcycle.type == 'ioread':
+            addr = mcycle.items['ab']
+            store = mcycle.items['dst']
+            tick('')
+            tick('')
+            tick(f'_wait();_ioread({addr});')
+            tick(f'{store}=_gd();{action}')
+            for _ in range(4,mcycle.tcycles):
+                tick('')
+        elif mcycle.type == 'iowrite':
+            addr = mcycle.items['ab']
+            data = mcycle.items['db']
+            tick('')
+            tick(f'_iowrite({addr},{data});')
+            tick(f'_wait();{action}')
+            tick('')
+            for _ in range(4,mcycle.tcycles):
+                tick('')
+        elif mcycle.type == 'generic':
+            tick(f'{action}')
+            for _ in range(1,mcycle.tcycles):
+                tick('')
+        elif mcycle.type == 'overlapped':
+            if 'post_action' in mcycle.items:
+                steps.append(('post_fetch', action, f"{mcycle.items['post_action']};"))
+            elif 'prefix' in mcycle.items:
+                steps.append(('prefix', action, mcycle.items['prefix']))
+            else:
+                steps.append(('fetch', action, None))
+    return steps
+
 # generate code for one op
 def gen_decoder():
     indent = 2
@@ -324,64 +387,84 @@ def gen_decoder():
         op_step = 0
         op.step_index = cur_step
         op.extra_step_index = cur_extra_step
-
-        for i,mcycle in enumerate(op.mcycles):
-            action = (f"{mcycle.items['action']};" if 'action' in mcycle.items else '')
-            if mcycle.type == 'fetch':
-                pass
-            elif mcycle.type == 'mread':
-                addr = mcycle.items['ab']
-                store = mcycle.items['dst']
-                add('')
-                add(f'_wait();_mread({addr});')
-                add(f'{store}=_gd();{action}')
-                for _ in range(3,mcycle.tcycles):
-                    add('')
-            elif mcycle.type == 'mwrite':
-                addr = mcycle.items['ab']
-                data = mcycle.items['db']
-                add('')
-                add(f'_wait();_mwrite({addr},{data});{action}')
-                add('')
-                for _ in range(3,mcycle.tcycles):
-                    add('')
-            elif mcycle.type == 'ioread':
-                addr = mcycle.items['ab']
-                store = mcycle.items['dst']
-                add('')
-                add('')
-                add(f'_wait();_ioread({addr});')
-                add(f'{store}=_gd();{action}')
-                for _ in range(4,mcycle.tcycles):
-                    add('')
-            elif mcycle.type == 'iowrite':
-                addr = mcycle.items['ab']
-                data = mcycle.items['db']
-                add('')
-                add(f'_iowrite({addr},{data});')
-                add(f'_wait();{action}')
-                add('')
-                for _ in range(4,mcycle.tcycles):
-                    add('')
-            elif mcycle.type == 'generic':
-                add(f'{action}')
-                for _ in range(1,mcycle.tcycles):
-                    add('')
-            elif mcycle.type == 'overlapped':
-                action = (f"{mcycle.items['action']};" if 'action' in mcycle.items else '')
-                if 'post_action' in mcycle.items:
-                    # if a post-action is defined we can jump to the common fetch block but
-                    # instead squeeze the fetch before the fetch action
-                    post_action = (f"{mcycle.items['post_action']};" if 'post_action' in mcycle.items else '')
-                    add_stepto(f"{action}pins=_z80_fetch(cpu,pins);{post_action}")
-                elif 'prefix' in mcycle.items:
-                    # likewise if this is a prefix instruction special case
-                    add_stepto(f"{action}_fetch_{mcycle.items['prefix']}();")
-                else:
-                    # regular case, jump to the shared fetch block after the
-                    add_fetch(f'{action}')
+        for (step_type, action, extra) in expand_steps(op):
+            if step_type == 'tick':
+                add(action)
+            elif step_type == 'fetch':
+                # regular case, jump to the shared fetch block
+                add_fetch(action)
+            elif step_type == 'post_fetch':
+                # if a post-action is defined we can jump to the common fetch block but
+                # instead squeeze the fetch before the fetch action
+                add_stepto(f"{action}pins=_z80_fetch(cpu,pins);{extra}")
+            elif step_type == 'prefix':
+                # likewise if this is a prefix instruction special case
+                add_stepto(f"{action}_fetch_{extra}();")
     return { 'out_lines': out_lines + out_extra_lines, 'max_step': cur_extra_step }
 
+# text replacements for actions in the instruction-stepped decoder
+# (wait states are not supported, and the interrupt acknowledge
+# cycle must explicitly call into the bus callback)
+FAST_REPLACE = [
+    ('_wait();', ''),
+    ('_wait()', ''),
+    ('pins|=(Z80_M1|Z80_IORQ)', '_ioack()'),
+]
+
+# generate the instruction-stepped decoder for z80_exec_op(), this is
+# stamped out from the same tcycle steps as the cycle-stepped decoder, but
+# each instruction runs to completion and only counts the executed tcycles
+def gen_fast_decoder():
+    indent = 2
+    out_lines = ''
+
+    def tab():
+        return ' ' * TAB_WIDTH * indent
+
+    def label(case, step):
+        return f'l_{case}_{step}'
+
+    for op_index, op in enumerate(OPS):
+        # special ops are dispatched by their cycle-stepped decoder step
+        case = op.extra_step_index if flag(op, 'special') else op_index
+        steps = expand_steps(op)
+        # find the target steps of conditional branches
+        targets = set()
+        for i, (_, action, _) in enumerate(steps):
+            for m in re.finditer(r'_goto\(\$NEXTSTEP\+(\d+)\)', action):
+                targets.add(i + 1 + int(m.group(1)))
+        res = ''
+        num_ticks = 0
+        # the virtual RETI pin is only set in the pin mask returned from
+        # z80_exec_op(), so that it doesn't leak into the bus callback
+        reti = False
+        for i, (step_type, action, extra) in enumerate(steps):
+            if i in targets:
+                if num_ticks > 0:
+                    res += f'_ticks({num_ticks});'
+                res += f'{label(case, i)}:'
+                num_ticks = 0
+            num_ticks += 1
+            for (src, dst) in FAST_REPLACE:
+                action = action.replace(src, dst)
+            if 'pins|=Z80_RETI;' in action:
+                action = action.replace('pins|=Z80_RETI;', '')
+                reti = True
+            action = re.sub(r'_goto\(\$NEXTSTEP\+(\d+)\)', lambda m: f'_skip({num_ticks},{label(case, i + 1 + int(m.group(1)))})', action)
+            action = re.sub(r'_goto\(([^)]*)\)', lambda m: f'_dispatch({num_ticks},{m.group(1)})', action)
+            if step_type == 'tick':
+                res += action
+            elif step_type == 'fetch':
+                res += f'{action}_fetch({num_ticks});'
+            elif step_type == 'post_fetch':
+                if reti:
+                    extra += 'pins|=Z80_RETI;'
+                res += f'{action}_fetch_post({num_ticks},{extra});'
+            elif step_type == 'prefix':
+                res += f'{action}_fetch_{extra}({num_ticks});'
+        out_lines += tab() + f'case {case:4}: {res} // {op.name}\n'
+    return out_lines
+
 def extra_step_defines_string(max_step):
     manual_steps = [
         "DDFD_M1_T2",
@@ -442,12 +525,13 @@ def indirect_table_string():
             res += '\n'
     return res
 
-def write_result(decoder_output):
+def write_result(decoder_output, fast_decoder_output):
     out_lines = decoder_output['out_lines']
     max_step = decoder_output['max_step']
     with open(INOUT_PATH, 'r') as f:
         lines = f.read().splitlines()
         lines = templ.replace(lines, 'decoder', out_lines)
+        lines = templ.replace(lines, 'fast_decoder', fast_decoder_output)
         lines = templ.replace(lines, 'extra_step_defines', extra_step_defines_string(max_step))
         lines = templ.replace(lines, 'indirect_table', indirect_table_string())
     out_str = '\n'.join(lines) + '\n'
@@ -458,4 +542,5 @@ if __name__ == '__main__':
     parse_opdescs()
     expand_optable()
     decoder_output = gen_decoder()
-    write_result(decoder_output)
+    fast_decoder_output = gen_fast_decoder()
+    write_result(decoder_output, fast_decoder_output)
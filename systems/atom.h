@@ -21,6 +21,7 @@
     You need to include the following headers before including atom.h:
 
     - chips/chips_common.h
+    - chips/chips_audio.h
     - chips/m6502.h
     - chips/mc6847.h
     - chips/i8255.h
@@ -34,6 +35,14 @@
 
     FIXME!
 
+    ## Frame Hashing
+
+    atom_frame_hash() returns a 64-bit hash of the visible area of the last
+    completed video frame, for comparing emulator output in regression tests.
+    The hash is updated line by line as the framebuffer is decoded and is
+    identical to chips_display_hash() of the framebuffer at the end of the
+    frame.
+
     ## TODO
 
     - handle shift key (some games use this as jump button)
@@ -67,7 +76,7 @@ extern "C" {
 #endif
 
 // bump snapshot version when memory layout of atom_t changes
-#define ATOM_SNAPSHOT_VERSION (1)
+#define ATOM_SNAPSHOT_VERSION (8)
 
 #define ATOM_FREQUENCY (1000000)
 #define ATOM_MAX_AUDIO_SAMPLES (1024)       // max number of audio samples in internal sample buffer
@@ -121,9 +130,11 @@ typedef struct {
     kbd_t kbd;
     struct {
         chips_audio_callback_t callback;
+        chips_audio_format_t format;
         int num_samples;
         int sample_pos;
         float sample_buffer[ATOM_MAX_AUDIO_SAMPLES];
+        int16_t sample_buffer_s16[ATOM_MAX_AUDIO_SAMPLES];
     } audio;
     uint8_t ram[0xA000];
     uint8_t rom_abasic[0x2000];
@@ -146,6 +157,8 @@ void atom_discard(atom_t* sys);
 void atom_reset(atom_t* sys);
 // query display information, can be called with nullptr
 chips_display_info_t atom_display_info(atom_t* sys);
+// get the hash of the last completed video frame (see chips_display_hash())
+uint64_t atom_frame_hash(atom_t* sys);
 // run Atom instance for a number of microseconds
 uint32_t atom_exec(atom_t* sys, uint32_t micro_seconds);
 // send a key down event
@@ -195,6 +208,7 @@ void atom_init(atom_t* sys, const atom_desc_t* desc) {
     sys->valid = true;
     sys->joystick_type = desc->joystick_type;
     sys->audio.callback = desc->audio.callback;
+    sys->audio.format = chips_audio_format(&desc->audio.callback, desc->audio.format);
     sys->audio.num_samples = _ATOM_DEFAULT(desc->audio.num_samples, ATOM_DEFAULT_AUDIO_SAMPLES);
     CHIPS_ASSERT(sys->audio.num_samples <= ATOM_MAX_AUDIO_SAMPLES);
     sys->debug = desc->debug;
@@ -262,11 +276,9 @@ uint64_t _atom_tick(atom_t* sys, uint64_t cpu_pins) {
     // update beeper
     if (beeper_tick(&sys->beeper)) {
         // new audio sample ready
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->beeper.sample;
+        chips_audio_store(sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.sample_pos++, sys->beeper.sample);
         if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
+            chips_audio_flush(&sys->audio.callback, sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.num_samples);
             sys->audio.sample_pos = 0;
         }
     }
@@ -726,6 +738,11 @@ chips_display_info_t atom_display_info(atom_t* sys) {
     return res;
 }
 
+uint64_t atom_frame_hash(atom_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return sys->vdg.frame_hash;
+}
+
 uint32_t atom_save_snapshot(atom_t* sys, atom_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
@@ -21,6 +21,7 @@
     You need to include the following headers before including bombjack.h:
 
     - chips/chips_common.h
+    - chips/chips_audio.h
     - chips/z80.h
     - chips/ay38910.h
     - chips/clk.h
@@ -33,6 +34,13 @@
         - https://floooh.github.io/2018/10/06/bombjack.html
         - https://github.com/floooh/emu-info/blob/master/misc/bombjack-schematics.pdf
 
+    ## Headless Mode
+
+    Set bombjack_desc_t.video_off to true, or call bombjack_enable_video(sys, false)
+    to skip the video decoding at the end of bombjack_exec(). Call
+    bombjack_render_video() to decode the framebuffer from the current
+    video state on demand (for instance to take a screenshot).
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -61,7 +69,7 @@ extern "C" {
 #endif
 
 // increase when bombjack_t memory layout changes
-#define BOMBJACK_SNAPSHOT_VERSION (2)
+#define BOMBJACK_SNAPSHOT_VERSION (12)
 
 #define BOMBJACK_MAX_AUDIO_SAMPLES (1024)
 #define BOMBJACK_DEFAULT_AUDIO_SAMPLES (128)
@@ -142,6 +150,7 @@ typedef struct {
 typedef struct {
     bombjack_debug_t debug;
     chips_audio_desc_t audio;
+    bool video_off;     // start in headless mode (see bombjack_enable_video())
     struct {
         chips_range_t main_0000_1FFF;    // main-board ROM 0x0000..0x1FFF
         chips_range_t main_2000_3FFF;    // main-board ROM 0x2000..0x3FFF
@@ -182,6 +191,7 @@ typedef struct {
     struct {
         z80_t cpu;
         ay38910_t psg[3];
+        uint32_t psg_ticks;     // PSG ticks not yet executed (see _bombjack_psg_sync())
         uint32_t tick_count;
         int vsync_count;
         mem_t mem;
@@ -202,12 +212,16 @@ typedef struct {
 
     struct {
         chips_audio_callback_t callback;
+        chips_audio_format_t format;
         int num_samples;
         int sample_pos;
         float volume;
         float sample_buffer[BOMBJACK_MAX_AUDIO_SAMPLES];
+        int16_t sample_buffer_s16[BOMBJACK_MAX_AUDIO_SAMPLES];
     } audio;
 
+    bool video_off;     // if true, don't decode video at the end of bombjack_exec()
+
     struct {
         bombjack_debug_t debug;
         bool draw_background_layer;
@@ -217,6 +231,17 @@ typedef struct {
     } dbg;
 
     alignas(64) uint32_t fb[BOMBJACK_FRAMEBUFFER_WIDTH * BOMBJACK_FRAMEBUFFER_HEIGHT];
+
+    // pre-decoded tiles and the cached background layer, this must be the
+    // last item, it is derived from the ROMs and not part of snapshots
+    struct {
+        uint8_t bg_tiles[256][16*16];       // 16x16 background tiles as 3-bit pens
+        uint8_t fg_tiles[512][8*8];         // 8x8 foreground tiles as 3-bit pens
+        uint8_t sprite_tiles[256][16*16];   // 16x16 sprites as 3-bit pens (32x32 sprites are made of 4)
+        bool bg_valid;                      // false if the background layer must be redrawn
+        uint8_t bg_image;                   // background image select value of the background layer
+        alignas(64) uint32_t bg_layer[BOMBJACK_DISPLAY_WIDTH * BOMBJACK_DISPLAY_HEIGHT];
+    } video;
 } bombjack_t;
 
 // initialize a new bombjack instance
@@ -227,12 +252,20 @@ void bombjack_discard(bombjack_t* sys);
 void bombjack_reset(bombjack_t* sys);
 // query display attributes and framebuffer content (can be called with nullptr)
 chips_display_info_t bombjack_display_info(bombjack_t* sys);
+// get a 64-bit hash of the visible screen area in the framebuffer (see chips_display_hash())
+uint64_t bombjack_frame_hash(bombjack_t* sys);
 // run bombjack instance for given amount of microseconds
 uint32_t bombjack_exec(bombjack_t* sys, uint32_t micro_seconds);
 // take a snapshot, patches any pointers to zero, returns a snapshot version
 uint32_t bombjack_save_snapshot(bombjack_t* sys, bombjack_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool bombjack_load_snapshot(bombjack_t* sys, uint32_t version, bombjack_t* src);
+// enable/disable video decoding at the end of bombjack_exec()
+void bombjack_enable_video(bombjack_t* sys, bool enabled);
+// return true if video decoding is enabled
+bool bombjack_video_enabled(bombjack_t* sys);
+// decode the framebuffer from the current video state
+void bombjack_render_video(bombjack_t* sys);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -245,6 +278,11 @@ bool bombjack_load_snapshot(bombjack_t* sys, uint32_t version, bombjack_t* src);
     #include <assert.h>
     #define CHIPS_ASSERT(c) assert(c)
 #endif
+// define BOMBJACK_NO_SIMD to disable the AVX2 tile blitter
+#if defined(__AVX2__) && !defined(BOMBJACK_NO_SIMD)
+    #include <immintrin.h>
+    #define _BOMBJACK_AVX2 (1)
+#endif
 
 #define _BOMBJACK_MAINBOARD_FREQUENCY (4000000)
 #define _BOMBJACK_SOUNDBOARD_FREQUENCY (3000000)
@@ -254,6 +292,9 @@ bool bombjack_load_snapshot(bombjack_t* sys, uint32_t version, bombjack_t* src);
 
 #define _bombjack_def(val, def) (val == 0 ? def : val)
 
+static void _bombjack_init_tiles(bombjack_t* sys);
+static void _bombjack_psg_sync(bombjack_t* sys);
+
 void bombjack_init(bombjack_t* sys, const bombjack_desc_t* desc) {
     CHIPS_ASSERT(sys && desc);
     if (desc->debug.mainboard.callback.func) { CHIPS_ASSERT(desc->debug.mainboard.stopped); }
@@ -262,6 +303,7 @@ void bombjack_init(bombjack_t* sys, const bombjack_desc_t* desc) {
     memset(sys, 0, sizeof(bombjack_t));
     sys->valid = true;
     sys->dbg.debug = desc->debug;
+    sys->video_off = desc->video_off;
     sys->dbg.draw_background_layer = true;
     sys->dbg.draw_foreground_layer = true;
     sys->dbg.draw_sprite_layer = true;
@@ -300,6 +342,7 @@ void bombjack_init(bombjack_t* sys, const bombjack_desc_t* desc) {
     memcpy(sys->rom_sprites[1], desc->roms.sprites_2000_3FFF.ptr, sizeof(sys->rom_sprites[1]));
     memcpy(sys->rom_sprites[2], desc->roms.sprites_4000_5FFF.ptr, sizeof(sys->rom_sprites[2]));
     memcpy(sys->rom_maps[0], desc->roms.maps_0000_0FFF.ptr, sizeof(sys->rom_maps[0]));
+    _bombjack_init_tiles(sys);
 
     /* The VSYNC/VBLANK mainly controls the interrupts (Bombjack generally
         uses NMIs for simplicity. The mainboard's NMI is connected to the
@@ -327,7 +370,8 @@ void bombjack_init(bombjack_t* sys, const bombjack_desc_t* desc) {
         .type = AY38910_TYPE_8910,
         .tick_hz = 1500000,
         .sound_hz = _bombjack_def(desc->audio.sample_rate, 44100),
-        .magnitude = 0.2f,
+        // the output volume is folded into the PSG magnitude so the mix stays fixed-point
+        .magnitude = 0.2f * _bombjack_def(desc->audio.volume, 1.0f),
     };
     for (size_t i = 0; i < 3; i++) {
         ay38910_init(&sys->soundboard.psg[i], &psg_desc);
@@ -375,6 +419,7 @@ void bombjack_init(bombjack_t* sys, const bombjack_desc_t* desc) {
     // move over audio-output config
     CHIPS_ASSERT(desc->audio.num_samples <= BOMBJACK_MAX_AUDIO_SAMPLES);
     sys->audio.callback = desc->audio.callback;
+    sys->audio.format = chips_audio_format(&desc->audio.callback, desc->audio.format);
     sys->audio.num_samples = _bombjack_def(desc->audio.num_samples, BOMBJACK_DEFAULT_AUDIO_SAMPLES);
     sys->audio.volume = _bombjack_def(desc->audio.volume, 1.0f);
 }
@@ -388,6 +433,7 @@ void bombjack_reset(bombjack_t* sys) {
     CHIPS_ASSERT(sys && sys->valid);
     z80_reset(&sys->mainboard.cpu);
     z80_reset(&sys->soundboard.cpu);
+    _bombjack_psg_sync(sys);
     for (size_t i = 0; i < 3; i++) {
         ay38910_reset(&sys->soundboard.psg[i]);
     }
@@ -415,7 +461,11 @@ static inline void _bombjack_update_palette_cache(bombjack_t* sys, uint16_t addr
         uint8_t r = (data & 0x0F) | ((data<<4)&0xF0);
         c = 0xFF000000 | (c & 0x00FF0000) | (g<<8) | r;
     }
-    sys->mainboard.palette[pal_index] = c;
+    if (c != sys->mainboard.palette[pal_index]) {
+        sys->mainboard.palette[pal_index] = c;
+        // the cached background layer has the old color
+        sys->video.bg_valid = false;
+    }
 }
 
 /* main board tick function
@@ -645,28 +695,42 @@ static uint64_t _bombjack_tick_soundboard(bombjack_t* sys, uint64_t pins) {
         if (psg_index < 3) {
             if (pins & Z80_WR) { pins |= AY38910_BDIR; }
             if (0 == (pins & Z80_A0)) { pins |= AY38910_BC1; }
+            _bombjack_psg_sync(sys);
             pins = ay38910_iorq(&sys->soundboard.psg[psg_index], pins) & Z80_PIN_MASK;
         }
     }
 
-    // tick the AY chips at half CPU frequency
+    // tick the AY chips at half CPU frequency (executed in bulk by _bombjack_psg_sync())
     if (sys->soundboard.tick_count++ & 1) {
-        ay38910_tick(&sys->soundboard.psg[2]);
-        ay38910_tick(&sys->soundboard.psg[1]);
-        if (ay38910_tick(&sys->soundboard.psg[0])) {
-            float s = sys->soundboard.psg[0].sample +
-                      sys->soundboard.psg[1].sample +
-                      sys->soundboard.psg[2].sample;
-            sys->audio.sample_buffer[sys->audio.sample_pos++] = s * sys->audio.volume;
+        sys->soundboard.psg_ticks++;
+    }
+    return pins;
+}
+
+/* run the pending PSG ticks in bulk, the 3 PSGs are advanced in lockstep
+   to the next sample of the first PSG, this must be called before accessing
+   a PSG, and at the end of each sound board time slice
+*/
+static void _bombjack_psg_sync(bombjack_t* sys) {
+    ay38910_t* psg = sys->soundboard.psg;
+    while (sys->soundboard.psg_ticks > 0) {
+        const uint32_t num_ticks = sys->soundboard.psg_ticks;
+        const bool sample_ready = ay38910_advance(&psg[0], &sys->soundboard.psg_ticks);
+        for (size_t i = 1; i < 3; i++) {
+            uint32_t ticks = num_ticks - sys->soundboard.psg_ticks;
+            while (ticks > 0) {
+                ay38910_advance(&psg[i], &ticks);
+            }
+        }
+        if (sample_ready) {
+            const int32_t s = psg[0].sample + psg[1].sample + psg[2].sample;
+            chips_audio_store(sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.sample_pos++, s);
             if (sys->audio.sample_pos == sys->audio.num_samples) {
-                if (sys->audio.callback.func) {
-                    sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-                }
+                chips_audio_flush(&sys->audio.callback, sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.num_samples);
                 sys->audio.sample_pos = 0;
             }
         }
     }
-    return pins;
 }
 
 /* render background tiles
@@ -729,8 +793,79 @@ static uint64_t _bombjack_tick_soundboard(bombjack_t* sys, uint64_t pins) {
 #define BOMBJACK_GATHER16(rom,off) \
     ((uint16_t)rom[0+off]<<8)|((uint16_t)rom[8+off])
 
+/* decode the 3-bitplane tile, char and sprite ROMs into 'pen atlases'
+    with one byte per pixel, this happens once in bombjack_init(), the
+    video decoding functions then only need to look up the pen's color
+    in the palette
+*/
+static void _bombjack_decode_tile16(uint8_t* dst, const uint8_t (*rom)[0x2000], size_t off) {
+    for (size_t yy = 0; yy < 16; yy++) {
+        uint16_t bm0 = BOMBJACK_GATHER16(rom[0], off);
+        uint16_t bm1 = BOMBJACK_GATHER16(rom[1], off);
+        uint16_t bm2 = BOMBJACK_GATHER16(rom[2], off);
+        off++;
+        if (yy == 7) {
+            off += 8;
+        }
+        for (int xx = 15; xx >= 0; xx--) {
+            *dst++ = ((bm2>>xx)&1) | (((bm1>>xx)&1)<<1) | (((bm0>>xx)&1)<<2);
+        }
+    }
+}
+
+static void _bombjack_init_tiles(bombjack_t* sys) {
+    for (size_t tile_code = 0; tile_code < 256; tile_code++) {
+        // every 16x16 tile is 32 bytes
+        _bombjack_decode_tile16(sys->video.bg_tiles[tile_code], sys->rom_tiles, tile_code * 32);
+        _bombjack_decode_tile16(sys->video.sprite_tiles[tile_code], sys->rom_sprites, tile_code * 32);
+    }
+    for (size_t tile_code = 0; tile_code < 512; tile_code++) {
+        // 8 bytes per char bitmap
+        uint8_t* dst = sys->video.fg_tiles[tile_code];
+        size_t off = tile_code * 8;
+        for (size_t yy = 0; yy < 8; yy++, off++) {
+            uint8_t bm0 = sys->rom_chars[0][off];
+            uint8_t bm1 = sys->rom_chars[1][off];
+            uint8_t bm2 = sys->rom_chars[2][off];
+            for (int xx = 7; xx >= 0; xx--) {
+                *dst++ = ((bm2>>xx)&1) | (((bm1>>xx)&1)<<1) | (((bm0>>xx)&1)<<2);
+            }
+        }
+    }
+    sys->video.bg_valid = false;
+}
+
+/* resolve 8 pens through an 8-entry palette block into 32-bit colors,
+    pen 0 is transparent if 'opaque' is false
+*/
+static inline void _bombjack_blit8(uint32_t* dst, const uint8_t* pens, const uint32_t* colors, bool opaque) {
+    #if defined(_BOMBJACK_AVX2)
+        __m256i pal = _mm256_loadu_si256((const __m256i*)colors);
+        __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)pens));
+        __m256i c = _mm256_permutevar8x32_epi32(pal, idx);
+        if (!opaque) {
+            __m256i transparent = _mm256_cmpeq_epi32(idx, _mm256_setzero_si256());
+            c = _mm256_blendv_epi8(c, _mm256_loadu_si256((const __m256i*)dst), transparent);
+        }
+        _mm256_storeu_si256((__m256i*)dst, c);
+    #else
+        for (size_t x = 0; x < 8; x++) {
+            uint8_t pen = pens[x];
+            if (opaque || (pen != 0)) {
+                dst[x] = colors[pen];
+            }
+        }
+    #endif
+}
+
+/* render the background layer into the background layer cache
+
+    The background image is selected by the background select register,
+    and the background layer cache is only redrawn when the selected image
+    or the color palette changes.
+*/
 static void _bombjack_decode_background(bombjack_t* sys) {
-    uint32_t* ptr = sys->fb;
+    uint32_t* ptr = sys->video.bg_layer;
     uint16_t img_base_addr = (sys->mainboard.bg_image & 7) * 0x0200;
     bool img_valid = (sys->mainboard.bg_image & 0x10) != 0;
     for (size_t y = 0; y < 16; y++) {
@@ -739,37 +874,29 @@ static void _bombjack_decode_background(bombjack_t* sys) {
             // 256 tiles
             uint8_t tile_code = img_valid ? sys->rom_maps[0][addr] : 0;
             uint8_t attr = sys->rom_maps[0][addr + 0x0100];
-            uint8_t color_block = (attr & 0x0F)<<3;
+            const uint32_t* colors = &sys->mainboard.palette[(attr & 0x0F)<<3];
             bool flip_y = (attr & 0x80) != 0;
-            if (flip_y) {
-                ptr += 15*BOMBJACK_FRAMEBUFFER_WIDTH;
-            }
-            // every tile is 32 bytes
-            size_t off = tile_code * 32;
-            for (size_t yy = 0; yy < 16; yy++) {
-                uint16_t bm0 = BOMBJACK_GATHER16(sys->rom_tiles[0], off);
-                uint16_t bm1 = BOMBJACK_GATHER16(sys->rom_tiles[1], off);
-                uint16_t bm2 = BOMBJACK_GATHER16(sys->rom_tiles[2], off);
-                off++;
-                if (yy == 7) {
-                    off += 8;
-                }
-                for (int xx = 15; xx >= 0; xx--) {
-                    uint8_t pen = ((bm2>>xx)&1) | (((bm1>>xx)&1)<<1) | (((bm0>>xx)&1)<<2);
-                    *ptr++ = sys->mainboard.palette[color_block | pen];
-                }
-                ptr += flip_y ? -272 : 240;
-            }
-            if (flip_y) {
-                ptr += BOMBJACK_FRAMEBUFFER_WIDTH + 16;
-            }
-            else {
-                ptr -= (16 * BOMBJACK_FRAMEBUFFER_WIDTH) - 16;
+            const uint8_t* pens = sys->video.bg_tiles[tile_code];
+            for (size_t yy = 0; yy < 16; yy++, pens += 16) {
+                uint32_t* dst = ptr + (flip_y ? (15 - yy) : yy) * BOMBJACK_DISPLAY_WIDTH + x * 16;
+                _bombjack_blit8(dst + 0, pens + 0, colors, true);
+                _bombjack_blit8(dst + 8, pens + 8, colors, true);
             }
         }
-        ptr += (15 * BOMBJACK_FRAMEBUFFER_WIDTH);
+        ptr += 16 * BOMBJACK_DISPLAY_WIDTH;
     }
-    CHIPS_ASSERT(ptr == &sys->fb[BOMBJACK_FRAMEBUFFER_WIDTH * BOMBJACK_DISPLAY_HEIGHT]);
+    CHIPS_ASSERT(ptr == &sys->video.bg_layer[BOMBJACK_DISPLAY_WIDTH * BOMBJACK_DISPLAY_HEIGHT]);
+    sys->video.bg_image = sys->mainboard.bg_image;
+    sys->video.bg_valid = true;
+}
+
+// copy the cached background layer into the framebuffer
+static void _bombjack_draw_background(bombjack_t* sys) {
+    if (!sys->video.bg_valid || (sys->video.bg_image != sys->mainboard.bg_image)) {
+        _bombjack_decode_background(sys);
+    }
+    CHIPS_ASSERT(BOMBJACK_DISPLAY_WIDTH == BOMBJACK_FRAMEBUFFER_WIDTH);
+    memcpy(sys->fb, sys->video.bg_layer, sizeof(sys->video.bg_layer));
 }
 
 /* render foreground tiles
@@ -802,29 +929,14 @@ static void _bombjack_decode_foreground(bombjack_t* sys) {
             // 512 foreground tiles, take 9th bit from color code
             size_t tile_code = chr | ((clr & 0x10)<<4);
             // 16 color blocks a 8 colors
-            size_t color_block = (clr & 0x0F)<<3;
-            // 8 bytes per char bitmap
-            size_t off = tile_code * 8;
-            for (size_t yy = 0; yy < 8; yy++) {
-                /* 3 bit planes per char (8 colors per pixel within
-                   the palette color block of the char
-                */
-                uint8_t bm0 = sys->rom_chars[0][off];
-                uint8_t bm1 = sys->rom_chars[1][off];
-                uint8_t bm2 = sys->rom_chars[2][off];
-                off++;
-                for (int xx = 7; xx >= 0; xx--) {
-                    uint8_t pen = ((bm2>>xx)&1) | (((bm1>>xx)&1)<<1) | (((bm0>>xx)&1)<<2);
-                    if (pen) {
-                        *ptr = sys->mainboard.palette[color_block | pen];
-                    }
-                    ptr++;
-                }
-                ptr += 248;
+            const uint32_t* colors = &sys->mainboard.palette[(clr & 0x0F)<<3];
+            const uint8_t* pens = sys->video.fg_tiles[tile_code];
+            uint32_t* dst = ptr + x * 8;
+            for (size_t yy = 0; yy < 8; yy++, pens += 8, dst += BOMBJACK_FRAMEBUFFER_WIDTH) {
+                _bombjack_blit8(dst, pens, colors, false);
             }
-            ptr -= (8 * BOMBJACK_FRAMEBUFFER_WIDTH) - 8;
         }
-        ptr += (7 * BOMBJACK_FRAMEBUFFER_WIDTH);
+        ptr += 8 * BOMBJACK_FRAMEBUFFER_WIDTH;
     }
     CHIPS_ASSERT(ptr == &sys->fb[BOMBJACK_FRAMEBUFFER_WIDTH * BOMBJACK_DISPLAY_HEIGHT]);
 }
@@ -845,13 +957,10 @@ static void _bombjack_decode_foreground(bombjack_t* sys) {
     G:  color
     X:  x pos
     Y:  y pos
-*/
-#define BOMBJACK_GATHER32(rom,off) \
-    ((uint32_t)rom[0+off]<<24)|\
-    ((uint32_t)rom[8+off]<<16)|\
-    ((uint32_t)rom[32+off]<<8)|\
-    ((uint32_t)rom[40+off])
 
+    32x32 sprites are made of the four 16x16 sprites 4*index+0..3
+    (top-left, top-right, bottom-left, bottom-right).
+*/
 static void _bombjack_decode_sprites(bombjack_t* sys) {
     uint32_t* dst = sys->fb;
     // 24 hardware sprites, sprite 0 has highest priority
@@ -862,7 +971,7 @@ static void _bombjack_decode_sprites(bombjack_t* sys) {
         uint8_t b1 = sys->main_ram[addr + 1];
         uint8_t b2 = sys->main_ram[addr + 2];
         uint8_t b3 = sys->main_ram[addr + 3];
-        uint8_t color_block = (b1 & 0x0F)<<3;
+        const uint32_t* colors = &sys->mainboard.palette[(b1 & 0x0F)<<3];
 
         // screen is 90 degree rotated, so x and y are switched
         uint8_t px = b3;
@@ -871,24 +980,15 @@ static void _bombjack_decode_sprites(bombjack_t* sys) {
             // 32x32 'large' sprites (no flip-x/y needed)
             uint8_t py = 225 - b2;
             uint32_t* ptr = dst + py*BOMBJACK_FRAMEBUFFER_WIDTH + px;
-            // offset into sprite ROM to gather sprite bitmap pixels
-            size_t off = sprite_code * 128;
             for (size_t y = 0; y < 32; y++) {
-                uint32_t bm0 = BOMBJACK_GATHER32(sys->rom_sprites[0], off);
-                uint32_t bm1 = BOMBJACK_GATHER32(sys->rom_sprites[1], off);
-                uint32_t bm2 = BOMBJACK_GATHER32(sys->rom_sprites[2], off);
-                off++;
-                if ((y & 7) == 7) {
-                    off += 8;
-                }
-                if ((y & 15) == 15) {
-                    off += 32;
-                }
-                for (int x = 31; x >= 0; x--) {
-                    uint8_t pen = ((bm2>>x)&1) | (((bm1>>x)&1)<<1) | (((bm0>>x)&1)<<2);
+                // the sprite ROM only has room for 64 large sprites
+                const uint8_t* pens_l = sys->video.sprite_tiles[((sprite_code * 4) + ((y & 16) ? 2 : 0)) & 0xFF] + (y & 15) * 16;
+                const uint8_t* pens_r = pens_l + sizeof(sys->video.sprite_tiles[0]);
+                for (size_t x = 0; x < 32; x++) {
+                    uint8_t pen = (x < 16) ? pens_l[x] : pens_r[x - 16];
                     if (0 != pen) {
                         CHIPS_ASSERT((ptr >= &sys->fb[0]) && (ptr < &sys->fb[BOMBJACK_FRAMEBUFFER_WIDTH*BOMBJACK_FRAMEBUFFER_HEIGHT]));
-                        *ptr = sys->mainboard.palette[color_block | pen];
+                        *ptr = colors[pen];
                     }
                     ptr++;
                 }
@@ -904,35 +1004,15 @@ static void _bombjack_decode_sprites(bombjack_t* sys) {
             if (flip_x) {
                 ptr += 16*BOMBJACK_FRAMEBUFFER_WIDTH;
             }
-            // offset into sprite ROM to gather sprite bitmap pixels
-            size_t off = sprite_code * 32;
-            for (size_t y = 0; y < 16; y++) {
-                uint16_t bm0 = BOMBJACK_GATHER16(sys->rom_sprites[0], off);
-                uint16_t bm1 = BOMBJACK_GATHER16(sys->rom_sprites[1], off);
-                uint16_t bm2 = BOMBJACK_GATHER16(sys->rom_sprites[2], off);
-                off++;
-                if (y == 7) {
-                    off += 8;
-                }
-                if (flip_y) {
-                    for (size_t x=0; x<=15; x++) {
-                        uint8_t pen = ((bm2>>x)&1) | (((bm1>>x)&1)<<1) | (((bm0>>x)&1)<<2);
-                        if (0 != pen) {
-                            CHIPS_ASSERT((ptr >= &sys->fb[0]) && (ptr < &sys->fb[BOMBJACK_FRAMEBUFFER_WIDTH*BOMBJACK_FRAMEBUFFER_HEIGHT]));
-                            *ptr = sys->mainboard.palette[color_block | pen];
-                        }
-                        ptr++;
-                    }
-                }
-                else {
-                    for (int x=15; x>=0; x--) {
-                        uint8_t pen = ((bm2>>x)&1) | (((bm1>>x)&1)<<1) | (((bm0>>x)&1)<<2);
-                        if (0 != pen) {
-                            CHIPS_ASSERT((ptr >= &sys->fb[0]) && (ptr < &sys->fb[BOMBJACK_FRAMEBUFFER_WIDTH*BOMBJACK_FRAMEBUFFER_HEIGHT]));
-                            *ptr = sys->mainboard.palette[color_block | pen];
-                        }
-                        ptr++;
+            const uint8_t* pens = sys->video.sprite_tiles[sprite_code];
+            for (size_t y = 0; y < 16; y++, pens += 16) {
+                for (size_t x = 0; x < 16; x++) {
+                    uint8_t pen = pens[flip_y ? (15 - x) : x];
+                    if (0 != pen) {
+                        CHIPS_ASSERT((ptr >= &sys->fb[0]) && (ptr < &sys->fb[BOMBJACK_FRAMEBUFFER_WIDTH*BOMBJACK_FRAMEBUFFER_HEIGHT]));
+                        *ptr = colors[pen];
                     }
+                    ptr++;
                 }
                 ptr += flip_x ? -272 : 240;
             }
@@ -942,7 +1022,7 @@ static void _bombjack_decode_sprites(bombjack_t* sys) {
 
 static void _bombjack_decode_video(bombjack_t* sys) {
     if (sys->dbg.draw_background_layer) {
-        _bombjack_decode_background(sys);
+        _bombjack_draw_background(sys);
     }
     else {
         if (sys->dbg.clear_background_layer) {
@@ -1008,21 +1088,40 @@ uint32_t bombjack_exec(bombjack_t* sys, uint32_t micro_seconds) {
                 for (uint32_t tick = 0; tick < sb_num_ticks; tick++) {
                     pins = _bombjack_tick_soundboard(sys, pins);
                 }
+                _bombjack_psg_sync(sys);
             }
             else {
-                // run with debug callback
+                // run with debug callback, keep the PSG state current for the debugger
                 for (uint32_t tick = 0; (tick < sb_num_ticks) && !(*sys->dbg.debug.soundboard.stopped); tick++) {
                     pins = _bombjack_tick_soundboard(sys, pins);
+                    _bombjack_psg_sync(sys);
                     sys->dbg.debug.soundboard.callback.func(sys->dbg.debug.soundboard.callback.user_data, pins);
                 }
             }
             sys->soundboard.pins = pins;
         }
     }
-    _bombjack_decode_video(sys);
+    if (!sys->video_off) {
+        _bombjack_decode_video(sys);
+    }
     return 2 * (mb_num_ticks + sb_num_ticks);
 }
 
+void bombjack_enable_video(bombjack_t* sys, bool enabled) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->video_off = !enabled;
+}
+
+bool bombjack_video_enabled(bombjack_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return !sys->video_off;
+}
+
+void bombjack_render_video(bombjack_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    _bombjack_decode_video(sys);
+}
+
 chips_display_info_t bombjack_display_info(bombjack_t* sys) {
     const chips_display_info_t res = {
         .frame = {
@@ -1048,9 +1147,16 @@ chips_display_info_t bombjack_display_info(bombjack_t* sys) {
     return res;
 }
 
+uint64_t bombjack_frame_hash(bombjack_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    const chips_display_info_t info = bombjack_display_info(sys);
+    return chips_display_hash(&info);
+}
+
 uint32_t bombjack_save_snapshot(bombjack_t* sys, bombjack_t* dst) {
     CHIPS_ASSERT(sys && dst);
-    *dst = *sys;
+    // skip the tile caches at the end of bombjack_t
+    memcpy(dst, sys, offsetof(bombjack_t, video));
     chips_debug_snapshot_onsave(&dst->dbg.debug.mainboard);
     chips_debug_snapshot_onsave(&dst->dbg.debug.soundboard);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
@@ -1068,7 +1174,7 @@ bool bombjack_load_snapshot(bombjack_t* sys, uint32_t version, bombjack_t* src)
         return false;
     }
     static bombjack_t im;
-    im = *src;
+    memcpy(&im, src, offsetof(bombjack_t, video));
     chips_debug_snapshot_onload(&im.dbg.debug.mainboard, &sys->dbg.debug.mainboard);
     chips_debug_snapshot_onload(&im.dbg.debug.soundboard, &sys->dbg.debug.soundboard);
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
@@ -1077,7 +1183,10 @@ bool bombjack_load_snapshot(bombjack_t* sys, uint32_t version, bombjack_t* src)
     }
     mem_snapshot_onload(&im.mainboard.mem, sys);
     mem_snapshot_onload(&im.soundboard.mem, sys);
-    *sys = im;
+    im.video_off = sys->video_off;
+    memcpy(sys, &im, offsetof(bombjack_t, video));
+    // rebuild the tile caches from the snapshot's ROMs
+    _bombjack_init_tiles(sys);
     return true;
 }
 
@@ -25,6 +25,20 @@
     - chips/m6522.h
     - chips/mem.h
 
+    ## Idle Sleep
+
+    Most of the time the drive CPU is spinning in a wait loop of the
+    drive ROM, which doubles the CPU emulation cost of a C64 with attached
+    floppy drive. When idle sleep is enabled (c1541_desc_t.idle_sleep),
+    c1541_tick() watches for loops where the CPU state at the start
+    of the loop is identical to the state at the start of the previous
+    iteration, with no memory writes and no IEC bus changes in between. Such
+    a loop will repeat forever until the IEC bus state changes, so the drive
+    goes to sleep and c1541_tick() only counts ticks until the next change
+    of the IEC port, then the drive CPU is fast-forwarded to the exact tick
+    within the loop before continuing normally. Use c1541_is_sleeping() to
+    check whether the drive is currently sleeping.
+
     ## zlib/libpng license
 
     Copyright (c) 2019 Andre Weissflog
@@ -64,6 +78,8 @@ extern "C" {
 typedef struct {
     // pointer to a shared byte with IEC serial bus line state
     uint8_t* iec_port;
+    // true to enable sleeping in idle loops
+    bool idle_sleep;
     // rom images
     struct {
         chips_range_t c000_dfff;
@@ -71,6 +87,20 @@ typedef struct {
     } roms;
 } c1541_desc_t;
 
+// idle loop detection state
+typedef struct {
+    bool enabled;
+    bool sleeping;
+    bool mem_written;       // true if memory was written since loop start
+    uint8_t iec;            // IEC port state at loop start
+    uint16_t last_pc;       // address of last opcode fetch
+    uint16_t loop_pc;       // address of loop start
+    uint32_t period;        // length of the idle loop in ticks
+    uint64_t ticks;         // ticks since loop start, or skipped ticks while sleeping
+    uint64_t pins;          // CPU pins at loop start
+    uint8_t cpu[offsetof(m6502_t, user_data)];   // CPU register state at loop start
+} c1541_idle_t;
+
 // 1541 emulator state
 typedef struct {
     uint64_t pins;
@@ -78,6 +108,7 @@ typedef struct {
     m6502_t cpu;
     m6522_t via_1;
     m6522_t via_2;
+    c1541_idle_t idle;
     bool valid;
     mem_t mem;
     uint8_t ram[0x0800];
@@ -96,6 +127,8 @@ void c1541_tick(c1541_t* sys);
 void c1541_insert_disc(c1541_t* sys, chips_range_t data);
 // remove current disc
 void c1541_remove_disc(c1541_t* sys);
+// return true if the drive CPU is currently sleeping in an idle loop
+bool c1541_is_sleeping(c1541_t* sys);
 // prepare a c1541_t snapshot for saving
 void c1541_snapshot_onsave(c1541_t* snapshot, void* base);
 // prepare a c1541_t snapshot for loading
@@ -118,6 +151,8 @@ void c1541_init(c1541_t* sys, const c1541_desc_t* desc) {
 
     memset(sys, 0, sizeof(c1541_t));
     sys->valid = true;
+    sys->iec = desc->iec_port;
+    sys->idle.enabled = desc->idle_sleep;
 
     // copy ROM images
     CHIPS_ASSERT(desc->roms.c000_dfff.ptr && (0x2000 == desc->roms.c000_dfff.size));
@@ -143,14 +178,51 @@ void c1541_discard(c1541_t* sys) {
     sys->valid = false;
 }
 
+static void _c1541_wakeup(c1541_t* sys);
+
 void c1541_reset(c1541_t* sys) {
     CHIPS_ASSERT(sys && sys->valid);
+    _c1541_wakeup(sys);
     sys->pins |= M6502_RES;
     m6522_reset(&sys->via_1);
     m6522_reset(&sys->via_2);
 }
 
-void c1541_tick(c1541_t* sys) {
+static inline uint8_t _c1541_iec(c1541_t* sys) {
+    return sys->iec ? *sys->iec : 0;
+}
+
+/*  Called on each opcode fetch when idle sleep is enabled, a backward jump
+    starts a new loop candidate, if the CPU arrives at the same loop
+    start again with exactly the same state, the loop will repeat forever
+    and the drive can go to sleep.
+*/
+static void _c1541_detect_idle(c1541_t* sys, uint16_t pc) {
+    c1541_idle_t* idle = &sys->idle;
+    if (pc <= idle->last_pc) {
+        if ((pc == idle->loop_pc) &&
+            !idle->mem_written &&
+            (idle->iec == _c1541_iec(sys)) &&
+            (idle->pins == sys->pins) &&
+            (0 == memcmp(idle->cpu, &sys->cpu, sizeof(idle->cpu))))
+        {
+            idle->sleeping = true;
+            idle->period = (uint32_t)idle->ticks;
+            idle->ticks = 0;
+        }
+        else {
+            idle->loop_pc = pc;
+            idle->mem_written = false;
+            idle->iec = _c1541_iec(sys);
+            idle->pins = sys->pins;
+            memcpy(idle->cpu, &sys->cpu, sizeof(idle->cpu));
+            idle->ticks = 0;
+        }
+    }
+    idle->last_pc = pc;
+}
+
+static void _c1541_tick(c1541_t* sys) {
     uint64_t pins = sys->pins;
 
     pins = m6502_tick(&sys->cpu, pins);
@@ -161,9 +233,58 @@ void c1541_tick(c1541_t* sys) {
     }
     else {
         mem_wr(&sys->mem, addr, M6502_GET_DATA(pins));
+        sys->idle.mem_written = true;
     }
 
     sys->pins = pins;
+    if (sys->idle.enabled) {
+        sys->idle.ticks++;
+        if (pins & M6502_SYNC) {
+            _c1541_detect_idle(sys, addr);
+        }
+    }
+}
+
+/*  Leave sleep mode, the CPU is still at the loop start, so run the
+    remaining ticks into the current loop iteration with the IEC port
+    state the loop was running with.
+*/
+static void _c1541_wakeup(c1541_t* sys) {
+    c1541_idle_t* idle = &sys->idle;
+    if (idle->sleeping) {
+        idle->sleeping = false;
+        uint8_t iec = 0;
+        if (sys->iec) {
+            iec = *sys->iec;
+            *sys->iec = idle->iec;
+        }
+        const uint32_t num_ticks = (uint32_t)(idle->ticks % idle->period);
+        for (uint32_t i = 0; i < num_ticks; i++) {
+            _c1541_tick(sys);
+        }
+        if (sys->iec) {
+            *sys->iec = iec;
+        }
+    }
+    idle->loop_pc = 0;
+    idle->last_pc = 0;
+    idle->ticks = 0;
+}
+
+void c1541_tick(c1541_t* sys) {
+    if (sys->idle.sleeping) {
+        if (_c1541_iec(sys) == sys->idle.iec) {
+            sys->idle.ticks++;
+            return;
+        }
+        _c1541_wakeup(sys);
+    }
+    _c1541_tick(sys);
+}
+
+bool c1541_is_sleeping(c1541_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return sys->idle.sleeping;
 }
 
 void c1541_insert_disc(c1541_t* sys, chips_range_t data) {
@@ -21,6 +21,7 @@
     You need to include the following headers before including c64.h:
 
     - chips/chips_common.h
+    - chips/chips_audio.h
     - chips/m6502.h
     - chips/m6526.h
     - chips/m6569.h
@@ -36,6 +37,22 @@
 
     TODO!
 
+    ## Headless Mode
+
+    Set c64_desc_t.video_off to true, or call c64_enable_video(sys, false) to
+    stop writing pixels into the framebuffer. The VIC-II raster timing, badlines,
+    sprite DMA, interrupts and sprite collisions are not affected (the
+    graphics sequencer still runs, but without color decoding). Like on the
+    real hardware, a frame can't be reconstructed after the fact, to take a
+    screenshot in headless mode, enable video and run until the next VSYNC
+    twice with c64_exec_until() to get one complete frame.
+
+    ## Partial Frames
+
+    For low-latency frontends, c64_desc_t.video_band can provide a callback
+    which is called each time a band of framebuffer rows has been decoded
+    by the VIC-II (see 'Video Bands' in chips_common.h).
+
     ## TODO:
 
     - floppy disc support
@@ -252,7 +269,7 @@ extern "C" {
 #endif
 
 // bump snapshot version when c64_t memory layout changes
-#define C64_SNAPSHOT_VERSION (1)
+#define C64_SNAPSHOT_VERSION (13)
 
 #define C64_FREQUENCY (985248)              // clock frequency in Hz
 #define C64_MAX_AUDIO_SAMPLES (1024)        // max number of audio samples in internal sample buffer
@@ -323,9 +340,12 @@ typedef enum {
 typedef struct {
     bool c1530_enabled;     // true to enable the C1530 datassette emulation
     bool c1541_enabled;     // true to enable the C1541 floppy drive emulation
+    bool c1541_idle_sleep;  // true to let the C1541 drive CPU sleep in idle loops
     c64_joystick_type_t joystick_type;  // default is C64_JOYSTICK_NONE
     chips_debug_t debug;    // optional debugging hook
     chips_audio_desc_t audio;   // audio output options
+    bool video_off;         // start in headless mode (see c64_enable_video())
+    chips_video_band_desc_t video_band; // optional callback for partially decoded frames
     // ROM images
     struct {
         chips_range_t chars;     // 4 KByte character ROM dump
@@ -340,12 +360,13 @@ typedef struct {
 } c64_desc_t;
 
 // C64 emulator state
-typedef struct {
+typedef struct c64_t {
     m6502_t cpu;
     m6526_t cia_1;
     m6526_t cia_2;
     m6569_t vic;
     m6581_t sid;
+    uint32_t sid_ticks;         // SID ticks not yet executed (see _c64_sid_sync())
     uint64_t pins;
 
     c64_joystick_type_t joystick_type;
@@ -360,16 +381,20 @@ typedef struct {
     uint16_t vic_bank_select;   // upper 4 address bits from CIA-2 port A
 
     kbd_t kbd;                  // keyboard matrix state
+    uint32_t kbd_ticks;         // ticks not yet passed to kbd_update() (see c64_exec_until())
     mem_t mem_cpu;              // CPU-visible memory mapping
     mem_t mem_vic;              // VIC-visible memory mapping
+    uint64_t (*tick)(struct c64_t* sys, uint64_t pins);    // tick function specialized for datasette/floppy config
     bool valid;
     chips_debug_t debug;
 
     struct {
         chips_audio_callback_t callback;
+        chips_audio_format_t format;
         int num_samples;
         int sample_pos;
         float sample_buffer[C64_MAX_AUDIO_SAMPLES];
+        int16_t sample_buffer_s16[C64_MAX_AUDIO_SAMPLES];
     } audio;
 
     uint8_t color_ram[1024];        // special static color ram
@@ -391,8 +416,12 @@ void c64_discard(c64_t* sys);
 void c64_reset(c64_t* sys);
 // get framebuffer and display attributes
 chips_display_info_t c64_display_info(c64_t* sys);
+// get a 64-bit hash of the visible screen area in the framebuffer (see chips_display_hash())
+uint64_t c64_frame_hash(c64_t* sys);
 // tick C64 instance for a given number of microseconds, return number of ticks executed
 uint32_t c64_exec(c64_t* sys, uint32_t micro_seconds);
+// run C64 instance until a stop condition is reached (without debug callback)
+chips_exec_result_t c64_exec_until(c64_t* sys, const chips_exec_until_t* until);
 // send a key-down event to the C64
 void c64_key_down(c64_t* sys, int key_code);
 // send a key-up event to the C64
@@ -417,6 +446,10 @@ void c64_tape_play(c64_t* sys);
 void c64_tape_stop(c64_t* sys);
 // return true if tape motor is on
 bool c64_is_tape_motor_on(c64_t* sys);
+// enable/disable writing pixels into the framebuffer
+void c64_enable_video(c64_t* sys, bool enabled);
+// return true if writing pixels into the framebuffer is enabled
+bool c64_video_enabled(c64_t* sys);
 // save a snapshot, patches pointers to zero and offsets, returns snapshot version
 uint32_t c64_save_snapshot(c64_t* sys, c64_t* dst);
 // load a snapshot, returns false if snapshot versions don't match
@@ -453,6 +486,8 @@ static uint16_t _c64_vic_fetch(uint16_t addr, void* user_data);
 static void _c64_update_memory_map(c64_t* sys);
 static void _c64_init_key_map(c64_t* sys);
 static void _c64_init_memory_map(c64_t* sys);
+static void _c64_select_tick(c64_t* sys);
+static void _c64_sid_sync(c64_t* sys);
 
 #define _C64_DEFAULT(val,def) (((val) != 0) ? (val) : (def))
 
@@ -465,6 +500,7 @@ void c64_init(c64_t* sys, const c64_desc_t* desc) {
     sys->joystick_type = desc->joystick_type;
     sys->debug = desc->debug;
     sys->audio.callback = desc->audio.callback;
+    sys->audio.format = chips_audio_format(&desc->audio.callback, desc->audio.format);
     sys->audio.num_samples = _C64_DEFAULT(desc->audio.num_samples, C64_DEFAULT_AUDIO_SAMPLES);
     CHIPS_ASSERT(sys->audio.num_samples <= C64_MAX_AUDIO_SAMPLES);
     CHIPS_ASSERT(desc->roms.chars.ptr && (desc->roms.chars.size == sizeof(sys->rom_char)));
@@ -501,7 +537,9 @@ void c64_init(c64_t* sys, const c64_desc_t* desc) {
             .height = _C64_SCREEN_HEIGHT,
         },
         .user_data = sys,
+        .video_band = desc->video_band,
     });
+    sys->vic.video_off = desc->video_off;
     m6581_init(&sys->sid, &(m6581_desc_t){
         .tick_hz = C64_FREQUENCY,
         .sound_hz = _C64_DEFAULT(desc->audio.sample_rate, 44100),
@@ -517,12 +555,14 @@ void c64_init(c64_t* sys, const c64_desc_t* desc) {
     if (desc->c1541_enabled) {
         c1541_init(&sys->c1541, &(c1541_desc_t){
             .iec_port = &sys->iec_port,
+            .idle_sleep = desc->c1541_idle_sleep,
             .roms = {
                 .c000_dfff = desc->roms.c1541.c000_dfff,
                 .e000_ffff = desc->roms.c1541.e000_ffff
             },
         });
     }
+    _c64_select_tick(sys);
 }
 
 void c64_discard(c64_t* sys) {
@@ -548,15 +588,20 @@ void c64_reset(c64_t* sys) {
     m6526_reset(&sys->cia_1);
     m6526_reset(&sys->cia_2);
     m6569_reset(&sys->vic);
+    _c64_sid_sync(sys);
     m6581_reset(&sys->sid);
 }
 
-static uint64_t _c64_tick(c64_t* sys, uint64_t pins) {
+/*  The tick function 'template', the c1530 and c1541 args are compile-time
+    constants in the specialized tick functions below, so that the
+    per-tick configuration checks are resolved by the compiler.
+*/
+static CHIPS_FORCE_INLINE uint64_t _c64_tick(c64_t* sys, uint64_t pins, bool c1530, bool c1541) {
     // FIXME: move datasette and floppy tick to end
-    if (sys->c1530.valid) {
+    if (c1530) {
         c1530_tick(&sys->c1530);
     }
-    if (sys->c1541.valid) {
+    if (c1541) {
         c1541_tick(&sys->c1541);
     }
 
@@ -612,18 +657,13 @@ static uint64_t _c64_tick(c64_t* sys, uint64_t pins) {
         }
     }
 
-    // tick the SID
+    // tick the SID, the SID ticks are only counted here and executed
+    // in blocks when the SID state is needed (see _c64_sid_sync())
     {
-        sid_pins = m6581_tick(&sys->sid, sid_pins);
-        if (sid_pins & M6581_SAMPLE) {
-            // new audio sample ready
-            sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->sid.sample;
-            if (sys->audio.sample_pos == sys->audio.num_samples) {
-                if (sys->audio.callback.func) {
-                    sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-                }
-                sys->audio.sample_pos = 0;
-            }
+        sys->sid_ticks++;
+        if (sid_pins & M6581_CS) {
+            _c64_sid_sync(sys);
+            sid_pins = m6581_iorq(&sys->sid, sid_pins);
         }
         if ((sid_pins & (M6581_CS|M6581_RW)) == (M6581_CS|M6581_RW)) {
             pins = M6502_COPY_DATA(pins, sid_pins);
@@ -744,6 +784,47 @@ static uint64_t _c64_tick(c64_t* sys, uint64_t pins) {
     return pins;
 }
 
+/* run the pending SID ticks in blocks and push the generated samples into
+   the audio buffer, this must be called before accessing the SID
+*/
+static void _c64_sid_sync(c64_t* sys) {
+    while (sys->sid_ticks > 0) {
+        if (m6581_advance(&sys->sid, &sys->sid_ticks)) {
+            // new audio sample ready
+            chips_audio_store(sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.sample_pos++, sys->sid.sample);
+            if (sys->audio.sample_pos == sys->audio.num_samples) {
+                chips_audio_flush(&sys->audio.callback, sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.num_samples);
+                sys->audio.sample_pos = 0;
+            }
+        }
+    }
+}
+
+static uint64_t _c64_tick_base(c64_t* sys, uint64_t pins) {
+    return _c64_tick(sys, pins, false, false);
+}
+
+static uint64_t _c64_tick_c1530(c64_t* sys, uint64_t pins) {
+    return _c64_tick(sys, pins, true, false);
+}
+
+static uint64_t _c64_tick_c1541(c64_t* sys, uint64_t pins) {
+    return _c64_tick(sys, pins, false, true);
+}
+
+static uint64_t _c64_tick_c1530_c1541(c64_t* sys, uint64_t pins) {
+    return _c64_tick(sys, pins, true, true);
+}
+
+static void _c64_select_tick(c64_t* sys) {
+    if (sys->c1530.valid) {
+        sys->tick = sys->c1541.valid ? _c64_tick_c1530_c1541 : _c64_tick_c1530;
+    }
+    else {
+        sys->tick = sys->c1541.valid ? _c64_tick_c1541 : _c64_tick_base;
+    }
+}
+
 static uint8_t _c64_cpu_port_in(void* user_data) {
     c64_t* sys = (c64_t*) user_data;
     /*
@@ -953,17 +1034,20 @@ static void _c64_init_key_map(c64_t* sys) {
 uint32_t c64_exec(c64_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
     uint32_t num_ticks = clk_us_to_ticks(C64_FREQUENCY, micro_seconds);
+    uint64_t (*tick_fn)(c64_t*, uint64_t) = sys->tick;
     uint64_t pins = sys->pins;
     if (0 == sys->debug.callback.func) {
         // run without debug callback
         for (uint32_t ticks = 0; ticks < num_ticks; ticks++) {
-            pins = _c64_tick(sys, pins);
+            pins = tick_fn(sys, pins);
         }
+        _c64_sid_sync(sys);
     }
     else {
-        // run with debug callback
+        // run with debug callback, keep the SID state current for the debugger
         for (uint32_t ticks = 0; (ticks < num_ticks) && !(*sys->debug.stopped); ticks++) {
-            pins = _c64_tick(sys, pins);
+            pins = tick_fn(sys, pins);
+            _c64_sid_sync(sys);
             sys->debug.callback.func(sys->debug.callback.user_data, pins);
         }
     }
@@ -972,6 +1056,50 @@ uint32_t c64_exec(c64_t* sys, uint32_t micro_seconds) {
     return num_ticks;
 }
 
+chips_exec_result_t c64_exec_until(c64_t* sys, const chips_exec_until_t* until) {
+    CHIPS_ASSERT(sys && sys->valid && until);
+    const uint32_t cond = until->conditions;
+    const bool until_audio = 0 != (cond & CHIPS_EXEC_UNTIL_AUDIO);
+    chips_exec_result_t res = { 0 };
+    uint64_t (*tick_fn)(c64_t*, uint64_t) = sys->tick;
+    uint64_t pins = sys->pins;
+    while (res.ticks < until->max_ticks) {
+        const uint16_t v_count = sys->vic.rs.v_count;
+        const int sample_pos = sys->audio.sample_pos;
+        pins = tick_fn(sys, pins);
+        // the SID writes the audio samples, only sync it when a sample is due
+        // and the caller waits for the audio buffer to be flushed
+        if (until_audio && (sys->sid_ticks >= chips_blip_ticks_to_sample(&sys->sid.blip))) {
+            _c64_sid_sync(sys);
+        }
+        res.ticks++;
+        // the VIC-II raster counter wraps around at the end of a frame
+        if ((cond & CHIPS_EXEC_UNTIL_VSYNC) && (v_count > sys->vic.rs.v_count)) {
+            res.reason |= CHIPS_EXEC_UNTIL_VSYNC;
+        }
+        if ((cond & CHIPS_EXEC_UNTIL_AUDIO) && (sample_pos > sys->audio.sample_pos)) {
+            res.reason |= CHIPS_EXEC_UNTIL_AUDIO;
+        }
+        if ((cond & CHIPS_EXEC_UNTIL_PC) && (pins & M6502_SYNC) && (M6502_GET_ADDR(pins) == until->pc)) {
+            res.reason |= CHIPS_EXEC_UNTIL_PC;
+        }
+        if (res.reason) {
+            break;
+        }
+    }
+    if (res.ticks == until->max_ticks) {
+        res.reason |= CHIPS_EXEC_UNTIL_TICKS;
+    }
+    _c64_sid_sync(sys);
+    sys->pins = pins;
+    // carry over the ticks which don't add up to a full microsecond
+    sys->kbd_ticks += res.ticks;
+    const uint32_t kbd_us = clk_ticks_to_us(C64_FREQUENCY, sys->kbd_ticks);
+    sys->kbd_ticks -= clk_us_to_ticks(C64_FREQUENCY, kbd_us);
+    kbd_update(&sys->kbd, kbd_us);
+    return res;
+}
+
 void c64_key_down(c64_t* sys, int key_code) {
     CHIPS_ASSERT(sys && sys->valid);
     if (sys->joystick_type == C64_JOYSTICKTYPE_NONE) {
@@ -1108,6 +1236,16 @@ bool c64_is_tape_motor_on(c64_t* sys) {
     return c1530_is_motor_on(&sys->c1530);
 }
 
+void c64_enable_video(c64_t* sys, bool enabled) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->vic.video_off = !enabled;
+}
+
+bool c64_video_enabled(c64_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return !sys->vic.video_off;
+}
+
 chips_display_info_t c64_display_info(c64_t* sys) {
     chips_display_info_t res = {
         .frame = {
@@ -1138,6 +1276,12 @@ chips_display_info_t c64_display_info(c64_t* sys) {
     return res;
 }
 
+uint64_t c64_frame_hash(c64_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    const chips_display_info_t info = c64_display_info(sys);
+    return chips_display_hash(&info);
+}
+
 uint32_t c64_save_snapshot(c64_t* sys, c64_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
@@ -1149,6 +1293,7 @@ uint32_t c64_save_snapshot(c64_t* sys, c64_t* dst) {
     mem_snapshot_onsave(&dst->mem_vic, sys);
     c1530_snapshot_onsave(&dst->c1530);
     c1541_snapshot_onsave(&dst->c1541, sys);
+    dst->tick = 0;
     return C64_SNAPSHOT_VERSION;
 }
 
@@ -1167,6 +1312,7 @@ bool c64_load_snapshot(c64_t* sys, uint32_t version, c64_t* src) {
     mem_snapshot_onload(&im.mem_vic, sys);
     c1530_snapshot_onload(&im.c1530, &sys->c1530);
     c1541_snapshot_onload(&im.c1541, &sys->c1541, sys);
+    _c64_select_tick(&im);
     *sys = im;
     return true;
 }
@@ -21,6 +21,7 @@
     You need to include the following headers before including cpc.h:
 
     - chips/chips_common.h
+    - chips/chips_audio.h
     - chips/z80.h
     - chips/ay38910.h
     - chips/i8255.h
@@ -45,6 +46,33 @@
 
     FIXME!
 
+    ## Headless Mode
+
+    Set cpc_desc_t.video_off to true, or call cpc_enable_video(sys, false) to
+    stop writing pixels into the framebuffer, the gate array and CRTC timing
+    (including interrupts and video memory reads) are not affected. Since
+    the CPC video output depends on the CRTC and gate array state at each
+    CCLK tick, a frame can't be reconstructed after the fact, to take a
+    screenshot in headless mode, enable video and run until the next VSYNC
+    twice with cpc_exec_until() to get one complete frame.
+
+    ## Frame Hashing
+
+    cpc_frame_hash() returns a 64-bit hash of the visible area of the last
+    completed video frame, for comparing emulator output in regression tests.
+    The hash is updated line by line as the framebuffer is decoded and is
+    identical to chips_display_hash() of the framebuffer at the end of the
+    frame. While the debug visualization is active,
+    cpc_frame_hash() hashes the current framebuffer content instead. In
+    headless mode the hash isn't updated.
+
+    ## Partial Frames
+
+    For low-latency frontends, cpc_desc_t.video_band can provide a callback
+    which is called each time a band of framebuffer rows has been decoded
+    (see 'Video Bands' in chips_common.h), so that the host can upload or
+    encode the top of the frame while the emulation continues.
+
     ## TODO
 
     - improve CRTC emulation, some graphics demos don't work yet
@@ -78,7 +106,7 @@ extern "C" {
 #endif
 
 // bump when cpc_t memory layout changes
-#define CPC_SNAPSHOT_VERSION (0x0001)
+#define CPC_SNAPSHOT_VERSION (0x000D)
 
 #define CPC_MAX_AUDIO_SAMPLES (1024)        // max number of audio samples in internal sample buffer
 #define CPC_DEFAULT_AUDIO_SAMPLES (128)     // default number of samples in internal sample buffer
@@ -112,6 +140,8 @@ typedef struct {
     cpc_joystick_type_t joystick_type;
     chips_debug_t debug;
     chips_audio_desc_t audio;
+    bool video_off;                 // start in headless mode (see cpc_enable_video())
+    chips_video_band_desc_t video_band; // optional callback for partially decoded frames
 
     // ROM images
     struct {
@@ -135,9 +165,10 @@ typedef struct {
 } cpc_desc_t;
 
 // CPC emulator state
-typedef struct {
+typedef struct cpc_t {
     z80_t cpu;
     ay38910_t psg;
+    uint32_t psg_ticks;     // PSG ticks not yet executed (see _cpc_psg_sync())
     mc6845_t crtc;
     i8255_t ppi;
     upd765_t fdc;
@@ -149,17 +180,21 @@ typedef struct {
     uint8_t joy_joymask;
 
     kbd_t kbd;
+    uint32_t kbd_ticks;     // ticks not yet passed to kbd_update() (see cpc_exec_until())
     mem_t mem;
 
     uint64_t pins;
+    uint64_t (*tick)(struct cpc_t* sys, uint64_t pins);     // tick function specialized for video debugging on/off
     bool valid;
     chips_debug_t debug;
 
     struct {
         chips_audio_callback_t callback;
+        chips_audio_format_t format;
         int num_samples;
         int sample_pos;
         float sample_buffer[CPC_MAX_AUDIO_SAMPLES];
+        int16_t sample_buffer_s16[CPC_MAX_AUDIO_SAMPLES];
     } audio;
     uint8_t ram[8][0x4000];
     uint8_t rom_os[0x4000];
@@ -177,8 +212,12 @@ void cpc_discard(cpc_t* cpc);
 void cpc_reset(cpc_t* cpc);
 // get display requirements and framebuffer content, may be called with nullptr
 chips_display_info_t cpc_display_info(cpc_t* cpc);
+// get the hash of the last completed video frame (see chips_display_hash())
+uint64_t cpc_frame_hash(cpc_t* sys);
 // run CPC instance for given amount of micro_seconds, returns number of ticks executed
 uint32_t cpc_exec(cpc_t* cpc, uint32_t micro_seconds);
+// run CPC emulator until a stop condition is reached (without debug callback)
+chips_exec_result_t cpc_exec_until(cpc_t* sys, const chips_exec_until_t* until);
 // send a key down event
 void cpc_key_down(cpc_t* cpc, int key_code);
 // send a key up event
@@ -207,6 +246,10 @@ bool cpc_disc_inserted(cpc_t* cpc);
 void cpc_enable_video_debugging(cpc_t* cpc, bool enabled);
 // get current display debug visualization enabled/disabled state
 bool cpc_video_debugging_enabled(cpc_t* cpc);
+// enable/disable writing pixels into the framebuffer
+void cpc_enable_video(cpc_t* cpc, bool enabled);
+// return true if writing pixels into the framebuffer is enabled
+bool cpc_video_enabled(cpc_t* cpc);
 // take a snapshot, patches any pointers to zero, returns snapshot version
 uint32_t cpc_save_snapshot(cpc_t* sys, cpc_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
@@ -227,6 +270,8 @@ bool cpc_load_snapshot(cpc_t* sys, uint32_t version, cpc_t* src);
 #define _CPC_FREQUENCY (4000000)
 
 static uint64_t _cpc_cclk(void* user_data);
+static void _cpc_psg_sync(cpc_t* sys);
+static void _cpc_select_tick(cpc_t* sys);
 static void _cpc_psg_out(int port_id, uint8_t data, void* user_data);
 static uint8_t _cpc_psg_in(int port_id, void* user_data);
 static void _cpc_init_keymap(cpc_t* sys);
@@ -250,6 +295,7 @@ void cpc_init(cpc_t* sys, const cpc_desc_t* desc) {
     sys->type = desc->type;
     sys->joystick_type = desc->joystick_type;
     sys->audio.callback = desc->audio.callback;
+    sys->audio.format = chips_audio_format(&desc->audio.callback, desc->audio.format);
     sys->audio.num_samples = _CPC_DEFAULT(desc->audio.num_samples, CPC_DEFAULT_AUDIO_SAMPLES);
     CHIPS_ASSERT(sys->audio.num_samples <= CPC_MAX_AUDIO_SAMPLES);
     if (CPC_TYPE_464 == desc->type) {
@@ -297,8 +343,10 @@ void cpc_init(cpc_t* sys, const cpc_desc_t* desc) {
             .ptr = &sys->fb[0],
             .size = sizeof(sys->fb),
         },
+        .video_band = desc->video_band,
         .user_data = sys,
     });
+    sys->ga.video_off = desc->video_off;
     upd765_init(&sys->fdc, &(upd765_desc_t){
         .seektrack_cb = _cpc_fdc_seektrack,
         .seeksector_cb = _cpc_fdc_seeksector,
@@ -311,6 +359,7 @@ void cpc_init(cpc_t* sys, const cpc_desc_t* desc) {
     fdd_init(&sys->fdd);
 
     _cpc_init_keymap(sys);
+    _cpc_select_tick(sys);
 }
 
 void cpc_discard(cpc_t* sys) {
@@ -322,6 +371,7 @@ void cpc_reset(cpc_t* sys) {
     CHIPS_ASSERT(sys && sys->valid);
     mem_unmap_all(&sys->mem);
     mc6845_reset(&sys->crtc);
+    _cpc_psg_sync(sys);
     ay38910_reset(&sys->psg);
     i8255_reset(&sys->ppi);
     am40010_reset(&sys->ga);
@@ -330,7 +380,12 @@ void cpc_reset(cpc_t* sys) {
     sys->joy_joymask = 0;
 }
 
-static uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins) {
+/*  The tick function 'template', dbg_vis is a compile-time constant in the
+    specialized tick functions below. The CPC models only differ in
+    the memory bank switching and the gate array colors, which isn't
+    part of the per-tick work.
+*/
+static CHIPS_FORCE_INLINE uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins, bool dbg_vis) {
     cpu_pins = z80_tick(&sys->cpu, cpu_pins);
 
     // memory and IO requests
@@ -392,6 +447,7 @@ static uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins) {
                 if (sys->ppi.pins & I8255_PC6) { ay_pins |= AY38910_BC1; }
                 const uint8_t ay_data = I8255_GET_PA(sys->ppi.pins);
                 AY38910_SET_DATA(ay_pins, ay_data);
+                _cpc_psg_sync(sys);
                 ay_pins = ay38910_iorq(&sys->psg, ay_pins);
                 I8255_SET_PA(ppi_pins, AY38910_GET_DATA(ay_pins));
             }
@@ -412,6 +468,7 @@ static uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins) {
                 if (ppi_pins & I8255_PC6) { ay_pins |= AY38910_BC1; }
                 const uint8_t ay_data = I8255_GET_PA(ppi_pins);
                 AY38910_SET_DATA(ay_pins, ay_data);
+                _cpc_psg_sync(sys);
                 ay38910_iorq(&sys->psg, ay_pins);
             }
             // PC0..PC3: select keyboard matrix line
@@ -466,27 +523,50 @@ static uint64_t _cpc_tick(cpc_t* sys, uint64_t cpu_pins) {
        (see _cpc_cclk callback). The returned CPU pin mask
        will have the WAIT and INT pin set as needed.
     */
-    cpu_pins = am40010_tick(&sys->ga, cpu_pins) & Z80_PIN_MASK;
+    if (dbg_vis) {
+        cpu_pins = am40010_tick_dbgvis(&sys->ga, cpu_pins) & Z80_PIN_MASK;
+    } else {
+        cpu_pins = am40010_tick_novis(&sys->ga, cpu_pins) & Z80_PIN_MASK;
+    }
     return cpu_pins;
 }
 
-/* handle a 1 MHz CCLK tick generated by the gate array, this ticks the
-   MC6845 CRTC and AY-3-8912 PSG, and must return the CRTC pins.
+static uint64_t _cpc_tick_novis(cpc_t* sys, uint64_t cpu_pins) {
+    return _cpc_tick(sys, cpu_pins, false);
+}
+
+static uint64_t _cpc_tick_dbgvis(cpc_t* sys, uint64_t cpu_pins) {
+    return _cpc_tick(sys, cpu_pins, true);
+}
+
+static void _cpc_select_tick(cpc_t* sys) {
+    sys->tick = sys->ga.dbg_vis ? _cpc_tick_dbgvis : _cpc_tick_novis;
+}
+
+/* run the pending AY-3-8912 PSG ticks in bulk, this must be called
+   before accessing the PSG, and at the end of cpc_exec()
 */
-static uint64_t _cpc_cclk(void* user_data) {
-    cpc_t* sys = (cpc_t*) user_data;
-    // tick the sound chip...
-    if (ay38910_tick(&sys->psg)) {
-        // new sound sample ready
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->psg.sample;
-        if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
+static void _cpc_psg_sync(cpc_t* sys) {
+    while (sys->psg_ticks > 0) {
+        if (ay38910_advance(&sys->psg, &sys->psg_ticks)) {
+            // new sound sample ready
+            chips_audio_store(sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.sample_pos++, sys->psg.sample);
+            if (sys->audio.sample_pos == sys->audio.num_samples) {
                 // new sample packet is ready
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
+                chips_audio_flush(&sys->audio.callback, sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.num_samples);
+                sys->audio.sample_pos = 0;
             }
-            sys->audio.sample_pos = 0;
         }
     }
+}
+
+/* handle a 1 MHz CCLK tick generated by the gate array, this ticks the
+   MC6845 CRTC and AY-3-8912 PSG, and must return the CRTC pins.
+*/
+static uint64_t _cpc_cclk(void* user_data) {
+    cpc_t* sys = (cpc_t*) user_data;
+    // the sound chip is ticked lazily (see _cpc_psg_sync())
+    sys->psg_ticks++;
     // tick the CRTC and return its pin mask
     uint64_t crtc_pins = mc6845_tick(&sys->crtc);
     return crtc_pins;
@@ -584,16 +664,21 @@ static void _cpc_bankswitch(uint8_t ram_config, uint8_t rom_enable, uint8_t rom_
 uint32_t cpc_exec(cpc_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
     const uint32_t num_ticks = clk_us_to_ticks(_CPC_FREQUENCY, micro_seconds);
+    // video debugging may have been toggled directly in the gate array (e.g. by ui_am40010.h)
+    _cpc_select_tick(sys);
+    uint64_t (*tick_fn)(cpc_t*, uint64_t) = sys->tick;
     uint64_t pins = sys->pins;
     if (0 == sys->debug.callback.func) {
         // run without debug hook
         for (uint32_t tick = 0; tick < num_ticks; tick++) {
-            pins = _cpc_tick(sys, pins);
+            pins = tick_fn(sys, pins);
         }
+        _cpc_psg_sync(sys);
     } else {
-        // run with debug hook
+        // run with debug hook, keep the PSG state current for the debugger
         for (uint32_t tick = 0; (tick < num_ticks) && !(*sys->debug.stopped); tick++) {
-            pins = _cpc_tick(sys, pins);
+            pins = tick_fn(sys, pins);
+            _cpc_psg_sync(sys);
             sys->debug.callback.func(sys->debug.callback.user_data, pins);
         }
     }
@@ -602,6 +687,51 @@ uint32_t cpc_exec(cpc_t* sys, uint32_t micro_seconds) {
     return num_ticks;
 }
 
+chips_exec_result_t cpc_exec_until(cpc_t* sys, const chips_exec_until_t* until) {
+    CHIPS_ASSERT(sys && sys->valid && until);
+    const uint32_t cond = until->conditions;
+    const bool until_audio = 0 != (cond & CHIPS_EXEC_UNTIL_AUDIO);
+    chips_exec_result_t res = { 0 };
+    // see cpc_exec()
+    _cpc_select_tick(sys);
+    uint64_t (*tick_fn)(cpc_t*, uint64_t) = sys->tick;
+    uint64_t pins = sys->pins;
+    while (res.ticks < until->max_ticks) {
+        const bool vs = sys->crtc.vs;
+        const int sample_pos = sys->audio.sample_pos;
+        pins = tick_fn(sys, pins);
+        // the PSG writes the audio samples, only sync it when a sample is due
+        // and the caller waits for the audio buffer to be flushed
+        if (until_audio && (sys->psg_ticks >= chips_blip_ticks_to_sample(&sys->psg.blip))) {
+            _cpc_psg_sync(sys);
+        }
+        res.ticks++;
+        if ((cond & CHIPS_EXEC_UNTIL_VSYNC) && !vs && sys->crtc.vs) {
+            res.reason |= CHIPS_EXEC_UNTIL_VSYNC;
+        }
+        if ((cond & CHIPS_EXEC_UNTIL_AUDIO) && (sample_pos > sys->audio.sample_pos)) {
+            res.reason |= CHIPS_EXEC_UNTIL_AUDIO;
+        }
+        if ((cond & CHIPS_EXEC_UNTIL_PC) && z80_opdone(&sys->cpu) && (Z80_GET_ADDR(pins) == until->pc)) {
+            res.reason |= CHIPS_EXEC_UNTIL_PC;
+        }
+        if (res.reason) {
+            break;
+        }
+    }
+    if (res.ticks == until->max_ticks) {
+        res.reason |= CHIPS_EXEC_UNTIL_TICKS;
+    }
+    _cpc_psg_sync(sys);
+    sys->pins = pins;
+    // carry over the ticks which don't add up to a full microsecond
+    sys->kbd_ticks += res.ticks;
+    const uint32_t kbd_us = clk_ticks_to_us(_CPC_FREQUENCY, sys->kbd_ticks);
+    sys->kbd_ticks -= clk_us_to_ticks(_CPC_FREQUENCY, kbd_us);
+    kbd_update(&sys->kbd, kbd_us);
+    return res;
+}
+
 void cpc_key_down(cpc_t* sys, int key_code) {
     CHIPS_ASSERT(sys && sys->valid);
     if (sys->joystick_type == CPC_JOYSTICK_DIGITAL) {
@@ -657,6 +787,7 @@ uint8_t cpc_joystick_mask(cpc_t* sys) {
 void cpc_enable_video_debugging(cpc_t* sys, bool enabled) {
     CHIPS_ASSERT(sys && sys->valid);
     sys->ga.dbg_vis = enabled;
+    _cpc_select_tick(sys);
 }
 
 bool cpc_video_debugging_enabled(cpc_t* sys) {
@@ -664,6 +795,16 @@ bool cpc_video_debugging_enabled(cpc_t* sys) {
     return sys->ga.dbg_vis;
 }
 
+void cpc_enable_video(cpc_t* sys, bool enabled) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->ga.video_off = !enabled;
+}
+
+bool cpc_video_enabled(cpc_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return !sys->ga.video_off;
+}
+
 // keyboard matrix initialization
 static void _cpc_init_keymap(cpc_t* sys) {
     /*
@@ -835,6 +976,7 @@ static bool _cpc_load_sna(cpc_t* sys, chips_range_t data) {
     sys->ppi.pc.outp = hdr->ppi_c;
     sys->ppi.control = hdr->ppi_control;
 
+    _cpc_psg_sync(sys);
     for (int i = 0; i < 16; i++) {
         ay38910_set_register(&sys->psg, i, hdr->psg_regs[i]);
     }
@@ -1078,6 +1220,16 @@ chips_display_info_t cpc_display_info(cpc_t* sys) {
     return res;
 }
 
+uint64_t cpc_frame_hash(cpc_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    if (sys->ga.dbg_vis) {
+        // the frame hash isn't tracked for the debug visualization
+        const chips_display_info_t info = cpc_display_info(sys);
+        return chips_display_hash(&info);
+    }
+    return sys->ga.crt.frame_hash;
+}
+
 uint32_t cpc_save_snapshot(cpc_t* sys, cpc_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
@@ -1087,6 +1239,7 @@ uint32_t cpc_save_snapshot(cpc_t* sys, cpc_t* dst) {
     upd765_snapshot_onsave(&dst->fdc);
     am40010_snapshot_onsave(&dst->ga);
     mem_snapshot_onsave(&dst->mem, sys);
+    dst->tick = 0;
     return CPC_SNAPSHOT_VERSION;
 }
 
@@ -1103,6 +1256,7 @@ bool cpc_load_snapshot(cpc_t* sys, uint32_t version, cpc_t* src) {
     upd765_snapshot_onload(&im.fdc, &sys->fdc);
     am40010_snapshot_onload(&im.ga, &sys->ga);
     mem_snapshot_onload(&im.mem, sys);
+    _cpc_select_tick(&im);
     *sys = im;
     return true;
 }
@@ -24,6 +24,7 @@
     You need to include the following headers before including kc85.h:
 
     - chips/chips_common.h
+    - chips/chips_audio.h
     - chips/z80.h
     - chips/z80ctc.h
     - chips/z80pio.h
@@ -229,6 +230,14 @@
         - bits 2..6:    unused
         - bit 7:        enable the 4 KByte CAOS ROM bank at C000
 
+    ## Headless Mode
+
+    Set kc85_desc_t.video_off to true, or call kc85_enable_video(sys, false) to
+    stop decoding the video memory (IRM) into the framebuffer, the video
+    raster counters which drive the CTC and the blinking are not affected.
+    Call kc85_render_video() to decode the entire framebuffer from the current
+    video memory content on demand (for instance to take a screenshot).
+
     ## TODO:
 
     - optionally proper keyboard emulation (the current implementation
@@ -285,7 +294,7 @@ extern "C" {
 #define KC85_IRM0_PAGE (4)
 
 // bump this whenever the kc85_t struct layout changes
-#define KC85_SNAPSHOT_VERSION (KC85_TYPE_ID | 0x0002)
+#define KC85_SNAPSHOT_VERSION (KC85_TYPE_ID | 0x0009)
 
 #define KC85_MAX_AUDIO_SAMPLES (1024U)      // max number of audio samples in internal sample buffer
 #define KC85_DEFAULT_AUDIO_SAMPLES (128)    // default number of samples in internal sample buffer
@@ -342,6 +351,7 @@ typedef struct {
 typedef struct {
     chips_debug_t debug;
     chips_audio_desc_t audio;
+    bool video_off;     // start in headless mode (see kc85_enable_video())
 
     // an optional callback to be invoked after a snapshot file is loaded to apply patches
     kc85_patch_callback_t patch_callback;
@@ -409,6 +419,7 @@ typedef struct {
         uint16_t h_tick;
         uint16_t v_count;
     } video;
+    bool video_off;     // if true, don't decode video memory into the framebuffer
     uint64_t pio_pins;
     #if defined(CHIPS_KC85_TYPE_4)
         uint8_t io84;           // byte latch at port 0x84, only on KC85/4
@@ -430,9 +441,11 @@ typedef struct {
 
     struct {
         chips_audio_callback_t callback;
+        chips_audio_format_t format;
         int num_samples;
         int sample_pos;
         float sample_buffer[KC85_MAX_AUDIO_SAMPLES];
+        int16_t sample_buffer_s16[KC85_MAX_AUDIO_SAMPLES];
     } audio;
     kc85_patch_callback_t patch_callback;
 
@@ -456,6 +469,8 @@ void kc85_discard(kc85_t* sys);
 void kc85_reset(kc85_t* sys);
 // query information about display requirements, can be called with nullptr
 chips_display_info_t kc85_display_info(kc85_t* sys);
+// get a 64-bit hash of the visible screen area in the framebuffer (see chips_display_hash())
+uint64_t kc85_frame_hash(kc85_t* sys);
 // run KC85 emulation for a given number of microseconds, returns number of ticks executed
 uint32_t kc85_exec(kc85_t* sys, uint32_t micro_seconds);
 // send a key-down event
@@ -498,6 +513,12 @@ uint16_t kc85_kcc_exec_addr(chips_range_t data);
 uint16_t kc85_quickload_return_addr(void);
 // load a .KCC or .TAP snapshot file into the emulator and optionally try to start
 bool kc85_quickload(kc85_t* sys, chips_range_t data, bool start);
+// enable/disable decoding video memory into the framebuffer
+void kc85_enable_video(kc85_t* sys, bool enabled);
+// return true if video decoding is enabled
+bool kc85_video_enabled(kc85_t* sys);
+// decode the entire framebuffer from the current video memory
+void kc85_render_video(kc85_t* sys);
 // take snapshot, patches any pointers to zero, returns a snapshot version
 uint32_t kc85_save_snapshot(kc85_t* sys, kc85_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
@@ -590,6 +611,7 @@ void kc85_init(kc85_t* sys, const kc85_desc_t* desc) {
     sys->freq_hz = KC85_FREQUENCY;
     sys->patch_callback = desc->patch_callback;
     sys->debug = desc->debug;
+    sys->video_off = desc->video_off;
 
     // copy ROM images
     #if defined(CHIPS_KC85_TYPE_2)
@@ -631,6 +653,7 @@ void kc85_init(kc85_t* sys, const kc85_desc_t* desc) {
     z80pio_init(&sys->pio);
 
     sys->audio.callback = desc->audio.callback;
+    sys->audio.format = chips_audio_format(&desc->audio.callback, desc->audio.format);
     sys->audio.num_samples = _KC85_DEFAULT(desc->audio.num_samples, KC85_DEFAULT_AUDIO_SAMPLES);
     const beeper_desc_t beeper_desc = {
         .tick_hz = (int)sys->freq_hz,
@@ -756,34 +779,39 @@ static inline uint64_t _kc85_update_raster_counters(kc85_t* sys, uint64_t pins)
 }
 
 #if defined(CHIPS_KC85_TYPE_2) || defined(CHIPS_KC85_TYPE_3)
+// decode 8 pixels at x (0..39) and y (0..255)
+static void _kc85_decode_video(kc85_t* sys, uint16_t x, uint16_t y, bool cpu_access) {
+    uint32_t pixel_offset, color_offset;
+    if (x & 0x20) {
+        // right 64x256 area
+        pixel_offset = 0x2000 + ((x&0x7) | (((y>>4)&0x3)<<3) | (((y>>2)&0x3)<<5) | ((y&0x3)<<7) | (((y>>6)&0x3)<<9));
+        color_offset = 0x3000 + ((x&0x7) | (((y>>4)&0x3)<<3) | (((y>>2)&0x3)<<5) | (((y>>6)&0x3)<<7));
+    }
+    else {
+        // left 256x256 area
+        pixel_offset = x | (((y>>2)&0x3)<<5) | ((y&0x3)<<7) | (((y>>4)&0xF)<<9);
+        color_offset = 0x2800 + (x | (((y>>2)&0x3f)<<5));
+    }
+    // cpu_access: emulate display needling on KC85/2 and /3, this happens when the
+    // CPU accesses video memory, which will force the background color
+    // a short duration
+    //
+    uint8_t color_bits = sys->ram[KC85_IRM0_PAGE][color_offset];
+    bool fg_blank = 0 != (color_bits & (sys->flip_flops>>(Z80CTC_BIT_ZCTO2-7)) & (sys->pio_pins>>(Z80PIO_PIN_PB7-7)) & (1<<7));
+    uint8_t pixel_bits = (fg_blank || cpu_access) ? 0 : sys->ram[KC85_IRM0_PAGE][pixel_offset];
+    uint8_t* dst = &(sys->fb[y*KC85_FRAMEBUFFER_WIDTH + x*8]);
+    _kc85_decode_8pixels(dst, pixel_bits, color_bits);
+}
+
 static uint64_t _kc85_tick_video(kc85_t* sys, uint64_t pins) {
     // every 2 CPU ticks, 8 pixels are decoded
-    if (sys->video.h_tick & 1) {
+    if (!sys->video_off && (sys->video.h_tick & 1)) {
         uint16_t x = sys->video.h_tick>>1;
         uint16_t y = sys->video.v_count;
         if ((y < 256) && (x < 40)) {
-            uint32_t pixel_offset, color_offset;
-            if (x & 0x20) {
-                // right 64x256 area
-                pixel_offset = 0x2000 + ((x&0x7) | (((y>>4)&0x3)<<3) | (((y>>2)&0x3)<<5) | ((y&0x3)<<7) | (((y>>6)&0x3)<<9));
-                color_offset = 0x3000 + ((x&0x7) | (((y>>4)&0x3)<<3) | (((y>>2)&0x3)<<5) | (((y>>6)&0x3)<<7));
-            }
-            else {
-                // left 256x256 area
-                pixel_offset = x | (((y>>2)&0x3)<<5) | ((y&0x3)<<7) | (((y>>4)&0xF)<<9);
-                color_offset = 0x2800 + (x | (((y>>2)&0x3f)<<5));
-            }
-            // cpu_access: emulate display needling on KC85/2 and /3, this happens when the
-            // CPU accesses video memory, which will force the background color
-            // a short duration
-            //
-            uint8_t color_bits = sys->ram[KC85_IRM0_PAGE][color_offset];
-            bool fg_blank = 0 != (color_bits & (sys->flip_flops>>(Z80CTC_BIT_ZCTO2-7)) & (sys->pio_pins>>(Z80PIO_PIN_PB7-7)) & (1<<7));
             // same as (pins & Z80_WR) && (addr >= 0x8000) && (addr < 0xC000)
             bool cpu_access = (pins & (Z80_WR | 0xC000)) == (Z80_WR | 0x8000);
-            uint8_t pixel_bits = (fg_blank || cpu_access) ? 0 : sys->ram[KC85_IRM0_PAGE][pixel_offset];
-            uint8_t* dst = &(sys->fb[y*KC85_FRAMEBUFFER_WIDTH + x*8]);
-            _kc85_decode_8pixels(dst, pixel_bits, color_bits);
+            _kc85_decode_video(sys, x, y, cpu_access);
         }
     }
     return _kc85_update_raster_counters(sys, pins);
@@ -813,28 +841,34 @@ static inline void _kc85_decode_hicolor_8pixels(uint8_t* dst, uint8_t p0, uint8_
     dst[7] = 0x20 | ((p0>>0)&1)|((p1<<1)&2);
 }
 
+// decode 8 pixels at x (0..39) and y (0..255), the KC85/4 has no display needling
+static void _kc85_decode_video(kc85_t* sys, uint16_t x, uint16_t y, bool cpu_access) {
+    (void)cpu_access;
+    size_t irm_index = (sys->io84 & 1) * 2;
+    size_t offset = (x<<8) | y;
+    uint8_t color_bits = sys->ram[KC85_IRM0_PAGE + irm_index + 1][offset];
+    uint8_t* dst = &sys->fb[y * KC85_FRAMEBUFFER_WIDTH + x * 8];
+    if (sys->io84 & KC85_IO84_HICOLOR) {
+        // regular KC85/4 video mode
+        bool fg_blank = 0 != (color_bits & (sys->flip_flops>>(Z80CTC_BIT_ZCTO2-7)) & (sys->pio_pins>>(Z80PIO_PIN_PB7-7)) & (1<<7));
+        uint8_t pixel_bits = fg_blank ? 0 : sys->ram[KC85_IRM0_PAGE + irm_index][offset];
+        _kc85_decode_8pixels(dst, pixel_bits, color_bits);
+    }
+    else {
+        // hicolor mode
+        uint8_t p0 = sys->ram[KC85_IRM0_PAGE + irm_index][offset];
+        uint8_t p1 = color_bits;
+        _kc85_decode_hicolor_8pixels(dst, p0, p1);
+    }
+}
+
 static uint64_t _kc85_tick_video(kc85_t* sys, uint64_t pins) {
     // decode 8 pixels every second tick
-    if (sys->video.h_tick & 1) {
+    if (!sys->video_off && (sys->video.h_tick & 1)) {
         uint16_t x = sys->video.h_tick>>1;
         uint16_t y = sys->video.v_count;
         if ((y < 256) && (x < 40)) {
-            size_t irm_index = (sys->io84 & 1) * 2;
-            size_t offset = (x<<8) | y;
-            uint8_t color_bits = sys->ram[KC85_IRM0_PAGE + irm_index + 1][offset];
-            uint8_t* dst = &sys->fb[y * KC85_FRAMEBUFFER_WIDTH + x * 8];
-            if (sys->io84 & KC85_IO84_HICOLOR) {
-                // regular KC85/4 video mode
-                bool fg_blank = 0 != (color_bits & (sys->flip_flops>>(Z80CTC_BIT_ZCTO2-7)) & (sys->pio_pins>>(Z80PIO_PIN_PB7-7)) & (1<<7));
-                uint8_t pixel_bits = fg_blank ? 0 : sys->ram[KC85_IRM0_PAGE + irm_index][offset];
-                _kc85_decode_8pixels(dst, pixel_bits, color_bits);
-            }
-            else {
-                // hicolor mode
-                uint8_t p0 = sys->ram[KC85_IRM0_PAGE + irm_index][offset];
-                uint8_t p1 = color_bits;
-                _kc85_decode_hicolor_8pixels(dst, p0, p1);
-            }
+            _kc85_decode_video(sys, x, y, false);
         }
     }
     return _kc85_update_raster_counters(sys, pins);
@@ -989,11 +1023,9 @@ static uint64_t _kc85_tick(kc85_t* sys, uint64_t pins) {
     beeper_tick(&sys->beeper_1);
     if (beeper_tick(&sys->beeper_2)) {
         // new audio sample ready
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->beeper_1.sample + sys->beeper_2.sample;
+        chips_audio_store(sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.sample_pos++, sys->beeper_1.sample + sys->beeper_2.sample);
         if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
+            chips_audio_flush(&sys->audio.callback, sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.num_samples);
             sys->audio.sample_pos = 0;
         }
     }
@@ -1745,6 +1777,31 @@ chips_display_info_t kc85_display_info(kc85_t* sys) {
     return res;
 }
 
+uint64_t kc85_frame_hash(kc85_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    const chips_display_info_t info = kc85_display_info(sys);
+    return chips_display_hash(&info);
+}
+
+void kc85_enable_video(kc85_t* sys, bool enabled) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->video_off = !enabled;
+}
+
+bool kc85_video_enabled(kc85_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return !sys->video_off;
+}
+
+void kc85_render_video(kc85_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    for (uint16_t y = 0; y < 256; y++) {
+        for (uint16_t x = 0; x < 40; x++) {
+            _kc85_decode_video(sys, x, y, false);
+        }
+    }
+}
+
 uint32_t kc85_save_snapshot(kc85_t* sys, kc85_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
@@ -1768,6 +1825,7 @@ bool kc85_load_snapshot(kc85_t* sys, uint32_t version, const kc85_t* src) {
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
     im.patch_callback = sys->patch_callback;
+    im.video_off = sys->video_off;
     mem_snapshot_onload(&im.mem, sys);
     *sys = im;
     return true;
@@ -21,6 +21,7 @@
     You need to include the following headers before including lc80.h:
 
     - chips/chips_common.h
+    - chips/chips_audio.h
     - chips/z80.h
     - chips/z80ctc.h
     - chips/z80pio.h
@@ -77,7 +78,7 @@ extern "C" {
 #endif
 
 // bump this whenever the lc80_t struct layout changes
-#define LC80_SNAPSHOT_VERSION (0x0001)
+#define LC80_SNAPSHOT_VERSION (0x0005)
 
 // key codes (for lc80_key(), lc80_key_down(), lc80_key_up()
 #define LC80_KEY_0      ('0')
@@ -219,9 +220,11 @@ typedef struct {
 
     struct {
         chips_audio_callback_t callback;
+        chips_audio_format_t format;
         int num_samples;
         int sample_pos;
         float sample_buffer[LC80_MAX_AUDIO_SAMPLES];
+        int16_t sample_buffer_s16[LC80_MAX_AUDIO_SAMPLES];
     } audio;
 
     uint8_t ram[0x0400];
@@ -272,6 +275,7 @@ void lc80_init(lc80_t* sys, const lc80_desc_t* desc) {
         sys->vqe23[i] = 0x0000FFFF;
     }
     sys->audio.callback = desc->audio.callback;
+    sys->audio.format = chips_audio_format(&desc->audio.callback, desc->audio.format);
     sys->audio.num_samples = _LC80_DEFAULT(desc->audio.num_samples, LC80_DEFAULT_AUDIO_SAMPLES);
     beeper_init(&sys->beeper, &(beeper_desc_t){
         .tick_hz = sys->freq_hz,
@@ -550,11 +554,9 @@ uint64_t _lc80_tick(lc80_t* sys, uint64_t pins) {
     // tick beeper
     if (beeper_tick(&sys->beeper)) {
         /* new audio sample ready */
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->beeper.sample;
+        chips_audio_store(sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.sample_pos++, sys->beeper.sample);
         if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
+            chips_audio_flush(&sys->audio.callback, sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.num_samples);
             sys->audio.sample_pos = 0;
         }
     }
@@ -34,6 +34,14 @@
     inspiration from the structure and design of source files written by Andre
     Weissflog for this project.
 
+    ## Frame Hashing
+
+    mp1000_frame_hash() returns a 64-bit hash of the visible area of the last
+    completed video frame, for comparing emulator output in regression tests.
+    The hash is updated line by line as the framebuffer is decoded and is
+    identical to chips_display_hash() of the framebuffer at the end of the
+    frame.
+
     ## zlib/libpng license
 
     Copyright (c) 2025 Hakan Candar
@@ -63,7 +71,7 @@ extern "C" {
 #endif
 
 // bump snapshot version when c64_t memory layout changes
-#define MP1000_SNAPSHOT_VERSION (1)
+#define MP1000_SNAPSHOT_VERSION (6)
 
 #define MP1000_FREQUENCY (894887)              // clock frequency in Hz
 #define MP1000_MAX_AUDIO_SAMPLES (1024)        // TODO: max number of audio samples in internal sample buffer
@@ -181,6 +189,8 @@ void mp1000_discard(mp1000_t* sys);
 void mp1000_reset(mp1000_t* sys);
 // get framebuffer and display attributes
 chips_display_info_t mp1000_display_info(mp1000_t* sys);
+// get the hash of the last completed video frame (see chips_display_hash())
+uint64_t mp1000_frame_hash(mp1000_t* sys);
 // save a snapshot, patches pointers to zero and offsets, returns snapshot version
 uint32_t mp1000_save_snapshot(mp1000_t* sys, mp1000_t* dst);
 // load a snapshot, returns false if snapshot versions don't match
@@ -666,6 +676,11 @@ chips_display_info_t mp1000_display_info(mp1000_t* sys) {
     return res;
 }
 
+uint64_t mp1000_frame_hash(mp1000_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return sys->vdg.frame_hash;
+}
+
 uint32_t mp1000_save_snapshot(mp1000_t* sys, mp1000_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
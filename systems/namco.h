@@ -31,6 +31,7 @@
     You need to include the following headers before including namco.h:
 
     - chips/chips_common.h
+    - chips/chips_audio.h
     - chips/z80.h
     - chips/clk.h
     - chips/mem.h
@@ -40,6 +41,14 @@
     https://github.com/floooh/chips-test/blob/master/examples/sokol/pacman.c
     https://github.com/floooh/chips-test/blob/master/examples/sokol/pengo.c
 
+    ## Headless Mode
+
+    Set namco_desc_t.video_off to true, or call namco_enable_video(sys, false)
+    to skip the video decoding at the end of namco_exec(). Call
+    namco_render_video() to decode the framebuffer from the current
+    video RAM, color RAM and sprite state on demand (for instance to take a
+    screenshot).
+
     ## zlib/libpng license
 
     Copyright (c) 2019 Andre Weissflog
@@ -68,7 +77,7 @@ extern "C" {
 #endif
 
 // increase when namco_t memory layout changes
-#define NAMCO_SNAPSHOT_VERSION (1)
+#define NAMCO_SNAPSHOT_VERSION (9)
 
 #define NAMCO_MAX_AUDIO_SAMPLES (1024)
 #define NAMCO_DEFAULT_AUDIO_SAMPLES (128)
@@ -77,6 +86,9 @@ extern "C" {
 #define NAMCO_FRAMEBUFFER_SIZE_BYTES (NAMCO_FRAMEBUFFER_WIDTH * NAMCO_FRAMEBUFFER_HEIGHT)
 #define NAMCO_DISPLAY_WIDTH     (288)
 #define NAMCO_DISPLAY_HEIGHT    (224)
+#define NAMCO_NUM_TILES_X       (36)
+#define NAMCO_NUM_TILES_Y       (28)
+#define NAMCO_TILE_CACHE_INVALID (0xFFFF)
 
 // input bits (use with namco_input_set() and namco_input_clear())
 #define NAMCO_INPUT_P1_UP       (1<<0)
@@ -98,6 +110,7 @@ extern "C" {
 typedef struct {
     chips_debug_t debug;
     chips_audio_desc_t audio;
+    bool video_off;     // start in headless mode (see namco_enable_video())
     struct {
         // common ROM areas for Pacman and Pengo
         struct {
@@ -133,20 +146,22 @@ typedef struct {
     int tick_counter;
     int sample_period;
     int sample_counter;
-    float volume;
+    int32_t volume;         // output volume (fixed-point)
     struct {
         uint32_t frequency; // 20-bit frequency
         uint32_t counter;   // 20-bit counter (top 5 bits are index into 32-byte wave table)
         uint8_t waveform;   // 3-bit waveform
         uint8_t volume;     // 4-bit volume
-        float sample;       // accumulated sample value
-        float sample_div  ; // oversampling divider
+        int32_t sample;     // accumulated sample value
+        int num_ticks;      // number of accumulated sample values
     } voice[3];
     uint8_t rom[2][0x0100]; // wave table ROM
     int num_samples;
     int sample_pos;
     chips_audio_callback_t callback;
+    chips_audio_format_t format;
     float sample_buffer[NAMCO_MAX_AUDIO_SAMPLES];
+    int16_t sample_buffer_s16[NAMCO_MAX_AUDIO_SAMPLES];
 } namco_sound_t;
 
 // the Namco arcade machine state
@@ -167,6 +182,7 @@ typedef struct {
     uint8_t clut_select;    // Pengo only
     uint8_t tile_select;    // Pengo only
     uint8_t sprite_coords[16];      // 8 sprites, uint8_t x, uint8_t y
+    bool video_off;                 // if true, don't decode video at the end of namco_exec()
 
     bool valid;
     chips_debug_t debug;
@@ -181,6 +197,11 @@ typedef struct {
     uint32_t hw_colors[32];         // decoded color palette from palette ROM
     uint8_t palette_cache[512];     // palette indirection table, Pacman: 256 entries , Pengo: 512 entries
     alignas(64) uint8_t fb[NAMCO_FRAMEBUFFER_SIZE_BYTES];   // indices into palette
+    uint16_t tile_cache[NAMCO_NUM_TILES_Y][NAMCO_NUM_TILES_X];  // color and char code of tiles in fb, or NAMCO_TILE_CACHE_INVALID
+    uint8_t tile_cache_select;          // pal_select, clut_select and tile_select of the tiles in fb
+    // the atlases must be the last items, they are derived from the tile ROM and not part of snapshots
+    uint8_t tile_atlas[2][256][64];     // pre-decoded 8x8 tiles as 2-bit color indices (per tile bank)
+    uint8_t sprite_atlas[2][64][256];   // pre-decoded 16x16 sprites as 2-bit color indices (per tile bank)
 } namco_t;
 
 // initialize a new namco_t instance
@@ -191,12 +212,20 @@ void namco_discard(namco_t* sys);
 void namco_reset(namco_t* sys);
 // query display, framebuffer and color palette (note: palette requires a valid sys ptr!)
 chips_display_info_t namco_display_info(namco_t* sys);
+// get a 64-bit hash of the visible screen area in the framebuffer (see chips_display_hash())
+uint64_t namco_frame_hash(namco_t* sys);
 // run namco_t instance for given amount of microseconds, return number of ticks executed
 uint32_t namco_exec(namco_t* sys, uint32_t micro_seconds);
 // set input bits
 void namco_input_set(namco_t* sys, uint32_t mask);
 // clear input bits
 void namco_input_clear(namco_t* sys, uint32_t mask);
+// enable/disable video decoding at the end of namco_exec()
+void namco_enable_video(namco_t* sys, bool enabled);
+// return true if video decoding is enabled
+bool namco_video_enabled(namco_t* sys);
+// decode the framebuffer from the current video state
+void namco_render_video(namco_t* sys);
 // take a snapshot, patches any pointers to zero, returns a snapshot version
 uint32_t namco_save_snapshot(namco_t* sys, namco_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
@@ -384,6 +413,8 @@ bool namco_load_snapshot(namco_t* sys, uint32_t version, namco_t* src);
 static void _namco_sound_init(namco_t* sys, const namco_desc_t* desc);
 static void _namco_sound_wr(namco_t* sys, uint16_t addr, uint8_t data);
 static void _namco_sound_tick(namco_t* sys);
+static void _namco_init_atlas(namco_t* sys);
+static void _namco_invalidate_tile_cache(namco_t* sys);
 
 #define _namco_def(val, def) (val == 0 ? def : val)
 
@@ -394,6 +425,7 @@ void namco_init(namco_t* sys, const namco_desc_t* desc) {
     memset(sys, 0, sizeof(namco_t));
     sys->valid = true;
     sys->debug = desc->debug;
+    sys->video_off = desc->video_off;
     sys->vsync_count = NAMCO_VSYNC_PERIOD;
     _namco_sound_init(sys, desc);
     sys->pins = z80_init(&sys->cpu);
@@ -521,6 +553,8 @@ void namco_init(namco_t* sys, const namco_desc_t* desc) {
         sys->palette_cache[i] = pal_index;
         sys->palette_cache[256 + i] = 0x10 | pal_index;
     }
+    _namco_init_atlas(sys);
+    _namco_invalidate_tile_cache(sys);
 }
 
 void namco_discard(namco_t* sys) {
@@ -653,64 +687,96 @@ static uint16_t _namco_video_offset(uint32_t x, uint32_t y) {
     return offset;
 }
 
-// 8x4 video tile decoder (used both for background tiles and sprites)
-static inline void _namco_8x4(
-    uint8_t* fb,
-    uint8_t* tile_base,
-    uint8_t* pal_base,
-    uint8_t* pal_rom,
-    uint32_t tile_stride,
-    uint32_t tile_offset,
-    uint32_t px,
-    uint32_t py,
-    uint8_t char_code,
-    uint8_t color_code,
-    bool opaque,
-    bool flip_x,
-    bool flip_y)
-{
-    uint32_t xor_x = flip_x ? 3 : 0;
-    uint32_t xor_y = flip_y ? 7 : 0;
+/* 8x4 video tile decoder (used both for background tiles and sprites),
+    writes 2-bit color indices into the tile or sprite atlas
+*/
+static void _namco_8x4(uint8_t* dst, uint32_t dst_pitch, const uint8_t* src) {
     for (uint32_t yy = 0; yy < 8; yy++) {
-        uint32_t y = py + (yy ^ xor_y);
-        if (y >= NAMCO_DISPLAY_HEIGHT) {
-            continue;
-        }
-        int tile_index = char_code * tile_stride + tile_offset + yy;
         for (uint32_t xx = 0; xx < 4; xx++) {
-            uint32_t x = px + (xx ^ xor_x);
-            if (x >= NAMCO_DISPLAY_WIDTH) {
-                continue;
-            }
-            uint8_t p2_hi = (tile_base[tile_index]>>(7-xx)) & 1;
-            uint8_t p2_lo = (tile_base[tile_index]>>(3-xx)) & 1;
-            uint8_t p2 = (p2_hi<<1)|p2_lo;
-            uint8_t hw_color = pal_base[(color_code<<2)|p2];
-            if (opaque || (pal_rom[hw_color] != 0)) {
-                fb[y * NAMCO_FRAMEBUFFER_WIDTH + x] = hw_color;
+            uint8_t p2_hi = (src[yy]>>(7-xx)) & 1;
+            uint8_t p2_lo = (src[yy]>>(3-xx)) & 1;
+            dst[yy * dst_pitch + xx] = (p2_hi<<1)|p2_lo;
+        }
+    }
+}
+
+/* decode all tiles and sprites in the tile ROM into the tile- and sprite-atlas,
+    this only needs to happen in namco_init() and namco_load_snapshot()
+*/
+static void _namco_init_atlas(namco_t* sys) {
+    // 8x4 block offsets in a sprite's 64 bytes of tile ROM data
+    static const uint8_t sprite_offsets[2][4] = { { 8, 16, 24, 0 }, { 40, 48, 56, 32 } };
+    for (uint32_t bank = 0; bank < 2; bank++) {
+        const uint8_t* tile_base = &sys->rom_gfx[bank * 0x2000];
+        for (uint32_t code = 0; code < 256; code++) {
+            uint8_t* dst = sys->tile_atlas[bank][code];
+            _namco_8x4(dst + 0, 8, tile_base + code * 16 + 8);
+            _namco_8x4(dst + 4, 8, tile_base + code * 16 + 0);
+        }
+        const uint8_t* sprite_base = &sys->rom_gfx[bank * 0x2000 + 0x1000];
+        for (uint32_t code = 0; code < 64; code++) {
+            uint8_t* dst = sys->sprite_atlas[bank][code];
+            for (uint32_t by = 0; by < 2; by++) {
+                for (uint32_t bx = 0; bx < 4; bx++) {
+                    _namco_8x4(dst + by * 8 * 16 + bx * 4, 16, sprite_base + code * 64 + sprite_offsets[by][bx]);
+                }
             }
         }
     }
 }
 
-// decode background tiles
+// force a redraw of all background tiles in the next frame
+static void _namco_invalidate_tile_cache(namco_t* sys) {
+    for (uint32_t y = 0; y < NAMCO_NUM_TILES_Y; y++) {
+        for (uint32_t x = 0; x < NAMCO_NUM_TILES_X; x++) {
+            sys->tile_cache[y][x] = NAMCO_TILE_CACHE_INVALID;
+        }
+    }
+}
+
+// force a redraw of the background tile under a pixel position (if visible)
+static inline void _namco_invalidate_tile_at(namco_t* sys, uint32_t x, uint32_t y) {
+    if ((x < NAMCO_DISPLAY_WIDTH) && (y < NAMCO_DISPLAY_HEIGHT)) {
+        sys->tile_cache[y>>3][x>>3] = NAMCO_TILE_CACHE_INVALID;
+    }
+}
+
+/* decode background tiles
+
+    Only tiles where the char- or color-code has changed since the last frame,
+    or which have been overdrawn by a sprite in the last frame are decoded.
+*/
 static void _namco_decode_chars(namco_t* sys) {
-    uint8_t* pal_base = &sys->palette_cache[(sys->pal_select<<8)|(sys->clut_select<<7)];
-    uint8_t* tile_base = &sys->rom_gfx[0x0000] + (sys->tile_select * 0x2000);
-    for (uint32_t y = 0; y < 28; y++) {
-        for (uint32_t x = 0; x < 36; x++) {
+    const uint8_t select = (sys->pal_select<<2)|(sys->clut_select<<1)|sys->tile_select;
+    if (select != sys->tile_cache_select) {
+        sys->tile_cache_select = select;
+        _namco_invalidate_tile_cache(sys);
+    }
+    const uint8_t* pal_base = &sys->palette_cache[(sys->pal_select<<8)|(sys->clut_select<<7)];
+    for (uint32_t y = 0; y < NAMCO_NUM_TILES_Y; y++) {
+        for (uint32_t x = 0; x < NAMCO_NUM_TILES_X; x++) {
             uint16_t offset = _namco_video_offset(x, y);
             uint8_t char_code = sys->video_ram[offset];
             uint8_t color_code = sys->color_ram[offset] & 0x1F;
-            _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 16, 8, x*8, y*8, char_code, color_code, true, false, false);
-            _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 16, 0, x*8+4, y*8, char_code, color_code, true, false, false);
+            uint16_t key = (color_code<<8) | char_code;
+            if (key == sys->tile_cache[y][x]) {
+                continue;
+            }
+            sys->tile_cache[y][x] = key;
+            const uint8_t* pal = &pal_base[color_code<<2];
+            const uint8_t* src = sys->tile_atlas[sys->tile_select][char_code];
+            uint8_t* dst = &sys->fb[(y * 8) * NAMCO_FRAMEBUFFER_WIDTH + x * 8];
+            for (uint32_t yy = 0; yy < 8; yy++, src += 8, dst += NAMCO_FRAMEBUFFER_WIDTH) {
+                for (uint32_t xx = 0; xx < 8; xx++) {
+                    dst[xx] = pal[src[xx]];
+                }
+            }
         }
     }
 }
 
 static void _namco_decode_sprites(namco_t* sys) {
-    uint8_t* pal_base = &sys->palette_cache[(sys->pal_select<<8)|(sys->clut_select<<7)];
-    uint8_t* tile_base = &sys->rom_gfx[0x1000] + (sys->tile_select * 0x2000);
+    const uint8_t* pal_base = &sys->palette_cache[(sys->pal_select<<8)|(sys->clut_select<<7)];
     #if defined(NAMCO_PACMAN)
     const int max_sprite = 6;
     const int min_sprite = 1;
@@ -724,22 +790,36 @@ static void _namco_decode_sprites(namco_t* sys) {
         uint8_t shape = sys->main_ram[NAMCO_ADDR_SPRITES_ATTR + sprite_index*2 + 0];
         uint8_t char_code = shape>>2;
         uint8_t color_code = sys->main_ram[NAMCO_ADDR_SPRITES_ATTR + sprite_index*2 + 1];
-        bool flip_x = shape & 1;
-        bool flip_y = shape & 2;
-        uint32_t fy0 = flip_y ? 8 : 0;
-        uint32_t fy1 = flip_y ? 0 : 8;
-        uint32_t fx0 = flip_x ? 12: 0;
-        uint32_t fx1 = flip_x ? 8 : 4;
-        uint32_t fx2 = flip_x ? 4 : 8;
-        uint32_t fx3 = flip_x ? 0 :12;
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 8,  px+fx0, py+fy0, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 16, px+fx1, py+fy0, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 24, px+fx2, py+fy0, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 0,  px+fx3, py+fy0, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 40, px+fx0, py+fy1, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 48, px+fx1, py+fy1, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 56, px+fx2, py+fy1, char_code, color_code, false, flip_x, flip_y);
-        _namco_8x4(sys->fb, tile_base, pal_base, sys->rom_prom, 64, 32, px+fx3, py+fy1, char_code, color_code, false, flip_x, flip_y);
+        uint32_t xor_x = (shape & 1) ? 15 : 0;
+        uint32_t xor_y = (shape & 2) ? 15 : 0;
+        // resolve the sprite's 4 colors and transparency
+        uint8_t colors[4];
+        bool opaque[4];
+        for (uint32_t i = 0; i < 4; i++) {
+            colors[i] = pal_base[(color_code<<2)|i];
+            opaque[i] = sys->rom_prom[colors[i]] != 0;
+        }
+        const uint8_t* src = sys->sprite_atlas[sys->tile_select][char_code];
+        for (uint32_t yy = 0; yy < 16; yy++) {
+            uint32_t y = py + (yy ^ xor_y);
+            if (y >= NAMCO_DISPLAY_HEIGHT) {
+                continue;
+            }
+            for (uint32_t xx = 0; xx < 16; xx++) {
+                uint32_t x = px + (xx ^ xor_x);
+                uint8_t p2 = src[yy * 16 + xx];
+                if ((x < NAMCO_DISPLAY_WIDTH) && opaque[p2]) {
+                    sys->fb[y * NAMCO_FRAMEBUFFER_WIDTH + x] = colors[p2];
+                }
+            }
+        }
+        // the background tiles under the sprite must be redrawn in the next frame
+        static const uint32_t corners[3] = { 0, 8, 15 };
+        for (uint32_t cy = 0; cy < 3; cy++) {
+            for (uint32_t cx = 0; cx < 3; cx++) {
+                _namco_invalidate_tile_at(sys, px + corners[cx], py + corners[cy]);
+            }
+        }
     }
 }
 
@@ -767,10 +847,27 @@ uint32_t namco_exec(namco_t* sys, uint32_t micro_seconds) {
         }
     }
     sys->pins = pins;
-    _namco_decode_video(sys);
+    if (!sys->video_off) {
+        _namco_decode_video(sys);
+    }
     return num_ticks;
 }
 
+void namco_enable_video(namco_t* sys, bool enabled) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->video_off = !enabled;
+}
+
+bool namco_video_enabled(namco_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return !sys->video_off;
+}
+
+void namco_render_video(namco_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    _namco_decode_video(sys);
+}
+
 void namco_input_set(namco_t* sys, uint32_t mask) {
     CHIPS_ASSERT(sys && sys->valid);
     if (mask & NAMCO_INPUT_P1_UP) {
@@ -878,9 +975,10 @@ static void _namco_sound_init(namco_t* sys, const namco_desc_t* desc) {
     snd->tick_counter = NAMCO_SOUND_PERIOD;
     snd->sample_period = (NAMCO_CPU_CLOCK * NAMCO_SAMPLE_SCALE) / _namco_def(desc->audio.sample_rate, 44100);
     snd->sample_counter = sys->sound.sample_period;
-    snd->volume = _namco_def(desc->audio.volume, 1.0f);
+    snd->volume = (int32_t)(_namco_def(desc->audio.volume, 1.0f) * (CHIPS_AUDIO_FIXEDPOINT_SCALE / 3));
     snd->num_samples = _namco_def(desc->audio.num_samples, NAMCO_DEFAULT_AUDIO_SAMPLES);
     snd->callback = desc->audio.callback;
+    snd->format = chips_audio_format(&desc->audio.callback, desc->audio.format);
 }
 
 #define _NAMCO_SET_NIBBLE_0(val, data) (val=(val&~0x0000F)|((data&0xF)<<0))
@@ -943,9 +1041,9 @@ static void _namco_sound_tick(namco_t* sys) {
                 uint32_t smp_index = ((snd->voice[i].waveform<<5) | ((snd->voice[i].counter>>15) & 0x1F)) & 0xFF;
                 // integer sample value now 7-bits plus sign bit
                 int val = (((int)(snd->rom[0][smp_index] & 0xF)) - 8) * snd->voice[i].volume;
-                snd->voice[i].sample += (float)val;
+                snd->voice[i].sample += val;
             }
-            snd->voice[i].sample_div += 128.0f;
+            snd->voice[i].num_ticks++;
         }
     }
 
@@ -953,20 +1051,19 @@ static void _namco_sound_tick(namco_t* sys) {
     snd->sample_counter -= NAMCO_SAMPLE_SCALE;
     if (snd->sample_counter < 0) {
         snd->sample_counter += snd->sample_period;
-        float sm = 0.0f;
+        // average the accumulated 8-bit sample values into a fixed-point sample
+        int32_t sm = 0;
         for (int i = 0; i < 3; i++) {
-            if (snd->voice[i].sample_div > 0.0f) {
-                sm += snd->voice[i].sample / snd->voice[i].sample_div;
-                snd->voice[i].sample = 0.0f;
-                snd->voice[i].sample_div = 0.0f;
+            if (snd->voice[i].num_ticks > 0) {
+                sm += (snd->voice[i].sample * (CHIPS_AUDIO_FIXEDPOINT_SCALE / 128)) / snd->voice[i].num_ticks;
+                snd->voice[i].sample = 0;
+                snd->voice[i].num_ticks = 0;
             }
         }
-        sm *= snd->volume * 0.33333f;
-        snd->sample_buffer[snd->sample_pos++] = sm;
+        sm = (int32_t)(((int64_t)sm * snd->volume) / CHIPS_AUDIO_FIXEDPOINT_SCALE);
+        chips_audio_store(snd->format, snd->sample_buffer, snd->sample_buffer_s16, snd->sample_pos++, sm);
         if (snd->sample_pos == snd->num_samples) {
-            if (snd->callback.func) {
-                snd->callback.func(snd->sample_buffer, snd->num_samples, snd->callback.user_data);
-            }
+            chips_audio_flush(&snd->callback, snd->format, snd->sample_buffer, snd->sample_buffer_s16, snd->num_samples);
             snd->sample_pos = 0;
         }
     }
@@ -1002,9 +1099,16 @@ chips_display_info_t namco_display_info(namco_t* sys) {
     return res;
 }
 
+uint64_t namco_frame_hash(namco_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    const chips_display_info_t info = namco_display_info(sys);
+    return chips_display_hash(&info);
+}
+
 uint32_t namco_save_snapshot(namco_t* sys, namco_t* dst) {
     CHIPS_ASSERT(sys && dst);
-    *dst = *sys;
+    // skip the tile and sprite atlas at the end of namco_t
+    memcpy(dst, sys, offsetof(namco_t, tile_atlas));
     chips_debug_snapshot_onsave(&dst->debug);
     chips_audio_callback_snapshot_onsave(&dst->sound.callback);
     mem_snapshot_onsave(&dst->mem, sys);
@@ -1017,11 +1121,14 @@ bool namco_load_snapshot(namco_t* sys, uint32_t version, namco_t* src) {
         return false;
     }
     static namco_t im;
-    im = *src;
+    memcpy(&im, src, offsetof(namco_t, tile_atlas));
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
     chips_audio_callback_snapshot_onload(&im.sound.callback, &sys->sound.callback);
     mem_snapshot_onload(&im.mem, sys);
-    *sys = im;
+    im.video_off = sys->video_off;
+    memcpy(sys, &im, offsetof(namco_t, tile_atlas));
+    // rebuild the atlases from the snapshot's tile ROM
+    _namco_init_atlas(sys);
     return true;
 }
 
@@ -21,6 +21,7 @@
     You need to include the following headers before including vic20.h:
 
     - chips/chips_common.h
+    - chips/chips_audio.h
     - chips/m6502.h
     - chips/m6522.h
     - chips/m6561.h
@@ -65,7 +66,7 @@ extern "C" {
 #endif
 
 // bump snapshot version when vic20_t memory layout changes
-#define VIC20_SNAPSHOT_VERSION (1)
+#define VIC20_SNAPSHOT_VERSION (6)
 
 #define VIC20_FREQUENCY (1108404)
 #define VIC20_MAX_AUDIO_SAMPLES (1024)        // max number of audio samples in internal sample buffer
@@ -146,9 +147,11 @@ typedef struct {
 
     struct {
         chips_audio_callback_t callback;
+        chips_audio_format_t format;
         int num_samples;
         int sample_pos;
         float sample_buffer[VIC20_MAX_AUDIO_SAMPLES];
+        int16_t sample_buffer_s16[VIC20_MAX_AUDIO_SAMPLES];
     } audio;
 
     uint8_t color_ram[0x0400];      // special color RAM
@@ -174,6 +177,8 @@ void vic20_discard(vic20_t* sys);
 void vic20_reset(vic20_t* sys);
 // query display information
 chips_display_info_t vic20_display_info(vic20_t* sys);
+// get a 64-bit hash of the visible screen area in the framebuffer (see chips_display_hash())
+uint64_t vic20_frame_hash(vic20_t* sys);
 // tick VIC-20 instance for a given number of microseconds, return number of executed ticks
 uint32_t vic20_exec(vic20_t* sys, uint32_t micro_seconds);
 // send a key-down event to the VIC-20
@@ -243,6 +248,7 @@ void vic20_init(vic20_t* sys, const vic20_desc_t* desc) {
     sys->via2_joy_mask = M6522_PB7;
     sys->debug = desc->debug;
     sys->audio.callback = desc->audio.callback;
+    sys->audio.format = chips_audio_format(&desc->audio.callback, desc->audio.format);
     sys->audio.num_samples = _VIC20_DEFAULT(desc->audio.num_samples, VIC20_DEFAULT_AUDIO_SAMPLES);
     CHIPS_ASSERT(sys->audio.num_samples <= VIC20_MAX_AUDIO_SAMPLES);
     CHIPS_ASSERT(desc->roms.chars.ptr && (desc->roms.chars.size == sizeof(sys->rom_char)));
@@ -523,11 +529,9 @@ static uint64_t _vic20_tick(vic20_t* sys, uint64_t pins) {
             pins = M6502_COPY_DATA(pins, vic_pins);
         }
         if (vic_pins & M6561_SAMPLE) {
-            sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->vic.sound.sample;
+            chips_audio_store(sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.sample_pos++, sys->vic.sound.sample);
             if (sys->audio.sample_pos == sys->audio.num_samples) {
-                if (sys->audio.callback.func) {
-                    sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-                }
+                chips_audio_flush(&sys->audio.callback, sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.num_samples);
                 sys->audio.sample_pos = 0;
             }
         }
@@ -829,6 +833,12 @@ chips_display_info_t vic20_display_info(vic20_t* sys) {
     return res;
 }
 
+uint64_t vic20_frame_hash(vic20_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    const chips_display_info_t info = vic20_display_info(sys);
+    return chips_display_hash(&info);
+}
+
 uint32_t vic20_save_snapshot(vic20_t* sys, vic20_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
@@ -44,6 +44,12 @@
 
     ## TODO: Describe Usage
 
+    ## Headless Mode
+
+    Set z1013_desc_t.video_off to true, or call z1013_enable_video(sys, false)
+    to skip the video decoding at the end of z1013_exec(). Call
+    z1013_render_video() to decode the framebuffer from the current video
+    memory content on demand (for instance to take a screenshot).
 
     ## zlib/libpng license
 
@@ -73,7 +79,7 @@ extern "C" {
 #endif
 
 // bump this whenever the z1013_t struct layout changes
-#define Z1013_SNAPSHOT_VERSION (0x0001)
+#define Z1013_SNAPSHOT_VERSION (0x0005)
 
 #define Z1013_FRAMEBUFFER_WIDTH (256)
 #define Z1013_FRAMEBUFFER_HEIGHT (256)
@@ -92,6 +98,7 @@ typedef enum {
 typedef struct {
     z1013_type_t type;          // default is Z1013_TYPE_64
     chips_debug_t debug;        // optional debug callback and userdata ptr
+    bool video_off;             // start in headless mode (see z1013_enable_video())
 
     // ROM images
     struct {
@@ -114,6 +121,8 @@ typedef struct {
     int kbd_request_line_hilo_shift;
     kbd_t kbd;
     uint64_t freq_hz;
+    uint64_t vid_dirty[16];     // one bit per character cell that needs to be decoded
+    bool video_off;             // if true, don't decode video memory at the end of z1013_exec()
     uint8_t ram[1<<16];
     uint8_t rom_os[2048];
     uint8_t rom_font[2048];
@@ -128,6 +137,8 @@ void z1013_discard(z1013_t* sys);
 void z1013_reset(z1013_t* sys);
 // query information about display requirements, can be called with nullptr
 chips_display_info_t z1013_display_info(z1013_t* sys);
+// get a 64-bit hash of the visible screen area in the framebuffer (see chips_display_hash())
+uint64_t z1013_frame_hash(z1013_t* sys);
 // run the Z1013 instance for a given number of microseconds, returns number of executed ticks
 uint32_t z1013_exec(z1013_t* sys, uint32_t micro_seconds);
 // send a key-down event
@@ -140,6 +151,12 @@ bool z1013_quickload(z1013_t* sys, chips_range_t data);
 uint32_t z1013_save_snapshot(z1013_t* sys, z1013_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool z1013_load_snapshot(z1013_t* sys, uint32_t version, const z1013_t* src);
+// enable/disable video decoding at the end of z1013_exec()
+void z1013_enable_video(z1013_t* sys, bool enabled);
+// return true if video decoding is enabled
+bool z1013_video_enabled(z1013_t* sys);
+// decode the framebuffer from the current video memory content
+void z1013_render_video(z1013_t* sys);
 
 #ifdef __cplusplus
 } // extern "C"
@@ -197,6 +214,7 @@ void z1013_init(z1013_t* sys, const z1013_desc_t* desc) {
     sys->valid = true;
     sys->freq_hz = (Z1013_TYPE_01 == desc->type) ? 1000000 : 2000000;
     sys->debug = desc->debug;
+    sys->video_off = desc->video_off;
 
     // copy ROM dumps
     CHIPS_ASSERT(desc->roms.font.ptr && (desc->roms.font.size == sizeof(sys->rom_font)));
@@ -229,6 +247,8 @@ void z1013_init(z1013_t* sys, const z1013_desc_t* desc) {
         mem_map_ram(&sys->mem, 1, 0xEC00, 0x0400, &(sys->ram[0xEC00]));
     }
     mem_map_rom(&sys->mem, 0, 0xF000, 0x0800, sys->rom_os);
+    // decode the entire video RAM in the first frame
+    memset(sys->vid_dirty, 0xFF, sizeof(sys->vid_dirty));
 
     /* Setup the keyboard matrix, the original Z1013.01 has a 8x4 matrix with
        4 shift keys, later models also support a more traditional 8x8 matrix.
@@ -331,6 +351,10 @@ static uint64_t _z1013_tick(z1013_t* sys, uint64_t pins) {
         }
         else if (pins & Z80_WR) {
             mem_wr(&sys->mem, addr, Z80_GET_DATA(pins));
+            // write to video RAM?
+            if ((addr & 0xFC00) == 0xEC00) {
+                sys->vid_dirty[(addr & 0x3FF) >> 6] |= 1ULL << (addr & 0x3F);
+            }
         }
     }
 
@@ -364,7 +388,8 @@ static uint64_t _z1013_tick(z1013_t* sys, uint64_t pins) {
 }
 
 /* since the Z1013 didn't have any sort of programmable video output,
-    we're cheating a bit and decode the entire frame in one go
+    we're cheating a bit and decode the entire frame in one go, but
+    only the character cells which have been written since the last decode
 */
 static void _z1013_decode_vidmem(z1013_t* sys) {
     static const uint32_t lut32[16] = {
@@ -373,16 +398,23 @@ static void _z1013_decode_vidmem(z1013_t* sys) {
         0x00000001, 0x01000001, 0x00010001, 0x01010001,
         0x00000101, 0x01000101, 0x00010101, 0x01010101,
     };
-    uint32_t* dst32 = (uint32_t*) sys->fb;
     const uint8_t* src = &sys->ram[0xEC00];   // the 32x32 framebuffer starts at EC00
     const uint8_t* font = sys->rom_font;
-    for (size_t y = 0; y < 32; y++) {
-        for (size_t py = 0; py < 8; py++) {
-            for (size_t x = 0; x < 32; x++) {
-                uint8_t chr = src[(y<<5) + x];
-                uint8_t pixels = font[(chr<<3)|py];
-                *dst32++ = lut32[pixels >> 4];
-                *dst32++ = lut32[pixels & 0xF];
+    for (size_t i = 0; i < 16; i++) {
+        uint64_t bits = sys->vid_dirty[i];
+        sys->vid_dirty[i] = 0;
+        for (size_t offset = i * 64; bits != 0; offset++, bits >>= 1) {
+            if (0 == (bits & 1)) {
+                continue;
+            }
+            const size_t x = offset & 31;
+            const size_t y = offset >> 5;
+            const uint8_t chr = src[offset];
+            uint32_t* dst32 = (uint32_t*) &sys->fb[y * 8 * Z1013_FRAMEBUFFER_WIDTH + x * 8];
+            for (size_t py = 0; py < 8; py++, dst32 += Z1013_FRAMEBUFFER_WIDTH / 4) {
+                const uint8_t pixels = font[(chr<<3)|py];
+                dst32[0] = lut32[pixels >> 4];
+                dst32[1] = lut32[pixels & 0xF];
             }
         }
     }
@@ -407,10 +439,27 @@ uint32_t z1013_exec(z1013_t* sys, uint32_t micro_seconds) {
     }
     sys->pins = pins;
     kbd_update(&sys->kbd, micro_seconds);
-    _z1013_decode_vidmem(sys);
+    if (!sys->video_off) {
+        _z1013_decode_vidmem(sys);
+    }
     return num_ticks;
 }
 
+void z1013_enable_video(z1013_t* sys, bool enabled) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->video_off = !enabled;
+}
+
+bool z1013_video_enabled(z1013_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return !sys->video_off;
+}
+
+void z1013_render_video(z1013_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    _z1013_decode_vidmem(sys);
+}
+
 void z1013_key_down(z1013_t* sys, int key_code) {
     CHIPS_ASSERT(sys && sys->valid);
     kbd_key_down(&sys->kbd, key_code);
@@ -453,6 +502,8 @@ bool z1013_quickload(z1013_t* sys, chips_range_t data) {
     }
     exec_addr = (hdr->exec_addr_h<<8 | hdr->exec_addr_l) & 0xFFFF;
     mem_write_range(&sys->mem, addr, ptr, end_addr - addr);
+    // the loaded data may overwrite video RAM
+    memset(sys->vid_dirty, 0xFF, sizeof(sys->vid_dirty));
 
     z80_reset(&sys->cpu);
     sys->cpu.a = 0x00;
@@ -497,6 +548,12 @@ chips_display_info_t z1013_display_info(z1013_t* sys) {
     return res;
 }
 
+uint64_t z1013_frame_hash(z1013_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    const chips_display_info_t info = z1013_display_info(sys);
+    return chips_display_hash(&info);
+}
+
 uint32_t z1013_save_snapshot(z1013_t* sys, z1013_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
@@ -515,6 +572,7 @@ bool z1013_load_snapshot(z1013_t* sys, uint32_t version, const z1013_t* src) {
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
     mem_snapshot_onload(&im.mem, sys);
+    im.video_off = sys->video_off;
     *sys = im;
     return true;
 }
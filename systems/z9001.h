@@ -21,6 +21,7 @@
     You need to include the following headers before including z9001.h:
 
     - chips/chips_common.h
+    - chips/chips_audio.h
     - chips/z80.h
     - chips/z80pio.h
     - chips/z80ctc.h
@@ -60,6 +61,13 @@
     - schematics: http://www.sax.de/~zander/kc/kcsch_1.pdf
     - manual: http://www.sax.de/~zander/z9001/doku/z9_fub.pdf
 
+    ## Headless Mode
+
+    Set z9001_desc_t.video_off to true, or call z9001_enable_video(sys, false)
+    to skip the video decoding at the end of z9001_exec(). Call
+    z9001_render_video() to decode the framebuffer from the current video
+    memory content on demand (for instance to take a screenshot).
+
     ## zlib/libpng license
 
     Copyright (c) 2018 Andre Weissflog
@@ -88,7 +96,7 @@ extern "C" {
 #endif
 
 // bump this whenever the z9001_t struct layout changes
-#define Z9001_SNAPSHOT_VERSION (0x0001)
+#define Z9001_SNAPSHOT_VERSION (0x0009)
 
 #define Z9001_MAX_AUDIO_SAMPLES (1024)      // max number of audio samples in internal sample buffer
 #define Z9001_DEFAULT_AUDIO_SAMPLES (128)   // default number of samples in internal sample buffer
@@ -109,6 +117,7 @@ typedef struct {
     z9001_type_t type;                  // default is Z9001_TYPE_Z9001
     chips_debug_t debug;                // optional debug hook
     chips_audio_desc_t audio;
+    bool video_off;                     // start in headless mode (see z9001_enable_video())
     struct {
         // Z9001 ROM images
         struct {
@@ -139,6 +148,9 @@ typedef struct {
     uint64_t pins;
     uint64_t ctc_zcto2;         // pin mask to store state of CTC ZCTO2
     uint32_t blink_counter;
+    uint8_t vid_blink;          // blink flip flop state at last video decode
+    uint64_t vid_dirty[16];     // one bit per character cell that needs to be decoded
+    bool video_off;             // if true, don't decode video memory at the end of z9001_exec()
     // FIXME: uint8_t border_color;
     mem_t mem;
     kbd_t kbd;
@@ -149,9 +161,11 @@ typedef struct {
 
     struct {
         chips_audio_callback_t callback;
+        chips_audio_format_t format;
         int num_samples;
         int sample_pos;
         float sample_buffer[Z9001_MAX_AUDIO_SAMPLES];
+        int16_t sample_buffer_s16[Z9001_MAX_AUDIO_SAMPLES];
     } audio;
     uint8_t ram[1<<16];
     uint8_t rom[0x4000];
@@ -167,6 +181,8 @@ void z9001_discard(z9001_t* sys);
 void z9001_reset(z9001_t* sys);
 // query information about display requirements, can be called with nullptr
 chips_display_info_t z9001_display_info(z9001_t* sys);
+// get a 64-bit hash of the visible screen area in the framebuffer (see chips_display_hash())
+uint64_t z9001_frame_hash(z9001_t* sys);
 // run Z9001 instance for a given number of microseconds, return number of executed ticks
 uint32_t z9001_exec(z9001_t* sys, uint32_t micro_seconds);
 // send a key-down event
@@ -179,6 +195,12 @@ bool z9001_quickload(z9001_t* sys, chips_range_t data);
 uint32_t z9001_save_snapshot(z9001_t* sys, z9001_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
 bool z9001_load_snapshot(z9001_t* sys, uint32_t version, const z9001_t* src);
+// enable/disable video decoding at the end of z9001_exec()
+void z9001_enable_video(z9001_t* sys, bool enabled);
+// return true if video decoding is enabled
+bool z9001_video_enabled(z9001_t* sys);
+// decode the framebuffer from the current video memory content
+void z9001_render_video(z9001_t* sys);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -224,6 +246,7 @@ void z9001_init(z9001_t* sys, const z9001_desc_t* desc) {
     sys->valid = true;
     sys->type = desc->type;
     sys->debug = desc->debug;
+    sys->video_off = desc->video_off;
     if (desc->type == Z9001_TYPE_Z9001) {
         CHIPS_ASSERT(desc->roms.z9001.font.ptr && (desc->roms.z9001.font.size == sizeof(sys->rom_font)));
         memcpy(sys->rom_font, desc->roms.z9001.font.ptr, sizeof(sys->rom_font));
@@ -253,6 +276,7 @@ void z9001_init(z9001_t* sys, const z9001_desc_t* desc) {
     z80pio_init(&sys->pio2);
 
     sys->audio.callback = desc->audio.callback;
+    sys->audio.format = chips_audio_format(&desc->audio.callback, desc->audio.format);
     sys->audio.num_samples = _Z9001_DEFAULT(desc->audio.num_samples, Z9001_DEFAULT_AUDIO_SAMPLES);
     CHIPS_ASSERT(sys->audio.num_samples <= Z9001_MAX_AUDIO_SAMPLES);
     beeper_init(&sys->beeper, &(beeper_desc_t){
@@ -301,6 +325,8 @@ void z9001_init(z9001_t* sys, const z9001_desc_t* desc) {
     }
     // 1 KB ASCII video RAM
     mem_map_ram(&sys->mem, 0, 0xEC00, 0x0400, &sys->ram[0xEC00]);
+    // decode the entire video RAM in the first frame
+    memset(sys->vid_dirty, 0xFF, sizeof(sys->vid_dirty));
 
     /* setup the 8x8 keyboard matrix, keep pressed keys sticky for 3 frames
         to give the keyboard scanning code enough time to read the key
@@ -384,6 +410,10 @@ static uint64_t _z9001_tick(z9001_t* sys, uint64_t pins) {
         }
         else if (pins & Z80_WR) {
             mem_wr(&sys->mem, addr, Z80_GET_DATA(pins));
+            // write to color (E800) or ASCII (EC00) video RAM?
+            if ((addr & 0xF800) == 0xE800) {
+                sys->vid_dirty[(addr & 0x3FF) >> 6] |= 1ULL << (addr & 0x3F);
+            }
         }
     }
 
@@ -460,11 +490,9 @@ static uint64_t _z9001_tick(z9001_t* sys, uint64_t pins) {
     // tick the beeper
     if (beeper_tick(&sys->beeper)) {
         // new audio sample ready
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sys->beeper.sample;
+        chips_audio_store(sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.sample_pos++, sys->beeper.sample);
         if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
+            chips_audio_flush(&sys->audio.callback, sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.num_samples);
             sys->audio.sample_pos = 0;
         }
     }
@@ -498,48 +526,56 @@ static inline void _z9001_decode_8pixels(uint8_t* dst, uint8_t pixels, uint8_t c
     dst32[1] = bg32 ^ (xor32 & lut32[pixels & 0xf]);
 }
 
+/*  Only the character cells which have been written by the CPU since the
+    last decode (and on the KC87 the blinking cells when the blink flip flop
+    has changed) are decoded, on a static screen this does nothing.
+*/
 static void _z9001_decode_vidmem(z9001_t* sys) {
     // FIXME: there's also a 40x20 video mode
     const uint8_t* vidmem = &sys->ram[0xEC00];     // 1 KB ASCII buffer at EC00
     const uint8_t* colmem = &sys->ram[0xE800];     // 1 KB color buffer at E800
-    size_t offset = 0;
-    if (Z9001_TYPE_KC87 == sys->type) {
-        // KC87 with color module
-        const uint8_t* font = sys->rom_font;
-        for (size_t y = 0; y < 24; y++) {
-            for (size_t py = 0; py < 8; py++) {
-                uint8_t* dst = &sys->fb[(y * 8 + py) * Z9001_FRAMEBUFFER_WIDTH];
-                for (size_t x = 0; x < 40; x++, dst += 8) {
-                    uint8_t chr = vidmem[offset+x];
-                    uint8_t pixels = font[(chr<<3)|py];
-                    uint8_t colors = colmem[offset+x];
-                    if (colors & sys->blink_flip_flop & 0x80) {
-                        // blinking: swap back- and foreground color
-                        colors = ((colors & 7) << 4) | ((colors >> 4) & 7);
-                    }
-                    _z9001_decode_8pixels(dst, pixels, colors);
-                }
+    const uint8_t* font = sys->rom_font;
+    const bool color = Z9001_TYPE_KC87 == sys->type;
+    if (color && (sys->vid_blink != sys->blink_flip_flop)) {
+        sys->vid_blink = sys->blink_flip_flop;
+        for (size_t i = 0; i < 24*40; i++) {
+            if (colmem[i] & 0x80) {
+                sys->vid_dirty[i >> 6] |= 1ULL << (i & 0x3F);
             }
-            offset += 40;
         }
     }
-    else {
-        // Z9001 monochrome display
-        const uint8_t* font = sys->rom_font;
-        for (size_t y = 0; y < 24; y++) {
-            for (size_t py = 0; py < 8; py++) {
-                uint8_t* dst = &sys->fb[(y * 8 + py) * Z9001_FRAMEBUFFER_WIDTH];
-                for (size_t x = 0; x < 40; x++, dst += 8) {
-                    uint8_t chr = vidmem[offset + x];
-                    uint8_t pixels = font[(chr<<3)|py];
-                    _z9001_decode_8pixels(dst, pixels, 0x70);
+    for (size_t i = 0; i < 16; i++) {
+        uint64_t bits = sys->vid_dirty[i];
+        sys->vid_dirty[i] = 0;
+        for (size_t offset = i * 64; (bits != 0) && (offset < 24*40); offset++, bits >>= 1) {
+            if (0 == (bits & 1)) {
+                continue;
+            }
+            const size_t x = offset % 40;
+            const size_t y = offset / 40;
+            const uint8_t chr = vidmem[offset];
+            uint8_t colors = 0x70;
+            if (color) {
+                // KC87 with color module
+                colors = colmem[offset];
+                if (colors & sys->blink_flip_flop & 0x80) {
+                    // blinking: swap back- and foreground color
+                    colors = ((colors & 7) << 4) | ((colors >> 4) & 7);
                 }
             }
-            offset += 40;
+            uint8_t* dst = &sys->fb[y * 8 * Z9001_FRAMEBUFFER_WIDTH + x * 8];
+            for (size_t py = 0; py < 8; py++, dst += Z9001_FRAMEBUFFER_WIDTH) {
+                _z9001_decode_8pixels(dst, font[(chr<<3)|py], colors);
+            }
         }
     }
 }
 
+// force a complete video decode (after writing video RAM without the CPU)
+static void _z9001_invalidate_vidmem(z9001_t* sys) {
+    memset(sys->vid_dirty, 0xFF, sizeof(sys->vid_dirty));
+}
+
 uint32_t z9001_exec(z9001_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
     const uint32_t num_ticks = clk_us_to_ticks(_Z9001_FREQUENCY, micro_seconds);
@@ -559,10 +595,27 @@ uint32_t z9001_exec(z9001_t* sys, uint32_t micro_seconds) {
     }
     sys->pins = pins;
     kbd_update(&sys->kbd, micro_seconds);
-    _z9001_decode_vidmem(sys);
+    if (!sys->video_off) {
+        _z9001_decode_vidmem(sys);
+    }
     return num_ticks;
 }
 
+void z9001_enable_video(z9001_t* sys, bool enabled) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->video_off = !enabled;
+}
+
+bool z9001_video_enabled(z9001_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return !sys->video_off;
+}
+
+void z9001_render_video(z9001_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    _z9001_decode_vidmem(sys);
+}
+
 void z9001_key_down(z9001_t* sys, int key_code) {
     CHIPS_ASSERT(sys && sys->valid);
     kbd_key_down(&sys->kbd, key_code);
@@ -708,6 +761,8 @@ static bool _z9001_load_kctap(z9001_t* sys, chips_range_t data) {
 
 bool z9001_quickload(z9001_t* sys, chips_range_t data) {
     CHIPS_ASSERT(sys && sys->valid && data.ptr);
+    // the loaded data may overwrite video RAM
+    _z9001_invalidate_vidmem(sys);
     // first check for KC TAP, since this can be properly identified
     if (_z9001_is_valid_kctap(data)) {
         return _z9001_load_kctap(sys, data);
@@ -759,6 +814,12 @@ chips_display_info_t z9001_display_info(z9001_t* sys) {
     return res;
 }
 
+uint64_t z9001_frame_hash(z9001_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    const chips_display_info_t info = z9001_display_info(sys);
+    return chips_display_hash(&info);
+}
+
 uint32_t z9001_save_snapshot(z9001_t* sys, z9001_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
@@ -778,6 +839,7 @@ bool z9001_load_snapshot(z9001_t* sys, uint32_t version, const z9001_t* src) {
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
     mem_snapshot_onload(&im.mem, sys);
+    im.video_off = sys->video_off;
     *sys = im;
     return true;
 }
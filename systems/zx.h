@@ -21,6 +21,7 @@
     You need to include the following headers before including zx.h:
 
     - chips/chips_common.h
+    - chips/chips_audio.h
     - chips/z80.h
     - chips/beeper.h
     - chips/ay38910.h
@@ -36,6 +37,30 @@
 
     TODO!
 
+    ## Headless Mode
+
+    Set zx_desc_t.video_off to true, or call zx_enable_video(sys, false) to
+    stop decoding the video memory into the framebuffer, the scanline timing
+    and the vblank interrupt are not affected. Call zx_render_video() to
+    decode the entire framebuffer from the current video memory content
+    on demand (for instance to take a screenshot), the border will have
+    the current border color.
+
+    ## Frame Hashing
+
+    zx_frame_hash() returns a 64-bit hash of the visible area of the last
+    completed video frame, for comparing emulator output in regression tests.
+    The hash is updated line by line as the framebuffer is decoded and is
+    identical to chips_display_hash() of the framebuffer at the end of the
+    frame. In headless mode the hash is only updated by zx_render_video().
+
+    ## Partial Frames
+
+    For low-latency frontends, zx_desc_t.video_band can provide a callback
+    which is called each time a band of framebuffer rows has been decoded
+    (see 'Video Bands' in chips_common.h). Since the video decoding only has
+    scanline accuracy, the rows are complete as soon as they are reported.
+
     ## TODO:
     - 'contended memory' timing and IO port timing
     - reads from port 0xFF must return 'current VRAM bytes
@@ -69,7 +94,7 @@ extern "C" {
 #endif
 
 // bump this whenever the zx_t struct layout changes
-#define ZX_SNAPSHOT_VERSION (0x0001)
+#define ZX_SNAPSHOT_VERSION (0x000D)
 
 #define ZX_MAX_AUDIO_SAMPLES (1024)      // max number of audio samples in internal sample buffer
 #define ZX_DEFAULT_AUDIO_SAMPLES (128)   // default number of samples in internal sample buffer
@@ -105,8 +130,11 @@ typedef struct {
     zx_type_t type;                     // default is ZX_TYPE_48K
     zx_joystick_type_t joystick_type;   // what joystick to emulate, default is ZX_JOYSTICK_NONE
     chips_debug_t debug;                // optional debugger hook
+    bool video_off;                     // start in headless mode (see zx_enable_video())
+    chips_video_band_desc_t video_band; // optional callback for partially decoded frames
     struct {
         chips_audio_callback_t callback;
+        chips_audio_format_t format;
         int num_samples;
         int sample_rate;
         float beeper_volume;
@@ -123,10 +151,11 @@ typedef struct {
 } zx_desc_t;
 
 // ZX emulator state
-typedef struct {
+typedef struct zx_t {
     z80_t cpu;
     beeper_t beeper;
     ay38910_t ay;
+    uint32_t ay_ticks;          // AY ticks not yet executed (see _zx_ay_sync())
     zx_type_t type;
     zx_joystick_type_t joystick_type;
     bool memory_paging_disabled;
@@ -137,6 +166,10 @@ typedef struct {
     uint8_t last_fe_out;        // last out value to 0xFE port
     uint8_t blink_counter;      // incremented on each vblank
     uint8_t border_color;
+    bool video_off;             // if true, don't decode video memory into the framebuffer
+    uint64_t line_hash;         // running hash of the decoded lines of the current frame
+    uint64_t frame_hash;        // hash of the visible area of the last completed frame
+    chips_video_band_t video_band;
     int frame_scan_lines;
     int top_border_scanlines;
     int scanline_period;
@@ -145,16 +178,20 @@ typedef struct {
     int int_counter;
     uint32_t display_ram_bank;
     kbd_t kbd;
+    uint32_t kbd_ticks;         // ticks not yet passed to kbd_update() (see zx_exec_until())
     mem_t mem;
     uint64_t pins;
     uint64_t freq_hz;
+    uint64_t (*tick)(struct zx_t* sys, uint64_t pins);  // tick function specialized for the ZX model
     bool valid;
     chips_debug_t debug;
     struct {
         chips_audio_callback_t callback;
+        chips_audio_format_t format;
         int num_samples;
         int sample_pos;
         float sample_buffer[ZX_MAX_AUDIO_SAMPLES];
+        int16_t sample_buffer_s16[ZX_MAX_AUDIO_SAMPLES];
     } audio;
     uint8_t ram[8][0x4000];
     uint8_t rom[2][0x4000];
@@ -170,8 +207,12 @@ void zx_discard(zx_t* sys);
 void zx_reset(zx_t* sys);
 // query information about display requirements, can be called with nullptr
 chips_display_info_t zx_display_info(zx_t* sys);
+// get the hash of the last completed video frame (see chips_display_hash())
+uint64_t zx_frame_hash(zx_t* sys);
 // run ZX Spectrum instance for a given number of microseconds, return number of ticks
 uint32_t zx_exec(zx_t* sys, uint32_t micro_seconds);
+// run ZX Spectrum instance until a stop condition is reached (without debug callback)
+chips_exec_result_t zx_exec_until(zx_t* sys, const chips_exec_until_t* until);
 // send a key-down event
 void zx_key_down(zx_t* sys, int key_code);
 // send a key-up event
@@ -184,6 +225,12 @@ zx_joystick_type_t zx_joystick_type(zx_t* sys);
 void zx_joystick(zx_t* sys, uint8_t mask);
 // load a ZX Z80 file into the emulator
 bool zx_quickload(zx_t* sys, chips_range_t data);
+// enable/disable decoding video memory into the framebuffer
+void zx_enable_video(zx_t* sys, bool enabled);
+// return true if video decoding is enabled
+bool zx_video_enabled(zx_t* sys);
+// decode the entire framebuffer from the current video memory
+void zx_render_video(zx_t* sys);
 // save a snapshot, patches any pointers to zero, returns a snapshot version
 uint32_t zx_save_snapshot(zx_t* sys, zx_t* dst);
 // load a snapshot, returns false if snapshot version doesn't match
@@ -203,6 +250,8 @@ bool zx_load_snapshot(zx_t* sys, uint32_t version, zx_t* src);
 
 static void _zx_init_memory_map(zx_t* sys);
 static void _zx_init_keyboard_matrix(zx_t* sys);
+static void _zx_select_tick(zx_t* sys);
+static void _zx_ay_sync(zx_t* sys);
 
 #define _ZX_DEFAULT(val,def) (((val) != 0) ? (val) : (def))
 
@@ -219,9 +268,14 @@ void zx_init(zx_t* sys, const zx_desc_t* desc) {
     sys->joystick_type = desc->joystick_type;
     sys->freq_hz = (sys->type == ZX_TYPE_48K) ? _ZX_48K_FREQUENCY : _ZX_128_FREQUENCY;
     sys->audio.callback = desc->audio.callback;
+    sys->audio.format = chips_audio_format(&desc->audio.callback, desc->audio.format);
     sys->audio.num_samples = _ZX_DEFAULT(desc->audio.num_samples, ZX_DEFAULT_AUDIO_SAMPLES);
     CHIPS_ASSERT(sys->audio.num_samples <= ZX_MAX_AUDIO_SAMPLES);
     sys->debug = desc->debug;
+    sys->video_off = desc->video_off;
+    chips_video_band_init(&sys->video_band, &desc->video_band);
+    sys->line_hash = CHIPS_HASH_SEED;
+    sys->frame_hash = CHIPS_HASH_SEED;
 
     // initalize the hardware
     sys->border_color = 0;
@@ -263,6 +317,7 @@ void zx_init(zx_t* sys, const zx_desc_t* desc) {
     }
     _zx_init_memory_map(sys);
     _zx_init_keyboard_matrix(sys);
+    _zx_select_tick(sys);
 }
 
 void zx_discard(zx_t* sys) {
@@ -275,6 +330,7 @@ void zx_reset(zx_t* sys) {
     sys->pins = z80_reset(&sys->cpu);
     beeper_reset(&sys->beeper);
     if (sys->type == ZX_TYPE_128) {
+        _zx_ay_sync(sys);
         ay38910_reset(&sys->ay);
     }
     sys->memory_paging_disabled = false;
@@ -283,6 +339,7 @@ void zx_reset(zx_t* sys) {
     sys->last_fe_out = 0;
     sys->scanline_counter = sys->scanline_period;
     sys->scanline_y = 0;
+    sys->line_hash = CHIPS_HASH_SEED;
     sys->blink_counter = 0;
     if (sys->type == ZX_TYPE_48K) {
         sys->display_ram_bank = 0;
@@ -293,6 +350,66 @@ void zx_reset(zx_t* sys) {
     _zx_init_memory_map(sys);
 }
 
+// decode one line of the framebuffer (0..255) from video memory
+static void _zx_decode_line(zx_t* sys, uint16_t y) {
+    uint8_t* dst = &sys->fb[y * ZX_FRAMEBUFFER_WIDTH];
+    const uint8_t* vidmem_bank = sys->ram[sys->display_ram_bank];
+    const bool blink = 0 != (sys->blink_counter & 0x10);
+    if ((y < 32) || (y >= 224)) {
+        // upper/lower border
+        for (int x = 0; x < ZX_DISPLAY_WIDTH; x++) {
+            *dst++ = sys->border_color;
+        }
+    }
+    else {
+        /* compute video memory Y offset (inside 256x192 area)
+            this is how the 16-bit video memory address is computed
+            from X and Y coordinates:
+            | 0| 1| 0|Y7|Y6|Y2|Y1|Y0|Y5|Y4|Y3|X4|X3|X2|X1|X0|
+        */
+        const uint16_t yy = y-32;
+        const uint16_t y_offset = ((yy & 0xC0)<<5) | ((yy & 0x07)<<8) | ((yy & 0x38)<<2);
+
+        // left border
+        for (int x = 0; x < (4*8); x++) {
+            *dst++ = sys->border_color;
+        }
+
+        // valid 256x192 vidmem area
+        for (uint16_t x = 0; x < 32; x++) {
+            const uint16_t pix_offset = y_offset | x;
+            const uint16_t clr_offset = 0x1800 + (((yy & ~0x7)<<2) | x);
+
+            // pixel mask and color attribute bytes
+            const uint8_t pix = vidmem_bank[pix_offset];
+            const uint8_t clr = vidmem_bank[clr_offset];
+
+            // foreground and background color
+            uint8_t fg, bg;
+            if ((clr & (1<<7)) && blink) {
+                fg = (clr>>3) & 7;
+                bg = clr & 7;
+            }
+            else {
+                fg = clr & 7;
+                bg = (clr>>3) & 7;
+            }
+            // color bit 6: standard vs bright
+            fg |= (clr & (1<<6)) >> 3;
+            bg |= (clr & (1<<6)) >> 3;
+
+            for (int px = 7; px >=0; px--) {
+                *dst++ = pix & (1<<px) ? fg : bg;
+            }
+        }
+
+        // right border
+        for (int x = 0; x < (4*8); x++) {
+            *dst++ = sys->border_color;
+        }
+    }
+}
+
 static bool _zx_decode_scanline(zx_t* sys) {
     /* this is called by the timer callback for every PAL line, controlling
         the vidmem decoding and vblank interrupt
@@ -314,69 +431,23 @@ static bool _zx_decode_scanline(zx_t* sys) {
     */
     const int top_decode_line = sys->top_border_scanlines - 32;
     const int btm_decode_line = sys->top_border_scanlines + 192 + 32;
-    if ((sys->scanline_y >= top_decode_line) && (sys->scanline_y < btm_decode_line)) {
-        const uint16_t y = sys->scanline_y - top_decode_line;
-        uint8_t* dst = &sys->fb[y * ZX_FRAMEBUFFER_WIDTH];
-        const uint8_t* vidmem_bank = sys->ram[sys->display_ram_bank];
-        const bool blink = 0 != (sys->blink_counter & 0x10);
-        if ((y < 32) || (y >= 224)) {
-            // upper/lower border
-            for (int x = 0; x < ZX_DISPLAY_WIDTH; x++) {
-                *dst++ = sys->border_color;
-            }
-        }
-        else {
-            /* compute video memory Y offset (inside 256x192 area)
-                this is how the 16-bit video memory address is computed
-                from X and Y coordinates:
-                | 0| 1| 0|Y7|Y6|Y2|Y1|Y0|Y5|Y4|Y3|X4|X3|X2|X1|X0|
-            */
-            const uint16_t yy = y-32;
-            const uint16_t y_offset = ((yy & 0xC0)<<5) | ((yy & 0x07)<<8) | ((yy & 0x38)<<2);
-
-            // left border
-            for (int x = 0; x < (4*8); x++) {
-                *dst++ = sys->border_color;
-            }
-
-            // valid 256x192 vidmem area
-            for (uint16_t x = 0; x < 32; x++) {
-                const uint16_t pix_offset = y_offset | x;
-                const uint16_t clr_offset = 0x1800 + (((yy & ~0x7)<<2) | x);
-
-                // pixel mask and color attribute bytes
-                const uint8_t pix = vidmem_bank[pix_offset];
-                const uint8_t clr = vidmem_bank[clr_offset];
-
-                // foreground and background color
-                uint8_t fg, bg;
-                if ((clr & (1<<7)) && blink) {
-                    fg = (clr>>3) & 7;
-                    bg = clr & 7;
-                }
-                else {
-                    fg = clr & 7;
-                    bg = (clr>>3) & 7;
-                }
-                // color bit 6: standard vs bright
-                fg |= (clr & (1<<6)) >> 3;
-                bg |= (clr & (1<<6)) >> 3;
-
-                for (int px = 7; px >=0; px--) {
-                    *dst++ = pix & (1<<px) ? fg : bg;
-                }
-            }
-
-            // right border
-            for (int x = 0; x < (4*8); x++) {
-                *dst++ = sys->border_color;
-            }
+    if (!sys->video_off && (sys->scanline_y >= top_decode_line) && (sys->scanline_y < btm_decode_line)) {
+        const uint16_t y = (uint16_t)(sys->scanline_y - top_decode_line);
+        _zx_decode_line(sys, y);
+        sys->line_hash = chips_hash(sys->line_hash, &sys->fb[y * ZX_FRAMEBUFFER_WIDTH], ZX_DISPLAY_WIDTH);
+        if (sys->video_band.callback.func) {
+            chips_video_band_row(&sys->video_band, y);
         }
     }
 
     if (sys->scanline_y++ >= sys->frame_scan_lines) {
         // start new frame, request vblank interrupt
         sys->scanline_y = 0;
+        if (!sys->video_off) {
+            sys->frame_hash = sys->line_hash;
+        }
+        sys->line_hash = CHIPS_HASH_SEED;
+        chips_video_band_frame(&sys->video_band);
         sys->blink_counter++;
         return true;
     }
@@ -413,7 +484,19 @@ static void _zx_update_memory_map_zx128(zx_t* sys, uint8_t data) {
     }
 }
 
-static uint64_t _zx_tick(zx_t* sys, uint64_t pins) {
+/* run the pending AY ticks in bulk, this must be called before accessing
+   the AY and before mixing its current sample into the audio output
+*/
+static void _zx_ay_sync(zx_t* sys) {
+    while (sys->ay_ticks > 0) {
+        ay38910_advance(&sys->ay, &sys->ay_ticks);
+    }
+}
+
+/*  The tick function 'template', is_128 is a compile-time constant
+    in the specialized tick functions below.
+*/
+static CHIPS_FORCE_INLINE uint64_t _zx_tick(zx_t* sys, uint64_t pins, bool is_128) {
     pins = z80_tick(&sys->cpu, pins);
 
     // video decoding and vblank interrupt
@@ -473,16 +556,17 @@ static uint64_t _zx_tick(zx_t* sys, uint64_t pins) {
                 beeper_set(&sys->beeper, 0 != (data & (1<<4)));
             }
         }
-        else if (((pins & (Z80_WR|Z80_A15|Z80_A1)) == Z80_WR) && (sys->type == ZX_TYPE_128)) {
+        else if (((pins & (Z80_WR|Z80_A15|Z80_A1)) == Z80_WR) && is_128) {
             /* Spectrum 128 memory control (0.............0.)
                 http://8bit.yarek.pl/computer/zx.128/
             */
             _zx_update_memory_map_zx128(sys, Z80_GET_DATA(pins));
         }
-        else if (((pins & (Z80_A15|Z80_A1)) == Z80_A15) && (sys->type == ZX_TYPE_128)) {
+        else if (((pins & (Z80_A15|Z80_A1)) == Z80_A15) && is_128) {
             // AY-3-8912 access (1*............0.)
             if (pins & Z80_A14) { pins |= AY38910_BC1; }
             if (pins & Z80_WR) { pins |= AY38910_BDIR; }
+            _zx_ay_sync(sys);
             pins = ay38910_iorq(&sys->ay, pins) & Z80_PIN_MASK;
         }
         else if ((pins & (Z80_RD|Z80_A7|Z80_A6|Z80_A5)) == Z80_RD) {
@@ -491,41 +575,58 @@ static uint64_t _zx_tick(zx_t* sys, uint64_t pins) {
         }
     }
 
-    // tick the AY at half frequency, use the buffered chip select
-    // pin mask so that the AY doesn't miss any IO requests
-    if (++sys->tick_count & 1) {
-        ay38910_tick(&sys->ay);
+    // tick the AY at half frequency, the AY ticks are only counted here
+    // and executed in bulk when the AY state is needed (see _zx_ay_sync())
+    // (the ZX 48K has no AY, sys->ay.sample remains 0)
+    if ((++sys->tick_count & 1) && is_128) {
+        sys->ay_ticks++;
     }
 
     // tick the beeper
     if (beeper_tick(&sys->beeper)) {
         // new sample ready (if this is not a ZX128, sys->ay.sample will be 0)
-        const float sample = sys->beeper.sample + sys->ay.sample;
-        sys->audio.sample_buffer[sys->audio.sample_pos++] = sample;
+        if (is_128) {
+            _zx_ay_sync(sys);
+        }
+        const int32_t sample = sys->beeper.sample + sys->ay.sample;
+        chips_audio_store(sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.sample_pos++, sample);
         if (sys->audio.sample_pos == sys->audio.num_samples) {
-            if (sys->audio.callback.func) {
-                sys->audio.callback.func(sys->audio.sample_buffer, sys->audio.num_samples, sys->audio.callback.user_data);
-            }
+            chips_audio_flush(&sys->audio.callback, sys->audio.format, sys->audio.sample_buffer, sys->audio.sample_buffer_s16, sys->audio.num_samples);
             sys->audio.sample_pos = 0;
         }
     }
     return pins;
 }
 
+static uint64_t _zx_tick_48k(zx_t* sys, uint64_t pins) {
+    return _zx_tick(sys, pins, false);
+}
+
+static uint64_t _zx_tick_128(zx_t* sys, uint64_t pins) {
+    return _zx_tick(sys, pins, true);
+}
+
+static void _zx_select_tick(zx_t* sys) {
+    sys->tick = (sys->type == ZX_TYPE_128) ? _zx_tick_128 : _zx_tick_48k;
+}
+
 uint32_t zx_exec(zx_t* sys, uint32_t micro_seconds) {
     CHIPS_ASSERT(sys && sys->valid);
     const uint32_t num_ticks = clk_us_to_ticks(sys->freq_hz, micro_seconds);
+    uint64_t (*tick_fn)(zx_t*, uint64_t) = sys->tick;
     uint64_t pins = sys->pins;
     if (0 == sys->debug.callback.func) {
         // run without debug hook
         for (uint32_t tick = 0; tick < num_ticks; tick++) {
-            pins = _zx_tick(sys, pins);
+            pins = tick_fn(sys, pins);
         }
+        _zx_ay_sync(sys);
     }
     else {
-        // run with debug hook
+        // run with debug hook, keep the AY state current for the debugger
         for (uint32_t tick = 0; (tick < num_ticks) && !(*sys->debug.stopped); tick++) {
-            pins = _zx_tick(sys, pins);
+            pins = tick_fn(sys, pins);
+            _zx_ay_sync(sys);
             sys->debug.callback.func(sys->debug.callback.user_data, pins);
         }
     }
@@ -534,6 +635,44 @@ uint32_t zx_exec(zx_t* sys, uint32_t micro_seconds) {
     return num_ticks;
 }
 
+chips_exec_result_t zx_exec_until(zx_t* sys, const chips_exec_until_t* until) {
+    CHIPS_ASSERT(sys && sys->valid && until);
+    const uint32_t cond = until->conditions;
+    chips_exec_result_t res = { 0 };
+    uint64_t (*tick_fn)(zx_t*, uint64_t) = sys->tick;
+    uint64_t pins = sys->pins;
+    while (res.ticks < until->max_ticks) {
+        const uint8_t blink_counter = sys->blink_counter;
+        const int sample_pos = sys->audio.sample_pos;
+        pins = tick_fn(sys, pins);
+        res.ticks++;
+        if ((cond & CHIPS_EXEC_UNTIL_VSYNC) && (blink_counter != sys->blink_counter)) {
+            res.reason |= CHIPS_EXEC_UNTIL_VSYNC;
+        }
+        if ((cond & CHIPS_EXEC_UNTIL_AUDIO) && (sample_pos > sys->audio.sample_pos)) {
+            res.reason |= CHIPS_EXEC_UNTIL_AUDIO;
+        }
+        if ((cond & CHIPS_EXEC_UNTIL_PC) && z80_opdone(&sys->cpu) && (Z80_GET_ADDR(pins) == until->pc)) {
+            res.reason |= CHIPS_EXEC_UNTIL_PC;
+        }
+        if (res.reason) {
+            break;
+        }
+    }
+    if (res.ticks == until->max_ticks) {
+        res.reason |= CHIPS_EXEC_UNTIL_TICKS;
+    }
+    // the tick function already syncs the AY for each audio sample
+    _zx_ay_sync(sys);
+    sys->pins = pins;
+    // carry over the ticks which don't add up to a full microsecond
+    sys->kbd_ticks += res.ticks;
+    const uint32_t kbd_us = clk_ticks_to_us(sys->freq_hz, sys->kbd_ticks);
+    sys->kbd_ticks -= clk_us_to_ticks(sys->freq_hz, kbd_us);
+    kbd_update(&sys->kbd, kbd_us);
+    return res;
+}
+
 void zx_key_down(zx_t* sys, int key_code) {
     CHIPS_ASSERT(sys && sys->valid);
     switch (sys->joystick_type) {
@@ -935,6 +1074,7 @@ bool zx_quickload(zx_t* sys, chips_range_t data) {
     if (ext_hdr) {
         sys->pins = z80_prefetch(&sys->cpu, (ext_hdr->PC_h<<8)|ext_hdr->PC_l);
         if (sys->type == ZX_TYPE_128) {
+            _zx_ay_sync(sys);
             ay38910_reset(&sys->ay);
             for (uint8_t i = 0; i < AY38910_NUM_REGISTERS; i++) {
                 ay38910_set_register(&sys->ay, i, ext_hdr->audio[i]);
@@ -996,13 +1136,40 @@ chips_display_info_t zx_display_info(zx_t* sys) {
     return res;
 }
 
+void zx_enable_video(zx_t* sys, bool enabled) {
+    CHIPS_ASSERT(sys && sys->valid);
+    sys->video_off = !enabled;
+}
+
+bool zx_video_enabled(zx_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return !sys->video_off;
+}
+
+void zx_render_video(zx_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    uint64_t hash = CHIPS_HASH_SEED;
+    for (uint16_t y = 0; y < ZX_DISPLAY_HEIGHT; y++) {
+        _zx_decode_line(sys, y);
+        hash = chips_hash(hash, &sys->fb[y * ZX_FRAMEBUFFER_WIDTH], ZX_DISPLAY_WIDTH);
+    }
+    sys->frame_hash = hash;
+}
+
+uint64_t zx_frame_hash(zx_t* sys) {
+    CHIPS_ASSERT(sys && sys->valid);
+    return sys->frame_hash;
+}
+
 uint32_t zx_save_snapshot(zx_t* sys, zx_t* dst) {
     CHIPS_ASSERT(sys && dst);
     *dst = *sys;
     chips_debug_snapshot_onsave(&dst->debug);
     chips_audio_callback_snapshot_onsave(&dst->audio.callback);
+    chips_video_band_snapshot_onsave(&dst->video_band);
     ay38910_snapshot_onsave(&dst->ay);
     mem_snapshot_onsave(&dst->mem, sys);
+    dst->tick = 0;
     return ZX_SNAPSHOT_VERSION;
 }
 
@@ -1015,8 +1182,11 @@ bool zx_load_snapshot(zx_t* sys, uint32_t version, zx_t* src) {
     im = *src;
     chips_debug_snapshot_onload(&im.debug, &sys->debug);
     chips_audio_callback_snapshot_onload(&im.audio.callback, &sys->audio.callback);
+    chips_video_band_snapshot_onload(&im.video_band, &sys->video_band);
     ay38910_snapshot_onload(&im.ay, &sys->ay);
     mem_snapshot_onload(&im.mem, sys);
+    im.video_off = sys->video_off;
+    _zx_select_tick(&im);
     *sys = im;
     return true;
 }
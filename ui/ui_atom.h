@@ -410,6 +410,9 @@ void ui_atom_init(ui_atom_t* ui, const ui_atom_desc_t* ui_desc) {
         ui_audio_desc_t desc = {0};
         desc.title = "Audio Output";
         desc.sample_buffer = ui->atom->audio.sample_buffer;
+        if (ui->atom->audio.format == CHIPS_AUDIO_FORMAT_S16) {
+            desc.sample_buffer_s16 = ui->atom->audio.sample_buffer_s16;
+        }
         desc.num_samples = ui->atom->audio.num_samples;
         desc.x = x;
         desc.y = y;
@@ -56,6 +56,7 @@ extern "C" {
 typedef struct {
     const char* title;          /* window title */
     const float* sample_buffer; /* pointer to audio sample buffer */
+    const int16_t* sample_buffer_s16;   /* optional: plot this S16 sample buffer instead */
     int num_samples;            /* max number of samples in sample buffer */
     int x, y;                   /* initial window position */
     int w, h;                   /* initial window size or zero for default size */
@@ -65,6 +66,7 @@ typedef struct {
 typedef struct {
     const char* title;
     const float* sample_buffer;
+    const int16_t* sample_buffer_s16;
     int num_samples;
     float init_x, init_y;
     float init_w, init_h;
@@ -103,6 +105,7 @@ void ui_audio_init(ui_audio_t* win, const ui_audio_desc_t* desc) {
     memset(win, 0, sizeof(ui_audio_t));
     win->title = desc->title;
     win->sample_buffer = desc->sample_buffer;
+    win->sample_buffer_s16 = desc->sample_buffer_s16;
     win->num_samples = desc->num_samples;
     win->init_x = (float) desc->x;
     win->init_y = (float) desc->y;
@@ -118,6 +121,10 @@ void ui_audio_discard(ui_audio_t* win) {
     win->valid = false;
 }
 
+static float _ui_audio_s16_getter(void* data, int idx) {
+    return (float)((const int16_t*)data)[idx] / 32768.0f;
+}
+
 void ui_audio_draw(ui_audio_t* win, int sample_pos) {
     CHIPS_ASSERT(win && win->valid && win->title && win->sample_buffer);
     ui_util_handle_window_open_dirty(&win->open, &win->last_open);
@@ -129,7 +136,12 @@ void ui_audio_draw(ui_audio_t* win, int sample_pos) {
     if (ImGui::Begin(win->title, &win->open)) {
         ImVec2 pos = ImGui::GetCursorScreenPos();
         ImVec2 area = ImGui::GetContentRegionAvail();
-        ImGui::PlotLines("##samples", win->sample_buffer, win->num_samples, 0, 0, -1.0f, +1.0f, area);
+        if (win->sample_buffer_s16) {
+            ImGui::PlotLines("##samples", _ui_audio_s16_getter, (void*)win->sample_buffer_s16, win->num_samples, 0, 0, -1.0f, +1.0f, area);
+        }
+        else {
+            ImGui::PlotLines("##samples", win->sample_buffer, win->num_samples, 0, 0, -1.0f, +1.0f, area);
+        }
         const ImGuiStyle& style = ImGui::GetStyle();
         float x0 = pos.x + style.FramePadding.x;
         float x1 = pos.x + area.x - style.FramePadding.x;
@@ -320,6 +320,9 @@ void ui_bombjack_init(ui_bombjack_t* ui, const ui_bombjack_desc_t* ui_desc) {
         ui_audio_desc_t desc = {0};
         desc.title = "Audio Output";
         desc.sample_buffer = ui->bj->audio.sample_buffer;
+        if (ui->bj->audio.format == CHIPS_AUDIO_FORMAT_S16) {
+            desc.sample_buffer_s16 = ui->bj->audio.sample_buffer_s16;
+        }
         desc.num_samples = ui->bj->audio.num_samples,
         desc.x = x;
         desc.y = y;
@@ -656,6 +656,9 @@ void ui_c64_init(ui_c64_t* ui, const ui_c64_desc_t* ui_desc) {
         ui_audio_desc_t desc = {0};
         desc.title = "Audio Output";
         desc.sample_buffer = ui->c64->audio.sample_buffer;
+        if (ui->c64->audio.format == CHIPS_AUDIO_FORMAT_S16) {
+            desc.sample_buffer_s16 = ui->c64->audio.sample_buffer_s16;
+        }
         desc.num_samples = ui->c64->audio.num_samples;
         desc.x = x;
         desc.y = y;
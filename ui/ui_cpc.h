@@ -676,6 +676,9 @@ void ui_cpc_init(ui_cpc_t* ui, const ui_cpc_desc_t* ui_desc) {
         ui_audio_desc_t desc = {0};
         desc.title = "Audio Output";
         desc.sample_buffer = ui->cpc->audio.sample_buffer;
+        if (ui->cpc->audio.format == CHIPS_AUDIO_FORMAT_S16) {
+            desc.sample_buffer_s16 = ui->cpc->audio.sample_buffer_s16;
+        }
         desc.num_samples = ui->cpc->audio.num_samples;
         desc.x = x;
         desc.y = y;
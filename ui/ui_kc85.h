@@ -440,6 +440,9 @@ void ui_kc85_init(ui_kc85_t* ui, const ui_kc85_desc_t* ui_desc) {
         ui_audio_desc_t desc = {0};
         desc.title = "Audio Output";
         desc.sample_buffer = ui->kc85->audio.sample_buffer;
+        if (ui->kc85->audio.format == CHIPS_AUDIO_FORMAT_S16) {
+            desc.sample_buffer_s16 = ui->kc85->audio.sample_buffer_s16;
+        }
         desc.num_samples = ui->kc85->audio.num_samples;
         desc.x = x;
         desc.y = y;
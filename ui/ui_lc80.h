@@ -1103,6 +1103,9 @@ static void _ui_lc80_init_windows(ui_lc80_t* ui, const ui_lc80_desc_t* ui_desc)
         ui_audio_desc_t desc = {0};
         desc.title = "Audio Output";
         desc.sample_buffer = ui->sys->audio.sample_buffer;
+        if (ui->sys->audio.format == CHIPS_AUDIO_FORMAT_S16) {
+            desc.sample_buffer_s16 = ui->sys->audio.sample_buffer_s16;
+        }
         desc.num_samples = ui->sys->audio.num_samples;
         desc.x = x;
         desc.y = y;
@@ -240,6 +240,9 @@ void ui_namco_init(ui_namco_t* ui, const ui_namco_desc_t* ui_desc) {
         ui_audio_desc_t desc = {0};
         desc.title = "Audio Output";
         desc.sample_buffer = ui->sys->sound.sample_buffer;
+        if (ui->sys->sound.format == CHIPS_AUDIO_FORMAT_S16) {
+            desc.sample_buffer_s16 = ui->sys->sound.sample_buffer_s16;
+        }
         desc.num_samples = ui->sys->sound.num_samples;
         desc.x = x;
         desc.y = y;
@@ -481,6 +481,9 @@ void ui_vic20_init(ui_vic20_t* ui, const ui_vic20_desc_t* ui_desc) {
         ui_audio_desc_t desc = {0};
         desc.title = "Audio Output";
         desc.sample_buffer = ui->vic20->audio.sample_buffer;
+        if (ui->vic20->audio.format == CHIPS_AUDIO_FORMAT_S16) {
+            desc.sample_buffer_s16 = ui->vic20->audio.sample_buffer_s16;
+        }
         desc.num_samples = ui->vic20->audio.num_samples;
         desc.x = x;
         desc.y = y;
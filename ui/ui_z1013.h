@@ -277,6 +277,10 @@ void _ui_z1013_mem_write(int layer, uint16_t addr, uint8_t data, void* user_data
     CHIPS_ASSERT(user_data);
     z1013_t* z1013 = (z1013_t*) user_data;
     mem_wr(&z1013->mem, addr, data);
+    // write to video RAM? (same as in _z1013_tick())
+    if ((addr & 0xFC00) == 0xEC00) {
+        z1013->vid_dirty[(addr & 0x3FF) >> 6] |= 1ULL << (addr & 0x3F);
+    }
 }
 
 void ui_z1013_init(ui_z1013_t* ui, const ui_z1013_desc_t* ui_desc) {
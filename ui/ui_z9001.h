@@ -315,6 +315,10 @@ void _ui_z9001_mem_write(int layer, uint16_t addr, uint8_t data, void* user_data
     CHIPS_ASSERT(user_data);
     z9001_t* z9001 = (z9001_t*) user_data;
     mem_wr(&z9001->mem, addr, data);
+    // write to color (E800) or ASCII (EC00) video RAM? (same as in _z9001_tick())
+    if ((addr & 0xF800) == 0xE800) {
+        z9001->vid_dirty[(addr & 0x3FF) >> 6] |= 1ULL << (addr & 0x3F);
+    }
 }
 
 void ui_z9001_init(ui_z9001_t* ui, const ui_z9001_desc_t* ui_desc) {
@@ -376,6 +380,9 @@ void ui_z9001_init(ui_z9001_t* ui, const ui_z9001_desc_t* ui_desc) {
         ui_audio_desc_t desc = {0};
         desc.title = "Audio Output";
         desc.sample_buffer = ui->z9001->audio.sample_buffer;
+        if (ui->z9001->audio.format == CHIPS_AUDIO_FORMAT_S16) {
+            desc.sample_buffer_s16 = ui->z9001->audio.sample_buffer_s16;
+        }
         desc.num_samples = ui->z9001->audio.num_samples;
         desc.x = x;
         desc.y = y;
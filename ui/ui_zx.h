@@ -407,6 +407,9 @@ void ui_zx_init(ui_zx_t* ui, const ui_zx_desc_t* ui_desc) {
         ui_audio_desc_t desc = {0};
         desc.title = "Audio Output";
         desc.sample_buffer = ui->zx->audio.sample_buffer;
+        if (ui->zx->audio.format == CHIPS_AUDIO_FORMAT_S16) {
+            desc.sample_buffer_s16 = ui->zx->audio.sample_buffer_s16;
+        }
         desc.num_samples = ui->zx->audio.num_samples;
         desc.x = x;
         desc.y = y;
@@ -0,0 +1,450 @@
+#pragma once
+/*#
+    # batch.h
+
+    Run many instances of the same emulated system on a fixed pool of
+    worker threads.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    ~~~C
+    BATCH_MAX_INSTANCES
+    ~~~
+        the max number of instance slots in a batch_t (default: 4096)
+
+    ~~~C
+    BATCH_MAX_WORKERS
+    ~~~
+        the max number of worker threads (default: 64)
+
+    On Windows, the Win32 threading API is used, everywhere else pthreads
+    (link with -pthread). Define BATCH_NO_THREADS to compile without
+    threading support, all instances will then run on the calling thread.
+
+    ## Usage
+
+    Since all system emulators have the same exec function signature (except
+    for the type of the first argument), the batch runner calls the exec
+    function through a small wrapper function:
+
+    ~~~C
+    static uint32_t exec_zx(void* sys, uint32_t micro_seconds) {
+        return zx_exec((zx_t*)sys, micro_seconds);
+    }
+    ~~~
+
+    The batch_t struct is big (it contains the instance slots and per-worker
+    state), so it should live in static or heap memory:
+
+    ~~~C
+    static batch_t batch;
+    batch_init(&batch, &(batch_desc_t){
+        .exec = exec_zx,
+        .num_workers = 63,  // plus the calling thread
+    });
+    ~~~
+
+    Add system instances to the batch, this returns a slot index (or
+    BATCH_INVALID_SLOT if all slots are in use):
+
+    ~~~C
+    int slot = batch_add(&batch, &zx_instances[i]);
+    ~~~
+
+    Advance all instances by a number of microseconds, this will return
+    after all instances have completed:
+
+    ~~~C
+    batch_exec(&batch, 16667);
+    ~~~
+
+    Each instance is run on exactly one thread per batch_exec() call, but
+    the same instance may run on different threads in different batches.
+    Idle worker threads steal instances from the work queues of busy
+    workers.
+
+    The number of ticks executed by an instance in the last batch and the
+    total number of ticks since it was added can be inspected with:
+
+    ~~~C
+    uint32_t batch_ticks(batch_t* batch, int slot);
+    uint64_t batch_total_ticks(batch_t* batch, int slot);
+    ~~~
+
+    Between calls to batch_exec(), instances can be retired from the batch,
+    this frees the slot for new instances (no memory is allocated or freed):
+
+    ~~~C
+    batch_remove(&batch, slot);
+    ~~~
+
+    Finally call batch_discard() to stop and join the worker threads.
+
+    ## zlib/libpng license
+
+    Copyright (c) 2018 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdalign.h>
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__) && !defined(BATCH_NO_THREADS)
+#define BATCH_NO_THREADS
+#endif
+#if !defined(BATCH_NO_THREADS)
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef BATCH_MAX_INSTANCES
+#define BATCH_MAX_INSTANCES (4096)
+#endif
+#ifndef BATCH_MAX_WORKERS
+#define BATCH_MAX_WORKERS (64)
+#endif
+#define BATCH_INVALID_SLOT (-1)
+
+// system exec function wrapper, returns number of executed ticks
+typedef uint32_t (*batch_exec_t)(void* sys, uint32_t micro_seconds);
+
+// config parameters for batch_init()
+typedef struct {
+    batch_exec_t exec;      // the exec function wrapper (required)
+    int num_workers;        // number of worker threads in addition to the calling thread (default: 0)
+} batch_desc_t;
+
+// an instance slot
+typedef struct {
+    void* sys;              // pointer to system instance, or 0 if slot is free
+    uint32_t ticks;         // number of ticks executed in last batch_exec()
+    uint64_t total_ticks;   // number of ticks executed since batch_add()
+} batch_slot_t;
+
+// per-thread work queue, a range in the active-instance list
+typedef struct {
+    alignas(64) volatile int32_t next;
+    int32_t end;
+} batch_queue_t;
+
+// a worker thread
+typedef struct {
+    struct batch_t* batch;
+    int index;
+    #if !defined(BATCH_NO_THREADS)
+    #if defined(_WIN32)
+    HANDLE thread;
+    #else
+    pthread_t thread;
+    #endif
+    #endif
+} batch_worker_t;
+
+// batch runner state
+typedef struct batch_t {
+    batch_exec_t exec;
+    int num_workers;
+    int num_slots;                  // high water mark of used slots
+    int num_free;
+    int num_active;
+    uint32_t micro_seconds;         // duration of current batch
+    int free_slots[BATCH_MAX_INSTANCES];
+    int active[BATCH_MAX_INSTANCES];
+    batch_slot_t slots[BATCH_MAX_INSTANCES];
+    batch_queue_t queues[BATCH_MAX_WORKERS + 1];
+    batch_worker_t workers[BATCH_MAX_WORKERS];
+    #if !defined(BATCH_NO_THREADS)
+    #if defined(_WIN32)
+    SRWLOCK lock;
+    CONDITION_VARIABLE start_cond;
+    CONDITION_VARIABLE done_cond;
+    #else
+    pthread_mutex_t lock;
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;
+    #endif
+    #endif
+    uint32_t generation;            // incremented for each batch_exec()
+    int num_busy;                   // number of workers still busy with current batch
+    bool quit;
+    bool valid;
+} batch_t;
+
+// initialize a batch runner and start the worker threads
+void batch_init(batch_t* batch, const batch_desc_t* desc);
+// stop and join the worker threads
+void batch_discard(batch_t* batch);
+// add a system instance, returns slot index or BATCH_INVALID_SLOT
+int batch_add(batch_t* batch, void* sys);
+// retire a system instance, the slot will be reused by batch_add()
+void batch_remove(batch_t* batch, int slot);
+// number of system instances in the batch
+int batch_num_instances(batch_t* batch);
+// run all system instances for a number of microseconds, blocks until all instances are done
+void batch_exec(batch_t* batch, uint32_t micro_seconds);
+// get the number of ticks executed by an instance in the last batch_exec()
+uint32_t batch_ticks(batch_t* batch, int slot);
+// get the number of ticks executed by an instance since it was added
+uint64_t batch_total_ticks(batch_t* batch, int slot);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define _BATCH_FETCH_ADD(ptr, val) _InterlockedExchangeAdd((volatile long*)(ptr), (long)(val))
+#else
+#define _BATCH_FETCH_ADD(ptr, val) __atomic_fetch_add((ptr), (val), __ATOMIC_RELAXED)
+#endif
+
+static void _batch_run_instance(batch_t* batch, int32_t active_index) {
+    batch_slot_t* slot = &batch->slots[batch->active[active_index]];
+    slot->ticks = batch->exec(slot->sys, batch->micro_seconds);
+    slot->total_ticks += slot->ticks;
+}
+
+// process the thread's own queue first, and then steal from the other queues
+static void _batch_run_queues(batch_t* batch, int queue_index) {
+    const int num_queues = batch->num_workers + 1;
+    for (int i = 0; i < num_queues; i++) {
+        batch_queue_t* queue = &batch->queues[(queue_index + i) % num_queues];
+        int32_t active_index;
+        while ((active_index = _BATCH_FETCH_ADD(&queue->next, 1)) < queue->end) {
+            _batch_run_instance(batch, active_index);
+        }
+    }
+}
+
+#if !defined(BATCH_NO_THREADS)
+#if defined(_WIN32)
+#define _batch_lock(b)              AcquireSRWLockExclusive(&(b)->lock)
+#define _batch_unlock(b)            ReleaseSRWLockExclusive(&(b)->lock)
+#define _batch_wait(b,cond)         SleepConditionVariableSRW(&(b)->cond, &(b)->lock, INFINITE, 0)
+#define _batch_broadcast(b,cond)    WakeAllConditionVariable(&(b)->cond)
+#define _batch_signal(b,cond)       WakeConditionVariable(&(b)->cond)
+#else
+#define _batch_lock(b)              pthread_mutex_lock(&(b)->lock)
+#define _batch_unlock(b)            pthread_mutex_unlock(&(b)->lock)
+#define _batch_wait(b,cond)         pthread_cond_wait(&(b)->cond, &(b)->lock)
+#define _batch_broadcast(b,cond)    pthread_cond_broadcast(&(b)->cond)
+#define _batch_signal(b,cond)       pthread_cond_signal(&(b)->cond)
+#endif
+
+static void _batch_worker_loop(batch_worker_t* worker) {
+    batch_t* batch = worker->batch;
+    uint32_t generation = 0;
+    while (true) {
+        _batch_lock(batch);
+        while (!batch->quit && (generation == batch->generation)) {
+            _batch_wait(batch, start_cond);
+        }
+        if (batch->quit) {
+            _batch_unlock(batch);
+            break;
+        }
+        generation = batch->generation;
+        _batch_unlock(batch);
+
+        // queue 0 belongs to the calling thread
+        _batch_run_queues(batch, worker->index + 1);
+
+        _batch_lock(batch);
+        if (--batch->num_busy == 0) {
+            _batch_signal(batch, done_cond);
+        }
+        _batch_unlock(batch);
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI _batch_worker_func(LPVOID arg) {
+    _batch_worker_loop((batch_worker_t*)arg);
+    return 0;
+}
+#else
+static void* _batch_worker_func(void* arg) {
+    _batch_worker_loop((batch_worker_t*)arg);
+    return 0;
+}
+#endif
+#endif // BATCH_NO_THREADS
+
+void batch_init(batch_t* batch, const batch_desc_t* desc) {
+    CHIPS_ASSERT(batch && desc && desc->exec);
+    CHIPS_ASSERT((desc->num_workers >= 0) && (desc->num_workers <= BATCH_MAX_WORKERS));
+    memset(batch, 0, sizeof(batch_t));
+    batch->valid = true;
+    batch->exec = desc->exec;
+    #if !defined(BATCH_NO_THREADS)
+    batch->num_workers = desc->num_workers;
+    #if defined(_WIN32)
+    InitializeSRWLock(&batch->lock);
+    InitializeConditionVariable(&batch->start_cond);
+    InitializeConditionVariable(&batch->done_cond);
+    #else
+    pthread_mutex_init(&batch->lock, 0);
+    pthread_cond_init(&batch->start_cond, 0);
+    pthread_cond_init(&batch->done_cond, 0);
+    #endif
+    for (int i = 0; i < batch->num_workers; i++) {
+        batch_worker_t* worker = &batch->workers[i];
+        worker->batch = batch;
+        worker->index = i;
+        #if defined(_WIN32)
+        worker->thread = CreateThread(0, 0, _batch_worker_func, worker, 0, 0);
+        CHIPS_ASSERT(worker->thread);
+        #else
+        int res = pthread_create(&worker->thread, 0, _batch_worker_func, worker);
+        CHIPS_ASSERT(0 == res); (void)res;
+        #endif
+    }
+    #endif
+}
+
+void batch_discard(batch_t* batch) {
+    CHIPS_ASSERT(batch && batch->valid);
+    #if !defined(BATCH_NO_THREADS)
+    _batch_lock(batch);
+    batch->quit = true;
+    _batch_broadcast(batch, start_cond);
+    _batch_unlock(batch);
+    for (int i = 0; i < batch->num_workers; i++) {
+        #if defined(_WIN32)
+        WaitForSingleObject(batch->workers[i].thread, INFINITE);
+        CloseHandle(batch->workers[i].thread);
+        #else
+        pthread_join(batch->workers[i].thread, 0);
+        #endif
+    }
+    #if !defined(_WIN32)
+    pthread_cond_destroy(&batch->done_cond);
+    pthread_cond_destroy(&batch->start_cond);
+    pthread_mutex_destroy(&batch->lock);
+    #endif
+    #endif
+    batch->valid = false;
+}
+
+int batch_add(batch_t* batch, void* sys) {
+    CHIPS_ASSERT(batch && batch->valid && sys);
+    int slot;
+    if (batch->num_free > 0) {
+        slot = batch->free_slots[--batch->num_free];
+    }
+    else if (batch->num_slots < BATCH_MAX_INSTANCES) {
+        slot = batch->num_slots++;
+    }
+    else {
+        return BATCH_INVALID_SLOT;
+    }
+    batch->slots[slot] = (batch_slot_t){ .sys = sys };
+    return slot;
+}
+
+void batch_remove(batch_t* batch, int slot) {
+    CHIPS_ASSERT(batch && batch->valid);
+    CHIPS_ASSERT((slot >= 0) && (slot < batch->num_slots) && batch->slots[slot].sys);
+    batch->slots[slot].sys = 0;
+    batch->free_slots[batch->num_free++] = slot;
+}
+
+int batch_num_instances(batch_t* batch) {
+    CHIPS_ASSERT(batch && batch->valid);
+    return batch->num_slots - batch->num_free;
+}
+
+void batch_exec(batch_t* batch, uint32_t micro_seconds) {
+    CHIPS_ASSERT(batch && batch->valid);
+    // gather active instances and split them into one work queue per thread
+    batch->num_active = 0;
+    for (int i = 0; i < batch->num_slots; i++) {
+        if (batch->slots[i].sys) {
+            batch->active[batch->num_active++] = i;
+        }
+    }
+    if (batch->num_active == 0) {
+        return;
+    }
+    batch->micro_seconds = micro_seconds;
+    const int num_queues = batch->num_workers + 1;
+    for (int i = 0; i < num_queues; i++) {
+        batch->queues[i].next = (int32_t)((i * batch->num_active) / num_queues);
+        batch->queues[i].end = (int32_t)(((i + 1) * batch->num_active) / num_queues);
+    }
+    #if !defined(BATCH_NO_THREADS)
+    if (batch->num_workers > 0) {
+        _batch_lock(batch);
+        batch->num_busy = batch->num_workers;
+        batch->generation++;
+        _batch_broadcast(batch, start_cond);
+        _batch_unlock(batch);
+    }
+    #endif
+    _batch_run_queues(batch, 0);
+    #if !defined(BATCH_NO_THREADS)
+    if (batch->num_workers > 0) {
+        _batch_lock(batch);
+        while (batch->num_busy > 0) {
+            _batch_wait(batch, done_cond);
+        }
+        _batch_unlock(batch);
+    }
+    #endif
+}
+
+uint32_t batch_ticks(batch_t* batch, int slot) {
+    CHIPS_ASSERT(batch && batch->valid);
+    CHIPS_ASSERT((slot >= 0) && (slot < batch->num_slots));
+    return batch->slots[slot].ticks;
+}
+
+uint64_t batch_total_ticks(batch_t* batch, int slot) {
+    CHIPS_ASSERT(batch && batch->valid);
+    CHIPS_ASSERT((slot >= 0) && (slot < batch->num_slots));
+    return batch->slots[slot].total_ticks;
+}
+
+#endif // CHIPS_UTIL_IMPL
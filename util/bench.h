@@ -0,0 +1,337 @@
+#pragma once
+/*#
+    # bench.h
+
+    Headless benchmark helpers with machine-readable output, for tracking
+    the performance of the system and chip emulators across commits.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    The system benchmarks live next to the tests in the chips-test
+    repository (which also has the ROM images needed to boot the systems),
+    bench.h only contains the measuring and reporting code so that all
+    benchmarks report the same numbers in the same format.
+
+    The ROM-free CPU and sound chip micro-benchmarks in bench/bench_chips.c
+    can be built and run directly from this repository:
+
+    ~~~
+    cc -O2 -I. bench/bench_chips.c -o bench_chips -lm
+    ./bench_chips -seconds 10 -tag $(git rev-parse --short HEAD)
+    ~~~
+
+    ## Usage
+
+    A benchmark runs an exec function for a number of emulated seconds and
+    measures the host time it took. The exec function has the same signature
+    as the exec function in batch.h, so the system emulators are called
+    through a small wrapper function:
+
+    ~~~C
+    static uint32_t exec_zx(void* sys, uint32_t micro_seconds) {
+        return zx_exec((zx_t*)sys, micro_seconds);
+    }
+    ~~~
+
+    Initialize and boot the system as usual, then run the benchmark:
+
+    ~~~C
+    bench_result_t res = bench_run(&(bench_desc_t){
+        .name = "zx48k",
+        .exec = exec_zx,
+        .sys = &sys,
+        .freq_hz = 3500000,
+        .num_seconds = 10,
+    });
+    bench_print_json(stdout, &res);
+    ~~~
+
+    The exec function is called with time slices of desc.slice_us
+    microseconds (default: 16667, one 60Hz frame) until desc.num_seconds
+    emulated seconds (default: 10) have been executed.
+
+    The result contains:
+
+    - **ticks**: the number of ticks reported by the exec function
+    - **host_seconds**: the measured host time
+    - **emu_mhz**: the effective emulated clock frequency in MHz, the
+      emulator can run in realtime if this is greater than the emulated
+      system's clock frequency
+    - **ticks_per_second**: emulated ticks per host second
+    - **ns_per_tick**: host nanoseconds per emulated tick
+    - **realtime**: emulated seconds per host second
+
+    ## Chip Micro-Benchmarks
+
+    To measure a chip's tick function in isolation, wrap the chip and the
+    minimal amount of glue code needed to feed its pins into a struct, and
+    run a tick loop in the exec function:
+
+    ~~~C
+    typedef struct {
+        z80_t cpu;
+        uint64_t pins;
+        uint8_t mem[1<<16];
+    } z80_bench_t;
+
+    static uint32_t exec_z80(void* user_data, uint32_t micro_seconds) {
+        z80_bench_t* b = (z80_bench_t*) user_data;
+        const uint32_t num_ticks = clk_us_to_ticks(4000000, micro_seconds);
+        uint64_t pins = b->pins;
+        for (uint32_t i = 0; i < num_ticks; i++) {
+            pins = z80_tick(&b->cpu, pins);
+            if (pins & Z80_MREQ) {
+                const uint16_t addr = Z80_GET_ADDR(pins);
+                if (pins & Z80_RD) {
+                    Z80_SET_DATA(pins, b->mem[addr]);
+                }
+                else if (pins & Z80_WR) {
+                    b->mem[addr] = Z80_GET_DATA(pins);
+                }
+            }
+        }
+        b->pins = pins;
+        return num_ticks;
+    }
+    ~~~
+
+    ## Output Format
+
+    bench_print_json() writes one JSON object per line (JSON Lines):
+
+    ~~~
+    {"name":"zx48k","tag":"abc1234","freq_hz":3500000,"ticks":35000000,"emu_seconds":10.000000,"host_seconds":0.812345,"emu_mhz":43.085,"ticks_per_second":43085388.5,"ns_per_tick":23.210,"realtime":12.310}
+    ~~~
+
+    The optional desc.tag string is copied into the output, for instance
+    to identify the commit or build configuration.
+
+    For spreadsheets, bench_print_csv_header() and bench_print_csv() write
+    the same fields as comma-separated values.
+
+    ## zlib/libpng license
+
+    Copyright (c) 2018 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BENCH_DEFAULT_SECONDS (10)
+#define BENCH_DEFAULT_SLICE_US (16667)
+
+// exec function signature, returns number of executed ticks
+typedef uint32_t (*bench_exec_t)(void* sys, uint32_t micro_seconds);
+
+// benchmark description for bench_run()
+typedef struct {
+    const char* name;       // benchmark name
+    const char* tag;        // optional tag (e.g. commit hash)
+    bench_exec_t exec;      // exec function
+    void* sys;              // system or chip instance passed to exec function
+    uint64_t freq_hz;       // emulated clock frequency
+    uint32_t num_seconds;   // emulated seconds to run (default: 10)
+    uint32_t slice_us;      // micro seconds per exec call (default: 16667)
+} bench_desc_t;
+
+// benchmark result
+typedef struct {
+    const char* name;
+    const char* tag;
+    uint64_t freq_hz;
+    uint64_t ticks;
+    double emu_seconds;
+    double host_seconds;
+    double emu_mhz;
+    double ticks_per_second;
+    double ns_per_tick;
+    double realtime;
+} bench_result_t;
+
+// run a benchmark
+bench_result_t bench_run(const bench_desc_t* desc);
+// get current host time in seconds
+double bench_now(void);
+// write benchmark result as single-line JSON object
+void bench_print_json(FILE* fp, const bench_result_t* res);
+// write CSV header line
+void bench_print_csv_header(FILE* fp);
+// write benchmark result as CSV line
+void bench_print_csv(FILE* fp, const bench_result_t* res);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <time.h>
+#include <string.h>  // strpbrk
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#endif
+
+#define _BENCH_DEFAULT(val,def) (((val) != 0) ? (val) : (def))
+
+double bench_now(void) {
+    #if defined(_WIN32)
+        LARGE_INTEGER freq, count;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&count);
+        return (double)count.QuadPart / (double)freq.QuadPart;
+    #elif defined(__APPLE__)
+        mach_timebase_info_data_t info;
+        mach_timebase_info(&info);
+        return ((double)mach_absolute_time() * (double)info.numer / (double)info.denom) * 1.0e-9;
+    #elif defined(CLOCK_MONOTONIC)
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+    #elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+        // strict C11 mode hides clock_gettime(), fall back to wall-clock time
+        struct timespec ts;
+        timespec_get(&ts, TIME_UTC);
+        return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+    #else
+        // last resort: processor time, only useful for single-threaded benchmarks
+        return (double)clock() / (double)CLOCKS_PER_SEC;
+    #endif
+}
+
+// write a string as JSON string literal (including the quotes)
+static void _bench_json_string(FILE* fp, const char* str) {
+    fputc('"', fp);
+    for (const unsigned char* p = (const unsigned char*)str; *p; p++) {
+        switch (*p) {
+            case '"':  fputs("\\\"", fp); break;
+            case '\\': fputs("\\\\", fp); break;
+            case '\n': fputs("\\n", fp); break;
+            case '\r': fputs("\\r", fp); break;
+            case '\t': fputs("\\t", fp); break;
+            default:
+                if (*p < 0x20) {
+                    fprintf(fp, "\\u%04x", *p);
+                }
+                else {
+                    fputc(*p, fp);
+                }
+                break;
+        }
+    }
+    fputc('"', fp);
+}
+
+// write a string as CSV field, quoted only if needed
+static void _bench_csv_string(FILE* fp, const char* str) {
+    if (0 == strpbrk(str, ",\"\r\n")) {
+        fputs(str, fp);
+        return;
+    }
+    fputc('"', fp);
+    for (const char* p = str; *p; p++) {
+        if (*p == '"') {
+            fputc('"', fp);
+        }
+        fputc(*p, fp);
+    }
+    fputc('"', fp);
+}
+
+bench_result_t bench_run(const bench_desc_t* desc) {
+    CHIPS_ASSERT(desc && desc->exec && desc->sys && (desc->freq_hz > 0));
+    const uint32_t num_seconds = _BENCH_DEFAULT(desc->num_seconds, BENCH_DEFAULT_SECONDS);
+    const uint32_t slice_us = _BENCH_DEFAULT(desc->slice_us, BENCH_DEFAULT_SLICE_US);
+    const uint64_t total_us = (uint64_t)num_seconds * 1000000;
+
+    bench_result_t res = { 0 };
+    res.name = desc->name ? desc->name : "";
+    res.tag = desc->tag ? desc->tag : "";
+    res.freq_hz = desc->freq_hz;
+    res.emu_seconds = (double)num_seconds;
+
+    const double start = bench_now();
+    for (uint64_t us = 0; us < total_us; us += slice_us) {
+        const uint32_t cur_us = ((total_us - us) < slice_us) ? (uint32_t)(total_us - us) : slice_us;
+        res.ticks += desc->exec(desc->sys, cur_us);
+    }
+    res.host_seconds = bench_now() - start;
+
+    if ((res.host_seconds > 0.0) && (res.ticks > 0)) {
+        res.ticks_per_second = (double)res.ticks / res.host_seconds;
+        res.emu_mhz = res.ticks_per_second * 1.0e-6;
+        res.ns_per_tick = (res.host_seconds * 1.0e9) / (double)res.ticks;
+        res.realtime = res.emu_seconds / res.host_seconds;
+    }
+    return res;
+}
+
+void bench_print_json(FILE* fp, const bench_result_t* res) {
+    CHIPS_ASSERT(fp && res);
+    fputs("{\"name\":", fp);
+    _bench_json_string(fp, res->name);
+    fputs(",\"tag\":", fp);
+    _bench_json_string(fp, res->tag);
+    fprintf(fp, ",\"freq_hz\":%llu,\"ticks\":%llu,"
+        "\"emu_seconds\":%f,\"host_seconds\":%f,\"emu_mhz\":%.3f,"
+        "\"ticks_per_second\":%.1f,\"ns_per_tick\":%.3f,\"realtime\":%.3f}\n",
+        (unsigned long long)res->freq_hz, (unsigned long long)res->ticks,
+        res->emu_seconds, res->host_seconds, res->emu_mhz,
+        res->ticks_per_second, res->ns_per_tick, res->realtime);
+}
+
+void bench_print_csv_header(FILE* fp) {
+    CHIPS_ASSERT(fp);
+    fprintf(fp, "name,tag,freq_hz,ticks,emu_seconds,host_seconds,emu_mhz,ticks_per_second,ns_per_tick,realtime\n");
+}
+
+void bench_print_csv(FILE* fp, const bench_result_t* res) {
+    CHIPS_ASSERT(fp && res);
+    _bench_csv_string(fp, res->name);
+    fputc(',', fp);
+    _bench_csv_string(fp, res->tag);
+    fprintf(fp, ",%llu,%llu,%f,%f,%.3f,%.1f,%.3f,%.3f\n",
+        (unsigned long long)res->freq_hz, (unsigned long long)res->ticks,
+        res->emu_seconds, res->host_seconds, res->emu_mhz,
+        res->ticks_per_second, res->ns_per_tick, res->realtime);
+}
+
+#endif // CHIPS_UTIL_IMPL
@@ -0,0 +1,534 @@
+#pragma once
+/*#
+    # capture.h
+
+    Record the video output of the system emulators to disk on a
+    background thread.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    ~~~C
+    CAPTURE_MAX_SLOTS
+    ~~~
+        the max number of frames in the ring buffer (default: 64)
+
+    ~~~C
+    CAPTURE_MAX_WIDTH
+    ~~~
+        the max width of a captured frame in pixels (default: 1024)
+
+    Include the following headers before including capture.h:
+
+    - chips/chips_common.h
+
+    On Windows, the Win32 threading API is used, everywhere else pthreads
+    (link with -pthread). Define CAPTURE_NO_THREADS to compile without
+    threading support, frames will then be written to disk on the calling
+    thread.
+
+    ## Overview
+
+    capture_frame() copies the visible screen rectangle of a
+    chips_display_info_t (the indexed or RGBA8 pixels and the color palette)
+    into a ring buffer of frame slots, and a writer thread encodes the
+    frames from the ring buffer to a file. The emulator thread never waits
+    for a frame to be written: if the ring buffer is full (because the disk
+    can't keep up), the frame is dropped and counted instead. The ring
+    buffer lives in a user-provided memory block, capture.h doesn't
+    allocate memory.
+
+    Since capture_frame() is called by the host after *_exec() returns,
+    recording doesn't change the emulation itself, and the only cost on
+    the emulator thread is copying the frame into the ring buffer.
+
+    ## Usage
+
+    Compute the size of one frame slot from the system's display info with
+    CAPTURE_SLOT_SIZE(), and provide a memory block for a few frames (at
+    least 2, more frames absorb longer disk stalls):
+
+    ~~~C
+    chips_display_info_t info = cpc_display_info(&sys);
+    static uint8_t buf[16 * CAPTURE_SLOT_SIZE(768, 272, 1)];
+    static capture_t cap;
+    if (!capture_init(&cap, &(capture_desc_t){
+        .path = "attract.y4m",
+        .format = CAPTURE_FORMAT_Y4M,
+        .display = info,
+        .fps = 50,
+        .buffer = { .ptr = buf, .size = sizeof(buf) },
+    })) {
+        // failed to open output file
+    }
+    ~~~
+
+    After each emulated frame, push the display info into the capture:
+
+    ~~~C
+    cpc_exec(&sys, micro_seconds);
+    capture_frame(&cap, &cpc_display_info(&sys));
+    ~~~
+
+    capture_frame() returns false if the frame was dropped because the
+    ring buffer is full, or because the screen rectangle doesn't match
+    the size passed to capture_init() (for instance while the CPC debug
+    visualization is active). The number of written and dropped frames
+    can be inspected with:
+
+    ~~~C
+    uint32_t capture_num_written(capture_t* cap);
+    uint32_t capture_num_dropped(capture_t* cap);
+    ~~~
+
+    Finally call capture_discard() to write the remaining frames, stop the
+    writer thread and close the file. capture_discard() returns false if
+    writing to the file failed.
+
+    ## File Formats
+
+    **CAPTURE_FORMAT_Y4M** writes uncompressed YUV4MPEG2 video with 8-bit
+    4:4:4 planes (BT.601 limited range), this can be read directly by
+    ffmpeg, mpv and most other video tools:
+
+    ~~~
+    ffmpeg -i attract.y4m -c:v libx264 attract.mp4
+    ~~~
+
+    **CAPTURE_FORMAT_RLE** writes the frames losslessly as run-length
+    encoded pixels. Emulator frames have long horizontal runs of the same
+    color, so this is usually much smaller than Y4M. All values are
+    little-endian:
+
+    - file header: the 4 bytes 'CRLE', followed by the frame width, height
+      and bytes per pixel (1 or 4) as uint32_t
+    - for each frame: the number of palette entries as uint32_t (0 for
+      RGBA8 frames), the RGBA8 palette entries as uint32_t, and for each row
+      of pixels a sequence of runs, each run is a uint8_t run length (1..255)
+      followed by the pixel value (bytes-per-pixel bytes), runs don't
+      continue across rows
+
+    The portrait flag of the display info is ignored.
+
+    ## zlib/libpng license
+
+    Copyright (c) 2018 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdalign.h>
+#include <stdio.h>
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__) && !defined(CAPTURE_NO_THREADS)
+#define CAPTURE_NO_THREADS
+#endif
+#if !defined(CAPTURE_NO_THREADS)
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CAPTURE_MAX_SLOTS
+#define CAPTURE_MAX_SLOTS (64)
+#endif
+#ifndef CAPTURE_MAX_WIDTH
+#define CAPTURE_MAX_WIDTH (1024)
+#endif
+
+// size of the palette stored with each frame
+#define CAPTURE_PALETTE_SIZE (256 * 4)
+// size of one frame slot in the ring buffer
+#define CAPTURE_SLOT_SIZE(width, height, bytes_per_pixel) ((size_t)(((CAPTURE_PALETTE_SIZE + (width) * (height) * (bytes_per_pixel)) + 63) & ~63))
+
+// output file formats
+typedef enum {
+    CAPTURE_FORMAT_Y4M,     // uncompressed YUV4MPEG2 (4:4:4)
+    CAPTURE_FORMAT_RLE,     // run-length encoded indexed or RGBA8 pixels
+} capture_format_t;
+
+// setup parameters for capture_init()
+typedef struct {
+    const char* path;               // output file path
+    capture_format_t format;        // output file format
+    chips_display_info_t display;   // display info of the recorded system (defines the frame size)
+    int fps;                        // frame rate for the Y4M header (default: 50)
+    chips_range_t buffer;           // memory block for the ring buffer, at least 2 frame slots
+} capture_desc_t;
+
+// capture state
+typedef struct {
+    capture_format_t format;
+    int width;
+    int height;
+    int bytes_per_pixel;
+    int fps;
+    int num_slots;
+    size_t slot_size;
+    uint8_t* slots;
+    FILE* fp;
+    alignas(64) volatile uint32_t write_count;  // frames pushed by capture_frame()
+    alignas(64) volatile uint32_t read_count;   // frames written by the writer thread
+    volatile uint32_t num_written;
+    uint32_t num_dropped;
+    bool io_error;
+    #if !defined(CAPTURE_NO_THREADS)
+    #if defined(_WIN32)
+    HANDLE thread;
+    SRWLOCK lock;
+    CONDITION_VARIABLE cond;
+    #else
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    #endif
+    #endif
+    bool quit;
+    bool valid;
+    uint8_t yuv[256][3];                        // palette converted to YCbCr
+    uint8_t row[CAPTURE_MAX_WIDTH * 5];         // encoding buffer for one row
+} capture_t;
+
+// open the output file and start the writer thread, returns false if the file can't be created
+bool capture_init(capture_t* cap, const capture_desc_t* desc);
+// write remaining frames, stop the writer thread and close the file, returns false on write errors
+bool capture_discard(capture_t* cap);
+// copy a frame into the ring buffer, returns false if the frame was dropped
+bool capture_frame(capture_t* cap, const chips_display_info_t* info);
+// get the number of frames written to the file
+uint32_t capture_num_written(capture_t* cap);
+// get the number of dropped frames
+uint32_t capture_num_dropped(capture_t* cap);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define _CAPTURE_LOAD(ptr)          ((uint32_t)_InterlockedOr((volatile long*)(ptr), 0))
+#define _CAPTURE_STORE(ptr, val)    _InterlockedExchange((volatile long*)(ptr), (long)(val))
+#else
+#define _CAPTURE_LOAD(ptr)          __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define _CAPTURE_STORE(ptr, val)    __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#endif
+
+static void _capture_write(capture_t* cap, const void* ptr, size_t num_bytes) {
+    if (!cap->io_error && (fwrite(ptr, 1, num_bytes, cap->fp) != num_bytes)) {
+        cap->io_error = true;
+    }
+}
+
+static void _capture_write_u32(capture_t* cap, uint32_t val) {
+    const uint8_t bytes[4] = { (uint8_t)val, (uint8_t)(val >> 8), (uint8_t)(val >> 16), (uint8_t)(val >> 24) };
+    _capture_write(cap, bytes, sizeof(bytes));
+}
+
+static void _capture_rgb_to_yuv(uint32_t rgba, uint8_t* yuv) {
+    const int r = (int)(rgba & 0xFF);
+    const int g = (int)((rgba >> 8) & 0xFF);
+    const int b = (int)((rgba >> 16) & 0xFF);
+    yuv[0] = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+    yuv[1] = (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+    yuv[2] = (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+static void _capture_write_header(capture_t* cap) {
+    if (cap->format == CAPTURE_FORMAT_Y4M) {
+        if (fprintf(cap->fp, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", cap->width, cap->height, cap->fps) < 0) {
+            cap->io_error = true;
+        }
+    }
+    else {
+        _capture_write(cap, "CRLE", 4);
+        _capture_write_u32(cap, (uint32_t)cap->width);
+        _capture_write_u32(cap, (uint32_t)cap->height);
+        _capture_write_u32(cap, (uint32_t)cap->bytes_per_pixel);
+    }
+}
+
+static void _capture_encode_y4m(capture_t* cap, const uint8_t* slot) {
+    const uint8_t* pixels = slot + CAPTURE_PALETTE_SIZE;
+    const size_t num_pixels = (size_t)cap->width;
+    if (cap->bytes_per_pixel == 1) {
+        for (int i = 0; i < 256; i++) {
+            const uint8_t* p = slot + i * 4;
+            _capture_rgb_to_yuv((uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16), cap->yuv[i]);
+        }
+    }
+    _capture_write(cap, "FRAME\n", 6);
+    for (int plane = 0; plane < 3; plane++) {
+        const uint8_t* src = pixels;
+        for (int y = 0; y < cap->height; y++) {
+            if (cap->bytes_per_pixel == 1) {
+                for (size_t x = 0; x < num_pixels; x++) {
+                    cap->row[x] = cap->yuv[*src++][plane];
+                }
+            }
+            else {
+                for (size_t x = 0; x < num_pixels; x++, src += 4) {
+                    uint8_t yuv[3];
+                    _capture_rgb_to_yuv((uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16), yuv);
+                    cap->row[x] = yuv[plane];
+                }
+            }
+            _capture_write(cap, cap->row, num_pixels);
+        }
+    }
+}
+
+static void _capture_encode_rle(capture_t* cap, const uint8_t* slot) {
+    const size_t bpp = (size_t)cap->bytes_per_pixel;
+    if (bpp == 1) {
+        _capture_write_u32(cap, 256);
+        _capture_write(cap, slot, CAPTURE_PALETTE_SIZE);
+    }
+    else {
+        _capture_write_u32(cap, 0);
+    }
+    const uint8_t* src = slot + CAPTURE_PALETTE_SIZE;
+    for (int y = 0; y < cap->height; y++) {
+        size_t pos = 0;
+        int x = 0;
+        while (x < cap->width) {
+            int run = 1;
+            while ((run < 255) && ((x + run) < cap->width) && (0 == memcmp(src + (size_t)(x + run) * bpp, src + (size_t)x * bpp, bpp))) {
+                run++;
+            }
+            cap->row[pos++] = (uint8_t)run;
+            memcpy(&cap->row[pos], src + (size_t)x * bpp, bpp);
+            pos += bpp;
+            x += run;
+        }
+        _capture_write(cap, cap->row, pos);
+        src += (size_t)cap->width * bpp;
+    }
+}
+
+static void _capture_encode(capture_t* cap, uint32_t index) {
+    const uint8_t* slot = cap->slots + (index % (uint32_t)cap->num_slots) * cap->slot_size;
+    if (cap->format == CAPTURE_FORMAT_Y4M) {
+        _capture_encode_y4m(cap, slot);
+    }
+    else {
+        _capture_encode_rle(cap, slot);
+    }
+    if (!cap->io_error) {
+        _CAPTURE_STORE(&cap->num_written, cap->num_written + 1);
+    }
+}
+
+#if !defined(CAPTURE_NO_THREADS)
+/* capture_frame() publishes write_count and signals the writer thread
+    while holding the lock, so the update can't slip in between the writer
+    thread checking write_count and going to sleep; the writer thread never
+    holds the lock while encoding, so the emulator thread only waits for
+    the short check in _capture_writer_loop()
+*/
+#if defined(_WIN32)
+#define _capture_lock(c)        AcquireSRWLockExclusive(&(c)->lock)
+#define _capture_unlock(c)      ReleaseSRWLockExclusive(&(c)->lock)
+#define _capture_wait(c)        SleepConditionVariableSRW(&(c)->cond, &(c)->lock, INFINITE, 0)
+#define _capture_signal(c)      WakeConditionVariable(&(c)->cond)
+#else
+#define _capture_lock(c)        pthread_mutex_lock(&(c)->lock)
+#define _capture_unlock(c)      pthread_mutex_unlock(&(c)->lock)
+#define _capture_wait(c)        pthread_cond_wait(&(c)->cond, &(c)->lock)
+#define _capture_signal(c)      pthread_cond_signal(&(c)->cond)
+#endif
+
+static void _capture_writer_loop(capture_t* cap) {
+    while (true) {
+        const uint32_t read_count = cap->read_count;
+        _capture_lock(cap);
+        while (!cap->quit && (read_count == _CAPTURE_LOAD(&cap->write_count))) {
+            _capture_wait(cap);
+        }
+        const bool quit = cap->quit;
+        _capture_unlock(cap);
+        // write all pending frames before checking for quit
+        const uint32_t write_count = _CAPTURE_LOAD(&cap->write_count);
+        if (read_count != write_count) {
+            _capture_encode(cap, read_count);
+            _CAPTURE_STORE(&cap->read_count, read_count + 1);
+        }
+        else if (quit) {
+            break;
+        }
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI _capture_writer_func(LPVOID arg) {
+    _capture_writer_loop((capture_t*)arg);
+    return 0;
+}
+#else
+static void* _capture_writer_func(void* arg) {
+    _capture_writer_loop((capture_t*)arg);
+    return 0;
+}
+#endif
+#endif // CAPTURE_NO_THREADS
+
+bool capture_init(capture_t* cap, const capture_desc_t* desc) {
+    CHIPS_ASSERT(cap && desc && desc->path && desc->buffer.ptr);
+    const chips_display_info_t* info = &desc->display;
+    CHIPS_ASSERT((info->frame.bytes_per_pixel == 1) || (info->frame.bytes_per_pixel == 4));
+    CHIPS_ASSERT((info->screen.width > 0) && (info->screen.width <= CAPTURE_MAX_WIDTH) && (info->screen.height > 0));
+    memset(cap, 0, sizeof(capture_t));
+    cap->format = desc->format;
+    cap->width = info->screen.width;
+    cap->height = info->screen.height;
+    cap->bytes_per_pixel = (int)info->frame.bytes_per_pixel;
+    cap->fps = (desc->fps > 0) ? desc->fps : 50;
+    cap->slot_size = CAPTURE_SLOT_SIZE(cap->width, cap->height, cap->bytes_per_pixel);
+    cap->num_slots = (int)(desc->buffer.size / cap->slot_size);
+    if (cap->num_slots > CAPTURE_MAX_SLOTS) {
+        cap->num_slots = CAPTURE_MAX_SLOTS;
+    }
+    CHIPS_ASSERT(cap->num_slots >= 2);
+    cap->slots = (uint8_t*)desc->buffer.ptr;
+    cap->fp = fopen(desc->path, "wb");
+    if (!cap->fp) {
+        return false;
+    }
+    _capture_write_header(cap);
+    #if !defined(CAPTURE_NO_THREADS)
+    #if defined(_WIN32)
+    InitializeSRWLock(&cap->lock);
+    InitializeConditionVariable(&cap->cond);
+    cap->thread = CreateThread(0, 0, _capture_writer_func, cap, 0, 0);
+    CHIPS_ASSERT(cap->thread);
+    #else
+    pthread_mutex_init(&cap->lock, 0);
+    pthread_cond_init(&cap->cond, 0);
+    int res = pthread_create(&cap->thread, 0, _capture_writer_func, cap);
+    CHIPS_ASSERT(0 == res); (void)res;
+    #endif
+    #endif
+    cap->valid = true;
+    return true;
+}
+
+bool capture_discard(capture_t* cap) {
+    CHIPS_ASSERT(cap && cap->valid);
+    #if !defined(CAPTURE_NO_THREADS)
+    _capture_lock(cap);
+    cap->quit = true;
+    _capture_signal(cap);
+    _capture_unlock(cap);
+    #if defined(_WIN32)
+    WaitForSingleObject(cap->thread, INFINITE);
+    CloseHandle(cap->thread);
+    #else
+    pthread_join(cap->thread, 0);
+    pthread_cond_destroy(&cap->cond);
+    pthread_mutex_destroy(&cap->lock);
+    #endif
+    #endif
+    if (0 != fclose(cap->fp)) {
+        cap->io_error = true;
+    }
+    cap->fp = 0;
+    cap->valid = false;
+    return !cap->io_error;
+}
+
+bool capture_frame(capture_t* cap, const chips_display_info_t* info) {
+    CHIPS_ASSERT(cap && cap->valid && info && info->frame.buffer.ptr);
+    if ((info->screen.width != cap->width) ||
+        (info->screen.height != cap->height) ||
+        ((int)info->frame.bytes_per_pixel != cap->bytes_per_pixel))
+    {
+        cap->num_dropped++;
+        return false;
+    }
+    // only the emulator thread writes write_count, only the writer thread writes read_count
+    const uint32_t write_count = cap->write_count;
+    if ((write_count - _CAPTURE_LOAD(&cap->read_count)) >= (uint32_t)cap->num_slots) {
+        cap->num_dropped++;
+        return false;
+    }
+    uint8_t* slot = cap->slots + (write_count % (uint32_t)cap->num_slots) * cap->slot_size;
+    size_t pal_size = info->palette.size;
+    if (pal_size > CAPTURE_PALETTE_SIZE) {
+        pal_size = CAPTURE_PALETTE_SIZE;
+    }
+    if (info->palette.ptr && (pal_size > 0)) {
+        memcpy(slot, info->palette.ptr, pal_size);
+    }
+    memset(slot + pal_size, 0, CAPTURE_PALETTE_SIZE - pal_size);
+    const size_t bpp = info->frame.bytes_per_pixel;
+    const size_t pitch = (size_t)info->frame.dim.width * bpp;
+    const size_t row_size = (size_t)cap->width * bpp;
+    const uint8_t* src = (const uint8_t*)info->frame.buffer.ptr + (size_t)info->screen.y * pitch + (size_t)info->screen.x * bpp;
+    uint8_t* dst = slot + CAPTURE_PALETTE_SIZE;
+    for (int y = 0; y < cap->height; y++, src += pitch, dst += row_size) {
+        memcpy(dst, src, row_size);
+    }
+    #if defined(CAPTURE_NO_THREADS)
+    _capture_encode(cap, write_count);
+    cap->write_count = write_count + 1;
+    cap->read_count = write_count + 1;
+    #else
+    // publish and signal under the lock, otherwise the wakeup may get lost
+    _capture_lock(cap);
+    _CAPTURE_STORE(&cap->write_count, write_count + 1);
+    _capture_signal(cap);
+    _capture_unlock(cap);
+    #endif
+    return true;
+}
+
+uint32_t capture_num_written(capture_t* cap) {
+    CHIPS_ASSERT(cap);
+    return _CAPTURE_LOAD(&cap->num_written);
+}
+
+uint32_t capture_num_dropped(capture_t* cap) {
+    CHIPS_ASSERT(cap);
+    return cap->num_dropped;
+}
+
+#endif // CHIPS_UTIL_IMPL
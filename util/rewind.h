@@ -0,0 +1,418 @@
+#pragma once
+/*#
+    # rewind.h
+
+    A compressed ring buffer of system snapshots with a fixed memory budget.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    ~~~C
+    REWIND_MAX_SNAPSHOTS
+    ~~~
+        the max number of snapshots in the ring buffer (default: 4096)
+
+    Include the following headers before including rewind.h:
+
+    - chips/chips_common.h
+
+    ## Overview
+
+    rewind.h stores the snapshots created by the *_save_snapshot() functions
+    of the system emulators in a ring buffer, when the ring buffer is full,
+    the oldest snapshots are dropped. The ring buffer lives in a
+    user-provided memory block, rewind.h doesn't allocate memory.
+
+    Snapshots are compressed by XOR-ing them against a 'key snapshot'
+    and run-length-encoding the resulting zero-bytes. Since most of the
+    system state doesn't change between snapshots, a compressed snapshot
+    is usually only a few KBytes. Every Nth snapshot is a key snapshot
+    (which is compressed by run-length-encoding its zero-bytes), and the
+    following snapshots are compressed against that key snapshot.
+
+    Restoring any snapshot in the ring buffer takes constant time (the
+    snapshot is found via an index, and at most two snapshots need to be
+    decompressed: the key snapshot and the snapshot itself).
+
+    ## Usage
+
+    Initialize a rewind_t instance with a memory block, the size of a
+    system snapshot, and optionally the number of snapshots between key
+    snapshots (default: 16):
+
+    ~~~C
+    static rewind_t rw;
+    static uint8_t rewind_buffer[64 * 1024 * 1024];
+    rewind_init(&rw, &(rewind_desc_t){
+        .buffer = { .ptr = rewind_buffer, .size = sizeof(rewind_buffer) },
+        .snapshot_size = sizeof(zx_t),
+    });
+    ~~~
+
+    The memory block must be big enough for at least two uncompressed
+    snapshots (one is used as scratch buffer for the current key
+    snapshot).
+
+    Push a new snapshot into the ring buffer, for instance every Nth frame:
+
+    ~~~C
+    static zx_t snapshot;
+    if ((frame_count % 10) == 0) {
+        uint32_t version = zx_save_snapshot(&sys, &snapshot);
+        rewind_push(&rw, &snapshot, version);
+    }
+    ~~~
+
+    Query the number of snapshots in the ring buffer with:
+
+    ~~~C
+    int rewind_num_snapshots(rewind_t* rw)
+    ~~~
+
+    To restore a snapshot, decompress it with rewind_get() into a
+    snapshot buffer, and load it into the system with *_load_snapshot(),
+    the snapshot index is in the range 0 (oldest snapshot) to
+    rewind_num_snapshots() - 1 (newest snapshot):
+
+    ~~~C
+    static zx_t im;
+    uint32_t version = rewind_get(&rw, index, &im);
+    zx_load_snapshot(&sys, version, &im);
+    ~~~
+
+    When the emulation continues from a restored snapshot, call
+    rewind_truncate() to drop all snapshots after that snapshot, so
+    that they are replaced by the new 'timeline':
+
+    ~~~C
+    rewind_truncate(&rw, index);
+    ~~~
+
+    To get the number of bytes used by compressed snapshots:
+
+    ~~~C
+    size_t rewind_used_bytes(rewind_t* rw)
+    ~~~
+
+    ## zlib/libpng license
+
+    Copyright (c) 2018 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef REWIND_MAX_SNAPSHOTS
+#define REWIND_MAX_SNAPSHOTS (4096)
+#endif
+#define REWIND_DEFAULT_KEY_INTERVAL (16)
+
+// config parameters for rewind_init()
+typedef struct {
+    chips_range_t buffer;   // memory block for the ring buffer (required)
+    size_t snapshot_size;   // size of a system snapshot in bytes (required)
+    int key_interval;       // number of snapshots between key snapshots (default: 16)
+} rewind_desc_t;
+
+// a compressed snapshot in the ring buffer
+typedef struct {
+    size_t offset;          // offset into ring buffer
+    size_t size;            // compressed size in bytes
+    uint32_t key_seq;       // sequence number of the key snapshot
+    uint32_t version;       // snapshot version returned by *_save_snapshot()
+} rewind_item_t;
+
+// rewind ring buffer state
+typedef struct {
+    uint8_t* key;           // scratch buffer with the uncompressed current key snapshot
+    uint8_t* data;          // start of the ring buffer
+    size_t data_size;
+    size_t snapshot_size;
+    size_t max_item_size;   // worst-case size of a compressed snapshot
+    size_t pos;             // current write position in the ring buffer
+    size_t used_bytes;
+    int key_interval;
+    bool key_valid;         // false if next snapshot must be a key snapshot
+    uint32_t key_seq;       // sequence number of current key snapshot
+    uint32_t head_seq;      // sequence number of oldest snapshot
+    uint32_t tail_seq;      // sequence number of next snapshot
+    rewind_item_t items[REWIND_MAX_SNAPSHOTS];
+    bool valid;
+} rewind_t;
+
+// initialize a rewind ring buffer
+void rewind_init(rewind_t* rw, const rewind_desc_t* desc);
+// discard a rewind ring buffer
+void rewind_discard(rewind_t* rw);
+// compress and push a snapshot, dropping the oldest snapshots if needed
+void rewind_push(rewind_t* rw, const void* snapshot, uint32_t version);
+// get the number of snapshots in the ring buffer
+int rewind_num_snapshots(rewind_t* rw);
+// decompress a snapshot (0 is oldest), returns the snapshot version
+uint32_t rewind_get(rewind_t* rw, int index, void* dst_snapshot);
+// drop all snapshots after a snapshot index
+void rewind_truncate(rewind_t* rw, int index);
+// drop all snapshots
+void rewind_clear(rewind_t* rw);
+// get number of bytes used by compressed snapshots
+size_t rewind_used_bytes(rewind_t* rw);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+/*
+    Compressed snapshot format: a sequence of (zero_run, literal_len, literal_bytes)
+    where zero_run and literal_len are LEB128 encoded. Zero-runs shorter than
+    _REWIND_MIN_ZERO_RUN are merged into literals, this guarantees that the
+    compressed size is at most the uncompressed size plus one run header.
+*/
+#define _REWIND_MIN_ZERO_RUN (16)
+#define _REWIND_MAX_RUN_HEADER (10)
+
+static uint8_t* _rewind_put_len(uint8_t* dst, size_t len) {
+    do {
+        uint8_t b = len & 0x7F;
+        len >>= 7;
+        *dst++ = b | (len ? 0x80 : 0);
+    } while (len);
+    return dst;
+}
+
+static const uint8_t* _rewind_get_len(const uint8_t* src, size_t* len) {
+    size_t val = 0;
+    int shift = 0;
+    uint8_t b;
+    do {
+        b = *src++;
+        val |= (size_t)(b & 0x7F) << shift;
+        shift += 7;
+    } while (b & 0x80);
+    *len = val;
+    return src;
+}
+
+// XOR snapshot against key (or zero if key is null) and compress, returns compressed size
+static size_t _rewind_encode(uint8_t* dst, const uint8_t* src, const uint8_t* key, size_t size) {
+    uint8_t* out = dst;
+    size_t pos = 0;
+    while (pos < size) {
+        // count zero bytes
+        size_t zero_start = pos;
+        if (key) {
+            while ((pos < size) && (src[pos] == key[pos])) {
+                pos++;
+            }
+        }
+        else {
+            while ((pos < size) && (src[pos] == 0)) {
+                pos++;
+            }
+        }
+        const size_t zero_run = pos - zero_start;
+        // find end of literal, short zero runs become part of the literal
+        const size_t lit_start = pos;
+        size_t zeros = 0;
+        while ((pos < size) && (zeros < _REWIND_MIN_ZERO_RUN)) {
+            const uint8_t x = key ? (src[pos] ^ key[pos]) : src[pos];
+            zeros = (x == 0) ? (zeros + 1) : 0;
+            pos++;
+        }
+        if (zeros == _REWIND_MIN_ZERO_RUN) {
+            pos -= zeros;
+        }
+        const size_t lit_len = pos - lit_start;
+        out = _rewind_put_len(out, zero_run);
+        out = _rewind_put_len(out, lit_len);
+        for (size_t i = 0; i < lit_len; i++) {
+            out[i] = key ? (src[lit_start + i] ^ key[lit_start + i]) : src[lit_start + i];
+        }
+        out += lit_len;
+    }
+    return (size_t)(out - dst);
+}
+
+// decompress and XOR into dst
+static void _rewind_decode(uint8_t* dst, const uint8_t* src, size_t src_size) {
+    const uint8_t* end = src + src_size;
+    while (src < end) {
+        size_t zero_run, lit_len;
+        src = _rewind_get_len(src, &zero_run);
+        src = _rewind_get_len(src, &lit_len);
+        dst += zero_run;
+        for (size_t i = 0; i < lit_len; i++) {
+            dst[i] ^= src[i];
+        }
+        dst += lit_len;
+        src += lit_len;
+    }
+}
+
+static rewind_item_t* _rewind_item(rewind_t* rw, uint32_t seq) {
+    return &rw->items[seq % REWIND_MAX_SNAPSHOTS];
+}
+
+// drop the oldest key snapshot and all snapshots depending on it
+static void _rewind_drop_oldest(rewind_t* rw) {
+    CHIPS_ASSERT(rw->head_seq != rw->tail_seq);
+    const uint32_t key_seq = _rewind_item(rw, rw->head_seq)->key_seq;
+    while ((rw->head_seq != rw->tail_seq) && (_rewind_item(rw, rw->head_seq)->key_seq == key_seq)) {
+        rw->used_bytes -= _rewind_item(rw, rw->head_seq)->size;
+        rw->head_seq++;
+    }
+    if (key_seq == rw->key_seq) {
+        rw->key_valid = false;
+    }
+}
+
+void rewind_init(rewind_t* rw, const rewind_desc_t* desc) {
+    CHIPS_ASSERT(rw && desc);
+    CHIPS_ASSERT(desc->buffer.ptr && (desc->snapshot_size > 0));
+    memset(rw, 0, sizeof(rewind_t));
+    rw->valid = true;
+    rw->snapshot_size = desc->snapshot_size;
+    rw->max_item_size = desc->snapshot_size + 2 * _REWIND_MAX_RUN_HEADER;
+    rw->key_interval = (desc->key_interval > 0) ? desc->key_interval : REWIND_DEFAULT_KEY_INTERVAL;
+    // the first part of the buffer is the key snapshot scratch buffer
+    const size_t key_size = (desc->snapshot_size + 7) & ~(size_t)7;
+    CHIPS_ASSERT(desc->buffer.size >= (key_size + rw->max_item_size));
+    rw->key = (uint8_t*) desc->buffer.ptr;
+    rw->data = rw->key + key_size;
+    rw->data_size = desc->buffer.size - key_size;
+}
+
+void rewind_discard(rewind_t* rw) {
+    CHIPS_ASSERT(rw && rw->valid);
+    rw->valid = false;
+}
+
+void rewind_clear(rewind_t* rw) {
+    CHIPS_ASSERT(rw && rw->valid);
+    rw->head_seq = rw->tail_seq;
+    rw->pos = 0;
+    rw->used_bytes = 0;
+    rw->key_valid = false;
+}
+
+void rewind_push(rewind_t* rw, const void* snapshot, uint32_t version) {
+    CHIPS_ASSERT(rw && rw->valid && snapshot);
+    if ((rw->tail_seq - rw->head_seq) == REWIND_MAX_SNAPSHOTS) {
+        _rewind_drop_oldest(rw);
+    }
+    // make room for a worst-case compressed snapshot at the write position
+    size_t pos = rw->pos;
+    if ((pos + rw->max_item_size) > rw->data_size) {
+        // not enough room at the end of the buffer, wrap around and
+        // drop the snapshots at the end of the buffer
+        while ((rw->head_seq != rw->tail_seq) && (_rewind_item(rw, rw->head_seq)->offset >= pos)) {
+            _rewind_drop_oldest(rw);
+        }
+        pos = 0;
+    }
+    while (rw->head_seq != rw->tail_seq) {
+        const rewind_item_t* oldest = _rewind_item(rw, rw->head_seq);
+        if ((oldest->offset >= pos) && (oldest->offset < (pos + rw->max_item_size))) {
+            _rewind_drop_oldest(rw);
+        }
+        else {
+            break;
+        }
+    }
+    // compress as key snapshot, or against current key snapshot
+    const bool is_key = !rw->key_valid || ((rw->tail_seq - rw->key_seq) >= (uint32_t)rw->key_interval);
+    if (is_key) {
+        memcpy(rw->key, snapshot, rw->snapshot_size);
+        rw->key_seq = rw->tail_seq;
+        rw->key_valid = true;
+    }
+    rewind_item_t* item = _rewind_item(rw, rw->tail_seq++);
+    item->offset = pos;
+    item->size = _rewind_encode(rw->data + pos, (const uint8_t*)snapshot, is_key ? 0 : rw->key, rw->snapshot_size);
+    item->key_seq = rw->key_seq;
+    item->version = version;
+    CHIPS_ASSERT(item->size <= rw->max_item_size);
+    rw->used_bytes += item->size;
+    rw->pos = pos + item->size;
+}
+
+int rewind_num_snapshots(rewind_t* rw) {
+    CHIPS_ASSERT(rw && rw->valid);
+    return (int)(rw->tail_seq - rw->head_seq);
+}
+
+size_t rewind_used_bytes(rewind_t* rw) {
+    CHIPS_ASSERT(rw && rw->valid);
+    return rw->used_bytes;
+}
+
+uint32_t rewind_get(rewind_t* rw, int index, void* dst_snapshot) {
+    CHIPS_ASSERT(rw && rw->valid && dst_snapshot);
+    CHIPS_ASSERT((index >= 0) && (index < rewind_num_snapshots(rw)));
+    const uint32_t seq = rw->head_seq + (uint32_t)index;
+    const rewind_item_t* item = _rewind_item(rw, seq);
+    const rewind_item_t* key_item = _rewind_item(rw, item->key_seq);
+    uint8_t* dst = (uint8_t*) dst_snapshot;
+    memset(dst, 0, rw->snapshot_size);
+    _rewind_decode(dst, rw->data + key_item->offset, key_item->size);
+    if (seq != item->key_seq) {
+        _rewind_decode(dst, rw->data + item->offset, item->size);
+    }
+    return item->version;
+}
+
+void rewind_truncate(rewind_t* rw, int index) {
+    CHIPS_ASSERT(rw && rw->valid);
+    CHIPS_ASSERT((index >= 0) && (index < rewind_num_snapshots(rw)));
+    const uint32_t new_tail_seq = rw->head_seq + (uint32_t)index + 1;
+    while (rw->tail_seq != new_tail_seq) {
+        rw->tail_seq--;
+        rw->used_bytes -= _rewind_item(rw, rw->tail_seq)->size;
+    }
+    const rewind_item_t* newest = _rewind_item(rw, rw->tail_seq - 1);
+    rw->pos = newest->offset + newest->size;
+    // restore the scratch copy of the newest key snapshot
+    const rewind_item_t* key_item = _rewind_item(rw, newest->key_seq);
+    memset(rw->key, 0, rw->snapshot_size);
+    _rewind_decode(rw->key, rw->data + key_item->offset, key_item->size);
+    rw->key_seq = newest->key_seq;
+    rw->key_valid = true;
+}
+
+#endif // CHIPS_UTIL_IMPL
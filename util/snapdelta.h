@@ -0,0 +1,451 @@
+#pragma once
+/*#
+    # snapdelta.h
+
+    Delta snapshots for the system emulators, driven by the dirty-page
+    tracking in mem.h.
+
+    Do this:
+    ~~~C
+    #define CHIPS_UTIL_IMPL
+    ~~~
+    before you include this file in *one* C or C++ file to create the
+    implementation.
+
+    Optionally provide the following macros with your own implementation
+
+    ~~~C
+    CHIPS_ASSERT(c)
+    ~~~
+        your own assert macro (default: assert(c))
+
+    Include the following headers before including snapdelta.h:
+
+    - chips/mem.h
+
+    ## Overview
+
+    A delta only stores the parts of a system's state (for instance a zx_t,
+    c64_t or cpc_t) which have changed since the previous delta. Since
+    most of the system state between two deltas is unchanged (ROM, most
+    of the RAM), a delta is typically only a few KBytes, compared to a few
+    hundred KBytes for a complete snapshot.
+
+    The encoder writes a snapshot of the running system into a 'scratch'
+    buffer with the system's *_save_snapshot() function, and uses the
+    dirty-page bitmaps of the system's mem_t memory maps (see mem.h) to
+    find the 1 KByte pages of emulator RAM which have been written since
+    the previous delta, RAM pages which haven't been written are skipped
+    without looking at them. Only the rest of the snapshot (CPU and chip
+    state, framebuffer, ...) is compared in 1 KByte blocks against a
+    'shadow' copy of the previous state. The shadow copy is provided by
+    the host and is updated by the encoder.
+
+    Apart from clearing the dirty-page bitmaps, the encoder doesn't modify
+    the running system, and since the deltas are computed from snapshots
+    (with the internal pointers converted to offsets, and host pointers
+    cleared), restoring the system state from a base snapshot and a chain
+    of deltas produces the same result as *_save_snapshot().
+
+    Deltas, the scratch buffer and the shadow copy are stored in
+    user-provided memory, snapdelta.h never allocates memory.
+
+    ## Usage
+
+    Take a complete base snapshot, setup a snapdelta_t encoder and start
+    the delta chain with snapdelta_begin():
+
+    ~~~C
+    static zx_t base;
+    static zx_t scratch;
+    static zx_t shadow;
+    static snapdelta_t sd;
+
+    static uint32_t save_snapshot(void* sys, void* dst) {
+        return zx_save_snapshot((zx_t*)sys, (zx_t*)dst);
+    }
+
+    uint32_t version = zx_save_snapshot(&sys, &base);
+    snapdelta_init(&sd, &(snapdelta_desc_t){
+        .sys = &sys,
+        .sys_size = sizeof(zx_t),
+        .save_snapshot = save_snapshot,
+        .mem = { &sys.mem },
+        .ram = { { .ptr = sys.ram, .size = sizeof(sys.ram) } },
+        .scratch = &scratch,
+        .shadow = &shadow,
+    });
+    snapdelta_begin(&sd, &base);
+    ~~~
+
+    The mem_t pointers must point to all memory maps embedded in the
+    system struct (for instance the C64 has two: mem_cpu and mem_vic).
+    The RAM ranges describe the emulator RAM in the system struct which
+    is only written through the memory maps, and which is mapped in
+    1 KByte steps from the start of the range. Memory which is written
+    directly by the system emulator (for instance the C64 color RAM) must
+    not be part of a RAM range, this is compared with the shadow copy
+    like the rest of the system state.
+
+    Then, for instance once per frame, encode the changes since the
+    previous delta into a delta buffer:
+
+    ~~~C
+    static uint8_t delta[SNAPDELTA_MAX_SIZE(sizeof(zx_t))];
+    size_t delta_size = snapdelta_encode(&sd, delta, sizeof(delta));
+    ~~~
+
+    The delta buffer must be at least SNAPDELTA_MAX_SIZE(sys_size) bytes.
+    snapdelta_encode() clears the dirty-page bitmaps of the memory maps.
+    If a written page has been mapped to different host memory since the
+    previous delta (see mem_dirty_remapped() in mem.h), the encoder falls
+    back to comparing the RAM ranges with the shadow copy.
+
+    Note that the encoder only sees RAM writes which go through mem_wr()
+    (or mem_layer_wr()) while the RAM is mapped. If the host writes
+    directly into emulator RAM (for instance with zx_quickload()), or
+    loads a snapshot into the running system, start a new delta chain
+    with a new base snapshot and snapdelta_begin().
+
+    To restore the system state at any point in the chain, copy the base
+    snapshot and apply the deltas in order:
+
+    ~~~C
+    static zx_t im;
+    snapdelta_restore(&im, &base, sizeof(zx_t), deltas, delta_sizes, num_deltas);
+    zx_load_snapshot(&sys, version, &im);
+    ~~~
+
+    Or apply single deltas with:
+
+    ~~~C
+    bool snapdelta_apply(void* snapshot, size_t snapshot_size, const void* delta, size_t delta_size)
+    ~~~
+
+    Applying a delta will fail (return false) if the delta doesn't match the
+    snapshot size.
+
+    The shadow copy always contains the state of the last encoded delta,
+    so it can also be passed to the *_load_snapshot() function directly.
+
+    To inspect a delta without applying it:
+
+    ~~~C
+    uint32_t snapdelta_num_chunks(const void* delta, size_t delta_size)
+    ~~~
+        Returns the number of changed memory chunks stored in the delta.
+
+    ## Delta Format
+
+    A delta starts with a 12-byte header (a magic number, the snapshot size
+    and the number of stored chunks as little-endian uint32_t), followed by
+    the changed chunks, each stored as a 32-bit byte offset and 32-bit
+    size followed by the chunk content (a chunk is at most MEM_PAGE_SIZE
+    bytes).
+
+    ## zlib/libpng license
+
+    Copyright (c) 2018 Andre Weissflog
+    This software is provided 'as-is', without any express or implied warranty.
+    In no event will the authors be held liable for any damages arising from the
+    use of this software.
+    Permission is granted to anyone to use this software for any purpose,
+    including commercial applications, and to alter it and redistribute it
+    freely, subject to the following restrictions:
+        1. The origin of this software must not be misrepresented; you must not
+        claim that you wrote the original software. If you use this software in a
+        product, an acknowledgment in the product documentation would be
+        appreciated but is not required.
+        2. Altered source versions must be plainly marked as such, and must not
+        be misrepresented as being the original software.
+        3. This notice may not be removed or altered from any source
+        distribution.
+#*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SNAPDELTA_MAGIC (0x41544C44)  // 'DLTA'
+#define SNAPDELTA_HEADER_SIZE (12)
+#define SNAPDELTA_CHUNK_HEADER_SIZE (8)
+// max number of memory maps per system
+#define SNAPDELTA_MAX_MEMS (4)
+// max number of RAM areas per system
+#define SNAPDELTA_MAX_RAM_RANGES (8)
+// worst-case number of chunks in a delta
+#define SNAPDELTA_MAX_CHUNKS(sys_size) (((sys_size)+MEM_PAGE_SIZE-1)/MEM_PAGE_SIZE+2*SNAPDELTA_MAX_RAM_RANGES+1)
+// worst-case size of an encoded delta (everything changed)
+#define SNAPDELTA_MAX_SIZE(sys_size) (SNAPDELTA_HEADER_SIZE+SNAPDELTA_MAX_CHUNKS(sys_size)*SNAPDELTA_CHUNK_HEADER_SIZE+(sys_size))
+
+// writes a snapshot of the system into dst (a wrapper around *_save_snapshot())
+typedef uint32_t (*snapdelta_save_t)(void* sys, void* dst);
+
+// a RAM area in the system struct
+typedef struct {
+    void* ptr;
+    size_t size;
+} snapdelta_range_t;
+
+typedef struct {
+    void* sys;                          // the running system (e.g. a zx_t*)
+    size_t sys_size;                    // size of the system struct (e.g. sizeof(zx_t))
+    snapdelta_save_t save_snapshot;     // writes a snapshot of the system (e.g. calls zx_save_snapshot())
+    mem_t* mem[SNAPDELTA_MAX_MEMS];     // the memory maps embedded in the system struct
+    snapdelta_range_t ram[SNAPDELTA_MAX_RAM_RANGES];   // RAM areas which are only written through the memory maps
+    void* scratch;                      // buffer of sys_size bytes for the current snapshot
+    void* shadow;                       // buffer of sys_size bytes for the previous state
+} snapdelta_desc_t;
+
+typedef struct {
+    uint32_t offset;
+    uint32_t size;
+} snapdelta_area_t;
+
+typedef struct {
+    uint8_t* sys;
+    size_t sys_size;
+    snapdelta_save_t save_snapshot;
+    uint8_t* scratch;
+    uint8_t* shadow;
+    int num_mems;
+    mem_t* mem[SNAPDELTA_MAX_MEMS];
+    int num_ram;
+    snapdelta_area_t ram[SNAPDELTA_MAX_RAM_RANGES];    // sorted by offset
+} snapdelta_t;
+
+// initialize a delta encoder
+void snapdelta_init(snapdelta_t* sd, const snapdelta_desc_t* desc);
+// start a new delta chain, base_snapshot is the complete snapshot of the current system state
+void snapdelta_begin(snapdelta_t* sd, const void* base_snapshot);
+// encode the changes since the previous delta, returns size of delta
+size_t snapdelta_encode(snapdelta_t* sd, void* dst, size_t dst_size);
+// apply a delta to a snapshot, returns false if delta is invalid
+bool snapdelta_apply(void* snapshot, size_t snapshot_size, const void* delta, size_t delta_size);
+// restore a snapshot from a base snapshot and a chain of deltas, returns false if a delta is invalid
+bool snapdelta_restore(void* dst_snapshot, const void* base_snapshot, size_t snapshot_size, const void* const* deltas, const size_t* delta_sizes, int num_deltas);
+// get the number of changed chunks in a delta
+uint32_t snapdelta_num_chunks(const void* delta, size_t delta_size);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/*-- IMPLEMENTATION ----------------------------------------------------------*/
+#ifdef CHIPS_UTIL_IMPL
+#include <string.h>
+#ifndef CHIPS_ASSERT
+    #include <assert.h>
+    #define CHIPS_ASSERT(c) assert(c)
+#endif
+
+static void _snapdelta_put32(uint8_t* ptr, uint32_t val) {
+    ptr[0] = (uint8_t)val;
+    ptr[1] = (uint8_t)(val>>8);
+    ptr[2] = (uint8_t)(val>>16);
+    ptr[3] = (uint8_t)(val>>24);
+}
+
+static uint32_t _snapdelta_get32(const uint8_t* ptr) {
+    return (uint32_t)ptr[0] | ((uint32_t)ptr[1]<<8) | ((uint32_t)ptr[2]<<16) | ((uint32_t)ptr[3]<<24);
+}
+
+void snapdelta_init(snapdelta_t* sd, const snapdelta_desc_t* desc) {
+    CHIPS_ASSERT(sd && desc);
+    CHIPS_ASSERT(desc->sys && desc->save_snapshot && desc->scratch && desc->shadow);
+    CHIPS_ASSERT((desc->sys_size > 0) && (desc->sys_size <= UINT32_MAX));
+    memset(sd, 0, sizeof(snapdelta_t));
+    sd->sys = (uint8_t*) desc->sys;
+    sd->sys_size = desc->sys_size;
+    sd->save_snapshot = desc->save_snapshot;
+    sd->scratch = (uint8_t*) desc->scratch;
+    sd->shadow = (uint8_t*) desc->shadow;
+    for (int i = 0; i < SNAPDELTA_MAX_MEMS; i++) {
+        mem_t* mem = desc->mem[i];
+        if (mem) {
+            // the memory maps must be part of the system struct
+            CHIPS_ASSERT(((uint8_t*)mem >= sd->sys) && (((uint8_t*)mem + sizeof(mem_t)) <= (sd->sys + sd->sys_size)));
+            sd->mem[sd->num_mems++] = mem;
+        }
+    }
+    for (int i = 0; i < SNAPDELTA_MAX_RAM_RANGES; i++) {
+        const uint8_t* ptr = (const uint8_t*) desc->ram[i].ptr;
+        if (ptr && (desc->ram[i].size > 0)) {
+            CHIPS_ASSERT((ptr >= sd->sys) && ((ptr + desc->ram[i].size) <= (sd->sys + sd->sys_size)));
+            const snapdelta_area_t area = { .offset = (uint32_t)(ptr - sd->sys), .size = (uint32_t)desc->ram[i].size };
+            // insert sorted by offset
+            int pos = sd->num_ram++;
+            while ((pos > 0) && (sd->ram[pos-1].offset > area.offset)) {
+                sd->ram[pos] = sd->ram[pos-1];
+                pos--;
+            }
+            sd->ram[pos] = area;
+        }
+    }
+    for (int i = 1; i < sd->num_ram; i++) {
+        // RAM areas must not overlap
+        CHIPS_ASSERT((sd->ram[i-1].offset + sd->ram[i-1].size) <= sd->ram[i].offset);
+    }
+}
+
+void snapdelta_begin(snapdelta_t* sd, const void* base_snapshot) {
+    CHIPS_ASSERT(sd && sd->sys && base_snapshot);
+    if (base_snapshot != sd->shadow) {
+        memcpy(sd->shadow, base_snapshot, sd->sys_size);
+    }
+    for (int i = 0; i < sd->num_mems; i++) {
+        mem_clear_dirty(sd->mem[i]);
+    }
+}
+
+// compare a range of the scratch snapshot in page-sized blocks with the shadow copy, and write changed blocks to the delta and shadow copy
+static size_t _snapdelta_put_changed(snapdelta_t* sd, uint8_t* out, size_t pos, uint32_t* num_chunks, uint32_t begin, uint32_t end) {
+    for (uint32_t offset = begin; offset < end; offset += MEM_PAGE_SIZE) {
+        const uint32_t size = ((end - offset) < MEM_PAGE_SIZE) ? (end - offset) : MEM_PAGE_SIZE;
+        if (0 != memcmp(sd->scratch + offset, sd->shadow + offset, size)) {
+            _snapdelta_put32(out + pos, offset);
+            _snapdelta_put32(out + pos + 4, size);
+            memcpy(out + pos + SNAPDELTA_CHUNK_HEADER_SIZE, sd->scratch + offset, size);
+            memcpy(sd->shadow + offset, sd->scratch + offset, size);
+            pos += SNAPDELTA_CHUNK_HEADER_SIZE + size;
+            *num_chunks += 1;
+        }
+    }
+    return pos;
+}
+
+// find the RAM area which contains a mapped memory page, or return -1
+static int _snapdelta_find_ram(snapdelta_t* sd, const uint8_t* ptr) {
+    for (int i = 0; i < sd->num_ram; i++) {
+        const uint8_t* ram = sd->sys + sd->ram[i].offset;
+        if ((ptr >= ram) && ((ptr + MEM_PAGE_SIZE) <= (ram + sd->ram[i].size))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+size_t snapdelta_encode(snapdelta_t* sd, void* dst, size_t dst_size) {
+    CHIPS_ASSERT(sd && sd->sys && dst);
+    CHIPS_ASSERT(dst_size >= SNAPDELTA_MAX_SIZE(sd->sys_size));
+    (void)dst_size;
+    uint8_t* out = (uint8_t*) dst;
+    size_t pos = SNAPDELTA_HEADER_SIZE;
+    uint32_t num_chunks = 0;
+
+    // all comparisons are done on a snapshot, so that pointer fixups
+    // never touch the running system
+    sd->save_snapshot(sd->sys, sd->scratch);
+
+    // if a dirty page has been remapped, the dirty-page bitmaps no longer
+    // tell which RAM has been written, and all RAM areas must be compared
+    bool remapped = false;
+    for (int i = 0; i < sd->num_mems; i++) {
+        remapped |= mem_dirty_remapped(sd->mem[i]);
+    }
+    if (!remapped) {
+        for (int i = 0; i < sd->num_mems; i++) {
+            const mem_t* mem = sd->mem[i];
+            for (size_t layer = 0; layer < MEM_NUM_LAYERS; layer++) {
+                const uint64_t dirty = mem->dirty[layer];
+                if (0 == dirty) {
+                    continue;
+                }
+                for (size_t page = 0; page < MEM_NUM_PAGES; page++) {
+                    if (dirty & (1ULL<<page)) {
+                        const uint8_t* ptr = mem->layers[layer][page].write_ptr;
+                        const int ram_index = _snapdelta_find_ram(sd, ptr);
+                        if (ram_index >= 0) {
+                            const uint32_t offset = (uint32_t)(ptr - sd->sys);
+                            // all pages must be at the same page grid in a RAM area
+                            CHIPS_ASSERT(0 == ((offset - sd->ram[ram_index].offset) & MEM_PAGE_MASK));
+                            // a page which is mapped more than once has already been written after the first time
+                            pos = _snapdelta_put_changed(sd, out, pos, &num_chunks, offset, offset + MEM_PAGE_SIZE);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    // also clear the dirty-page bitmaps in the snapshot, so that they don't show up in every delta
+    for (int i = 0; i < sd->num_mems; i++) {
+        mem_clear_dirty(sd->mem[i]);
+        mem_clear_dirty((mem_t*)(sd->scratch + ((uint8_t*)sd->mem[i] - sd->sys)));
+    }
+
+    // compare the rest of the snapshot
+    uint32_t begin = 0;
+    for (int i = 0; i < sd->num_ram; i++) {
+        const uint32_t ram_begin = sd->ram[i].offset;
+        const uint32_t ram_end = ram_begin + sd->ram[i].size;
+        pos = _snapdelta_put_changed(sd, out, pos, &num_chunks, begin, ram_begin);
+        if (remapped) {
+            pos = _snapdelta_put_changed(sd, out, pos, &num_chunks, ram_begin, ram_end);
+        }
+        begin = ram_end;
+    }
+    pos = _snapdelta_put_changed(sd, out, pos, &num_chunks, begin, (uint32_t)sd->sys_size);
+
+    _snapdelta_put32(out, SNAPDELTA_MAGIC);
+    _snapdelta_put32(out + 4, (uint32_t)sd->sys_size);
+    _snapdelta_put32(out + 8, num_chunks);
+    return pos;
+}
+
+uint32_t snapdelta_num_chunks(const void* delta, size_t delta_size) {
+    CHIPS_ASSERT(delta);
+    const uint8_t* ptr = (const uint8_t*) delta;
+    if ((delta_size < SNAPDELTA_HEADER_SIZE) || (_snapdelta_get32(ptr) != SNAPDELTA_MAGIC)) {
+        return 0;
+    }
+    return _snapdelta_get32(ptr + 8);
+}
+
+bool snapdelta_apply(void* snapshot, size_t snapshot_size, const void* delta, size_t delta_size) {
+    CHIPS_ASSERT(snapshot && delta);
+    const uint8_t* ptr = (const uint8_t*) delta;
+    if ((delta_size < SNAPDELTA_HEADER_SIZE) || (_snapdelta_get32(ptr) != SNAPDELTA_MAGIC)) {
+        return false;
+    }
+    if (_snapdelta_get32(ptr + 4) != snapshot_size) {
+        return false;
+    }
+    const uint32_t num_chunks = _snapdelta_get32(ptr + 8);
+    uint8_t* dst = (uint8_t*) snapshot;
+    size_t pos = SNAPDELTA_HEADER_SIZE;
+    for (uint32_t i = 0; i < num_chunks; i++) {
+        if ((pos + SNAPDELTA_CHUNK_HEADER_SIZE) > delta_size) {
+            return false;
+        }
+        const uint32_t offset = _snapdelta_get32(ptr + pos);
+        const uint32_t size = _snapdelta_get32(ptr + pos + 4);
+        if ((size > MEM_PAGE_SIZE) || (offset > snapshot_size) || (size > (snapshot_size - offset))) {
+            return false;
+        }
+        if ((pos + SNAPDELTA_CHUNK_HEADER_SIZE + size) > delta_size) {
+            return false;
+        }
+        memcpy(dst + offset, ptr + pos + SNAPDELTA_CHUNK_HEADER_SIZE, size);
+        pos += SNAPDELTA_CHUNK_HEADER_SIZE + size;
+    }
+    return true;
+}
+
+bool snapdelta_restore(void* dst_snapshot, const void* base_snapshot, size_t snapshot_size, const void* const* deltas, const size_t* delta_sizes, int num_deltas) {
+    CHIPS_ASSERT(dst_snapshot && base_snapshot);
+    CHIPS_ASSERT((num_deltas == 0) || (deltas && delta_sizes));
+    if (dst_snapshot != base_snapshot) {
+        memcpy(dst_snapshot, base_snapshot, snapshot_size);
+    }
+    for (int i = 0; i < num_deltas; i++) {
+        if (!snapdelta_apply(dst_snapshot, snapshot_size, deltas[i], delta_sizes[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // CHIPS_UTIL_IMPL